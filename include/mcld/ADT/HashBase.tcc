@@ -127,13 +127,25 @@ template<typename HashEntryTy,
 unsigned int
 HashTableImpl<HashEntryTy, HashFunctionTy>::lookUpBucketFor(
   const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey)
+{
+  return lookUpBucketFor(pKey, m_Hasher(pKey));
+}
+
+/// lookUpBucketFor - look up the bucket whose key is pKey. pFullHash is the
+/// hash value of pKey.
+template<typename HashEntryTy,
+         typename HashFunctionTy>
+unsigned int
+HashTableImpl<HashEntryTy, HashFunctionTy>::lookUpBucketFor(
+  const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+  unsigned int pFullHash)
 {
   if (0 == m_NumOfBuckets) {
     // NumOfBuckets is changed after init(pInitSize)
     init(NumOfInitBuckets);
   }
 
-  unsigned int full_hash = m_Hasher(pKey);
+  unsigned int full_hash = pFullHash;
   unsigned int index = full_hash % m_NumOfBuckets;
 
   const unsigned int probe = 1;
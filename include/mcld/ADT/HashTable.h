@@ -67,6 +67,9 @@ public:
   EntryFactoryTy& getEntryFactory()
   { return m_EntryFactory; }
 
+  const EntryFactoryTy& getEntryFactory() const
+  { return m_EntryFactory; }
+
   // -----  modifiers  ----- //
   void clear();
 
@@ -75,6 +78,10 @@ public:
   //  If the element already exists, return the element, and set pExist true.
   entry_type* insert(const key_type& pKey, bool& pExist);
 
+  /// insert - insert with the hash value of pKey computed by the caller.
+  //  pHash must be equal to hash()(pKey).
+  entry_type* insert(const key_type& pKey, unsigned int pHash, bool& pExist);
+
   /// erase - remove the element with the same key
   size_type erase(const key_type& pKey);
 
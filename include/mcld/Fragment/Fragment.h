@@ -54,7 +54,7 @@ public:
 
   uint64_t getOffset() const;
 
-  void setOffset(uint64_t pOffset) { m_Offset = pOffset; }
+  void setOffset(uint64_t pOffset);
 
   bool hasOffset() const;
 
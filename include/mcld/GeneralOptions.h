@@ -42,6 +42,20 @@ public:
     Both    = 0x3
   };
 
+  enum ICF {
+    ICF_None,
+    ICF_All,
+    ICF_Safe
+  };
+
+  enum BuildIDStyle {
+    BuildID_None,
+    BuildID_Fast,
+    BuildID_SHA1,
+    BuildID_UUID,
+    BuildID_Hex
+  };
+
   typedef std::vector<std::string> RpathList;
   typedef RpathList::iterator rpath_iterator;
   typedef RpathList::const_iterator const_rpath_iterator;
@@ -187,6 +201,9 @@ public:
   bool hasOrigin() const
   { return m_bOrigin; }
 
+  bool hasPackRelativeRelocs() const
+  { return m_bPackRelativeRelocs; }
+
   uint64_t commPageSize() const
   { return m_CommPageSize; }
 
@@ -274,6 +291,13 @@ public:
   bool printMap() const
   { return m_bPrintMap; }
 
+  // --stats
+  void setPrintStats(bool pEnable = true)
+  { m_bPrintStats = pEnable; }
+
+  bool printStats() const
+  { return m_bPrintStats; }
+
   // -G, max GP size option
   void setGPSize(int gpsize)
   { m_GPSize = gpsize; }
@@ -281,11 +305,65 @@ public:
   int getGPSize() const
   { return m_GPSize; }
 
+  // --gc-sections
+  void setGCSections(bool pEnable = true)
+  { m_bGCSections = pEnable; }
+
+  bool GCSections() const
+  { return m_bGCSections; }
+
+  // --lazy-dso-symbols
+  // Read the defined symbols of a shared object only when they are referred.
+  void setLazyDynObjSymbols(bool pEnable = true)
+  { m_bLazyDynObjSymbols = pEnable; }
+
+  bool lazyDynObjSymbols() const
+  { return m_bLazyDynObjSymbols; }
+
+  // --map-whole-inputs
+  // Map each read-only input file once instead of mapping or reading every
+  // requested piece.
+  void setMapWholeInputs(bool pEnable = true)
+  { m_bMapWholeInputs = pEnable; }
+
+  bool mapWholeInputs() const
+  { return m_bMapWholeInputs; }
+
+  // --icf=[none|all|safe]
+  void setICFMode(ICF pMode)
+  { m_ICF = pMode; }
+
+  ICF getICFMode() const
+  { return m_ICF; }
+
+  // --build-id[=fast|sha1|uuid|0xHEX|none]
+  /// setBuildID - set up the build-id by the style given to --build-id. An
+  /// empty style means sha1. Return false if pStyle is invalid.
+  bool setBuildID(const std::string& pStyle);
+
+  BuildIDStyle getBuildIDStyle() const
+  { return m_BuildID; }
+
+  bool hasBuildID() const
+  { return (BuildID_None != m_BuildID); }
+
+  /// getBuildIDHex - the bytes given by --build-id=0xHEX
+  const std::string& getBuildIDHex() const
+  { return m_BuildIDHex; }
+
   unsigned int getHashStyle() const { return m_HashStyle; }
 
   void setHashStyle(unsigned int pStyle)
   { m_HashStyle = pStyle; }
 
+  // --threads, --no-threads, --thread-count=N
+  // The number of threads the linker may use. 1 means single-threaded.
+  void setNumOfThreads(unsigned int pNum)
+  { m_NumOfThreads = (0 == pNum) ? 1 : pNum; }
+
+  unsigned int numOfThreads() const
+  { return m_NumOfThreads; }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList&       getRpathList()       { return m_RpathList; }
@@ -354,6 +432,7 @@ private:
   bool m_bRelro         : 1;   // relro, norelro
   bool m_bNow           : 1;   // lazy, now
   bool m_bOrigin        : 1;   // origin
+  bool m_bPackRelativeRelocs : 1; // [no]pack-relative-relocs
   bool m_bTrace         : 1;   // --trace
   bool m_Bsymbolic      : 1;   // --Bsymbolic
   bool m_Bgroup         : 1;
@@ -371,11 +450,19 @@ private:
   bool m_bNewDTags: 1; // --enable-new-dtags
   bool m_bNoStdlib: 1; // -nostdlib
   bool m_bPrintMap: 1; // --print-map
+  bool m_bPrintStats: 1; // --stats
+  bool m_bGCSections: 1; // --gc-sections
+  bool m_bLazyDynObjSymbols: 1; // --lazy-dso-symbols
+  bool m_bMapWholeInputs: 1; // --map-whole-inputs
   uint32_t m_GPSize; // -G, --gpsize
   StripSymbolMode m_StripSymbols;
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   unsigned int m_HashStyle;
+  unsigned int m_NumOfThreads; // --threads, --thread-count=N
+  ICF m_ICF; // --icf
+  BuildIDStyle m_BuildID; // --build-id
+  std::string m_BuildIDHex; // --build-id=0xHEX
   std::string m_Filter;
   AuxiliaryList m_AuxiliaryList;
 };
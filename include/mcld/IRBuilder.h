@@ -35,7 +35,9 @@ namespace mcld {
 
 class Module;
 class LinkerConfig;
+class LinkContext;
 class InputTree;
+class DynObjReader;
 
 /** \class IRBuilder
  *  \brief IRBuilder provides an uniform API for creating sections and
@@ -44,6 +46,10 @@ class InputTree;
  *  Ahead-of-time virtual machines (VM) usually compiles an intermediate
  *  language into a system-dependent binary.  IRBuilder helps such kind of VMs
  *  to emit binaries in native object format, such as ELF or MachO.
+ *
+ *  The static member functions produce the objects in the current
+ *  LinkContext of the calling thread. Callers which build the IR by hand
+ *  should hold a LinkContext::Scope of getContext().
  */
 class IRBuilder
 {
@@ -65,15 +71,25 @@ public:
   };
 
 public:
+  /// IRBuilder - the objects go to the current LinkContext.
   IRBuilder(Module& pModule, const LinkerConfig& pConfig);
 
+  IRBuilder(Module& pModule, const LinkerConfig& pConfig,
+            LinkContext& pContext);
+
   ~IRBuilder();
 
+  LinkContext& getContext() { return m_Context; }
+
   const InputBuilder& getInputBuilder() const { return m_InputBuilder; }
   InputBuilder&       getInputBuilder()       { return m_InputBuilder; }
   const Module& getModule() const { return m_Module; }
   Module&       getModule()       { return m_Module; }
 
+  /// setDynObjReader - if pReader is not NULL, every new non-local symbol
+  /// is looked up in the shared objects that pReader imports lazily.
+  void setDynObjReader(DynObjReader* pReader) { m_pDynObjReader = pReader; }
+
 /// @}
 /// @name Input Files On The Command Line
 /// @{
@@ -402,7 +418,27 @@ public:
   /// @return The added symbol. If the insertion fails due to the resoluction,
   /// return NULL.
   LDSymbol* AddSymbol(Input& pInput,
-                      const std::string& pName,
+                      const llvm::StringRef& pName,
+                      ResolveInfo::Type pType,
+                      ResolveInfo::Desc pDesc,
+                      ResolveInfo::Binding pBind,
+                      ResolveInfo::SizeType pSize,
+                      LDSymbol::ValueType pValue = 0x0,
+                      LDSection* pSection = NULL,
+                      ResolveInfo::Visibility pVis = ResolveInfo::Default);
+
+  /// AddSymbol - To add a symbol to the input file. The hash value of the
+  /// name is computed by the caller, e.g., by NamePool::Scan when the reader
+  /// finds the end of the name.
+  ///
+  /// pName is not copied unless a new symbol is created, so it can point to
+  /// the string table of the input file.
+  ///
+  /// @param [in]      pHash    The hash value of pName. It must be equal to
+  ///                           NamePool::Hash(pName).
+  LDSymbol* AddSymbol(Input& pInput,
+                      const llvm::StringRef& pName,
+                      uint32_t pHash,
                       ResolveInfo::Type pType,
                       ResolveInfo::Desc pDesc,
                       ResolveInfo::Binding pBind,
@@ -471,7 +507,8 @@ public:
                                    Relocation::Address pAddend = 0);
 
 private:
-  LDSymbol* addSymbolFromObject(const std::string& pName,
+  LDSymbol* addSymbolFromObject(const llvm::StringRef& pName,
+                                uint32_t pHash,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
@@ -481,7 +518,8 @@ private:
                                 ResolveInfo::Visibility pVisibility);
 
   LDSymbol* addSymbolFromDynObj(Input& pInput,
-                                const std::string& pName,
+                                const llvm::StringRef& pName,
+                                uint32_t pHash,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
@@ -492,8 +530,11 @@ private:
 private:
   Module& m_Module;
   const LinkerConfig& m_Config;
+  LinkContext& m_Context;
 
   InputBuilder m_InputBuilder;
+
+  DynObjReader* m_pDynObjReader;
 };
 
 template<> LDSymbol*
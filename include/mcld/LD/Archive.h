@@ -112,7 +112,7 @@ public:
     Symbol(const char* pName,
            uint32_t pOffset,
            enum Status pStatus)
-     : name(pName), fileOffset(pOffset), status(pStatus)
+     : name(pName), fileOffset(pOffset), status(pStatus), next(0)
     {}
 
     ~Symbol()
@@ -122,10 +122,23 @@ public:
     std::string name;
     uint32_t fileOffset;
     enum Status status;
+    /// index of the next symtab entry with the same name, or 0 if there is
+    /// none (the first entry can never follow another one)
+    size_t next;
   };
 
   typedef std::vector<Symbol*> SymTabType;
 
+private:
+  typedef HashEntry<const llvm::StringRef,
+                    size_t,
+                    hash::StringCompare<llvm::StringRef> > SymbolIndexEntryType;
+
+public:
+  typedef HashTable<SymbolIndexEntryType,
+                    hash::StringHash<hash::DJB>,
+                    EntryFactory<SymbolIndexEntryType> > SymbolIndexType;
+
 public:
   Archive(Input& pInputFile, InputBuilder& pBuilder);
 
@@ -218,6 +231,23 @@ public:
   /// setSymbolStatus - set the status of a symbol
   void setSymbolStatus(size_t pSymIdx, enum Symbol::Status pStatus);
 
+  /// findSymbol - get the index of the first symtab entry with the given name
+  /// @return numOfSymbols() if there is no such entry
+  size_t findSymbol(const llvm::StringRef& pName) const;
+
+  /// getNextSymbol - get the index of the next symtab entry that has the same
+  /// name as the given one
+  /// @return numOfSymbols() if there is no such entry
+  size_t getNextSymbol(size_t pSymIdx) const;
+
+  /// getUndefCursor - get the number of entries in NamePool's undefined
+  /// symbol list that have been searched in this archive
+  size_t getUndefCursor() const;
+
+  /// setUndefCursor - set the number of entries in NamePool's undefined
+  /// symbol list that have been searched in this archive
+  void setUndefCursor(size_t pCursor);
+
   /// getStrTable - get the extended name table
   std::string& getStrTable();
 
@@ -249,7 +279,9 @@ private:
   ArchiveMemberMapType m_ArchiveMemberMap;
   SymbolFactory m_SymbolFactory;
   SymTabType m_SymTab;
+  SymbolIndexType m_SymIndex;
   size_t m_SymTabSize;
+  size_t m_UndefCursor;
   std::string m_StrTab;
   InputBuilder& m_Builder;
 };
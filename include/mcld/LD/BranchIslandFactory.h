@@ -12,46 +12,74 @@
 #include <gtest.h>
 #endif
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/Support/DataTypes.h>
 #include <mcld/Support/GCFactory.h>
 #include <mcld/LD/BranchIsland.h>
 
+#include <utility>
+#include <vector>
+
 namespace mcld
 {
 
 class Fragment;
 class Module;
+class SectionData;
 
 /** \class BranchIslandFactory
- *  \brief
+ *  \brief BranchIslandFactory creates and finds the branch islands.
  *
+ *  Islands are grouped for every executable output section. The islands of
+ *  a section are kept in the order of their offsets, so the islands around a
+ *  fragment are found by binary search.
  */
 class BranchIslandFactory : public GCFactory<BranchIsland, 0>
 {
 public:
   /// ctor
-  /// @param pMaxBranchRange - the max branch range of the target backend
+  /// @param pMaxFwdBranchRange - the max forward branch range of the target
+  /// @param pMaxBwdBranchRange - the max backward branch range of the target
   /// @param pMaxIslandSize - a predifned value (64KB here) to decide the max
   ///                         size of the island
-  BranchIslandFactory(uint64_t pMaxBranchRange,
+  BranchIslandFactory(uint64_t pMaxFwdBranchRange,
+                      uint64_t pMaxBwdBranchRange,
                       uint64_t pMaxIslandSize = 65536U);
 
   ~BranchIslandFactory();
 
-  /// group - group fragments and create islands when needed
-  /// @param pSectionData - the SectionData holds fragments need to be grouped
+  /// group - group fragments of every executable output section and create
+  /// islands when needed
   void group(Module& pModule);
 
   /// produce - produce a island for the given fragment
   /// @param pFragment - the fragment needs a branch island
   BranchIsland* produce(Fragment& pFragment);
 
-  /// find - find a island for the given fragment
-  /// @param pFragment - the fragment needs a branch isladn
+  /// find - find a island for the given fragment. The island after the
+  /// fragment is preferred.
+  /// @param pFragment - the fragment needs a branch island
   BranchIsland* find(const Fragment& pFragment);
 
+  /// getIslands - get the islands before and after the branch at pOffset of
+  /// the given fragment which are in the branch range. Either one may be NULL.
+  /// @param pFragment - the fragment needs a branch island
+  /// @param pOffset - the offset of the branch in pFragment
+  std::pair<BranchIsland*, BranchIsland*> getIslands(const Fragment& pFragment,
+                                                     uint64_t pOffset = 0);
+
+private:
+  typedef std::vector<BranchIsland*> IslandList;
+  typedef llvm::DenseMap<const SectionData*, IslandList> IslandMap;
+
+private:
+  /// group - group fragments of pSectionData
+  void group(SectionData& pSectionData);
+
 private:
-  uint64_t m_MaxBranchRange;
+  IslandMap m_IslandMap;
+  uint64_t m_MaxFwdBranchRange;
+  uint64_t m_MaxBwdBranchRange;
   uint64_t m_MaxIslandSize;
 };
 
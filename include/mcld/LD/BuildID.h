@@ -0,0 +1,83 @@
+//===- BuildID.h ----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_BUILDID_H
+#define MCLD_LD_BUILDID_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/Support/DataTypes.h>
+#include <cstddef>
+
+namespace mcld {
+
+class LDSection;
+class LinkerConfig;
+class MemoryArea;
+
+/** \class BuildID
+ *  \brief BuildID represents the .note.gnu.build-id section.
+ *
+ *  The descriptor of the note identifies the output file. It is
+ *    - fast:  a 64-bit xxHash of the output file,
+ *    - sha1:  a 160-bit SHA-1 of the output file,
+ *    - uuid:  a random 128-bit UUID, or
+ *    - 0xHEX: the given bytes.
+ *
+ *  fast and sha1 are tree hashes. The output file is cut into chunks of
+ *  ChunkSize bytes, the chunks are hashed in parallel, and the descriptor is
+ *  the hash of the concatenated chunk digests. The chunk size is fixed, so
+ *  the build-id does not depend on the number of threads. The descriptor
+ *  itself is zero while hashing.
+ *
+ *  The note header is written in the byte order of the target.
+ */
+class BuildID
+{
+public:
+  enum {
+    ChunkSize = 1024 * 1024
+  };
+
+public:
+  BuildID(LDSection& pSection, const LinkerConfig& pConfig);
+
+  ~BuildID();
+
+  /// descSize - the size of the note descriptor
+  size_t descSize() const;
+
+  /// sizeOutput - set the size of .note.gnu.build-id
+  void sizeOutput();
+
+  /// emitOutput - write out the note. Must be called after all the other
+  /// parts of the output file are written.
+  void emitOutput(MemoryArea& pOutput, unsigned int pNumOfThreads);
+
+  /// emit - write out the note into pFile, the image of the whole output
+  /// file of pFileSize bytes
+  void emit(uint8_t* pFile, size_t pFileSize, unsigned int pNumOfThreads);
+
+private:
+  /// computeDigest - compute the tree hash of pData into pDigest
+  void computeDigest(const uint8_t* pData,
+                     size_t pSize,
+                     unsigned int pNumOfThreads,
+                     uint8_t* pDigest) const;
+
+private:
+  LDSection& m_Section;
+
+  const LinkerConfig& m_Config;
+};
+
+} // namespace of mcld
+
+#endif
+
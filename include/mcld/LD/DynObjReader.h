@@ -18,6 +18,7 @@ namespace mcld {
 
 class TargetLDBackend;
 class Input;
+class ResolveInfo;
 
 /** \class DynObjReader
  *  \brief DynObjReader provides an common interface for different object
@@ -36,6 +37,12 @@ public:
 
   virtual bool readSymbols(Input& pFile) = 0;
 
+  /// importSymbol - import the definitions of pInfo from the shared objects
+  /// whose symbols are read lazily.
+  virtual void importSymbol(const ResolveInfo& pInfo) { }
+
+  /// finishLazyImport - stop importing symbols lazily
+  virtual void finishLazyImport() { }
 };
 
 } // namespace of mcld
@@ -13,6 +13,7 @@
 #endif
 #include <mcld/LD/DynObjReader.h>
 #include <llvm/Support/system_error.h>
+#include <vector>
 
 namespace mcld {
 
@@ -21,6 +22,7 @@ class LinkerConfig;
 class IRBuilder;
 class GNULDBackend;
 class ELFReaderIF;
+class ELFDynSymTab;
 
 /** \class ELFDynObjReader
  *  \brief ELFDynObjReader reads ELF dynamic shared objects.
@@ -42,9 +44,30 @@ public:
 
   bool readSymbols(Input& pInput);
 
+  /// importSymbol - import the definitions of pInfo from the first lazily
+  /// read shared object which defines it.
+  void importSymbol(const ResolveInfo& pInfo);
+
+  /// finishLazyImport - release the tables of the lazily read shared objects
+  void finishLazyImport();
+
+private:
+  /// readLazySymbols - read the undefined symbols of pTable and the
+  /// definitions of the symbols that are already referred.
+  void readLazySymbols(ELFDynSymTab& pTable);
+
+  /// importSymbol - read the symbol at pIdx of pTable and its aliases
+  void importSymbol(ELFDynSymTab& pTable, size_t pIdx);
+
+private:
+  typedef std::vector<ELFDynSymTab*> DynSymTabList;
+
 private:
   ELFReaderIF *m_pELFReader;
   IRBuilder& m_Builder;
+  unsigned int m_BitClass;
+  bool m_bLazy;
+  DynSymTabList m_LazyDynObjs;
 };
 
 } // namespace of mcld
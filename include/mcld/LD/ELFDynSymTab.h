@@ -0,0 +1,115 @@
+//===- ELFDynSymTab.h -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ELF_DYNSYM_TABLE_H
+#define MCLD_ELF_DYNSYM_TABLE_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class MemoryRegion;
+
+/** \class ELFDynSymTab
+ *  \brief ELFDynSymTab looks up the dynamic symbols of an input shared object
+ *  by the object's own .gnu.hash or .hash.
+ *
+ *  .dynsym, .dynstr and the hash table stay mapped while the table is open,
+ *  so the symbols of the shared object can be imported one by one when they
+ *  are referred, instead of all at once.
+ */
+class ELFDynSymTab
+{
+public:
+  ELFDynSymTab(Input& pInput, unsigned int pBitClass);
+
+  ~ELFDynSymTab();
+
+  /// open - map the tables. Return false if the input has no .dynsym or no
+  /// hash table.
+  bool open();
+
+  /// close - release the mapped tables
+  void close();
+
+  Input& input() { return m_Input; }
+
+  const MemoryRegion& symtab() const { return *m_pSymTab; }
+
+  const char* strtab() const;
+
+  size_t numOfSymbols() const { return m_NumOfSymbols; }
+
+  /// find - the lowest index of the visible definitions of pName. Return 0
+  /// if the shared object does not define pName.
+  size_t find(const llvm::StringRef& pName) const;
+
+  /// isUndef - is the symbol at pIdx undefined?
+  bool isUndef(size_t pIdx) const;
+
+  /// getAliases - if the symbol at pIdx is a data object sharing its address
+  /// with a weak one, append the index of all of them to pAliases in the
+  /// order that Module's alias list expects. Otherwise, append nothing.
+  void getAliases(size_t pIdx, std::vector<size_t>& pAliases);
+
+  bool isImported(size_t pIdx) const { return m_Imported[pIdx]; }
+
+  void setImported(size_t pIdx) { m_Imported[pIdx] = true; }
+
+private:
+  struct Symbol {
+    uint32_t name;
+    uint64_t value;
+    uint8_t  info;
+    uint8_t  other;
+    uint16_t shndx;
+  };
+
+  struct AliasLess;
+
+private:
+  Symbol getSymbol(size_t pIdx) const;
+
+  uint32_t getWord(const MemoryRegion& pRegion, size_t pIdx) const;
+
+  /// isVisibleDefine - can the symbol with pName define a reference to pName
+  /// from other objects?
+  bool isVisibleDefine(size_t pIdx, const llvm::StringRef& pName) const;
+
+  /// isAlias - may the symbol be an alias of a weak data object?
+  bool isAlias(const Symbol& pSym) const;
+
+  size_t findByGNUHash(const llvm::StringRef& pName) const;
+
+  size_t findBySysVHash(const llvm::StringRef& pName) const;
+
+private:
+  Input& m_Input;
+  unsigned int m_BitClass;
+  MemoryRegion* m_pSymTab;
+  MemoryRegion* m_pStrTab;
+  MemoryRegion* m_pHash;
+  bool m_bGNUHash;
+  size_t m_NumOfSymbols;
+  std::vector<bool> m_Imported;
+
+  /// the possible aliases sorted by AliasLess, built on the first use
+  std::vector<size_t> m_Aliases;
+  bool m_bHasAliases;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -36,6 +36,17 @@ private:
   virtual void
   initObjectFormat(ObjectBuilder& pBuilder, unsigned int pBitClass) = 0;
 
+public:
+  /// the section type and the dynamic tags of the packed relative
+  /// relocations
+  /// FIXME: use llvm enum constants
+  enum {
+    SHT_RELR   = 19,
+    DT_RELRSZ  = 35,
+    DT_RELR    = 36,
+    DT_RELRENT = 37
+  };
+
 public:
   ELFFileFormat();
 
@@ -64,6 +75,9 @@ public:
   bool hasRelaPlt() const
   { return (NULL != f_pRelaPlt) && (0 != f_pRelaPlt->size()); }
 
+  bool hasRelrDyn() const
+  { return (NULL != f_pRelrDyn) && (0 != f_pRelrDyn->size()); }
+
   /// @ref 10.3.1.1, ISO/IEC 23360, Part 1:2010(E), p. 21.
   bool hasComment() const
   { return (NULL != f_pComment) && (0 != f_pComment->size()); }
@@ -165,6 +179,9 @@ public:
   bool hasNoteABITag() const
   { return (NULL != f_pNoteABITag) && (0 != f_pNoteABITag->size()); }
 
+  bool hasNoteGNUBuildID() const
+  { return (NULL != f_pNoteGNUBuildID) && (0 != f_pNoteGNUBuildID->size()); }
+
   bool hasStab() const
   { return (NULL != f_pStab) && (0 != f_pStab->size()); }
 
@@ -255,6 +272,16 @@ public:
     return *f_pRelaPlt;
   }
 
+  LDSection& getRelrDyn() {
+    assert(NULL != f_pRelrDyn);
+    return *f_pRelrDyn;
+  }
+
+  const LDSection& getRelrDyn() const {
+    assert(NULL != f_pRelrDyn);
+    return *f_pRelrDyn;
+  }
+
   LDSection& getComment() {
     assert(NULL != f_pComment);
     return *f_pComment;
@@ -587,6 +614,16 @@ public:
     return *f_pNoteABITag;
   }
 
+  LDSection& getNoteGNUBuildID() {
+    assert(NULL != f_pNoteGNUBuildID);
+    return *f_pNoteGNUBuildID;
+  }
+
+  const LDSection& getNoteGNUBuildID() const {
+    assert(NULL != f_pNoteGNUBuildID);
+    return *f_pNoteGNUBuildID;
+  }
+
   LDSection& getStab() {
     assert(NULL != f_pStab);
     return *f_pStab;
@@ -657,6 +694,7 @@ protected:
   LDSection* f_pRelPlt;            // .rel.plt
   LDSection* f_pRelaDyn;           // .rela.dyn
   LDSection* f_pRelaPlt;           // .rela.plt
+  LDSection* f_pRelrDyn;           // .relr.dyn
 
   /// @ref 10.3.1.1, ISO/IEC 23360, Part 1:2010(E), p. 21.
   LDSection* f_pComment;           // .comment
@@ -694,6 +732,7 @@ protected:
   LDSection* f_pGOTPLT;            // .got.plt
   LDSection* f_pJCR;               // .jcr
   LDSection* f_pNoteABITag;        // .note.ABI-tag
+  LDSection* f_pNoteGNUBuildID;    // .note.gnu.build-id
   LDSection* f_pStab;              // .stab
   LDSection* f_pStabStr;           // .stabstr
 
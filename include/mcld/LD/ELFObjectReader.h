@@ -53,6 +53,8 @@ public:
 
   virtual bool readSections(Input& pFile);
 
+  virtual bool readRegularSections(Input& pFile);
+
   virtual bool readSymbols(Input& pFile);
 
   /// readRelocations - read relocation sections
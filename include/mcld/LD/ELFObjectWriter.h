@@ -13,6 +13,7 @@
 #endif
 #include <mcld/LD/ObjectWriter.h>
 #include <cassert>
+#include <vector>
 
 #include <llvm/Support/system_error.h>
 
@@ -45,7 +46,21 @@ public:
   llvm::error_code writeObject(Module& pModule, MemoryArea& pOutput);
 
 private:
-  void writeSection(MemoryArea& pOutput, LDSection *section);
+  typedef std::vector<LDSection*> SectionList;
+
+  class WriteTask;
+
+  /// writeSections - write out the contents of pSections. Output sections
+  /// have disjoint file offsets after layout, so the regions are filled
+  /// concurrently.
+  void writeSections(const SectionList& pSections, MemoryArea& pOutput);
+
+  /// requestRegion - request the output region of pSection. Return NULL if
+  /// pSection has no contents in the output file.
+  MemoryRegion* requestRegion(MemoryArea& pOutput, LDSection& pSection);
+
+  /// writeSection - write out the whole pSection into pRegion
+  void writeSection(LDSection& pSection, MemoryRegion& pRegion);
 
   GNULDBackend&       target()        { return m_Backend; }
 
@@ -71,9 +86,7 @@ private:
   void emitProgramHeader(MemoryArea& pOutput) const;
 
   // emitShStrTab - emit .shstrtab
-  void emitShStrTab(const LDSection& pShStrTab,
-                    const Module& pModule,
-                    MemoryArea& pOutput);
+  void emitShStrTab(const LDSection& pShStrTab, MemoryArea& pOutput);
 
   void emitSectionData(const LDSection& pSection,
                        MemoryRegion& pRegion) const;
@@ -83,6 +83,13 @@ public:
                    const MemoryRegion& pRegion,
                    const char* StrTab) const;
 
+  /// readSymbol - read a symbol of an input shared object and create LDSymbol
+  LDSymbol* readSymbol(Input& pInput,
+                       IRBuilder& pBuilder,
+                       const MemoryRegion& pRegion,
+                       const char* pStrTab,
+                       size_t pIdx) const;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
@@ -173,6 +180,13 @@ public:
                    const MemoryRegion& pRegion,
                    const char* StrTab) const;
 
+  /// readSymbol - read a symbol of an input shared object and create LDSymbol
+  LDSymbol* readSymbol(Input& pInput,
+                       IRBuilder& pBuilder,
+                       const MemoryRegion& pRegion,
+                       const char* pStrTab,
+                       size_t pIdx) const;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
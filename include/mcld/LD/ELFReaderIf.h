@@ -29,6 +29,7 @@ class IRBuilder;
 class FragmentRef;
 class SectionData;
 class LDSection;
+class LDSymbol;
 
 /** \class ELFReaderIF
  *  \brief ELFReaderIF provides common interface for all kind of ELF readers.
@@ -74,6 +75,14 @@ public:
                            const MemoryRegion& pRegion,
                            const char* StrTab) const = 0;
 
+  /// readSymbol - read the symbol at pIdx of the dynamic symbol table pRegion
+  /// of a shared object and create its LDSymbol
+  virtual LDSymbol* readSymbol(Input& pInput,
+                               IRBuilder& pBuilder,
+                               const MemoryRegion& pRegion,
+                               const char* pStrTab,
+                               size_t pIdx) const = 0;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   virtual ResolveInfo* readSignature(Input& pInput,
@@ -17,15 +17,24 @@
 #include <mcld/Fragment/NullFragment.h>
 #include <mcld/Support/Allocators.h>
 
+#include <llvm/ADT/StringMap.h>
+
 #include <vector>
 
 namespace mcld {
 
+class Input;
 class LDSection;
+class MemoryRegion;
 class SectionData;
 
 /** \class EhFrame
  *  \brief EhFrame represents .eh_frame section
+ *
+ *  When the CIEs and FDEs of the inputs are merged into the output, the CIEs
+ *  with the same contents and relocations are folded into one, and the FDEs
+ *  of the discarded functions are dropped. The CIE pointers of the FDEs are
+ *  rewritten by emitCIEPointers() when the output is written.
  */
 class EhFrame
 {
@@ -68,13 +77,22 @@ public:
         const CIE& pCIE,
         uint32_t pDataStart);
 
-    const CIE& getCIE() const { return m_CIE; }
+    const CIE& getCIE() const { return *m_pCIE; }
+
+    void setCIE(const CIE& pCIE) { m_pCIE = &pCIE; }
 
     uint32_t getDataStart() const { return m_DataStart; }
 
+    /// getFunction - the input section of the described function, or NULL if
+    /// it is not known
+    const LDSection* getFunction() const { return m_pFunction; }
+
+    void setFunction(const LDSection& pFunction) { m_pFunction = &pFunction; }
+
   private:
-    const CIE& m_CIE;
+    const CIE* m_pCIE;
     uint32_t m_DataStart;
+    const LDSection* m_pFunction;
   };
 
   typedef std::vector<CIE*> CIEList;
@@ -99,6 +117,21 @@ public:
   /// merge - move all data from pOther to this object.
   EhFrame& merge(EhFrame& pOther);
 
+  /// merge - move the CIEs and FDEs of pOther in pInput to this object. A CIE
+  /// already in this object is not moved, and its FDEs refer to the existing
+  /// one. The FDEs of the discarded functions, and the CIEs left without any
+  /// FDE, are dropped along with their relocations.
+  EhFrame& merge(const Input& pInput, EhFrame& pOther);
+
+  /// setUpFunctions - record the input sections of the functions described by
+  /// the FDEs. This must be done before --gc-sections and --icf discard the
+  /// sections and redirect the symbols defined in them.
+  void setUpFunctions(const Input& pInput);
+
+  /// emitCIEPointers - write the CIE pointers of the FDEs into pRegion, the
+  /// output region of the section.
+  void emitCIEPointers(MemoryRegion& pRegion) const;
+
   const LDSection& getSection() const;
   LDSection&       getSection();
 
@@ -144,12 +177,18 @@ public:
 
   size_t numOfFDEs() const { return m_FDEs.size(); }
 
+private:
+  /// the contents and the relocations of a CIE to the CIE
+  typedef llvm::StringMap<CIE*> CIEMap;
+
 private:
   LDSection* m_pSection;
   SectionData* m_pSectionData;
 
   CIEList m_CIEs;
   FDEList m_FDEs;
+
+  CIEMap m_CIEMap;
 };
 
 } // namespace of mcld
@@ -11,10 +11,8 @@
 #ifdef ENABLE_UNITTEST
 #include <gtest.h>
 #endif
-#include <mcld/ADT/SizeTraits.h>
-#include <cassert>
+#include <cstddef>
 
-#include <mcld/LD/EhFrame.h>
 namespace mcld {
 
 class LDSection;
@@ -34,6 +32,12 @@ class MemoryRegion;
  *  uint32_t : fde_count
  *  __________________________ when fde_count > 0
  *  <uint32_t, uint32_t>+ : binary search table
+ *
+ *  The entries of the binary search table are relative to .eh_frame_hdr on
+ *  both 32-bit and 64-bit targets. The PC Begin values of the FDEs are
+ *  decoded in parallel, and the table is sorted by a parallel LSD radix sort
+ *  whose last pass writes into the output. The sort is stable, so the output
+ *  does not depend on the number of threads.
  */
 class EhFrameHdr
 {
@@ -46,14 +50,9 @@ public:
   void sizeOutput();
 
   /// emitOutput - write out eh_frame_hdr
-  template<size_t size>
-  void emitOutput(MemoryArea& pOutput)
-  { assert(false && "Call invalid EhFrameHdr::emitOutput"); }
-
-private:
-  /// computePCBegin - return the address of FDE's pc
-  /// @ref binutils gold: ehframe.cc:222
-  uint32_t computePCBegin(const EhFrame::FDE& pFDE, const MemoryRegion& pEhFrameRegion);
+  /// @param SIZE - the bitclass of the target
+  template<size_t SIZE>
+  void emitOutput(MemoryArea& pOutput, unsigned int pNumOfThreads);
 
 private:
   /// .eh_frame_hdr section
@@ -63,13 +62,6 @@ private:
   const LDSection& m_EhFrame;
 };
 
-//===----------------------------------------------------------------------===//
-// Template Specification Functions
-//===----------------------------------------------------------------------===//
-/// emitOutput - write out eh_frame_hdr
-template<>
-void EhFrameHdr::emitOutput<32>(MemoryArea& pOutput);
-
 } // namespace of mcld
 
 #endif
@@ -77,6 +77,12 @@ private:
   enum Archive::Symbol::Status
   shouldIncludeSymbol(const llvm::StringRef& pSymName) const;
 
+  /// includeSymbol - decide whether the symtab entry at the given index is
+  /// needed, and include the object member defining it if so
+  void includeSymbol(const LinkerConfig& pConfig,
+                     Archive& pArchive,
+                     size_t pSymIdx);
+
   /// includeMember - include the object member in the given file offset, and
   /// return the size of the object
   /// @param pConfig - LinkerConfig
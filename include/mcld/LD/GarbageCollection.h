@@ -0,0 +1,119 @@
+//===- GarbageCollection.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_GARBAGECOLLECTION_H
+#define MCLD_LD_GARBAGECOLLECTION_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+class LDSymbol;
+class LinkerConfig;
+class Module;
+class RelocData;
+class Relocation;
+class TargetLDBackend;
+
+/** \class GarbageCollection
+ *  \brief GarbageCollection removes the input sections which can not be
+ *  reached from the entries of the output (--gc-sections).
+ *
+ *  The reference graph is the FragmentGraph at the granularity of input
+ *  sections: an input section refers to the sections where the symbols of
+ *  its relocations are defined. The entries are the entry symbol, the
+ *  exported dynamic symbols, the symbols used by dynamic objects, KEEP()
+ *  sections in the linker script, init/fini sections, and the sections that
+ *  are never garbage collected.
+ *
+ *  GarbageCollection runs after reading relocations and before merging
+ *  sections. Only allocatable Regular and BSS input sections are candidates.
+ *  An unreached candidate becomes LDFileFormat::Ignore, so no later pass
+ *  merges, scans, relocates or emits it.
+ */
+class GarbageCollection
+{
+public:
+  typedef std::vector<const LDSection*> SectionVecTy;
+
+public:
+  GarbageCollection(const LinkerConfig& pConfig,
+                    const TargetLDBackend& pBackend,
+                    Module& pModule);
+
+  ~GarbageCollection();
+
+  /// run - mark the reached sections and strip the others
+  bool run();
+
+  /// isCollectable - can pSection be garbage collected?
+  static bool isCollectable(const LDSection& pSection);
+
+private:
+  typedef llvm::DenseMap<const LDSection*, unsigned int> SectionIndexMap;
+  typedef llvm::DenseSet<const LDSection*> SectionSetTy;
+
+  /// setUpReachedSections - build the edges between input sections from the
+  /// input relocations.
+  void setUpReachedSections(SectionVecTy& pEntry);
+
+  /// setUpEhFrameEdges - an FDE is reached only if its function is reached.
+  /// The references of FDEs become the references of their functions, and
+  /// the references of the other entries (CIEs) are entries.
+  void setUpEhFrameEdges(const LDSection& pEhFrame,
+                         const RelocData& pRelocs,
+                         SectionVecTy& pEntry);
+
+  /// getEntrySections - get the sections that must be kept
+  void getEntrySections(SectionVecTy& pEntry);
+
+  /// findReferencedSections - mark all sections reached from pEntry
+  void findReferencedSections(SectionVecTy& pEntry);
+
+  /// stripSections - strip the unreached sections
+  void stripSections();
+
+  /// isKept - should the collectable pSection of pInput always be kept?
+  bool isKept(const Input& pInput, const LDSection& pSection) const;
+
+  /// addEntrySymbol - add the section defining pSymbol as an entry
+  void addEntrySymbol(const LDSymbol* pSymbol, SectionVecTy& pEntry) const;
+
+  /// addEdge - pFrom refers to pTo
+  void addEdge(const LDSection& pFrom, const LDSection& pTo);
+
+  /// getTargetSection - the section defining the symbol of pReloc
+  static const LDSection* getTargetSection(const Relocation& pReloc);
+
+  /// isDead - is pSymbol defined in a stripped section?
+  static bool isDead(const LDSymbol& pSymbol);
+
+private:
+  const LinkerConfig& m_Config;
+  const TargetLDBackend& m_Backend;
+  Module& m_Module;
+
+  /// m_EdgeIndex - the index of a section's edges in m_Edges
+  SectionIndexMap m_EdgeIndex;
+  std::vector<SectionVecTy> m_Edges;
+
+  /// m_ReferencedSections - the reached sections
+  SectionSetTy m_ReferencedSections;
+};
+
+} // namespace of mcld
+
+#endif
+
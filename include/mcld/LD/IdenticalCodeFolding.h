@@ -0,0 +1,144 @@
+//===- IdenticalCodeFolding.h ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_IDENTICALCODEFOLDING_H
+#define MCLD_LD_IDENTICALCODEFOLDING_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+class LDSymbol;
+class LinkerConfig;
+class Module;
+class Relocation;
+class TargetLDBackend;
+
+/** \class IdenticalCodeFolding
+ *  \brief IdenticalCodeFolding merges the identical function sections
+ *  (--icf=all|safe).
+ *
+ *  Two .text.* input sections are identical if they have the same content
+ *  and their relocations are the same except that they may refer to
+ *  identical sections. The sections are first partitioned by their content
+ *  and the relocations to the other sections, and the partition is refined
+ *  by the classes of the referred sections until it reaches a fixed point.
+ *
+ *  The first section of each class is kept. The others become
+ *  LDFileFormat::Ignore, and the symbols defined in them are redirected to
+ *  the kept one through their FragmentRefs.
+ *
+ *  With --icf=safe, a section is not folded if its address may be taken:
+ *  the Relocator reports such relocations, and exported dynamic symbols are
+ *  always considered address-taken.
+ */
+class IdenticalCodeFolding
+{
+public:
+  IdenticalCodeFolding(const LinkerConfig& pConfig,
+                       TargetLDBackend& pBackend,
+                       Module& pModule);
+
+  ~IdenticalCodeFolding();
+
+  /// foldIdenticalCode - fold the identical sections
+  /// @return the number of folded sections
+  size_t foldIdenticalCode();
+
+private:
+  /** \class Reference
+   *  \brief a relocation of a candidate section
+   */
+  struct Reference
+  {
+    uint64_t offset;        // the offset of the relocation in the section
+    uint32_t type;
+    uint64_t addend;
+    const void* target;     // the section or the ResolveInfo referred to
+    uint64_t target_offset; // the offset in the referred section
+    int candidate;          // the referred candidate, or -1
+
+    bool operator<(const Reference& pOther) const
+    { return offset < pOther.offset; }
+  };
+
+  typedef std::vector<Reference> ReferenceList;
+
+  /** \class Candidate
+   *  \brief a section which may be folded
+   */
+  struct Candidate
+  {
+    LDSection* section;
+    llvm::StringRef content;
+    ReferenceList refs;
+    uint64_t hash;
+  };
+
+  typedef std::vector<Candidate> CandidateList;
+  typedef llvm::DenseMap<const LDSection*, int> CandidateMap;
+  typedef llvm::DenseSet<const LDSection*> SectionSetTy;
+
+  class StaticLess;
+  class ClassLess;
+
+private:
+  /// findAddressTakenSections - --icf=safe only
+  void findAddressTakenSections();
+
+  /// isCandidate - may pSection be folded?
+  bool isCandidate(const LDSection& pSection) const;
+
+  /// findCandidates - collect the candidates and their relocations
+  void findCandidates();
+
+  /// setUpReferences - set up the references of all candidates
+  void setUpReferences();
+
+  /// partition - the initial partition by content and references
+  void partition(std::vector<int>& pOrder, std::vector<int>& pClass) const;
+
+  /// refine - split the classes by the classes of the referred candidates
+  /// @return true if any class is split
+  bool refine(std::vector<int>& pOrder, std::vector<int>& pClass) const;
+
+  /// foldSections - fold the members of each class into its first member
+  size_t foldSections(const std::vector<int>& pOrder,
+                      const std::vector<int>& pClass);
+
+  /// redirect - redirect pSymbol from a folded section to pKept
+  static void redirect(LDSymbol& pSymbol, LDSection& pKept);
+
+  /// getTarget - the section defining the symbol of pReloc, and the offset
+  /// of the symbol in that section.
+  static const LDSection* getTarget(const Relocation& pReloc,
+                                    uint64_t& pOffset);
+
+private:
+  const LinkerConfig& m_Config;
+  TargetLDBackend& m_Backend;
+  Module& m_Module;
+
+  CandidateList m_Candidates;
+  CandidateMap m_CandidateMap;
+  SectionSetTy m_AddressTaken;
+};
+
+} // namespace of mcld
+
+#endif
+
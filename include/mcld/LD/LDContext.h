@@ -63,6 +63,9 @@ public:
   { return m_SectionTable.size(); }
 
   // -----  symbols  ----- //
+  size_t numOfSymbols() const
+  { return m_SymTab.size(); }
+
   const LDSymbol* getSymbol(unsigned int pIdx) const;
   LDSymbol*       getSymbol(unsigned int pIdx);
 
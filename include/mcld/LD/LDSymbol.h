@@ -29,6 +29,7 @@ template<class T> void* object_creator();
 namespace mcld {
 
 class FragmentRef;
+class LDSection;
 
 /** \class LDSymbol
  *  \brief LDSymbol provides a consistent abstraction for different formats
@@ -148,6 +149,10 @@ private:
 
 };
 
+/// getSymbolSection - the section where pSymbol is defined. Return NULL if
+/// pSymbol is the null symbol or its fragment is not in any section.
+const LDSection* getSymbolSection(const LDSymbol& pSymbol);
+
 } // namespace mcld
 
 #endif
@@ -0,0 +1,136 @@
+//===- MergeString.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_MERGESTRING_H
+#define MCLD_LD_MERGESTRING_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld {
+
+class LDSection;
+
+/** \class MergeString
+ *  \brief MergeString is the merged content of the SHF_MERGE|SHF_STRINGS
+ *  input sections which go to the same output section with the same entry
+ *  size and alignment.
+ *
+ *  Each input section is split into null-terminated pieces. A piece is kept
+ *  at its first occurrence in input order, and the later copies are mapped
+ *  onto it.
+ *
+ *  The pieces are deduplicated in NumOfShards shards by their hash values.
+ *  Each shard is an open-addressing table of its own, so shards can be
+ *  deduplicated in parallel without locks, and the result does not depend on
+ *  the number of threads.
+ *
+ *  Usage:
+ *    1. addSection() for each input section in input order.
+ *    2. split() for each section and then dedup() for each shard. Calls of
+ *       the same step can run in parallel.
+ *    3. layout() builds the merged content.
+ */
+class MergeString
+{
+public:
+  enum { NumOfShards = 32 };
+
+public:
+  MergeString(uint32_t pEntSize, uint32_t pAlign);
+
+  ~MergeString();
+
+  /// addSection - add an input section whose content is pContent. The
+  /// content must be a sequence of null-terminated strings.
+  void addSection(LDSection& pSection, llvm::StringRef pContent);
+
+  /// split - split the pIdx-th section into pieces
+  void split(size_t pIdx);
+
+  /// dedup - find the first occurrence of the pieces in pShard
+  void dedup(unsigned int pShard);
+
+  /// layout - assign output offsets to the kept pieces and build the merged
+  /// content
+  void layout();
+
+  /// getOutputOffset - the offset in the merged content of the byte at
+  /// pOffset in the input section pSection.
+  uint64_t getOutputOffset(const LDSection& pSection, uint64_t pOffset) const;
+
+  size_t numOfSections() const { return m_Sections.size(); }
+
+  LDSection& getSection(size_t pIdx)
+  { return *m_Sections[pIdx].section; }
+
+  const LDSection& getSection(size_t pIdx) const
+  { return *m_Sections[pIdx].section; }
+
+  uint32_t entSize() const { return m_EntSize; }
+
+  uint32_t align() const { return m_Align; }
+
+  /// data - the merged content. Valid after layout().
+  uint8_t* data() { return m_pData; }
+
+  /// size - the size of the merged content. Valid after layout().
+  uint64_t size() const { return m_Size; }
+
+  /// inputSize - the total size of all input sections
+  uint64_t inputSize() const;
+
+private:
+  struct Piece
+  {
+    uint64_t input_offset;
+    uint64_t output_offset;
+    uint32_t size;
+    uint32_t hash;
+    uint32_t owner_sect;   // the first occurrence of this piece
+    uint32_t owner_piece;
+  };
+
+  typedef std::vector<Piece> PieceList;
+
+  struct Section
+  {
+    LDSection* section;
+    llvm::StringRef content;
+    PieceList pieces;
+  };
+
+  typedef std::vector<Section> SectionList;
+  typedef llvm::DenseMap<const LDSection*, size_t> SectionMap;
+
+private:
+  llvm::StringRef getPiece(uint32_t pSect, uint32_t pPiece) const;
+
+  static unsigned int getShard(uint32_t pHash)
+  { return pHash >> 27; }
+
+private:
+  uint32_t m_EntSize;
+  uint32_t m_Align;
+
+  SectionList m_Sections;
+  SectionMap m_SectionMap;
+
+  uint8_t* m_pData;
+  uint64_t m_Size;
+};
+
+} // namespace of mcld
+
+#endif
+
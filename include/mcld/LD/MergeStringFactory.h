@@ -0,0 +1,119 @@
+//===- MergeStringFactory.h -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_MERGESTRINGFACTORY_H
+#define MCLD_LD_MERGESTRINGFACTORY_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+class Fragment;
+class Input;
+class LDSection;
+class LDSymbol;
+class LinkerConfig;
+class MergeString;
+class Module;
+
+/** \class MergeStringFactory
+ *  \brief MergeStringFactory merges the strings of the SHF_MERGE|SHF_STRINGS
+ *  input sections, such as .rodata.str1.1 and .debug_str.
+ *
+ *  The input sections going to the same output section with the same flags,
+ *  entry size and alignment share a MergeString. After deduplication, the
+ *  merged content replaces the first input section of each MergeString, and
+ *  the other input sections become LDFileFormat::Ignore.
+ *
+ *  The symbols defined in the merged sections are moved to the merged
+ *  content, and the addends of the relocations against their section
+ *  symbols are mapped to the merged offsets. Since the addends of REL
+ *  relocations live in the place being relocated, a section referred to by
+ *  a REL relocation through its section symbol is not merged. Neither is a
+ *  section which has relocations of its own.
+ *
+ *  MergeStringFactory owns the merged content, so it must live until the
+ *  output is emitted.
+ */
+class MergeStringFactory
+{
+public:
+  MergeStringFactory(const LinkerConfig& pConfig, Module& pModule);
+
+  ~MergeStringFactory();
+
+  /// mergeStrings - merge all mergeable string sections
+  /// @return the number of bytes saved
+  uint64_t mergeStrings();
+
+private:
+  /** \class Domain
+   *  \brief the input sections sharing a MergeString
+   */
+  struct Domain
+  {
+    std::string name;
+    uint32_t flag;
+    uint32_t entsize;
+    uint32_t align;
+
+    bool operator<(const Domain& pOther) const;
+  };
+
+  typedef std::map<Domain, MergeString*> DomainMap;
+  typedef llvm::DenseMap<const LDSection*, MergeString*> MergeStringMap;
+  typedef llvm::DenseSet<const LDSection*> SectionSetTy;
+
+private:
+  /// findExcludedSections - the sections which can not be merged
+  void findExcludedSections(SectionSetTy& pExcluded) const;
+
+  /// getContent - get the content of pSection if it can be merged
+  bool getContent(const LDSection& pSection, llvm::StringRef& pContent) const;
+
+  /// collectSections - put the mergeable sections into MergeStrings
+  void collectSections(const SectionSetTy& pExcluded);
+
+  /// merge - deduplicate all MergeStrings in parallel
+  void merge();
+
+  /// rewriteRelocations - map the addends of the relocations against the
+  /// section symbols of the merged sections
+  void rewriteRelocations();
+
+  /// rewriteSymbols - move the symbols to the merged content
+  void rewriteSymbols();
+
+  /// replaceSections - replace the merged sections by the merged content
+  void replaceSections();
+
+private:
+  const LinkerConfig& m_Config;
+  Module& m_Module;
+
+  std::vector<MergeString*> m_MergeStrings;
+  DomainMap m_Domains;
+  MergeStringMap m_SectionMap;
+
+  /// m_Fragments - the fragment of the merged content of each MergeString
+  llvm::DenseMap<const MergeString*, Fragment*> m_Fragments;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -21,6 +21,7 @@
 #include <mcld/Support/GCFactory.h>
 
 #include <utility>
+#include <vector>
 
 #include <llvm/ADT/StringRef.h>
 
@@ -38,8 +39,34 @@ class SectionData;
 class NamePool : private Uncopyable
 {
 public:
-  typedef HashTable<ResolveInfo, hash::StringHash<hash::DJB> > Table;
+  /** \class InfoFactory
+   *  \brief InfoFactory creates the ResolveInfos of the pool and counts them.
+   */
+  class InfoFactory : public HashEntryFactory<ResolveInfo>
+  {
+  public:
+    InfoFactory() : m_NumOfProduced(0) { }
+
+    entry_type* produce(const key_type& pKey)
+    {
+      ++m_NumOfProduced;
+      return ResolveInfo::Create(pKey);
+    }
+
+    size_t numOfProduced() const { return m_NumOfProduced; }
+
+  private:
+    size_t m_NumOfProduced;
+  };
+
+  typedef HashTable<ResolveInfo,
+                    hash::StringHash<hash::DJB>,
+                    InfoFactory> Table;
   typedef size_t size_type;
+  typedef std::vector<ResolveInfo*> UndefList;
+  typedef std::vector<ResolveInfo*> DynRefList;
+  typedef Table::iterator syminfo_iterator;
+  typedef Table::const_iterator const_syminfo_iterator;
 
 public:
   explicit NamePool(size_type pSize = 3);
@@ -74,6 +101,28 @@ public:
                     ResolveInfo* pOldInfo,
                     Resolver::Result& pResult);
 
+  /// insertSymbol - insertSymbol with the hash value of pName computed by the
+  /// caller. pHash must be equal to Hash(pName).
+  void insertSymbol(const llvm::StringRef& pName,
+                    uint32_t pHash,
+                    bool pIsDyn,
+                    ResolveInfo::Type pType,
+                    ResolveInfo::Desc pDesc,
+                    ResolveInfo::Binding pBinding,
+                    ResolveInfo::SizeType pSize,
+                    LDSymbol::ValueType pValue,
+                    ResolveInfo::Visibility pVisibility,
+                    ResolveInfo* pOldInfo,
+                    Resolver::Result& pResult);
+
+  /// Hash - the hash value of pName in the pool
+  static uint32_t Hash(const llvm::StringRef& pName)
+  { return Table::hasher()(pName); }
+
+  /// Scan - get the null-terminated name pStr and its hash value in one pass
+  /// over the string.
+  static llvm::StringRef Scan(const char* pStr, uint32_t& pHash);
+
   /// findSymbol - find the resolved output LDSymbol
   const LDSymbol* findSymbol(const llvm::StringRef& pName) const;
   LDSymbol*       findSymbol(const llvm::StringRef& pName);
@@ -88,12 +137,35 @@ public:
   llvm::StringRef insertString(const llvm::StringRef& pString);
 
   // -----  observers  ----- //
+  /// undefs - the non-weak undefined symbols in the order they were
+  /// introduced. The list only grows, so archive readers can consume it as a
+  /// worklist by remembering how far they have searched.
+  const UndefList& undefs() const
+  { return m_Undefs; }
+
+  /// dynRefs - the symbols which also appear in dynamic objects. A regular
+  /// definition of such a symbol may be used by the dynamic objects at run
+  /// time. A symbol may appear more than once.
+  const DynRefList& dynRefs() const
+  { return m_DynRefs; }
+
   size_type size() const
   { return m_Table.numOfEntries(); }
 
   bool empty() const
   { return m_Table.empty(); }
 
+  /// numOfProducedInfos - the number of ResolveInfos the pool has created
+  size_type numOfProducedInfos() const
+  { return m_Table.getEntryFactory().numOfProduced(); }
+
+  // -----  iterators  ----- //
+  syminfo_iterator syminfo_begin() { return m_Table.begin(); }
+  syminfo_iterator syminfo_end()   { return m_Table.end(); }
+
+  const_syminfo_iterator syminfo_begin() const { return m_Table.begin(); }
+  const_syminfo_iterator syminfo_end()   const { return m_Table.end(); }
+
   // -----  capacity  ----- //
   void reserve(size_type pN);
 
@@ -106,6 +178,8 @@ private:
   Resolver* m_pResolver;
   Table m_Table;
   FreeInfoSet m_FreeInfoSet;
+  UndefList m_Undefs;
+  DynRefList m_DynRefs;
 };
 
 } // namespace of mcld
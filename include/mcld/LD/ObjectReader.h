@@ -44,6 +44,14 @@ public:
 
   virtual bool readSections(Input& pFile) = 0;
 
+  /// readRegularSections - read the sections whose contents do not depend on
+  /// the other inputs.
+  ///
+  /// Linkers may call this function for different inputs concurrently, after
+  /// readHeader and before readSections. readSections then reads only the
+  /// sections left.
+  virtual bool readRegularSections(Input& pFile) { return true; }
+
   /// readRelocations - read relocation sections
   ///
   /// This function should be called after symbol resolution.
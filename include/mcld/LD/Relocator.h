@@ -96,6 +96,24 @@ public:
                                      Module& pModule,
                                      const LDSection& pSection);
 
+  /// mayHaveFunctionPointerAccess - may pReloc take the address of its
+  /// target? --icf=safe does not fold a function whose address is taken.
+  /// Targets return false for their call and branch relocations. The default
+  /// is conservative.
+  virtual bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const
+  { return true; }
+
+  /// mayApplyConcurrently - can pReloc be applied concurrently with the
+  /// relocations of other inputs? It can if applying it only writes its own
+  /// target data, that is, it creates no GOT, PLT or dynamic relocation
+  /// entries and uses no per-input state of the relocator. The default is
+  /// conservative.
+  virtual bool mayApplyConcurrently(const Relocation& pReloc) const
+  { return false; }
+
+  /// reportResult - report the error if applying pReloc did not succeed
+  void reportResult(const Relocation& pReloc, Result pResult) const;
+
   // ------ observers -----//
   virtual TargetLDBackend& getTarget() = 0;
 
@@ -18,9 +18,11 @@
 namespace mcld {
 
 class LDSymbol;
+class ResolveInfo;
 
-/** \class ResolveInfo
- *  \brief ResolveInfo records the information about how to resolve a symbol.
+/** \class SymbolDescriptor
+ *  \brief SymbolDescriptor records the attributes of a symbol without its
+ *  name.
  *
  *  A symbol must have some `attributes':
  *  - Desc - Defined, Reference, Common or Indirect
@@ -32,12 +34,12 @@ class LDSymbol;
  *  In order to save the memory and speed up the performance, FragmentLinker uses
  *  a bit field to store all attributes.
  *
- *  The maximum string length is (2^16 - 1)
+ *  Symbol resolution reads only the attributes of the new symbol, so a
+ *  SymbolDescriptor can live on the stack while it is resolved against an
+ *  existing ResolveInfo.
  */
-class ResolveInfo
+class SymbolDescriptor
 {
-friend class FragmentLinker;
-friend class IRBuilder;
 public:
   typedef uint64_t SizeType;
 
@@ -89,16 +91,8 @@ public:
     Protected    = 3
   };
 
-  // -----  For HashTable  ----- //
-  typedef llvm::StringRef key_type;
-
 public:
-  // -----  factory method  ----- //
-  static ResolveInfo* Create(const key_type& pKey);
-
-  static void Destroy(ResolveInfo*& pInfo);
-
-  static ResolveInfo* Null();
+  SymbolDescriptor();
 
   // -----  modifiers  ----- //
   /// setRegular - set the source of the file is a regular object
@@ -128,11 +122,11 @@ public:
   void setSize(SizeType pSize)
   { m_Size = pSize; }
 
-  void override(const ResolveInfo& pForm);
+  void override(const SymbolDescriptor& pFrom);
 
-  void overrideAttributes(const ResolveInfo& pFrom);
+  void overrideAttributes(const SymbolDescriptor& pFrom);
 
-  void overrideVisibility(const ResolveInfo& pFrom);
+  void overrideVisibility(const SymbolDescriptor& pFrom);
 
   void setSymPtr(const LDSymbol* pSymPtr)
   { m_Ptr.sym_ptr = const_cast<LDSymbol*>(pSymPtr); }
@@ -143,8 +137,6 @@ public:
   }
 
   // -----  observers  ----- //
-  bool isNull() const;
-
   bool isSymbol() const;
 
   bool isString() const;
@@ -195,22 +187,13 @@ public:
   SizeType size() const
   { return m_Size; }
 
-  const char* name() const
-  { return m_Name; }
-
-  unsigned int nameSize() const
-  { return (m_BitField >> NAME_LENGTH_OFFSET); }
-
   uint32_t info() const
   { return (m_BitField & INFO_MASK); }
 
   uint32_t bitfield() const
   { return m_BitField; }
 
-  // -----  For HashTable  ----- //
-  bool compare(const key_type& pKey);
-
-private:
+protected:
   static const uint32_t GLOBAL_OFFSET      = 0;
   static const uint32_t GLOBAL_MASK        = 1;
 
@@ -263,13 +246,7 @@ public:
   static const uint32_t string_flag    = 0        << SYMBOL_OFFSET;
   static const uint32_t symbol_flag    = 1        << SYMBOL_OFFSET;
 
-private:
-  ResolveInfo();
-  ResolveInfo(const ResolveInfo& pCopy);
-  ResolveInfo& operator=(const ResolveInfo& pCopy);
-  ~ResolveInfo();
-
-private:
+protected:
   SizeType m_Size;
   SymOrInfo m_Ptr;
 
@@ -278,6 +255,51 @@ private:
    * |length of m_Name|reserved|Symbol|Type |ELF visibility|Local|Com|Def|Dyn|Weak|
    */
   uint32_t m_BitField;
+};
+
+/** \class ResolveInfo
+ *  \brief ResolveInfo records the information about how to resolve a symbol.
+ *
+ *  ResolveInfo is the entry of NamePool. It is a SymbolDescriptor followed by
+ *  the name of the symbol.
+ *
+ *  The maximum string length is (2^16 - 1)
+ */
+class ResolveInfo : public SymbolDescriptor
+{
+friend class FragmentLinker;
+friend class IRBuilder;
+public:
+  // -----  For HashTable  ----- //
+  typedef llvm::StringRef key_type;
+
+public:
+  // -----  factory method  ----- //
+  static ResolveInfo* Create(const key_type& pKey);
+
+  static void Destroy(ResolveInfo*& pInfo);
+
+  static ResolveInfo* Null();
+
+  // -----  observers  ----- //
+  bool isNull() const;
+
+  const char* name() const
+  { return m_Name; }
+
+  unsigned int nameSize() const
+  { return (m_BitField >> NAME_LENGTH_OFFSET); }
+
+  // -----  For HashTable  ----- //
+  bool compare(const key_type& pKey);
+
+private:
+  ResolveInfo();
+  ResolveInfo(const ResolveInfo& pCopy);
+  ResolveInfo& operator=(const ResolveInfo& pCopy);
+  ~ResolveInfo();
+
+private:
   char m_Name[];
 };
 
@@ -19,6 +19,7 @@ namespace mcld
 {
 
 class ResolveInfo;
+class SymbolDescriptor;
 class NamePool;
 
 /** \class Resolver
@@ -57,9 +58,10 @@ public:
   /// shouldOverride - Can resolver override the symbol pOld by the symbol pNew?
   /// @return the action should be taken.
   /// @param pOld the symbol which may be overridden.
-  /// @param pNew the symbol which is used to replace pOld
+  /// @param pNew the symbol which is used to replace pOld. It has the same
+  ///        name as pOld.
   virtual bool resolve(ResolveInfo & __restrict__ pOld,
-                       const ResolveInfo & __restrict__ pNew,
+                       const SymbolDescriptor & __restrict__ pNew,
                        bool &pOverride, LDSymbol::ValueType pValue) const = 0;
 
   /// resolveAgain - Can override by derived classes.
@@ -68,7 +70,7 @@ public:
   virtual void resolveAgain(NamePool& pNamePool,
                               unsigned int pAction,
                               ResolveInfo& __restrict__ pOld,
-                              const ResolveInfo& __restrict__ pNew,
+                              const SymbolDescriptor& __restrict__ pNew,
                               Result& pResult) const {
     pResult.info = NULL;
     pResult.existent = false;
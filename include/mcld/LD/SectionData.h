@@ -12,6 +12,7 @@
 #include <gtest.h>
 #endif
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/ilist.h>
 #include <llvm/ADT/ilist_node.h>
 #include <llvm/Support/DataTypes.h>
@@ -20,10 +21,38 @@
 #include <mcld/Support/Allocators.h>
 #include <mcld/Fragment/Fragment.h>
 
+#include <vector>
+
 namespace mcld {
 
 class LDSection;
 
+/** \class FragmentListTraits
+ *  \brief FragmentListTraits counts the changes of a fragment list, so that
+ *  SectionData knows when its offset index is out of date.
+ */
+class FragmentListTraits : public llvm::ilist_default_traits<Fragment>
+{
+public:
+  FragmentListTraits() : m_Version(0) { }
+
+  void addNodeToList(Fragment* pFrag) { ++m_Version; }
+
+  void removeNodeFromList(Fragment* pFrag) { ++m_Version; }
+
+  void transferNodesFromList(FragmentListTraits& pSrc,
+                             llvm::ilist_iterator<Fragment> pFirst,
+                             llvm::ilist_iterator<Fragment> pLast) {
+    ++m_Version;
+    ++pSrc.m_Version;
+  }
+
+  unsigned int version() const { return m_Version; }
+
+private:
+  unsigned int m_Version;
+};
+
 /** \class SectionData
  *  \brief SectionData provides a container for all Fragments.
  */
@@ -39,7 +68,7 @@ private:
   SectionData& operator=(const SectionData &); // DO NOT IMPLEMENT
 
 public:
-  typedef llvm::iplist<Fragment> FragmentListType;
+  typedef llvm::iplist<Fragment, FragmentListTraits> FragmentListType;
 
   typedef FragmentListType::reference reference;
   typedef FragmentListType::const_reference const_reference;
@@ -81,10 +110,39 @@ public:
   const_reverse_iterator rend  () const { return m_Fragments.rend();   }
   reverse_iterator       rend  ()       { return m_Fragments.rend();   }
 
+  // -----  offset index  ----- //
+  /// locate - find the fragment which is pOffset bytes after the beginning of
+  /// pFrag by binary search. As FragmentRef::Create does, a fragment ending
+  /// exactly at the offset is preferred to the fragment starting there.
+  ///
+  /// The index is built on demand, and rebuilt after fragments are inserted
+  /// or removed, or any fragment's offset is changed.
+  ///
+  /// @param pFrag   [in] the fragment to start with
+  /// @param pOffset [in, out] the offset from the beginning of pFrag. If the
+  ///                fragment is found, the offset within that fragment.
+  /// @return NULL if pFrag is not in the index or pOffset is out of range.
+  Fragment* locate(const Fragment& pFrag, uint64_t& pOffset);
+
+  void invalidateOffsetIndex() { m_bIndexValid = false; }
+
+private:
+  void buildOffsetIndex();
+
+private:
+  typedef llvm::DenseMap<const Fragment*, size_t> FragPositionMap;
+
 private:
   FragmentListType m_Fragments;
   LDSection* m_pSection;
 
+  // the end offset of each fragment from the beginning of the section data
+  std::vector<uint64_t> m_FragEnds;
+  std::vector<Fragment*> m_IndexedFrags;
+  FragPositionMap m_FragPositions;
+  unsigned int m_IndexVersion;
+  bool m_bIndexValid;
+
 };
 
 } // namespace of mcld
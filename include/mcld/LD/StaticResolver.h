@@ -110,11 +110,11 @@ public:
   /// @param pOld the symbol which may be overridden.
   /// @param pNew the symbol which is used to replace pOld
   virtual bool resolve(ResolveInfo & __restrict__ pOld,
-                       const ResolveInfo & __restrict__ pNew,
+                       const SymbolDescriptor & __restrict__ pNew,
                        bool &pOverride, LDSymbol::ValueType pValue) const;
 
 private:
-  inline unsigned int getOrdinate(const ResolveInfo& pInfo) const {
+  inline unsigned int getOrdinate(const SymbolDescriptor& pInfo) const {
     if (pInfo.isAbsolute() && pInfo.isDyn())
       return d_D_ORD;
     if (pInfo.isAbsolute())
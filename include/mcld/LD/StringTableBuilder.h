@@ -0,0 +1,83 @@
+//===- StringTableBuilder.h -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_STRINGTABLEBUILDER_H
+#define MCLD_LD_STRINGTABLEBUILDER_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+namespace mcld {
+
+/** \class StringTableBuilder
+ *  \brief StringTableBuilder builds an ELF string table, such as .strtab,
+ *  .dynstr and .shstrtab.
+ *
+ *  Each string is kept once. finalize() sorts the strings by their reversed
+ *  contents, so a string which is a suffix of another one comes right after
+ *  it and shares its tail. For example, "bar" is placed inside "foobar".
+ *
+ *  The offset 0 always holds the empty string. The layout only depends on
+ *  the set of strings, not on the order they are added.
+ *
+ *  Usage:
+ *    1. add() all strings.
+ *    2. finalize() lays out the table.
+ *    3. getOffset() and emit().
+ *
+ *  A string added after finalize() is appended to the end of the table, so
+ *  the offsets given out before stay unchanged.
+ */
+class StringTableBuilder
+{
+public:
+  StringTableBuilder();
+
+  ~StringTableBuilder();
+
+  /// add - add pString into the table
+  void add(llvm::StringRef pString);
+
+  /// finalize - lay out the strings and compute the offsets
+  void finalize();
+
+  bool isFinalized() const { return m_bFinalized; }
+
+  /// getOffset - the offset of pString in the table. pString must have been
+  /// added, and the table must be finalized.
+  uint64_t getOffset(llvm::StringRef pString) const;
+
+  /// size - the size of the table in bytes. Valid after finalize().
+  uint64_t size() const { return m_Size; }
+
+  /// numOfStrings - the number of distinct non-empty strings
+  size_t numOfStrings() const { return m_Offsets.size(); }
+
+  /// emit - write out the table. pBuffer must hold size() bytes.
+  void emit(char* pBuffer) const;
+
+  /// clear - remove all strings
+  void clear();
+
+private:
+  typedef llvm::StringMap<uint64_t> OffsetMap;
+
+private:
+  OffsetMap m_Offsets;
+  uint64_t m_Size;
+  bool m_bFinalized;
+};
+
+} // namespace of mcld
+
+#endif
+
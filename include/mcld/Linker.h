@@ -19,6 +19,7 @@ namespace mcld {
 class Module;
 class LinkerConfig;
 class LinkerScript;
+class LinkContext;
 
 class Target;
 class TargetLDBackend;
@@ -31,12 +32,19 @@ class MemoryArea;
 
 /** \class Linker
 *  \brief Linker is a modular linker.
+*
+*  All stages run in the LinkContext given to the constructor. Give the same
+*  LinkContext to the IRBuilder. Links in different LinkContexts can run on
+*  different threads at the same time.
 */
 class Linker
 {
 public:
+  /// Linker - the stages run in the current LinkContext of the caller.
   Linker();
 
+  explicit Linker(LinkContext& pContext);
+
   ~Linker();
 
   /// emulate - To set up target-dependent options and default linker script.
@@ -75,7 +83,10 @@ private:
 
   bool initEmulator(LinkerScript& pScript);
 
+  LinkContext& context();
+
 private:
+  LinkContext* m_pContext;
   LinkerConfig* m_pConfig;
   IRBuilder* m_pIRBuilder;
 
@@ -15,6 +15,7 @@
 #include "mcld/Support/FileSystem.h"
 #include <llvm/ADT/StringRef.h>
 #include <string>
+#include <vector>
 
 namespace mcld
 {
@@ -22,6 +23,8 @@ namespace mcld
 /** \class MCLDDirectory
  *  \brief MCLDDirectory is an directory entry for library search.
  *
+ *  The first find() reads the whole directory once and indexes the entries
+ *  by their file names, so the later look-ups need not walk the directory.
  */
 class MCLDDirectory : public sys::fs::Directory
 {
@@ -42,9 +45,34 @@ public:
   const std::string& name() const
   { return m_Name; }
 
+  // -----  index  ----- //
+  /// find - return the path of the entry whose file name is pFileName, or
+  /// NULL if there is no such entry. Build the index if it is not built yet.
+  sys::fs::Path* find(llvm::StringRef pFileName);
+
+  bool isIndexed() const { return m_bIndexed; }
+
+  /// buildIndex - read the directory and index all entries.
+  void buildIndex();
+
+  /// buildIndex - index the given file names instead of reading the
+  /// directory. The caller guarantees that pFileNames is the listing of the
+  /// directory, e.g., a listing cached by the previous link.
+  void buildIndex(const std::vector<std::string>& pFileNames);
+
+private:
+  void addIndex(llvm::StringRef pFileName);
+
+  void clearIndex();
+
 private:
   std::string m_Name;
   bool m_bInSysroot;
+
+  // file name to the path of the entry. The keys refer to the file name
+  // part of the paths.
+  sys::fs::PathCache m_Index;
+  bool m_bIndexed;
 };
 
 } // namespace of mcld
@@ -15,8 +15,10 @@
 #include <mcld/MC/Input.h>
 #include <mcld/Support/Path.h>
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 
+#include <ctime>
 #include <vector>
 #include <string>
 
@@ -32,6 +34,11 @@ class MCLDDirectory;
  *  SearchDirs is customized for linking. It handles -L on the command line
  *  and SEARCH_DIR macro in the link script.
  *
+ *  Each directory is read once and indexed by file names, so find() costs
+ *  one look-up per directory. If an index cache file is set, the listings of
+ *  the directories are also kept in that file, and the later links reuse a
+ *  listing as long as the directory is not modified.
+ *
  *  @see MCLDDirectory.
  */
 class SearchDirs : private Uncopyable
@@ -55,6 +62,11 @@ public:
   const sys::fs::Path*
   find(const std::string& pNamespec, mcld::Input::Type pPreferType) const;
 
+  /// setIndexCache - load the directory listings from pCacheFile and write
+  /// the listings back when SearchDirs is destroyed.
+  /// @return false if pCacheFile exists but can not be read.
+  bool setIndexCache(const sys::fs::Path& pCacheFile);
+
   void setSysRoot(const sys::fs::Path& pSysRoot) { m_SysRoot = pSysRoot; }
   const sys::fs::Path& sysroot() const { return m_SysRoot; }
 
@@ -71,9 +83,34 @@ public:
 
   bool insert(const sys::fs::Path& pDirectory);
 
+private:
+  struct Listing
+  {
+    std::time_t time;
+    std::vector<std::string> names;
+  };
+
+  typedef llvm::StringMap<Listing> ListingMap;
+
+private:
+  sys::fs::Path* lookup(const std::string& pNamespec,
+                        mcld::Input::Type pType) const;
+
+  /// index - build the index of pDir, from the cached listing if possible.
+  void index(MCLDDirectory& pDir) const;
+
+  bool loadIndexCache();
+
+  void saveIndexCache() const;
+
 private:
   DirList m_DirList;
   sys::fs::Path m_SysRoot;
+
+  // the directory listings cached across links
+  sys::fs::Path m_IndexCache;
+  mutable ListingMap m_Listings;
+  mutable bool m_bListingsChanged;
 };
 
 } // namespace of mcld
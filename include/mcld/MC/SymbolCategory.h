@@ -11,6 +11,7 @@
 #ifdef ENABLE_UNITTEST
 #include <gtest.h>
 #endif
+#include <llvm/ADT/DenseMap.h>
 #include <cstddef>
 #include <vector>
 
@@ -21,11 +22,15 @@ class LDSymbol;
 class ResolveInfo;
 /** \class SymbolCategory
  *  \brief SymbolCategory groups output LDSymbol into different categories.
+ *
+ *  SymbolCategory remembers the position of every symbol, so moving a symbol
+ *  between categories does not scan the source category.
  */
 class SymbolCategory
 {
 private:
   typedef std::vector<LDSymbol*> OutputSymbols;
+  typedef llvm::DenseMap<const LDSymbol*, size_t> PositionMap;
 
 public:
   typedef OutputSymbols::iterator iterator;
@@ -178,8 +183,16 @@ private:
                           Category::Type pSource,
                           Category::Type pTarget);
 
+  /// swap - exchange the symbols at pX and pY and update their positions.
+  void swap(size_t pX, size_t pY);
+
+  /// position - the position of pSymbol in pCategory, or pCategory.end if
+  /// pSymbol is not in it.
+  size_t position(const LDSymbol& pSymbol, const Category& pCategory);
+
 private:
   OutputSymbols m_OutputSymbols;
+  PositionMap m_Positions;
 
   Category* m_pFile;
   Category* m_pLocal;
@@ -42,6 +42,8 @@ public:
     Lazy,
     Now,
     Origin,
+    PackRelativeRelocs,
+    NoPackRelativeRelocs,
     CommPageSize,
     MaxPageSize,
     Unknown
@@ -12,10 +12,12 @@
 #include <gtest.h>
 #endif
 #include <llvm/Support/DataTypes.h>
+#include <llvm/ADT/DenseSet.h>
 
 namespace mcld {
 
 class Module;
+class Input;
 class LinkerConfig;
 class IRBuilder;
 class TargetLDBackend;
@@ -32,6 +34,7 @@ class DynObjWriter;
 class ExecWriter;
 class BinaryWriter;
 class Relocation;
+class MergeStringFactory;
 
 /** \class ObjectLinker
  */
@@ -60,6 +63,13 @@ public:
   /// readRelocations - read all relocation entries
   bool readRelocations();
 
+  /// dataStrippingOpt - remove the unused data (--gc-sections) and fold the
+  /// identical code (--icf)
+  void dataStrippingOpt();
+
+  /// mergeStrings - merge the strings of SHF_MERGE|SHF_STRINGS sections
+  void mergeStrings();
+
   /// mergeSections - put allinput sections into output sections
   bool mergeSections();
 
@@ -141,6 +151,14 @@ public:
   ObjectWriter*        getWriter ()       { return m_pWriter;  }
 
 private:
+  /// readObjectsInParallel - read the section headers and the regular
+  /// sections of the top-level relocatable objects on a thread pool.
+  /// Symbols and order-dependent sections (groups, link-once, .eh_frame) are
+  /// read later in command-line order, so the output does not depend on
+  /// thread scheduling.
+  ///   @param pParsed [out] the inputs read
+  void readObjectsInParallel(llvm::DenseSet<Input*>& pParsed);
+
   /// normalSyncRelocationResult - sync relocation result when producing shared
   /// objects or executables
   void normalSyncRelocationResult(MemoryArea& pOutput);
@@ -149,10 +167,6 @@ private:
   /// link
   void partialSyncRelocationResult(MemoryArea& pOutput);
 
-  /// writeRelocationResult - helper function of syncRelocationResult, write
-  /// relocation target data to output
-  void writeRelocationResult(Relocation& pReloc, uint8_t* pOutput);
-
 private:
   const LinkerConfig& m_Config;
   Module* m_pModule;
@@ -168,6 +182,9 @@ private:
   BinaryReader*  m_pBinaryReader;
   ScriptReader*  m_pScriptReader;
   ObjectWriter*  m_pWriter;
+
+  // -----  merged data  ----- //
+  MergeStringFactory* m_pMergeStringFactory;
 };
 
 } // end namespace mcld
@@ -15,7 +15,9 @@
 #include <mcld/Script/OutputSectDesc.h>
 #include <mcld/Script/InputSectDesc.h>
 #include <mcld/Script/Assignment.h>
+#include <mcld/Object/SectionMatcher.h>
 #include <llvm/Support/DataTypes.h>
+#include <llvm/Support/Mutex.h>
 #include <vector>
 #include <string>
 
@@ -26,6 +28,10 @@ class LDSection;
 
 /** \class SectionMap
  *  \brief descirbe how to map input sections into output sections
+ *
+ *  The input section descriptions are compiled into a SectionMatcher on the
+ *  first find() after they change. find() is safe to call from multiple
+ *  threads.
  */
 class SectionMap
 {
@@ -149,6 +155,8 @@ public:
   typedef OutputDescList::reverse_iterator reverse_iterator;
 
 public:
+  SectionMap();
+
   ~SectionMap();
 
   const_mapping find(const std::string& pInputFile,
@@ -184,13 +192,27 @@ public:
 
   iterator insert(iterator pPosition, LDSection* pSection);
 
+  /// invalidate - recompile the descriptions at the next find(). Call this
+  /// after reordering the output descriptions through the iterators.
+  void invalidate();
+
+private:
+  /// match - the index of the first description in m_Mappings which matches
+  /// pInputSection of pInputFile
+  unsigned int match(const std::string& pInputFile,
+                     const std::string& pInputSection) const;
+
 private:
-  bool matched(const Input& pInput,
-               const std::string& pInputFile,
-               const std::string& pInputSection) const;
+  typedef std::vector<mapping> MappingList;
 
 private:
   OutputDescList m_OutputDescList;
+
+  /// the compiled input section descriptions in the order of priority
+  mutable SectionMatcher m_Matcher;
+  mutable MappingList m_Mappings;
+  mutable bool m_bCompiled;
+  mutable llvm::sys::SmartMutex<true> m_CompileLock;
 };
 
 } // namespace of mcld
@@ -0,0 +1,140 @@
+//===- SectionMatcher.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SECTION_MATCHER_H
+#define MCLD_SECTION_MATCHER_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/Script/InputSectDesc.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Mutex.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+/** \class SectionMatcher
+ *  \brief SectionMatcher finds the first input section description that an
+ *  input section matches.
+ *
+ *  The section patterns of the rules are compiled once. A pattern without
+ *  wildcards goes to a hash table, and the others go to a trie by their
+ *  literal prefix, so a section name only meets the patterns whose prefix it
+ *  starts with. A pattern such as ".text.*" is decided by the trie alone.
+ *  The rest of the patterns and the file patterns are checked by fnmatch.
+ *
+ *  The results are memoized per (input file, input section) pair. match()
+ *  can be called from multiple threads, but addRule() and clear() can not.
+ */
+class SectionMatcher
+{
+public:
+  static const unsigned int NoMatch = ~0U;
+
+public:
+  SectionMatcher();
+
+  ~SectionMatcher();
+
+  /// addRule - append a rule. The rules added earlier take priority.
+  /// @return the index of the rule
+  unsigned int addRule(const InputSectDesc::Spec& pSpec);
+
+  /// clear - remove all rules and the memoized results
+  void clear();
+
+  size_t size() const { return m_Rules.size(); }
+
+  /// match - the index of the first rule which pInputSection of pInputFile
+  /// matches. Return NoMatch if there is none.
+  unsigned int match(const std::string& pInputFile,
+                     const std::string& pInputSection) const;
+
+private:
+  /// Glob - a compiled wildcard pattern
+  class Glob
+  {
+  public:
+    enum Kind {
+      Literal,    // no wildcard
+      PrefixAny,  // a literal prefix followed by a single '*'
+      General     // anything else, checked by fnmatch
+    };
+
+  public:
+    Glob();
+
+    explicit Glob(const std::string& pPattern);
+
+    Kind kind() const { return m_Kind; }
+
+    /// prefix - the literal characters before the first wildcard
+    llvm::StringRef prefix() const
+    { return llvm::StringRef(m_Pattern.data(), m_PrefixSize); }
+
+    bool matches(const std::string& pString) const;
+
+  private:
+    std::string m_Pattern;
+    Kind m_Kind;
+    size_t m_PrefixSize;
+  };
+
+  struct Rule
+  {
+    bool hasFile;
+    bool hasSections;
+    Glob file;
+    std::vector<Glob> excludes;
+  };
+
+  struct TrieNode
+  {
+    typedef std::pair<unsigned int, Glob> Candidate;
+
+    std::map<char, unsigned int> children;
+
+    /// the section patterns whose literal prefix ends at this node
+    std::vector<Candidate> candidates;
+  };
+
+  typedef std::vector<unsigned int> RuleList;
+
+private:
+  void addSectionPattern(unsigned int pRule, const std::string& pPattern);
+
+  /// acceptFile - does the rule pRule accept pInputFile, provided that the
+  /// section name has matched?
+  bool acceptFile(const Rule& pRule, const std::string& pInputFile) const;
+
+  unsigned int lookup(const std::string& pInputFile,
+                      const std::string& pInputSection) const;
+
+private:
+  std::vector<Rule> m_Rules;
+
+  /// the literal section patterns
+  llvm::StringMap<RuleList> m_Literals;
+
+  /// the section patterns with wildcards. m_Trie[0] is the root.
+  std::vector<TrieNode> m_Trie;
+
+  /// the rules without section patterns
+  RuleList m_FileRules;
+
+  mutable llvm::StringMap<unsigned int> m_Results;
+  mutable llvm::sys::SmartMutex<true> m_ResultLock;
+};
+
+} // namespace of mcld
+
+#endif
+
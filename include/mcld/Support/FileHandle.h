@@ -68,6 +68,13 @@ public:
 
   typedef Flags<PermissionEnum> Permission;
 
+  /// Advice - the expected access pattern of a piece of mapped memory
+  enum Advice
+  {
+    Sequential,  // read once from low to high addresses
+    WillNeed     // read soon
+  };
+
 public:
   FileHandle();
 
@@ -99,6 +106,10 @@ public:
 
   bool munmap(void* pMemBuffer, size_t pLength);
 
+  /// advise - hint the system how the memory given by mmap will be accessed.
+  /// pMemBuffer must be at a page boundary. The hint may be ignored.
+  bool advise(void* pMemBuffer, size_t pLength, Advice pAdvice);
+
   // -----  observers  ----- //
   const sys::fs::Path& path() const
   { return m_Path; }
@@ -20,6 +20,7 @@
 #include "mcld/Support/PathCache.h"
 #include <mcld/Config/Defines.h>
 #include <string>
+#include <ctime>
 #include <iosfwd>
 #include <locale>
 
@@ -93,6 +94,7 @@ size_t canonicalize(Path::StringType& pPathName);
 bool not_found_error(int perrno);
 void status(const Path& p, FileStatus& pFileStatus);
 void symlink_status(const Path& p, FileStatus& pFileStatus);
+bool last_write_time(const Path& p, std::time_t& pTime);
 mcld::sys::fs::PathCache::entry_type* bring_one_into_cache(DirIterator& pIter);
 void open_dir(Directory& pDir);
 void close_dir(Directory& pDir);
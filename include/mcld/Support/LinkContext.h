@@ -0,0 +1,157 @@
+//===- LinkContext.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_LINK_CONTEXT_H
+#define MCLD_SUPPORT_LINK_CONTEXT_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/ADT/Uncopyable.h>
+#include <llvm/Support/Atomic.h>
+#include <llvm/Support/Mutex.h>
+
+namespace mcld {
+
+/** \class LinkContext
+ *  \brief LinkContext owns the arenas of one link.
+ *
+ *  The objects of a link, such as Relocation, FragmentRef, MemoryRegion and
+ *  the linker script tokens, are produced by their static Create functions
+ *  from the arenas of the current LinkContext of the calling thread.
+ *  Destroying the LinkContext releases all of them at once.
+ *
+ *  A LinkContext becomes current on a thread through LinkContext::Scope.
+ *  ThreadPool passes the current LinkContext on to its helper threads. If no
+ *  LinkContext is current, the process-wide default one is used.
+ *
+ *  Different LinkContexts share nothing, so independent links can run on
+ *  different threads at the same time.
+ */
+class LinkContext : private Uncopyable
+{
+public:
+  /// The kinds of arenas. release() destroys the arenas in this order.
+  enum ArenaKind
+  {
+    // Since llvm::iplist touches the removed nodes, the lists go first.
+    RelocDataArena,
+    SectionDataArena,
+    EhFrameArena,
+    LDSectionArena,
+    LDSymbolArena,
+    FragmentRefArena,
+    RelocationArena,
+    ELFSegmentArena,
+    MemoryRegionArena,
+
+    // linker script
+    WildcardPatternArena,
+    RpnExprArena,
+    StringListArena,
+    FileTokenArena,
+    NameSpecArena,
+    StrTokenArena,
+    SymOperandArena,
+    IntOperandArena,
+    SectOperandArena,
+    SectDescOperandArena,
+    FragOperandArena,
+    ParserStrPoolArena,
+
+    NumOfArenas
+  };
+
+  typedef llvm::sys::SmartMutex<true> Lock;
+
+  /** \class Scope
+   *  \brief Scope makes a LinkContext current on the calling thread during
+   *  its lifetime.
+   */
+  class Scope : private Uncopyable
+  {
+  public:
+    explicit Scope(LinkContext& pContext);
+
+    ~Scope();
+
+  private:
+    LinkContext* m_pPrevious;
+  };
+
+public:
+  LinkContext();
+
+  ~LinkContext();
+
+  /// Current - the current LinkContext of the calling thread.
+  static LinkContext& Current();
+
+  /// Default - the process-wide LinkContext used when no one is current.
+  static LinkContext& Default();
+
+  /// GetActive - the LinkContext made current by a Scope, or NULL.
+  static LinkContext* GetActive();
+
+  /// SetActive - make pContext current. NULL restores the default one.
+  static void SetActive(LinkContext* pContext);
+
+  /// arena - the arena of pKind. It is created on the first use.
+  template<typename FactoryType>
+  FactoryType& arena(ArenaKind pKind);
+
+  /// lock - the lock guarding the arena of pKind.
+  Lock& lock(ArenaKind pKind) { return m_Locks[pKind]; }
+
+  /// release - destroy all arenas and the objects in them.
+  void release();
+
+private:
+  class ArenaBase
+  {
+  public:
+    virtual ~ArenaBase() { }
+  };
+
+  template<typename FactoryType>
+  class Arena : public ArenaBase
+  {
+  public:
+    FactoryType factory;
+  };
+
+private:
+  ArenaBase* volatile m_Arenas[NumOfArenas];
+  Lock m_Locks[NumOfArenas];
+  Lock m_CreateLock;
+};
+
+//===----------------------------------------------------------------------===//
+// LinkContext template member functions
+//===----------------------------------------------------------------------===//
+template<typename FactoryType>
+FactoryType& LinkContext::arena(LinkContext::ArenaKind pKind)
+{
+  ArenaBase* result = m_Arenas[pKind];
+  llvm::sys::MemoryFence();
+  if (NULL == result) {
+    llvm::sys::SmartScopedLock<true> locker(m_CreateLock);
+    result = m_Arenas[pKind];
+    if (NULL == result) {
+      result = new Arena<FactoryType>();
+      llvm::sys::MemoryFence();
+      m_Arenas[pKind] = result;
+    }
+  }
+  return static_cast<Arena<FactoryType>*>(result)->factory;
+}
+
+} // namespace of mcld
+
+#endif
+
@@ -13,6 +13,8 @@
 #endif
 
 #include <mcld/ADT/Uncopyable.h>
+#include <mcld/Support/FileHandle.h>
+#include <llvm/Support/Mutex.h>
 #include <cstddef>
 #include <map>
 
@@ -25,7 +27,6 @@ namespace mcldtest {
 namespace mcld {
 
 class Space;
-class FileHandle;
 class MemoryRegion;
 
 /** \class MemoryArea
@@ -43,6 +44,13 @@ class MemoryRegion;
  *  If the part a file being loaded is larger than 3/4 pages, MemoryArea uses
  *  memory mapped I/O to load the file. Otherwise, MemoryArea uses dynamic
  *  memory to read the content of file into the memory space.
+ *
+ *  Members of an archive share the MemoryArea of the archive, so request and
+ *  release are serialized when inputs are read by several threads.
+ *
+ *  A read-only file can also be mapped as a whole by mapWhole(). After that,
+ *  request() slices the mapping without system calls, dynamic memory or
+ *  looking up the spaces.
  */
 class MemoryArea : private Uncopyable
 {
@@ -75,6 +83,17 @@ public:
   // clear - release all memory regions.
   void clear();
 
+  // mapWhole - map the whole read-only file at once. Call this before the
+  // MemoryArea is shared by threads. Return false if the file is writable,
+  // empty or can not be mapped.
+  bool mapWhole();
+
+  bool isMappedWhole() const { return (NULL != m_pWhole); }
+
+  // advise - hint the system how a part of the whole mapped file will be
+  // accessed. Do nothing if the file is not mapped as a whole.
+  void advise(size_t pOffset, size_t pLength, FileHandle::Advice pAdvice);
+
   const FileHandle* handler() const { return m_pFileHandle; }
   FileHandle*       handler()       { return m_pFileHandle; }
 
@@ -118,6 +137,8 @@ private:
   SpaceMapType m_SpaceMap;
   FileHandle* m_pFileHandle;
   size_t m_Size;
+  Space* m_pWhole;
+  llvm::sys::SmartMutex<true> m_Lock;
 };
 
 } // namespace of mcld
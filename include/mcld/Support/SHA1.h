@@ -0,0 +1,65 @@
+//===- SHA1.h -------------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_SHA1_H
+#define MCLD_SUPPORT_SHA1_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <llvm/Support/DataTypes.h>
+#include <cstddef>
+
+namespace mcld {
+
+/** \class SHA1
+ *  \brief SHA1 computes the SHA-1 message digest (FIPS 180-4).
+ *
+ *  Usage:
+ *    SHA1 sha1;
+ *    sha1.update(data, size);
+ *    sha1.final(digest);
+ */
+class SHA1
+{
+public:
+  enum {
+    DigestSize = 20
+  };
+
+public:
+  SHA1();
+
+  /// update - append pSize bytes of pData to the message
+  void update(const void* pData, size_t pSize);
+
+  /// final - finish the message and write the digest into pDigest. The
+  /// object is reset afterward.
+  void final(uint8_t pDigest[DigestSize]);
+
+  /// reset - start a new message
+  void reset();
+
+private:
+  enum {
+    BlockSize = 64
+  };
+
+  void compress(const uint8_t* pBlock);
+
+private:
+  uint32_t m_State[5];
+  uint64_t m_Length;
+  uint8_t m_Buffer[BlockSize];
+  size_t m_BufferSize;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -79,6 +79,9 @@ public:
   /// Create - Create a Space from FileHandler
   static Space* Create(FileHandle& pHandler, size_t pOffset, size_t pSize);
 
+  /// Map - Map the whole read-only file at once
+  static Space* Map(FileHandle& pHandler);
+
   static void Destroy(Space*& pSpace);
   
   static void Release(Space* pSpace, FileHandle& pHandler);
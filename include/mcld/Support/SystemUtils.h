@@ -31,6 +31,9 @@ std::string getDefaultTargetTriple();
 
 int GetPageSize();
 
+/// GetNumOfCPUs - the number of online processors, at least 1.
+unsigned int GetNumOfCPUs();
+
 /// GetRandomNum - generate a random number.
 long GetRandomNum();
 
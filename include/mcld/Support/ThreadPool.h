@@ -0,0 +1,84 @@
+//===- ThreadPool.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_THREAD_POOL_H
+#define MCLD_SUPPORT_THREAD_POOL_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/ADT/Uncopyable.h>
+#include <llvm/Support/Atomic.h>
+#include <cstddef>
+#include <vector>
+
+namespace mcld {
+
+class LinkContext;
+
+/** \class ThreadPool
+ *  \brief ThreadPool runs a list of independent tasks on a fixed number of
+ *  threads.
+ *
+ *  The calling thread takes part in the work, so a pool of N threads spawns
+ *  N-1 helper threads in ThreadPool::run. Tasks are handed out in list order
+ *  through a shared atomic cursor, and ThreadPool::run returns only after all
+ *  tasks finish. A pool of one thread runs the tasks serially in list order.
+ *
+ *  Tasks must not touch each other's data. Whatever must happen in a
+ *  deterministic order (e.g., symbol resolution) belongs after run().
+ *
+ *  The helper threads run the tasks in the LinkContext of the caller.
+ */
+class ThreadPool : private Uncopyable
+{
+public:
+  class Task
+  {
+  public:
+    virtual ~Task() { }
+
+    virtual void run() = 0;
+  };
+
+  typedef std::vector<Task*> TaskList;
+
+public:
+  /// @param pNumOfThreads - the number of threads, including the caller.
+  ///                        0 is treated as 1.
+  explicit ThreadPool(unsigned int pNumOfThreads);
+
+  ~ThreadPool();
+
+  unsigned int numOfThreads() const { return m_NumOfThreads; }
+
+  /// run - run all tasks in pTasks and wait for them.
+  void run(TaskList& pTasks);
+
+  /// Worker - the entry of helper threads. pPool is the ThreadPool.
+  static void* Worker(void* pPool);
+
+private:
+  /// work - keep taking tasks until the list is drained.
+  void work();
+
+  /// spawn - platform-dependent. Run work() on pNumOfHelpers new threads and
+  /// on the calling thread, then join the helpers.
+  void spawn(unsigned int pNumOfHelpers);
+
+private:
+  unsigned int m_NumOfThreads;
+  TaskList* m_pTasks;
+  LinkContext* m_pContext;
+  volatile llvm::sys::cas_flag m_Cursor;
+};
+
+} // namespace of mcld
+
+#endif
+
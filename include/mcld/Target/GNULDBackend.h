@@ -29,6 +29,7 @@ class LinkerConfig;
 class IRBuilder;
 class Layout;
 class EhFrameHdr;
+class BuildID;
 class BranchIslandFactory;
 class StubFactory;
 class GNUInfo;
@@ -40,6 +41,9 @@ class ELFExecFileFormat;
 class ELFObjectFileFormat;
 class LinkerScript;
 class Relocation;
+class StringTableBuilder;
+class OutputRelocSection;
+class OutputRelrSection;
 
 /** \class GNULDBackend
  *  \brief GNULDBackend provides a common interface for all GNU Unix-OS
@@ -111,6 +115,15 @@ public:
   /// sizeShstrtab - compute the size of .shstrtab
   void sizeShstrtab(Module& pModule);
 
+  /// strTabBuilder - the string table builder of .strtab. Targets adding
+  /// symbols after sizeNamePools() should add the names here.
+  StringTableBuilder&       strTabBuilder()       { return *m_pStrTabBuilder; }
+  const StringTableBuilder& strTabBuilder() const { return *m_pStrTabBuilder; }
+
+  /// shStrTabBuilder - the string table builder of .shstrtab
+  const StringTableBuilder& shStrTabBuilder() const
+  { return *m_pShStrTabBuilder; }
+
   /// sizeNamePools - compute the size of regular name pools
   /// In ELF executable files, regular name pools are .symtab, .strtab.,
   /// .dynsym, .dynstr, and .hash
@@ -138,6 +151,10 @@ public:
   /// In ELF executables, this is the length of dynamic linker's path name
   virtual void sizeInterp();
 
+  /// getEntry - get the entry point name. The entry of the linker script
+  /// takes precedence over the target's default one.
+  llvm::StringRef getEntry(const Module& pModule) const;
+
   /// emitInterp - emit the .interp
   virtual void emitInterp(MemoryArea& pOutput);
 
@@ -312,6 +329,10 @@ public:
   /// Target can override this function if needed.
   virtual uint64_t maxBranchOffset() { return (uint64_t)-1; }
 
+  /// maxBwdBranchOffset - return the max backward branch offset of the
+  /// backend. The default is the same as the forward one.
+  virtual uint64_t maxBwdBranchOffset() { return maxBranchOffset(); }
+
   /// checkAndSetHasTextRel - check pSection flag to set HasTextRel
   void checkAndSetHasTextRel(const LDSection& pSection);
 
@@ -319,6 +340,39 @@ public:
   /// process relocations more efficiently
   void sortRelocation(LDSection& pSection);
 
+  //  -----  packed relative relocations  -----  //
+  /// getRelativeRelocType - the type of the relative dynamic relocation.
+  /// Targets which classify their relative relocations should override this
+  /// function. 0x0 means the target packs none of them.
+  virtual uint32_t getRelativeRelocType() const { return 0x0; }
+
+  /// mayPackRelativeRelocs - if the relative relocations go to .relr.dyn
+  bool mayPackRelativeRelocs() const;
+
+  /// isPackablePlace - if the place of pReloc, a relocation of the input
+  /// section pTarget, is word-aligned in the output
+  bool isPackablePlace(const Relocation& pReloc,
+                       const LDSection& pTarget) const;
+
+  /// sizeRelrDyn - size .relr.dyn by the relative entries of pRelDyn. Return
+  /// the number of the entries left in pRelDyn.
+  size_t sizeRelrDyn(OutputRelocSection& pRelDyn);
+
+  /// packRelocations - move the relative relocations from .rel.dyn or
+  /// .rela.dyn to .relr.dyn, and count the ones left for DT_RELCOUNT or
+  /// DT_RELACOUNT. It is called after the relocations are applied.
+  void packRelocations();
+
+  /// numOfRelativeRelocs - the number of the relative relocations in .rel.dyn
+  /// or .rela.dyn
+  size_t numOfRelativeRelocs() const { return m_NumOfRelativeRelocs; }
+
+  /// numOfRelrEntries - the number of the encoded entries in .relr.dyn
+  size_t numOfRelrEntries() const;
+
+  /// emitRelrDyn - emit .relr.dyn
+  void emitRelrDyn(MemoryRegion& pRegion) const;
+
 protected:
   /// getRelEntrySize - the size in BYTE of rel type relocation
   virtual size_t getRelEntrySize() = 0;
@@ -348,15 +402,13 @@ protected:
   /// emitSymbol32 - emit an ELF32 symbol
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    const StringTableBuilder& pStrTab,
                     size_t pSymtabIdx);
 
   /// emitSymbol64 - emit an ELF64 symbol
   void emitSymbol64(llvm::ELF::Elf64_Sym& pSym64,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    const StringTableBuilder& pStrTab,
                     size_t pSymtabIdx);
 
 private:
@@ -417,14 +469,23 @@ private:
   /// mayRelax - Backends should override this function if they need relaxation
   virtual bool mayRelax() { return false; }
 
-  /// doRelax - Backend can orevride this function to add its relaxation
-  /// implementation. Return true if the output (e.g., .text) is "relaxed"
-  /// (i.e. layout is changed), and set pFinished to true if everything is fit,
-  /// otherwise set it to false.
-  virtual bool doRelax(Module& pModule, IRBuilder& pBuilder, bool& pFinished)
-  { return false; }
 
 protected:
+  /// mayNeedStub - Backends should override this function to tell if a
+  /// relocation may need a stub (e.g., a branch). relax() collects these
+  /// relocations once.
+  virtual bool mayNeedStub(const Relocation& pRel) const
+  { return false; }
+
+  /// getBranchTarget - the address reached by a relocation collected by
+  /// mayNeedStub. It is the address of the symbol by default.
+  virtual uint64_t getBranchTarget(const Relocation& pRel) const;
+
+  /// relaxRelocation - Backends should override this function to insert a
+  /// stub for pRel if needed. Return true if a stub is inserted.
+  virtual bool relaxRelocation(IRBuilder& pBuilder, Relocation& pRel)
+  { return false; }
+
   // Based on Kind in LDFileFormat to define basic section orders for ELF, and
   // refer gold linker to add more enumerations to handle Regular and BSS kind
   enum SectionOrder {
@@ -523,6 +584,20 @@ protected:
   // section .eh_frame_hdr
   EhFrameHdr* m_pEhFrameHdr;
 
+  // section .note.gnu.build-id
+  BuildID* m_pBuildID;
+
+  // section .relr.dyn
+  OutputRelrSection* m_pRelrDyn;
+
+  // the number of the relative relocations in .rel.dyn or .rela.dyn
+  size_t m_NumOfRelativeRelocs;
+
+  // string tables of .strtab, .dynstr and .shstrtab
+  StringTableBuilder* m_pStrTabBuilder;
+  StringTableBuilder* m_pDynStrTabBuilder;
+  StringTableBuilder* m_pShStrTabBuilder;
+
   // ----- dynamic flags ----- //
   // DF_TEXTREL of DT_FLAGS
   bool m_bHasTextRel;
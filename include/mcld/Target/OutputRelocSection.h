@@ -34,6 +34,11 @@ public:
 
   void reserveEntry(size_t pNum=1);
 
+  /// reserveRelativeEntry - reserve entries which become relative relocations
+  /// against word-aligned places. These entries may be packed into
+  /// .relr.dyn.
+  void reserveRelativeEntry(size_t pNum=1);
+
   Relocation* consumeEntry();
 
   /// addSymbolToDynSym - add local symbol to TLS category so that it'll be
@@ -46,6 +51,10 @@ public:
 
   size_t numOfRelocs();
 
+  /// numOfRelatives - the number of entries reserved by reserveRelativeEntry
+  size_t numOfRelatives() const
+  { return m_NumOfRelatives; }
+
 private:
   typedef RelocData::iterator RelocIterator;
 
@@ -61,6 +70,8 @@ private:
 
   /// m_ValidEntryIterator - point to the first valid entry
   RelocIterator m_ValidEntryIterator;
+
+  size_t m_NumOfRelatives;
 };
 
 } // namespace of mcld
@@ -0,0 +1,88 @@
+//===- OutputRelrSection.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OUTPUT_RELR_SECTION_H
+#define MCLD_OUTPUT_RELR_SECTION_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/Fragment/Relocation.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld
+{
+
+class LDSection;
+class MemoryRegion;
+class RelocData;
+
+/** \class OutputRelrSection
+ *  \brief OutputRelrSection is .relr.dyn, the packed relative relocations.
+ *
+ *  An even entry is the address of a word to relocate. An odd entry is a
+ *  bitmap of the (N - 1) words following the last relocated word, where N is
+ *  the number of bits in a word. The dynamic linker adds the load bias to
+ *  each relocated word, so the addend of a packed relocation must be in its
+ *  place.
+ *
+ *  The places of the dynamic relocations are known only after they are
+ *  applied. .relr.dyn is therefore sized by the number of relative
+ *  relocations reserved for it, which bounds the number of entries, and the
+ *  unused tail is filled with empty bitmaps.
+ */
+class OutputRelrSection
+{
+public:
+  OutputRelrSection(LDSection& pSection,
+                    unsigned int pBitClass,
+                    bool pIsLittleEndian);
+
+  ~OutputRelrSection();
+
+  /// entrySize - the size in byte of an entry
+  size_t entrySize() const
+  { return m_BitClass / 8; }
+
+  /// sizeOutput - reserve room for pNum relocations
+  void sizeOutput(size_t pNum);
+
+  /// capacity - the number of relocations reserved by sizeOutput
+  size_t capacity() const
+  { return m_Capacity; }
+
+  /// pack - move the relocations of pType against word-aligned places from
+  /// pRelocData into this section, at most capacity() of them, and encode
+  /// their places. A place relocated more than once is encoded once. Return
+  /// the number of the moved relocations.
+  size_t pack(RelocData& pRelocData, Relocation::Type pType);
+
+  /// numOfEntries - the number of the encoded entries
+  size_t numOfEntries() const
+  { return m_Entries.size(); }
+
+  /// emit - write out the entries and the padding in the target byte order
+  void emit(MemoryRegion& pRegion) const;
+
+private:
+  LDSection& m_Section;
+
+  unsigned int m_BitClass;
+
+  bool m_IsLittleEndian;
+
+  size_t m_Capacity;
+
+  std::vector<uint64_t> m_Entries;
+};
+
+} // namespace of mcld
+
+#endif
+
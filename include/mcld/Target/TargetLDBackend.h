@@ -9,6 +9,7 @@
 #ifndef MCLD_TARGET_TARGETLDBACKEND_H
 #define MCLD_TARGET_TARGETLDBACKEND_H
 
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/DataTypes.h>
 
 namespace mcld {
@@ -157,6 +158,9 @@ public:
   /// process relocations more efficiently
   virtual void sortRelocation(LDSection& pSection) = 0;
 
+  /// getEntry - get the entry point name
+  virtual llvm::StringRef getEntry(const Module& pModule) const = 0;
+
 protected:
   const LinkerConfig& config() const { return m_Config; }
 
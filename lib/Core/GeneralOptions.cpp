@@ -37,6 +37,7 @@ GeneralOptions::GeneralOptions()
     m_bRelro(false),
     m_bNow(false),
     m_bOrigin(false),
+    m_bPackRelativeRelocs(false),
     m_bTrace(false),
     m_Bsymbolic(false),
     m_Bgroup(false),
@@ -53,9 +54,16 @@ GeneralOptions::GeneralOptions()
     m_bFatalWarnings(false),
     m_bNewDTags(false),
     m_bNoStdlib(false),
+    m_bPrintStats(false),
+    m_bGCSections(false),
+    m_bLazyDynObjSymbols(false),
+    m_bMapWholeInputs(false),
     m_GPSize(8),
     m_StripSymbols(KeepAllSymbols),
-    m_HashStyle(SystemV) {
+    m_HashStyle(SystemV),
+    m_NumOfThreads(1),
+    m_ICF(ICF_None),
+    m_BuildID(BuildID_None) {
 }
 
 GeneralOptions::~GeneralOptions()
@@ -71,6 +79,46 @@ void GeneralOptions::setSOName(const std::string& pName)
     m_SOName = pName.substr(pos + 1);
 }
 
+bool GeneralOptions::setBuildID(const std::string& pStyle)
+{
+  if (pStyle.empty() || "sha1" == pStyle)
+    m_BuildID = BuildID_SHA1;
+  else if ("fast" == pStyle)
+    m_BuildID = BuildID_Fast;
+  else if ("uuid" == pStyle)
+    m_BuildID = BuildID_UUID;
+  else if ("none" == pStyle)
+    m_BuildID = BuildID_None;
+  else if (0 == pStyle.compare(0, 2, "0x")) {
+    // two hex digits per byte
+    if (2 == pStyle.size() || 0 != (pStyle.size() % 2))
+      return false;
+
+    std::string bytes;
+    for (size_t i = 2; i < pStyle.size(); i += 2) {
+      unsigned int byte = 0;
+      for (size_t j = i; j < i + 2; ++j) {
+        char c = pStyle[j];
+        byte <<= 4;
+        if ('0' <= c && c <= '9')
+          byte |= c - '0';
+        else if ('a' <= c && c <= 'f')
+          byte |= c - 'a' + 10;
+        else if ('A' <= c && c <= 'F')
+          byte |= c - 'A' + 10;
+        else
+          return false;
+      }
+      bytes += static_cast<char>(byte);
+    }
+    m_BuildID = BuildID_Hex;
+    m_BuildIDHex = bytes;
+  }
+  else
+    return false;
+  return true;
+}
+
 void GeneralOptions::addZOption(const ZOption& pOption)
 {
   switch (pOption.kind()) {
@@ -131,6 +179,12 @@ void GeneralOptions::addZOption(const ZOption& pOption)
     case ZOption::Origin:
       m_bOrigin = true;
       break;
+    case ZOption::PackRelativeRelocs:
+      m_bPackRelativeRelocs = true;
+      break;
+    case ZOption::NoPackRelativeRelocs:
+      m_bPackRelativeRelocs = false;
+      break;
     case ZOption::CommPageSize:
       m_CommPageSize = pOption.pageSize();
       break;
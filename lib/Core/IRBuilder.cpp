@@ -9,10 +9,12 @@
 #include <mcld/IRBuilder.h>
 #include <mcld/LinkerScript.h>
 #include <mcld/LD/ELFReader.h>
+#include <mcld/LD/DynObjReader.h>
 #include <mcld/Object/ObjectBuilder.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/LD/RelocData.h>
+#include <mcld/Support/LinkContext.h>
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/Support/ELF.h>
 #include <mcld/Fragment/FragmentRef.h>
@@ -114,13 +116,25 @@ bool ShouldForceLocal(const ResolveInfo& pInfo, const LinkerConfig& pConfig)
 // IRBuilder
 //===----------------------------------------------------------------------===//
 IRBuilder::IRBuilder(Module& pModule, const LinkerConfig& pConfig)
-  : m_Module(pModule), m_Config(pConfig), m_InputBuilder(pConfig) {
+  : m_Module(pModule), m_Config(pConfig), m_Context(LinkContext::Current()),
+    m_InputBuilder(pConfig), m_pDynObjReader(NULL) {
   m_InputBuilder.setCurrentTree(m_Module.getInputTree());
 
   // FIXME: where to set up Relocation?
   Relocation::SetUp(m_Config);
 }
 
+IRBuilder::IRBuilder(Module& pModule, const LinkerConfig& pConfig,
+                     LinkContext& pContext)
+  : m_Module(pModule), m_Config(pConfig), m_Context(pContext),
+    m_InputBuilder(pConfig), m_pDynObjReader(NULL) {
+  m_InputBuilder.setCurrentTree(m_Module.getInputTree());
+
+  // FIXME: where to set up Relocation?
+  LinkContext::Scope scope(m_Context);
+  Relocation::SetUp(m_Config);
+}
+
 IRBuilder::~IRBuilder()
 {
 }
@@ -445,7 +459,24 @@ uint64_t IRBuilder::AppendEhFrame(EhFrame::CIE& pCIE, EhFrame& pEhFrame)
 /// AddSymbol - To add a symbol in the input file and resolve the symbol
 /// immediately
 LDSymbol* IRBuilder::AddSymbol(Input& pInput,
-                               const std::string& pName,
+                               const llvm::StringRef& pName,
+                               ResolveInfo::Type pType,
+                               ResolveInfo::Desc pDesc,
+                               ResolveInfo::Binding pBind,
+                               ResolveInfo::SizeType pSize,
+                               LDSymbol::ValueType pValue,
+                               LDSection* pSection,
+                               ResolveInfo::Visibility pVis)
+{
+  return AddSymbol(pInput, pName, NamePool::Hash(pName), pType, pDesc, pBind,
+                   pSize, pValue, pSection, pVis);
+}
+
+/// AddSymbol - To add a symbol whose hash value is known in the input file
+/// and resolve the symbol immediately
+LDSymbol* IRBuilder::AddSymbol(Input& pInput,
+                               const llvm::StringRef& pName,
+                               uint32_t pHash,
                                ResolveInfo::Type pType,
                                ResolveInfo::Desc pDesc,
                                ResolveInfo::Binding pBind,
@@ -455,7 +486,8 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
                                ResolveInfo::Visibility pVis)
 {
   // rename symbols
-  std::string name = pName;
+  llvm::StringRef name = pName;
+  uint32_t hash = pHash;
   if (!m_Module.getScript().renameMap().empty() &&
       ResolveInfo::Undefined == pDesc) {
     // If the renameMap is not empty, some symbols should be renamed.
@@ -463,8 +495,10 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
     const LinkerScript& script = m_Module.getScript();
     LinkerScript::SymbolRenameMap::const_iterator renameSym =
                                                 script.renameMap().find(pName);
-    if (script.renameMap().end() != renameSym)
+    if (script.renameMap().end() != renameSym) {
       name = renameSym.getEntry()->value();
+      hash = NamePool::Hash(name);
+    }
   }
 
   switch (pInput.type()) {
@@ -481,12 +515,14 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
       else
         frag = FragmentRef::Create(*pSection, pValue);
 
-      LDSymbol* input_sym = addSymbolFromObject(name, pType, pDesc, pBind, pSize, pValue, frag, pVis);
+      LDSymbol* input_sym = addSymbolFromObject(name, hash, pType, pDesc, pBind,
+                                                pSize, pValue, frag, pVis);
       pInput.context()->addSymbol(input_sym);
       return input_sym;
     }
     case Input::DynObj: {
-      return addSymbolFromDynObj(pInput, name, pType, pDesc, pBind, pSize, pValue, pVis);
+      return addSymbolFromDynObj(pInput, name, hash, pType, pDesc, pBind, pSize,
+                                 pValue, pVis);
     }
     default: {
       return NULL;
@@ -496,7 +532,8 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
   return NULL;
 }
 
-LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
+LDSymbol* IRBuilder::addSymbolFromObject(const llvm::StringRef& pName,
+                                         uint32_t pHash,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
@@ -528,8 +565,8 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
   }
   else {
     // if the symbol is not local, insert and resolve it immediately
-    m_Module.getNamePool().insertSymbol(pName, false, pType, pDesc, pBinding,
-                                        pSize, pValue, pVisibility,
+    m_Module.getNamePool().insertSymbol(pName, pHash, false, pType, pDesc,
+                                        pBinding, pSize, pValue, pVisibility,
                                         &old_info, resolved_result);
   }
 
@@ -598,11 +635,18 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
     }
   }
 
+  // Step 5. Import the definitions of a new symbol from the lazily read
+  // shared objects.
+  if (NULL != m_pDynObjReader && !resolved_result.existent &&
+      ResolveInfo::Local != pBinding)
+    m_pDynObjReader->importSymbol(*resolved_result.info);
+
   return input_sym;
 }
 
 LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
-                                         const std::string& pName,
+                                         const llvm::StringRef& pName,
+                                         uint32_t pHash,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
@@ -629,7 +673,7 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
   // insert symbol and resolve it immediately
   // resolved_result is a triple <resolved_info, existent, override>
   Resolver::Result resolved_result;
-  m_Module.getNamePool().insertSymbol(pName, true, pType, pDesc,
+  m_Module.getNamePool().insertSymbol(pName, pHash, true, pType, pDesc,
                                       pBinding, pSize, pValue, pVisibility,
                                       NULL, resolved_result);
 
@@ -663,6 +707,12 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
     }
   }
 
+  // a new reference from a shared object may be defined by the lazily read
+  // shared objects.
+  if (NULL != m_pDynObjReader && !resolved_result.existent &&
+      ResolveInfo::Undefined == pDesc)
+    m_pDynObjReader->importSymbol(*resolved_result.info);
+
   return input_sym;
 }
 
@@ -14,6 +14,7 @@
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/Support/TargetRegistry.h>
 #include <mcld/Support/FileHandle.h>
+#include <mcld/Support/LinkContext.h>
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/raw_ostream.h>
 
@@ -32,7 +33,12 @@
 using namespace mcld;
 
 Linker::Linker()
-  : m_pConfig(NULL), m_pIRBuilder(NULL),
+  : m_pContext(NULL), m_pConfig(NULL), m_pIRBuilder(NULL),
+    m_pTarget(NULL), m_pBackend(NULL), m_pObjLinker(NULL) {
+}
+
+Linker::Linker(LinkContext& pContext)
+  : m_pContext(&pContext), m_pConfig(NULL), m_pIRBuilder(NULL),
     m_pTarget(NULL), m_pBackend(NULL), m_pObjLinker(NULL) {
 }
 
@@ -45,6 +51,7 @@ Linker::~Linker()
 /// Follow GNU ld quirks.
 bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig)
 {
+  LinkContext::Scope scope(context());
   m_pConfig = &pConfig;
 
   if (!initTarget())
@@ -64,6 +71,7 @@ bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig)
 
 bool Linker::link(Module& pModule, IRBuilder& pBuilder)
 {
+  LinkContext::Scope scope(context());
   if (!normalize(pModule, pBuilder))
     return false;
 
@@ -77,6 +85,9 @@ bool Linker::link(Module& pModule, IRBuilder& pBuilder)
 bool Linker::normalize(Module& pModule, IRBuilder& pBuilder)
 {
   assert(NULL != m_pConfig);
+  assert(&context() == &pBuilder.getContext() &&
+         "IRBuilder and Linker must share the same LinkContext");
+  LinkContext::Scope scope(context());
 
   m_pIRBuilder = &pBuilder;
 
@@ -161,6 +172,7 @@ bool Linker::resolve()
 {
   assert(NULL != m_pConfig);
   assert(m_pObjLinker != NULL);
+  LinkContext::Scope scope(context());
 
   // 6. - read all relocation entries from input files
   //   For all relocation sections of each input file (in the tree),
@@ -170,6 +182,16 @@ bool Linker::resolve()
   //   To collect all edges in the reference graph.
   m_pObjLinker->readRelocations();
 
+  // 6.b - remove the input sections no one refers to (--gc-sections), and
+  //   fold the identical code sections (--icf).
+  //   Stripped and folded sections become Ignore, so they are never merged.
+  m_pObjLinker->dataStrippingOpt();
+
+  // 6.c - merge the strings of SHF_MERGE|SHF_STRINGS sections.
+  //   The merged content replaces the first input section of each output
+  //   section, and the other input sections become Ignore.
+  m_pObjLinker->mergeStrings();
+
   // 7. - merge all sections
   //   Push sections into Module's SectionTable.
   //   Merge sections that have the same name.
@@ -189,6 +211,7 @@ bool Linker::resolve()
 bool Linker::layout()
 {
   assert(NULL != m_pConfig && NULL != m_pObjLinker);
+  LinkContext::Scope scope(context());
 
   // 9. - add standard symbols, target-dependent symbols and script symbols
   // m_pObjLinker->addUndefSymbols();
@@ -231,6 +254,7 @@ bool Linker::layout()
 
 bool Linker::emit(MemoryArea& pOutput)
 {
+  LinkContext::Scope scope(context());
   // 13. - write out output
   m_pObjLinker->emitOutput(pOutput);
 
@@ -245,6 +269,8 @@ bool Linker::emit(MemoryArea& pOutput)
 
 bool Linker::emit(const std::string& pPath)
 {
+  // The regions of the output are destroyed with the MemoryArea.
+  LinkContext::Scope scope(context());
   FileHandle file;
   FileHandle::Permission perm;
   switch (m_pConfig->codeGenType()) {
@@ -278,6 +304,7 @@ bool Linker::emit(const std::string& pPath)
 
 bool Linker::emit(int pFileDescriptor)
 {
+  LinkContext::Scope scope(context());
   FileHandle file;
   file.delegate(pFileDescriptor);
   MemoryArea* output = new MemoryArea(file);
@@ -291,6 +318,7 @@ bool Linker::emit(int pFileDescriptor)
 
 bool Linker::reset()
 {
+  LinkContext::Scope scope(context());
   m_pConfig = NULL;
   m_pIRBuilder = NULL;
   m_pTarget = NULL;
@@ -359,3 +387,9 @@ bool Linker::initEmulator(LinkerScript& pScript)
   return m_pTarget->emulate(pScript, *m_pConfig);
 }
 
+LinkContext& Linker::context()
+{
+  if (NULL == m_pContext)
+    return LinkContext::Current();
+  return *m_pContext;
+}
@@ -32,6 +32,14 @@ Fragment::~Fragment()
 {
 }
 
+void Fragment::setOffset(uint64_t pOffset)
+{
+  m_Offset = pOffset;
+  // the size of an alignment fragment depends on its offset.
+  if (NULL != m_pParent)
+    m_pParent->invalidateOffsetIndex();
+}
+
 uint64_t Fragment::getOffset() const
 {
   assert(hasOffset() && "Cannot getOffset() before setting it up.");
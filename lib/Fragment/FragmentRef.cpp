@@ -12,13 +12,14 @@
 #include <cassert>
 
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 #include <mcld/Fragment/Fragment.h>
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/Support/GCFactory.h>
+#include <mcld/Support/LinkContext.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Fragment/RegionFragment.h>
 #include <mcld/Fragment/Stub.h>
@@ -27,7 +28,16 @@ using namespace mcld;
 
 typedef GCFactory<FragmentRef, MCLD_SECTIONS_PER_INPUT> FragRefFactory;
 
-static llvm::ManagedStatic<FragRefFactory> g_FragRefFactory;
+static inline FragRefFactory& GetFragRefFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<FragRefFactory>(LinkContext::FragmentRefArena);
+}
+
+static inline LinkContext::Lock& GetFragRefFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::FragmentRefArena);
+}
 
 FragmentRef FragmentRef::g_NullFragmentRef;
 
@@ -52,22 +62,36 @@ FragmentRef::FragmentRef(Fragment& pFrag,
 /// return NULL.
 FragmentRef* FragmentRef::Create(Fragment& pFrag, uint64_t pOffset)
 {
-  int64_t offset = pOffset;
   Fragment* frag = &pFrag;
-
-  while (NULL != frag) {
-    offset -= frag->size();
-    if (offset <= 0)
-      break;
-    frag = frag->getNextNode();
+  uint64_t offset = pOffset;
+
+  // If the offset is out of pFrag, binary-search the fragment in the offset
+  // index of the section data. Fragments out of any section data are walked
+  // through one by one.
+  if (pOffset > pFrag.size()) {
+    frag = NULL;
+    if (NULL != pFrag.getParent())
+      frag = pFrag.getParent()->locate(pFrag, offset);
+
+    if (NULL == frag) {
+      int64_t remain = pOffset;
+      frag = &pFrag;
+      while (NULL != frag) {
+        remain -= frag->size();
+        if (remain <= 0)
+          break;
+        frag = frag->getNextNode();
+      }
+
+      if (NULL == frag)
+        return Null();
+      offset = remain + frag->size();
+    }
   }
 
-
-  if (NULL == frag)
-    return Null();
-
-  FragmentRef* result = g_FragRefFactory->allocate();
-  new (result) FragmentRef(*frag, offset + frag->size());
+  llvm::sys::SmartScopedLock<true> locker(GetFragRefFactoryLock());
+  FragmentRef* result = GetFragRefFactory().allocate();
+  new (result) FragmentRef(*frag, offset);
 
   return result;
 }
@@ -97,7 +121,7 @@ FragmentRef* FragmentRef::Create(LDSection& pSection, uint64_t pOffset)
 
 void FragmentRef::Clear()
 {
-  g_FragRefFactory->clear();
+  GetFragRefFactory().clear();
 }
 
 FragmentRef* FragmentRef::Null()
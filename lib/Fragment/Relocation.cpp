@@ -12,14 +12,23 @@
 #include <mcld/LD/LDSymbol.h>
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/SectionData.h>
-#include <mcld/Support/MsgHandling.h>
 #include <mcld/LD/RelocationFactory.h>
+#include <mcld/Support/LinkContext.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 using namespace mcld;
 
-static llvm::ManagedStatic<RelocationFactory> g_RelocationFactory;
+static inline RelocationFactory& GetRelocationFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<RelocationFactory>(LinkContext::RelocationArena);
+}
+
+static inline LinkContext::Lock& GetRelocationFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::RelocationArena);
+}
 
 //===----------------------------------------------------------------------===//
 // Relocation Factory Methods
@@ -27,19 +36,20 @@ static llvm::ManagedStatic<RelocationFactory> g_RelocationFactory;
 /// Initialize - set up the relocation factory
 void Relocation::SetUp(const LinkerConfig& pConfig)
 {
-  g_RelocationFactory->setConfig(pConfig);
+  GetRelocationFactory().setConfig(pConfig);
 }
 
 /// Clear - Clean up the relocation factory
 void Relocation::Clear()
 {
-  g_RelocationFactory->clear();
+  GetRelocationFactory().clear();
 }
 
 /// Create - produce an empty relocation entry
 Relocation* Relocation::Create()
 {
-  return g_RelocationFactory->produceEmptyEntry();
+  llvm::sys::SmartScopedLock<true> locker(GetRelocationFactoryLock());
+  return GetRelocationFactory().produceEmptyEntry();
 }
 
 /// Create - produce a relocation entry
@@ -48,13 +58,15 @@ Relocation* Relocation::Create()
 /// @param pAddend  [in] the addend of the relocation entry
 Relocation* Relocation::Create(Type pType, FragmentRef& pFragRef, Address pAddend)
 {
-  return g_RelocationFactory->produce(pType, pFragRef, pAddend);
+  llvm::sys::SmartScopedLock<true> locker(GetRelocationFactoryLock());
+  return GetRelocationFactory().produce(pType, pFragRef, pAddend);
 }
 
 /// Destroy - destroy a relocation entry
 void Relocation::Destroy(Relocation*& pRelocation)
 {
-  g_RelocationFactory->destroy(pRelocation);
+  llvm::sys::SmartScopedLock<true> locker(GetRelocationFactoryLock());
+  GetRelocationFactory().destroy(pRelocation);
   pRelocation = NULL;
 }
 
@@ -100,32 +112,7 @@ Relocation::Address Relocation::symValue() const
 void Relocation::apply(Relocator& pRelocator)
 {
   Relocator::Result result = pRelocator.applyRelocation(*this);
-
-  switch (result) {
-    case Relocator::OK: {
-      // do nothing
-      return;
-    }
-    case Relocator::Overflow: {
-      error(diag::result_overflow) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::BadReloc: {
-      error(diag::result_badreloc) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::Unsupport: {
-      fatal(diag::unsupported_relocation) << type()
-                                          << "mclinker@googlegroups.com";
-      return;
-    }
-    case Relocator::Unknown: {
-      fatal(diag::unknown_relocation) << type() << symInfo()->name();
-      return;
-    }
-  } // end of switch
+  pRelocator.reportResult(*this, result);
 }
 
 void Relocation::setType(Type pType)
@@ -29,6 +29,8 @@ Archive::Archive(Input& pInputFile, InputBuilder& pBuilder)
  : m_ArchiveFile(pInputFile),
    m_pInputTree(NULL),
    m_SymbolFactory(32),
+   m_SymTabSize(0),
+   m_UndefCursor(0),
    m_Builder(pBuilder)
 {
   // FIXME: move creation of input tree out of Archive.
@@ -192,6 +194,22 @@ void Archive::addSymbol(const char* pName,
   Symbol* entry = m_SymbolFactory.allocate();
   new (entry) Symbol(pName, pFileOffset, pStatus);
   m_SymTab.push_back(entry);
+
+  // index the entry by its name. Symbol is never moved after allocation, so
+  // the key can refer to its name directly.
+  bool exist = false;
+  SymbolIndexEntryType* index = m_SymIndex.insert(entry->name, exist);
+  if (!exist) {
+    index->setValue(m_SymTab.size() - 1);
+    return;
+  }
+
+  // the same name is defined by several members, chain them up in the order
+  // of the symtab
+  size_t idx = index->value();
+  while (0 != m_SymTab[idx]->next)
+    idx = m_SymTab[idx]->next;
+  m_SymTab[idx]->next = m_SymTab.size() - 1;
 }
 
 /// getSymbolName - get the symbol name with the given index
@@ -223,6 +241,37 @@ void Archive::setSymbolStatus(size_t pSymIdx,
   m_SymTab[pSymIdx]->status = pStatus;
 }
 
+/// findSymbol - get the index of the first symtab entry with the given name
+size_t Archive::findSymbol(const llvm::StringRef& pName) const
+{
+  SymbolIndexType::const_iterator it = m_SymIndex.find(pName);
+  if (it == m_SymIndex.end())
+    return numOfSymbols();
+  return it.getEntry()->value();
+}
+
+/// getNextSymbol - get the index of the next symtab entry that has the same
+/// name as the given one
+size_t Archive::getNextSymbol(size_t pSymIdx) const
+{
+  assert(pSymIdx < numOfSymbols());
+  if (0 == m_SymTab[pSymIdx]->next)
+    return numOfSymbols();
+  return m_SymTab[pSymIdx]->next;
+}
+
+/// getUndefCursor - get the number of searched undefined symbols
+size_t Archive::getUndefCursor() const
+{
+  return m_UndefCursor;
+}
+
+/// setUndefCursor - set the number of searched undefined symbols
+void Archive::setUndefCursor(size_t pCursor)
+{
+  m_UndefCursor = pCursor;
+}
+
 /// getStrTable - get the extended name table
 std::string& Archive::getStrTable()
 {
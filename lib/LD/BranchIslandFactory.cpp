@@ -12,6 +12,8 @@
 #include <mcld/LD/SectionData.h>
 #include <mcld/Module.h>
 
+#include <llvm/Support/ELF.h>
+
 using namespace mcld;
 
 //===----------------------------------------------------------------------===//
@@ -19,13 +21,16 @@ using namespace mcld;
 //===----------------------------------------------------------------------===//
 
 /// ctor
-/// @param pMaxBranchRange - the max branch range of the target backend
+/// @param pMaxFwdBranchRange - the max forward branch range of the target
+/// @param pMaxBwdBranchRange - the max backward branch range of the target
 /// @param pMaxIslandSize - a predifned value (1KB here) to decide the max
 ///                         size of the island
-BranchIslandFactory::BranchIslandFactory(uint64_t pMaxBranchRange,
+BranchIslandFactory::BranchIslandFactory(uint64_t pMaxFwdBranchRange,
+                                         uint64_t pMaxBwdBranchRange,
                                          uint64_t pMaxIslandSize)
  : GCFactory<BranchIsland, 0>(1u), // magic number
-   m_MaxBranchRange(pMaxBranchRange - pMaxIslandSize),
+   m_MaxFwdBranchRange(pMaxFwdBranchRange - pMaxIslandSize),
+   m_MaxBwdBranchRange(pMaxBwdBranchRange),
    m_MaxIslandSize(pMaxIslandSize)
 {
 }
@@ -34,30 +39,41 @@ BranchIslandFactory::~BranchIslandFactory()
 {
 }
 
-/// group - group fragments and create islands when needed
-/// @param pSectionData - the SectionData holds fragments need to be grouped
+/// group - group fragments of every executable output section and create
+/// islands when needed
 void BranchIslandFactory::group(Module& pModule)
 {
-  /* Currently only support relaxing .text section! */
-  LDSection* text = pModule.getSection(".text");
-  if (text != NULL && text->hasSectionData()) {
-    SectionData& sd = *text->getSectionData();
-    uint64_t group_end = m_MaxBranchRange - m_MaxIslandSize;
-    for (SectionData::iterator it = sd.begin(), ie = sd.end(); it != ie; ++it) {
-      if ((*it).getOffset() + (*it).size() > group_end) {
-        Fragment* frag = (*it).getPrevNode();
-        while (frag != NULL && frag->getKind() == Fragment::Alignment) {
-          frag = frag->getPrevNode();
-        }
-        if (frag != NULL) {
-          produce(*frag);
-          group_end = (*it).getOffset() + m_MaxBranchRange - m_MaxIslandSize;
-        }
+  Module::iterator sect, sectEnd = pModule.end();
+  for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+    if (LDFileFormat::Regular != (*sect)->kind() ||
+        0x0 == ((*sect)->flag() & llvm::ELF::SHF_EXECINSTR) ||
+        !(*sect)->hasSectionData() ||
+        (*sect)->getSectionData()->empty())
+      continue;
+    group(*(*sect)->getSectionData());
+  }
+}
+
+/// group - group fragments of pSectionData
+void BranchIslandFactory::group(SectionData& pSectionData)
+{
+  IslandList& islands = m_IslandMap[&pSectionData];
+  uint64_t group_end = m_MaxFwdBranchRange - m_MaxIslandSize;
+  SectionData::iterator it, ie = pSectionData.end();
+  for (it = pSectionData.begin(); it != ie; ++it) {
+    if ((*it).getOffset() + (*it).size() > group_end) {
+      Fragment* frag = (*it).getPrevNode();
+      while (frag != NULL && frag->getKind() == Fragment::Alignment) {
+        frag = frag->getPrevNode();
+      }
+      if (frag != NULL) {
+        islands.push_back(produce(*frag));
+        group_end = (*it).getOffset() + m_MaxFwdBranchRange - m_MaxIslandSize;
       }
     }
-    if (find(sd.back()) == NULL)
-      produce(sd.back());
   }
+  if (getIslands(pSectionData.back()).second == NULL)
+    islands.push_back(produce(pSectionData.back()));
 }
 
 /// produce - produce a island for the given fragment
@@ -71,17 +87,51 @@ BranchIsland* BranchIslandFactory::produce(Fragment& pFragment)
   return island;
 }
 
-/// find - find a island for the given fragment
-/// @param pFragment - the fragment needs a branch isladn
+/// find - find a island for the given fragment. The island after the
+/// fragment is preferred.
+/// @param pFragment - the fragment needs a branch island
 BranchIsland* BranchIslandFactory::find(const Fragment& pFragment)
 {
-  // Currently we always find the island in a forward direction.
-  // TODO: If we can search backward, then we may reduce the number of stubs.
-  for (iterator it = begin(), ie = end(); it != ie; ++it) {
-    if ((pFragment.getOffset() < (*it).offset()) &&
-        ((pFragment.getOffset() + m_MaxBranchRange) >= (*it).offset()))
-      return &(*it);
+  std::pair<BranchIsland*, BranchIsland*> islands = getIslands(pFragment);
+  return (NULL != islands.second) ? islands.second : islands.first;
+}
+
+/// getIslands - get the islands before and after the branch at pOffset of
+/// the given fragment which are in the branch range. Either one may be NULL.
+/// @param pFragment - the fragment needs a branch island
+/// @param pOffset - the offset of the branch in pFragment
+std::pair<BranchIsland*, BranchIsland*>
+BranchIslandFactory::getIslands(const Fragment& pFragment, uint64_t pOffset)
+{
+  std::pair<BranchIsland*, BranchIsland*> result(NULL, NULL);
+  IslandMap::iterator entry = m_IslandMap.find(pFragment.getParent());
+  if (m_IslandMap.end() == entry || entry->second.empty())
+    return result;
+
+  // Stubs only grow the islands, so the islands stay sorted by offset. Find
+  // the first island after the branch.
+  const IslandList& islands = entry->second;
+  uint64_t place = pFragment.getOffset() + pOffset;
+  size_t low = 0, high = islands.size();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (islands[mid]->offset() <= place)
+      low = mid + 1;
+    else
+      high = mid;
   }
-  return NULL;
+
+  // A stub in the island after the branch is at most m_MaxIslandSize beyond
+  // the island's offset, which the forward range already leaves room for.
+  if (low < islands.size() &&
+      (islands[low]->offset() - place) <= m_MaxFwdBranchRange)
+    result.second = islands[low];
+
+  // A stub in the island before the branch is at least at the island's
+  // offset, so the distance to it is at most place - offset.
+  if (0 != low && (place - islands[low - 1]->offset()) <= m_MaxBwdBranchRange)
+    result.first = islands[low - 1];
+
+  return result;
 }
 
@@ -0,0 +1,317 @@
+//===- BuildID.cpp --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/BuildID.h>
+#include <mcld/GeneralOptions.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/ADT/SizeTraits.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/Support/FileHandle.h>
+#include <mcld/Support/MemoryArea.h>
+#include <mcld/Support/MemoryRegion.h>
+#include <mcld/Support/SHA1.h>
+#include <mcld/Support/ThreadPool.h>
+
+#include <llvm/Support/Process.h>
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+namespace {
+
+// the type of a GNU build-id note
+const uint32_t NT_GNU_BUILD_ID = 3;
+
+// the size of the note header and the name "GNU"
+const size_t NoteHeaderSize = 16;
+
+// xxHash64 constants
+const uint64_t Prime1 = 0x9e3779b185ebca87ULL;
+const uint64_t Prime2 = 0xc2b2ae3d27d4eb4fULL;
+const uint64_t Prime3 = 0x165667b19e3779f9ULL;
+const uint64_t Prime4 = 0x85ebca77c2b2ae63ULL;
+const uint64_t Prime5 = 0x27d4eb2f165667c5ULL;
+
+inline uint64_t Rotl64(uint64_t pValue, unsigned int pBits)
+{
+  return (pValue << pBits) | (pValue >> (64 - pBits));
+}
+
+// read little-endian values, so the hash is the same on all hosts
+inline uint64_t ReadLE64(const uint8_t* pData)
+{
+  uint64_t result = 0;
+  for (int i = 7; i >= 0; --i)
+    result = (result << 8) | pData[i];
+  return result;
+}
+
+inline uint32_t ReadLE32(const uint8_t* pData)
+{
+  return uint32_t(pData[0]) | (uint32_t(pData[1]) << 8) |
+         (uint32_t(pData[2]) << 16) | (uint32_t(pData[3]) << 24);
+}
+
+inline void WriteLE64(uint8_t* pData, uint64_t pValue)
+{
+  for (unsigned int i = 0; i < 8; ++i)
+    pData[i] = static_cast<uint8_t>(pValue >> (i * 8));
+}
+
+/// WriteWord - write a 32-bit word of the note header in the target order
+inline void WriteWord(uint8_t* pData, uint32_t pValue, bool pIsLittleEndian)
+{
+  for (unsigned int i = 0; i < 4; ++i) {
+    unsigned int shift = pIsLittleEndian ? (i * 8) : ((3 - i) * 8);
+    pData[i] = static_cast<uint8_t>(pValue >> shift);
+  }
+}
+
+inline uint64_t XXH64Round(uint64_t pAcc, uint64_t pInput)
+{
+  pAcc += pInput * Prime2;
+  pAcc = Rotl64(pAcc, 31);
+  return pAcc * Prime1;
+}
+
+inline uint64_t XXH64Merge(uint64_t pAcc, uint64_t pValue)
+{
+  pAcc ^= XXH64Round(0, pValue);
+  return pAcc * Prime1 + Prime4;
+}
+
+/// XXH64 - the 64-bit xxHash of pData with seed 0
+uint64_t XXH64(const uint8_t* pData, size_t pSize)
+{
+  const uint8_t* p = pData;
+  const uint8_t* end = pData + pSize;
+  uint64_t hash;
+
+  if (pSize >= 32) {
+    uint64_t v1 = Prime1 + Prime2;
+    uint64_t v2 = Prime2;
+    uint64_t v3 = 0;
+    uint64_t v4 = 0 - Prime1;
+    for (; p + 32 <= end; p += 32) {
+      v1 = XXH64Round(v1, ReadLE64(p));
+      v2 = XXH64Round(v2, ReadLE64(p + 8));
+      v3 = XXH64Round(v3, ReadLE64(p + 16));
+      v4 = XXH64Round(v4, ReadLE64(p + 24));
+    }
+    hash = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+    hash = XXH64Merge(hash, v1);
+    hash = XXH64Merge(hash, v2);
+    hash = XXH64Merge(hash, v3);
+    hash = XXH64Merge(hash, v4);
+  }
+  else
+    hash = Prime5;
+
+  hash += pSize;
+  for (; p + 8 <= end; p += 8) {
+    hash ^= XXH64Round(0, ReadLE64(p));
+    hash = Rotl64(hash, 27) * Prime1 + Prime4;
+  }
+  if (p + 4 <= end) {
+    hash ^= uint64_t(ReadLE32(p)) * Prime1;
+    hash = Rotl64(hash, 23) * Prime2 + Prime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    hash ^= (*p) * Prime5;
+    hash = Rotl64(hash, 11) * Prime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= Prime2;
+  hash ^= hash >> 29;
+  hash *= Prime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/// DigestSize - the size of a digest of a hashing style
+size_t DigestSize(GeneralOptions::BuildIDStyle pStyle)
+{
+  switch (pStyle) {
+    case GeneralOptions::BuildID_Fast:
+      return 8;
+    case GeneralOptions::BuildID_SHA1:
+      return SHA1::DigestSize;
+    default:
+      assert(false && "not a hashing build-id style");
+      return 0;
+  }
+}
+
+/// Hash - write the digest of pData into pDigest
+void Hash(GeneralOptions::BuildIDStyle pStyle,
+          const uint8_t* pData,
+          size_t pSize,
+          uint8_t* pDigest)
+{
+  switch (pStyle) {
+    case GeneralOptions::BuildID_Fast:
+      WriteLE64(pDigest, XXH64(pData, pSize));
+      break;
+    case GeneralOptions::BuildID_SHA1: {
+      SHA1 sha1;
+      sha1.update(pData, pSize);
+      sha1.final(pDigest);
+      break;
+    }
+    default:
+      assert(false && "not a hashing build-id style");
+      break;
+  }
+}
+
+/** \class HashChunkTask
+ *  \brief HashChunkTask computes the digest of one chunk of the output file.
+ */
+class HashChunkTask : public ThreadPool::Task
+{
+public:
+  HashChunkTask(GeneralOptions::BuildIDStyle pStyle,
+                const uint8_t* pData,
+                size_t pSize,
+                uint8_t* pDigest)
+    : m_Style(pStyle), m_pData(pData), m_Size(pSize), m_pDigest(pDigest) {
+  }
+
+  void run()
+  {
+    Hash(m_Style, m_pData, m_Size, m_pDigest);
+  }
+
+private:
+  GeneralOptions::BuildIDStyle m_Style;
+  const uint8_t* m_pData;
+  size_t m_Size;
+  uint8_t* m_pDigest;
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// BuildID
+//===----------------------------------------------------------------------===//
+BuildID::BuildID(LDSection& pSection, const LinkerConfig& pConfig)
+  : m_Section(pSection), m_Config(pConfig) {
+}
+
+BuildID::~BuildID()
+{
+}
+
+size_t BuildID::descSize() const
+{
+  switch (m_Config.options().getBuildIDStyle()) {
+    case GeneralOptions::BuildID_Fast:
+    case GeneralOptions::BuildID_SHA1:
+      return DigestSize(m_Config.options().getBuildIDStyle());
+    case GeneralOptions::BuildID_UUID:
+      return 16;
+    case GeneralOptions::BuildID_Hex:
+      return m_Config.options().getBuildIDHex().size();
+    case GeneralOptions::BuildID_None:
+    default:
+      return 0;
+  }
+}
+
+void BuildID::sizeOutput()
+{
+  uint64_t size = NoteHeaderSize + descSize();
+  alignAddress(size, 4);
+  m_Section.setSize(size);
+}
+
+void BuildID::emitOutput(MemoryArea& pOutput, unsigned int pNumOfThreads)
+{
+  size_t file_size = pOutput.handler()->size();
+  MemoryRegion* region = pOutput.request(0, file_size);
+  emit(region->start(), file_size, pNumOfThreads);
+}
+
+void BuildID::emit(uint8_t* pFile, size_t pFileSize, unsigned int pNumOfThreads)
+{
+  uint8_t* note = pFile + m_Section.offset();
+
+  // write out the note header. The descriptor is zero while hashing.
+  bool is_little_endian = m_Config.targets().isLittleEndian();
+  WriteWord(note, 4, is_little_endian);
+  WriteWord(note + 4, descSize(), is_little_endian);
+  WriteWord(note + 8, NT_GNU_BUILD_ID, is_little_endian);
+  memcpy(note + 12, "GNU", 4);
+
+  uint8_t* desc = note + NoteHeaderSize;
+  memset(desc, 0, m_Section.size() - NoteHeaderSize);
+
+  switch (m_Config.options().getBuildIDStyle()) {
+    case GeneralOptions::BuildID_Fast:
+    case GeneralOptions::BuildID_SHA1:
+      computeDigest(pFile, pFileSize, pNumOfThreads, desc);
+      break;
+    case GeneralOptions::BuildID_UUID: {
+      for (unsigned int i = 0; i < 16; i += 4) {
+        unsigned int random = llvm::sys::Process::GetRandomNumber();
+        memcpy(desc + i, &random, 4);
+      }
+      // RFC 4122 version 4, variant 1
+      desc[6] = (desc[6] & 0x0f) | 0x40;
+      desc[8] = (desc[8] & 0x3f) | 0x80;
+      break;
+    }
+    case GeneralOptions::BuildID_Hex:
+      memcpy(desc, m_Config.options().getBuildIDHex().data(), descSize());
+      break;
+    case GeneralOptions::BuildID_None:
+    default:
+      break;
+  }
+}
+
+void BuildID::computeDigest(const uint8_t* pData,
+                            size_t pSize,
+                            unsigned int pNumOfThreads,
+                            uint8_t* pDigest) const
+{
+  GeneralOptions::BuildIDStyle style = m_Config.options().getBuildIDStyle();
+  size_t digest_size = DigestSize(style);
+  size_t num_chunks = (pSize + ChunkSize - 1) / ChunkSize;
+
+  // hash the chunks
+  std::vector<uint8_t> leaves(num_chunks * digest_size);
+  std::vector<HashChunkTask> tasks;
+  tasks.reserve(num_chunks);
+  for (size_t i = 0; i < num_chunks; ++i) {
+    size_t offset = i * ChunkSize;
+    size_t size = (pSize - offset < ChunkSize) ? (pSize - offset) : ChunkSize;
+    tasks.push_back(HashChunkTask(style, pData + offset, size,
+                                  &leaves[i * digest_size]));
+  }
+
+  ThreadPool::TaskList task_list;
+  std::vector<HashChunkTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(pNumOfThreads);
+  pool.run(task_list);
+
+  // hash the chunk digests
+  Hash(style, leaves.empty() ? NULL : &leaves[0], leaves.size(), pDigest);
+}
+
@@ -10,7 +10,9 @@
 
 #include <mcld/LinkerConfig.h>
 #include <mcld/IRBuilder.h>
+#include <mcld/LD/ELFDynSymTab.h>
 #include <mcld/LD/ELFReader.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/MC/Input.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Target/GNULDBackend.h>
@@ -31,7 +33,9 @@ ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
                                  const LinkerConfig& pConfig)
   : DynObjReader(),
     m_pELFReader(0),
-    m_Builder(pBuilder) {
+    m_Builder(pBuilder),
+    m_BitClass(pConfig.targets().bitclass()),
+    m_bLazy(pConfig.options().lazyDynObjSymbols()) {
   if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<32, true>(pBackend);
   else if (pConfig.targets().is64Bits() && pConfig.targets().isLittleEndian())
@@ -40,6 +44,7 @@ ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
 
 ELFDynObjReader::~ELFDynObjReader()
 {
+  finishLazyImport();
   delete m_pELFReader;
 }
 
@@ -116,6 +121,16 @@ bool ELFDynObjReader::readSymbols(Input& pInput)
     return false;
   }
 
+  if (m_bLazy) {
+    ELFDynSymTab* table = new ELFDynSymTab(pInput, m_BitClass);
+    if (table->open()) {
+      readLazySymbols(*table);
+      return true;
+    }
+    // no hash table to look up, read all symbols
+    delete table;
+  }
+
   MemoryRegion* symtab_region = pInput.memArea()->request(
               pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
 
@@ -130,3 +145,104 @@ bool ELFDynObjReader::readSymbols(Input& pInput)
   return result;
 }
 
+/// importSymbol
+void ELFDynObjReader::importSymbol(const ResolveInfo& pInfo)
+{
+  if (pInfo.isDyn() && !pInfo.isUndef())
+    return;
+
+  llvm::StringRef name(pInfo.name(), pInfo.nameSize());
+  DynSymTabList::iterator table, tableEnd = m_LazyDynObjs.end();
+  for (table = m_LazyDynObjs.begin(); table != tableEnd; ++table) {
+    size_t idx = (*table)->find(name);
+    if (0 != idx) {
+      importSymbol(**table, idx);
+      return;
+    }
+  }
+}
+
+/// finishLazyImport
+void ELFDynObjReader::finishLazyImport()
+{
+  DynSymTabList::iterator table, tableEnd = m_LazyDynObjs.end();
+  for (table = m_LazyDynObjs.begin(); table != tableEnd; ++table)
+    delete *table;
+  m_LazyDynObjs.clear();
+}
+
+/// readLazySymbols
+void ELFDynObjReader::readLazySymbols(ELFDynSymTab& pTable)
+{
+  // The undefined symbols are read at once, because they may pull in the
+  // members of the following archives.
+  for (size_t idx = 1; idx < pTable.numOfSymbols(); ++idx) {
+    if (!pTable.isUndef(idx))
+      continue;
+    pTable.setImported(idx);
+    m_pELFReader->readSymbol(pTable.input(), m_Builder, pTable.symtab(),
+                             pTable.strtab(), idx);
+  }
+
+  // Look up the symbols referred so far. Importing a symbol may insert its
+  // aliases into NamePool, so take the referred ones first.
+  std::vector<const ResolveInfo*> referred;
+  NamePool& pool = m_Builder.getModule().getNamePool();
+  NamePool::syminfo_iterator entry, entryEnd = pool.syminfo_end();
+  for (entry = pool.syminfo_begin(); entry != entryEnd; ++entry) {
+    const ResolveInfo* info = entry.getEntry();
+    if (!info->isSymbol() || info->isLocal() ||
+        (info->isDyn() && !info->isUndef()))
+      continue;
+    referred.push_back(info);
+  }
+
+  m_LazyDynObjs.push_back(&pTable);
+
+  std::vector<const ResolveInfo*>::iterator info, infoEnd = referred.end();
+  for (info = referred.begin(); info != infoEnd; ++info) {
+    llvm::StringRef name((*info)->name(), (*info)->nameSize());
+    size_t idx = pTable.find(name);
+    if (0 != idx)
+      importSymbol(pTable, idx);
+  }
+}
+
+/// importSymbol - a weak data object and its aliases are read together, so
+/// that Module links them as ELFReader does when it reads all symbols.
+void ELFDynObjReader::importSymbol(ELFDynSymTab& pTable, size_t pIdx)
+{
+  if (pTable.isImported(pIdx))
+    return;
+
+  std::vector<size_t> aliases;
+  pTable.getAliases(pIdx, aliases);
+  if (aliases.empty()) {
+    pTable.setImported(pIdx);
+    m_pELFReader->readSymbol(pTable.input(), m_Builder, pTable.symtab(),
+                             pTable.strtab(), pIdx);
+    return;
+  }
+
+  std::vector<LDSymbol*> symbols;
+  std::vector<size_t>::iterator alias, aliasEnd = aliases.end();
+  for (alias = aliases.begin(); alias != aliasEnd; ++alias) {
+    if (pTable.isImported(*alias))
+      continue;
+    pTable.setImported(*alias);
+    LDSymbol* sym = m_pELFReader->readSymbol(pTable.input(), m_Builder,
+                                             pTable.symtab(), pTable.strtab(),
+                                             *alias);
+    if (NULL != sym)
+      symbols.push_back(sym);
+  }
+
+  if (symbols.size() < 2)
+    return;
+
+  Module& module = m_Builder.getModule();
+  module.CreateAliasList(*symbols.front()->resolveInfo());
+  std::vector<LDSymbol*>::iterator sym, symEnd = symbols.end();
+  for (sym = symbols.begin() + 1; sym != symEnd; ++sym)
+    module.addAlias(*(*sym)->resolveInfo());
+}
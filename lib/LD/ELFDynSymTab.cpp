@@ -0,0 +1,335 @@
+//===- ELFDynSymTab.cpp ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/ELFDynSymTab.h>
+
+#include <mcld/ADT/SizeTraits.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Support/MemoryArea.h>
+#include <mcld/Support/MemoryRegion.h>
+
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/Host.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+/// GNUHash - the hash function of .gnu.hash
+static uint32_t GNUHash(const llvm::StringRef& pName)
+{
+  uint32_t hash_val = 5381;
+  for (size_t i = 0; i < pName.size(); ++i)
+    hash_val = (hash_val << 5) + hash_val + (unsigned char)pName[i];
+  return hash_val;
+}
+
+/// SysVHash - the hash function of .hash
+static uint32_t SysVHash(const llvm::StringRef& pName)
+{
+  uint32_t hash_val = 0;
+  for (size_t i = 0; i < pName.size(); ++i) {
+    hash_val = (hash_val << 4) + (unsigned char)pName[i];
+    uint32_t high = hash_val & 0xF0000000;
+    if (0x0 != high)
+      hash_val ^= (high >> 24);
+    hash_val &= ~high;
+  }
+  return hash_val;
+}
+
+//===----------------------------------------------------------------------===//
+// ELFDynSymTab::AliasLess
+//===----------------------------------------------------------------------===//
+/// AliasLess - sort the possible aliases by address and then weak before
+/// strong, as ELFReader does when it reads all symbols.
+struct ELFDynSymTab::AliasLess
+{
+  explicit AliasLess(const ELFDynSymTab& pTable) : table(pTable) { }
+
+  bool operator()(size_t pX, size_t pY) const {
+    Symbol x = table.getSymbol(pX);
+    Symbol y = table.getSymbol(pY);
+    if (x.value != y.value)
+      return (x.value < y.value);
+    bool x_weak = (llvm::ELF::STB_WEAK == (x.info >> 4));
+    bool y_weak = (llvm::ELF::STB_WEAK == (y.info >> 4));
+    if (x_weak != y_weak)
+      return x_weak;
+    return (std::strcmp(table.strtab() + x.name, table.strtab() + y.name) < 0);
+  }
+
+  const ELFDynSymTab& table;
+};
+
+//===----------------------------------------------------------------------===//
+// ELFDynSymTab
+//===----------------------------------------------------------------------===//
+ELFDynSymTab::ELFDynSymTab(Input& pInput, unsigned int pBitClass)
+  : m_Input(pInput), m_BitClass(pBitClass),
+    m_pSymTab(NULL), m_pStrTab(NULL), m_pHash(NULL),
+    m_bGNUHash(false), m_NumOfSymbols(0), m_bHasAliases(false) {
+}
+
+ELFDynSymTab::~ELFDynSymTab()
+{
+  close();
+}
+
+bool ELFDynSymTab::open()
+{
+  assert(m_Input.hasMemArea());
+
+  LDSection* symtab_shdr = m_Input.context()->getSection(".dynsym");
+  if (NULL == symtab_shdr || NULL == symtab_shdr->getLink())
+    return false;
+
+  LDSection* hash_shdr = m_Input.context()->getSection(".gnu.hash");
+  m_bGNUHash = (NULL != hash_shdr);
+  if (!m_bGNUHash)
+    hash_shdr = m_Input.context()->getSection(".hash");
+  if (NULL == hash_shdr || 0 == hash_shdr->size())
+    return false;
+
+  LDSection* strtab_shdr = symtab_shdr->getLink();
+  MemoryArea* area = m_Input.memArea();
+  m_pSymTab = area->request(m_Input.fileOffset() + symtab_shdr->offset(),
+                            symtab_shdr->size());
+  m_pStrTab = area->request(m_Input.fileOffset() + strtab_shdr->offset(),
+                            strtab_shdr->size());
+  m_pHash = area->request(m_Input.fileOffset() + hash_shdr->offset(),
+                          hash_shdr->size());
+
+  if (32 == m_BitClass)
+    m_NumOfSymbols = m_pSymTab->size() / sizeof(llvm::ELF::Elf32_Sym);
+  else
+    m_NumOfSymbols = m_pSymTab->size() / sizeof(llvm::ELF::Elf64_Sym);
+  m_Imported.assign(m_NumOfSymbols, false);
+  return true;
+}
+
+void ELFDynSymTab::close()
+{
+  if (NULL == m_pSymTab)
+    return;
+
+  m_Input.memArea()->release(m_pSymTab);
+  m_Input.memArea()->release(m_pStrTab);
+  m_Input.memArea()->release(m_pHash);
+  m_pSymTab = NULL;
+  m_pStrTab = NULL;
+  m_pHash = NULL;
+}
+
+const char* ELFDynSymTab::strtab() const
+{
+  return reinterpret_cast<const char*>(m_pStrTab->start());
+}
+
+size_t ELFDynSymTab::find(const llvm::StringRef& pName) const
+{
+  if (m_bGNUHash)
+    return findByGNUHash(pName);
+  return findBySysVHash(pName);
+}
+
+bool ELFDynSymTab::isUndef(size_t pIdx) const
+{
+  return (llvm::ELF::SHN_UNDEF == getSymbol(pIdx).shndx);
+}
+
+void ELFDynSymTab::getAliases(size_t pIdx, std::vector<size_t>& pAliases)
+{
+  Symbol sym = getSymbol(pIdx);
+  if (!isAlias(sym))
+    return;
+
+  if (!m_bHasAliases) {
+    for (size_t idx = 1; idx < m_NumOfSymbols; ++idx) {
+      if (isAlias(getSymbol(idx)))
+        m_Aliases.push_back(idx);
+    }
+    std::sort(m_Aliases.begin(), m_Aliases.end(), AliasLess(*this));
+    m_bHasAliases = true;
+  }
+
+  // find the symbols at the same address
+  std::vector<size_t>::iterator first, last;
+  first = std::lower_bound(m_Aliases.begin(), m_Aliases.end(), pIdx,
+                           AliasLess(*this));
+  while (first != m_Aliases.begin() &&
+         sym.value == getSymbol(*(first - 1)).value)
+    --first;
+  last = first;
+  while (last != m_Aliases.end() && sym.value == getSymbol(*last).value)
+    ++last;
+
+  // weak symbols go first, so there is a weak one if the first is weak
+  if (last - first < 2 ||
+      llvm::ELF::STB_WEAK != (getSymbol(*first).info >> 4))
+    return;
+  pAliases.insert(pAliases.end(), first, last);
+}
+
+ELFDynSymTab::Symbol ELFDynSymTab::getSymbol(size_t pIdx) const
+{
+  assert(pIdx < m_NumOfSymbols);
+  Symbol result;
+  if (32 == m_BitClass) {
+    const llvm::ELF::Elf32_Sym* sym =
+      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(m_pSymTab->start()) + pIdx;
+    result.info  = sym->st_info;
+    result.other = sym->st_other;
+    if (llvm::sys::IsLittleEndianHost) {
+      result.name  = sym->st_name;
+      result.value = sym->st_value;
+      result.shndx = sym->st_shndx;
+    }
+    else {
+      result.name  = mcld::bswap32(sym->st_name);
+      result.value = mcld::bswap32(sym->st_value);
+      result.shndx = mcld::bswap16(sym->st_shndx);
+    }
+  }
+  else {
+    const llvm::ELF::Elf64_Sym* sym =
+      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(m_pSymTab->start()) + pIdx;
+    result.info  = sym->st_info;
+    result.other = sym->st_other;
+    if (llvm::sys::IsLittleEndianHost) {
+      result.name  = sym->st_name;
+      result.value = sym->st_value;
+      result.shndx = sym->st_shndx;
+    }
+    else {
+      result.name  = mcld::bswap32(sym->st_name);
+      result.value = mcld::bswap64(sym->st_value);
+      result.shndx = mcld::bswap16(sym->st_shndx);
+    }
+  }
+  return result;
+}
+
+/// getWord - the 32-bit word at pIdx of a hash table. Return 0 out of range.
+uint32_t ELFDynSymTab::getWord(const MemoryRegion& pRegion, size_t pIdx) const
+{
+  if ((pIdx + 1) * 4 > pRegion.size())
+    return 0x0;
+  uint32_t word;
+  std::memcpy(&word, pRegion.start() + pIdx * 4, 4);
+  if (llvm::sys::IsLittleEndianHost)
+    return word;
+  return mcld::bswap32(word);
+}
+
+bool ELFDynSymTab::isVisibleDefine(size_t pIdx,
+                                   const llvm::StringRef& pName) const
+{
+  Symbol sym = getSymbol(pIdx);
+  if (llvm::ELF::SHN_UNDEF == sym.shndx ||
+      llvm::ELF::STB_LOCAL == (sym.info >> 4) ||
+      llvm::ELF::STT_SECTION == (sym.info & 0xF))
+    return false;
+
+  uint8_t vis = sym.other & 0x3;
+  if (llvm::ELF::STV_INTERNAL == vis || llvm::ELF::STV_HIDDEN == vis)
+    return false;
+
+  if (sym.name >= m_pStrTab->size())
+    return false;
+  const char* name = strtab() + sym.name;
+  return (0 == std::strncmp(name, pName.data(), pName.size()) &&
+          '\0' == name[pName.size()]);
+}
+
+bool ELFDynSymTab::isAlias(const Symbol& pSym) const
+{
+  if (llvm::ELF::STT_OBJECT != (pSym.info & 0xF) ||
+      llvm::ELF::SHN_UNDEF == pSym.shndx)
+    return false;
+
+  // ELFReader takes the global absolute symbols as Absolute, not Global
+  uint8_t bind = pSym.info >> 4;
+  if (llvm::ELF::STB_WEAK != bind &&
+      (llvm::ELF::STB_GLOBAL != bind || llvm::ELF::SHN_ABS == pSym.shndx))
+    return false;
+
+  uint8_t vis = pSym.other & 0x3;
+  return (llvm::ELF::STV_INTERNAL != vis && llvm::ELF::STV_HIDDEN != vis);
+}
+
+/// findByGNUHash - .gnu.hash has a bloom filter, the buckets and a chain of
+/// hash values for each symbol. The symbols in a bucket are contiguous, in the
+/// order of their index.
+size_t ELFDynSymTab::findByGNUHash(const llvm::StringRef& pName) const
+{
+  const MemoryRegion& table = *m_pHash;
+  uint32_t num_buckets = getWord(table, 0);
+  uint32_t sym_offset  = getWord(table, 1);
+  uint32_t bloom_size  = getWord(table, 2);
+  uint32_t bloom_shift = getWord(table, 3);
+  if (0 == num_buckets)
+    return 0;
+
+  uint32_t hash_val = GNUHash(pName);
+
+  // the bloom filter is made of words of the bit class
+  size_t bloom_words = m_BitClass / 32;
+  if (0 != bloom_size) {
+    size_t bloom_idx = (hash_val / m_BitClass) % bloom_size;
+    uint64_t word = getWord(table, 4 + bloom_idx * bloom_words);
+    if (64 == m_BitClass)
+      word |= (uint64_t)getWord(table, 5 + bloom_idx * bloom_words) << 32;
+    uint64_t mask = ((uint64_t)1 << (hash_val % m_BitClass)) |
+                    ((uint64_t)1 << ((hash_val >> bloom_shift) % m_BitClass));
+    if (mask != (word & mask))
+      return 0;
+  }
+
+  size_t buckets = 4 + bloom_size * bloom_words;
+  size_t chains = buckets + num_buckets;
+  for (size_t idx = getWord(table, buckets + hash_val % num_buckets);
+       idx >= sym_offset && 0 != idx && idx < m_NumOfSymbols; ++idx) {
+    uint32_t chain_val = getWord(table, chains + idx - sym_offset);
+    if ((hash_val | 0x1) == (chain_val | 0x1) && isVisibleDefine(idx, pName))
+      return idx;
+    // the last symbol in the bucket
+    if (0x1 == (chain_val & 0x1))
+      break;
+  }
+  return 0;
+}
+
+/// findBySysVHash - .hash has the buckets and a chain of symbol indices for
+/// each symbol. The symbols in a bucket are not ordered.
+size_t ELFDynSymTab::findBySysVHash(const llvm::StringRef& pName) const
+{
+  const MemoryRegion& table = *m_pHash;
+  uint32_t num_buckets = getWord(table, 0);
+  uint32_t num_chains  = getWord(table, 1);
+  if (0 == num_buckets)
+    return 0;
+
+  size_t result = 0;
+  size_t idx = getWord(table, 2 + SysVHash(pName) % num_buckets);
+  for (size_t step = 0; 0 != idx && idx < m_NumOfSymbols && step < num_chains;
+       ++step) {
+    if ((0 == result || idx < result) && isVisibleDefine(idx, pName))
+      result = idx;
+    idx = getWord(table, 2 + num_buckets + idx);
+  }
+  return result;
+}
+
@@ -53,6 +53,11 @@ void ELFExecFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                            llvm::ELF::SHT_RELA,
                                            llvm::ELF::SHF_ALLOC,
                                            pBitClass / 8);
+  f_pRelrDyn      = pBuilder.CreateSection(".relr.dyn",
+                                           LDFileFormat::Relocation,
+                                           SHT_RELR,
+                                           llvm::ELF::SHF_ALLOC,
+                                           pBitClass / 8);
   f_pRelDyn       = pBuilder.CreateSection(".rel.dyn",
                                            LDFileFormat::Relocation,
                                            llvm::ELF::SHT_REL,
@@ -88,4 +93,9 @@ void ELFExecFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                            llvm::ELF::SHT_GNU_HASH,
                                            llvm::ELF::SHF_ALLOC,
                                            pBitClass / 8);
+  f_pNoteGNUBuildID = pBuilder.CreateSection(".note.gnu.build-id",
+                                             LDFileFormat::Note,
+                                             llvm::ELF::SHT_NOTE,
+                                             llvm::ELF::SHF_ALLOC,
+                                             0x4);
 }
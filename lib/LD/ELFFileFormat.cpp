@@ -22,6 +22,7 @@ ELFFileFormat::ELFFileFormat()
     f_pRelPlt(NULL),
     f_pRelaDyn(NULL),
     f_pRelaPlt(NULL),
+    f_pRelrDyn(NULL),
     f_pComment(NULL),
     f_pData1(NULL),
     f_pDebug(NULL),
@@ -55,6 +56,7 @@ ELFFileFormat::ELFFileFormat()
     f_pGOTPLT(NULL),
     f_pJCR(NULL),
     f_pNoteABITag(NULL),
+    f_pNoteGNUBuildID(NULL),
     f_pStab(NULL),
     f_pStabStr(NULL),
     f_pStack(NULL),
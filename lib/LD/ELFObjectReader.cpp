@@ -20,6 +20,7 @@
 #include <mcld/LD/EhFrameReader.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/Target/GNULDBackend.h>
+#include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/Object/ObjectBuilder.h>
 
@@ -203,6 +204,10 @@ bool ELFObjectReader::readSections(Input& pInput)
       case LDFileFormat::Regular:
       case LDFileFormat::Note:
       case LDFileFormat::MetaData: {
+        // already read by readRegularSections
+        if ((*section)->hasSectionData())
+          break;
+
         SectionData* sd = IRBuilder::CreateSectionData(**section);
         if (!m_pELFReader->readRegularSection(pInput, *sd))
           fatal(diag::err_cannot_read_section) << (*section)->name();
@@ -212,7 +217,7 @@ bool ELFObjectReader::readSections(Input& pInput)
         if (m_Config.options().stripDebug()) {
           (*section)->setKind(LDFileFormat::Ignore);
         }
-        else {
+        else if (!(*section)->hasSectionData()) {
           SectionData* sd = IRBuilder::CreateSectionData(**section);
           if (!m_pELFReader->readRegularSection(pInput, *sd)) {
             fatal(diag::err_cannot_read_section) << (*section)->name();
@@ -251,7 +256,8 @@ bool ELFObjectReader::readSections(Input& pInput)
       }
       /** BSS sections **/
       case LDFileFormat::BSS: {
-        IRBuilder::CreateBSS(**section);
+        if (!(*section)->hasSectionData())
+          IRBuilder::CreateBSS(**section);
         break;
       }
       // ignore
@@ -274,6 +280,55 @@ bool ELFObjectReader::readSections(Input& pInput)
   return true;
 }
 
+/// readRegularSections - read the regular, note, debug and BSS sections.
+/// Group members, link-once, .eh_frame and target-dependent sections are
+/// left to readSections, because whether and how to read them depends on
+/// the inputs read before.
+bool ELFObjectReader::readRegularSections(Input& pInput)
+{
+  LDContext::sect_iterator section, sectEnd = pInput.context()->sectEnd();
+  for (section = pInput.context()->sectBegin(); section != sectEnd; ++section) {
+    if (NULL == *section)
+      continue;
+
+    // the group may be discarded by a group with the same signature.
+    if (0x0 != ((*section)->flag() & llvm::ELF::SHF_GROUP))
+      continue;
+
+    switch((*section)->kind()) {
+      case LDFileFormat::Version:
+      case LDFileFormat::GCCExceptTable:
+      case LDFileFormat::Regular:
+      case LDFileFormat::Note:
+      case LDFileFormat::MetaData: {
+        SectionData* sd = IRBuilder::CreateSectionData(**section);
+        if (!m_pELFReader->readRegularSection(pInput, *sd))
+          fatal(diag::err_cannot_read_section) << (*section)->name();
+        break;
+      }
+      case LDFileFormat::Debug: {
+        if (m_Config.options().stripDebug()) {
+          (*section)->setKind(LDFileFormat::Ignore);
+        }
+        else {
+          SectionData* sd = IRBuilder::CreateSectionData(**section);
+          if (!m_pELFReader->readRegularSection(pInput, *sd))
+            fatal(diag::err_cannot_read_section) << (*section)->name();
+        }
+        break;
+      }
+      case LDFileFormat::BSS: {
+        IRBuilder::CreateBSS(**section);
+        break;
+      }
+      default:
+        continue;
+    }
+  } // end of for all sections
+
+  return true;
+}
+
 /// readSymbols - read symbols from the input relocatable object.
 bool ELFObjectReader::readSymbols(Input& pInput)
 {
@@ -295,6 +350,12 @@ bool ELFObjectReader::readSymbols(Input& pInput)
     return false;
   }
 
+  // the symbols are read once in order, and the names as they are referred
+  pInput.memArea()->advise(pInput.fileOffset() + symtab_shdr->offset(),
+                           symtab_shdr->size(), FileHandle::Sequential);
+  pInput.memArea()->advise(pInput.fileOffset() + strtab_shdr->offset(),
+                           strtab_shdr->size(), FileHandle::WillNeed);
+
   MemoryRegion* symtab_region = pInput.memArea()->request(
              pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   MemoryRegion* strtab_region = pInput.memArea()->request(
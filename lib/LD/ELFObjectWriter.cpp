@@ -15,6 +15,8 @@
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/ThreadPool.h>
+#include <mcld/Support/raw_ostream.h>
 #include <mcld/ADT/SizeTraits.h>
 #include <mcld/Fragment/AlignFragment.h>
 #include <mcld/Fragment/FillFragment.h>
@@ -29,17 +31,199 @@
 #include <mcld/LD/RelocData.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/LD/ELFFileFormat.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/Target/GNUInfo.h>
 
 #include <llvm/Support/ErrorHandling.h>
 #include <llvm/Support/system_error.h>
 #include <llvm/Support/ELF.h>
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Timer.h>
+
+#include <map>
 
 using namespace llvm;
 using namespace llvm::ELF;
 using namespace mcld;
 
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+/// EmitFragments - write out the fragments [pBegin, pEnd) into pRegion. The
+/// first fragment is at pOffset of pRegion.
+static void EmitFragments(SectionData::const_iterator pBegin,
+                          SectionData::const_iterator pEnd,
+                          size_t pOffset,
+                          MemoryRegion& pRegion)
+{
+  SectionData::const_iterator fragIter;
+  size_t cur_offset = pOffset;
+  for (fragIter = pBegin; fragIter != pEnd; ++fragIter) {
+    size_t size = fragIter->size();
+    switch(fragIter->getKind()) {
+      case Fragment::Region: {
+        const RegionFragment& region_frag = llvm::cast<RegionFragment>(*fragIter);
+        const uint8_t* from = region_frag.getRegion().start();
+        memcpy(pRegion.getBuffer(cur_offset), from, size);
+        break;
+      }
+      case Fragment::Alignment: {
+        // TODO: emit values with different sizes (> 1 byte), and emit nops
+        const AlignFragment& align_frag = llvm::cast<AlignFragment>(*fragIter);
+        uint64_t count = size / align_frag.getValueSize();
+        switch (align_frag.getValueSize()) {
+          case 1u:
+            std::memset(pRegion.getBuffer(cur_offset),
+                        align_frag.getValue(),
+                        count);
+            break;
+          default:
+            llvm::report_fatal_error("unsupported value size for align fragment emission yet.\n");
+            break;
+        }
+        break;
+      }
+      case Fragment::Fillment: {
+        const FillFragment& fill_frag = llvm::cast<FillFragment>(*fragIter);
+        if (0 == size ||
+            0 == fill_frag.getValueSize() ||
+            0 == fill_frag.size()) {
+          // ignore virtual fillment
+          break;
+        }
+
+        uint64_t num_tiles = fill_frag.size() / fill_frag.getValueSize();
+        for (uint64_t i = 0; i != num_tiles; ++i) {
+          std::memset(pRegion.getBuffer(cur_offset),
+                      fill_frag.getValue(),
+                      fill_frag.getValueSize());
+        }
+        break;
+      }
+      case Fragment::Stub: {
+        const Stub& stub_frag = llvm::cast<Stub>(*fragIter);
+        memcpy(pRegion.getBuffer(cur_offset), stub_frag.getContent(), size);
+        break;
+      }
+      case Fragment::Null: {
+        assert(0x0 == size);
+        break;
+      }
+      case Fragment::Target:
+        llvm::report_fatal_error("Target fragment should not be in a regular section.\n");
+        break;
+      default:
+        llvm::report_fatal_error("invalid fragment should not be in a regular section.\n");
+        break;
+    }
+    cur_offset += size;
+  }
+}
+
+/// GetSectionData - the fragments of pSection, or NULL if pSection is not
+/// written out fragment by fragment.
+static const SectionData* GetSectionData(const LDSection& pSection)
+{
+  switch (pSection.kind()) {
+  case LDFileFormat::Regular:
+  case LDFileFormat::Debug:
+  case LDFileFormat::Note:
+  case LDFileFormat::GCCExceptTable:
+    return pSection.getSectionData();
+  case LDFileFormat::EhFrame:
+    return pSection.getEhFrame()->getSectionData();
+  default:
+    return NULL;
+  }
+}
+
+static inline double GetWallTime()
+{
+  return llvm::TimeRecord::getCurrentTime().getWallTime();
+}
+
+//===----------------------------------------------------------------------===//
+// ELFObjectWriter::WriteTask
+//===----------------------------------------------------------------------===//
+/** \class ELFObjectWriter::WriteTask
+ *  \brief WriteTask writes a list of jobs in order. A job is either a whole
+ *  output section, or a run of fragments of a large section.
+ */
+class ELFObjectWriter::WriteTask : public ThreadPool::Task
+{
+public:
+  /// a section larger than ChunkSize is split into runs of fragments
+  static const size_t ChunkSize = 4 * 1024 * 1024;
+
+  struct Job
+  {
+    LDSection* section;
+    MemoryRegion* region;
+    bool whole;
+    SectionData::const_iterator begin;
+    SectionData::const_iterator end;
+    size_t offset;
+    double time; // wall time in seconds
+  };
+
+  typedef std::vector<Job> JobList;
+  typedef JobList::const_iterator const_iterator;
+
+public:
+  explicit WriteTask(ELFObjectWriter& pWriter)
+    : m_pWriter(&pWriter) {
+  }
+
+  void addSection(LDSection& pSection, MemoryRegion& pRegion)
+  {
+    Job job;
+    job.section = &pSection;
+    job.region = &pRegion;
+    job.whole = true;
+    job.offset = 0;
+    job.time = 0.0;
+    m_Jobs.push_back(job);
+  }
+
+  void addFragments(LDSection& pSection,
+                    MemoryRegion& pRegion,
+                    SectionData::const_iterator pBegin,
+                    SectionData::const_iterator pEnd,
+                    size_t pOffset)
+  {
+    Job job;
+    job.section = &pSection;
+    job.region = &pRegion;
+    job.whole = false;
+    job.begin = pBegin;
+    job.end = pEnd;
+    job.offset = pOffset;
+    job.time = 0.0;
+    m_Jobs.push_back(job);
+  }
+
+  const_iterator begin() const { return m_Jobs.begin(); }
+  const_iterator end  () const { return m_Jobs.end();   }
+
+  void run()
+  {
+    JobList::iterator job, jobEnd = m_Jobs.end();
+    for (job = m_Jobs.begin(); job != jobEnd; ++job) {
+      double start = GetWallTime();
+      if (job->whole)
+        m_pWriter->writeSection(*job->section, *job->region);
+      else
+        EmitFragments(job->begin, job->end, job->offset, *job->region);
+      job->time = GetWallTime() - start;
+    }
+  }
+
+private:
+  ELFObjectWriter* m_pWriter;
+  JobList m_Jobs;
+};
+
 //===----------------------------------------------------------------------===//
 // ELFObjectWriter
 //===----------------------------------------------------------------------===//
@@ -53,14 +237,14 @@ ELFObjectWriter::~ELFObjectWriter()
 {
 }
 
-void ELFObjectWriter::writeSection(MemoryArea& pOutput, LDSection *section)
+MemoryRegion*
+ELFObjectWriter::requestRegion(MemoryArea& pOutput, LDSection& pSection)
 {
-  MemoryRegion* region;
-  // Request output region
-  switch (section->kind()) {
+  MemoryRegion* region = NULL;
+  switch (pSection.kind()) {
   case LDFileFormat::Note:
-    if (section->getSectionData() == NULL)
-      return;
+    if (pSection.getSectionData() == NULL)
+      return NULL;
     // Fall through
   case LDFileFormat::Regular:
   case LDFileFormat::Relocation:
@@ -68,10 +252,10 @@ void ELFObjectWriter::writeSection(MemoryArea& pOutput, LDSection *section)
   case LDFileFormat::Debug:
   case LDFileFormat::GCCExceptTable:
   case LDFileFormat::EhFrame: {
-    region = pOutput.request(section->offset(), section->size());
+    region = pOutput.request(pSection.offset(), pSection.size());
     if (NULL == region) {
       llvm::report_fatal_error(llvm::Twine("cannot get enough memory region for output section `") +
-                               llvm::Twine(section->name()) +
+                               llvm::Twine(pSection.name()) +
                                llvm::Twine("'.\n"));
     }
     break;
@@ -84,41 +268,144 @@ void ELFObjectWriter::writeSection(MemoryArea& pOutput, LDSection *section)
   case LDFileFormat::EhFrameHdr:
   case LDFileFormat::StackNote:
     // Ignore these sections
-    return;
+    return NULL;
   default:
     llvm::errs() << "WARNING: unsupported section kind: "
-                 << section->kind()
+                 << pSection.kind()
                  << " of section "
-                 << section->name()
+                 << pSection.name()
                  << ".\n";
-    return;
+    return NULL;
   }
+  return region;
+}
 
+void ELFObjectWriter::writeSection(LDSection& pSection, MemoryRegion& pRegion)
+{
   // Write out sections with data
-  switch(section->kind()) {
-  case LDFileFormat::GCCExceptTable:
+  switch(pSection.kind()) {
   case LDFileFormat::EhFrame:
+    emitSectionData(pSection, pRegion);
+    if (pSection.hasEhFrame())
+      pSection.getEhFrame()->emitCIEPointers(pRegion);
+    break;
+  case LDFileFormat::GCCExceptTable:
   case LDFileFormat::Regular:
   case LDFileFormat::Debug:
   case LDFileFormat::Note:
     // FIXME: if optimization of exception handling sections is enabled,
     // then we should emit these sections by the other way.
-    emitSectionData(*section, *region);
+    emitSectionData(pSection, pRegion);
     break;
   case LDFileFormat::Relocation:
+    // .relr.dyn is a list of places, not relocation entries
+    if (ELFFileFormat::SHT_RELR == pSection.type()) {
+      target().emitRelrDyn(pRegion);
+      break;
+    }
+
     // sort relocation for the benefit of the dynamic linker.
-    target().sortRelocation(*section);
+    target().sortRelocation(pSection);
 
-    emitRelocation(m_Config, *section, *region);
+    emitRelocation(m_Config, pSection, pRegion);
     break;
   case LDFileFormat::Target:
-    target().emitSectionData(*section, *region);
+    target().emitSectionData(pSection, pRegion);
     break;
   default:
     llvm_unreachable("invalid section kind");
   }
 }
 
+void ELFObjectWriter::writeSections(const SectionList& pSections,
+                                    MemoryArea& pOutput)
+{
+  // A backend may update its states when emitting its own sections (e.g., the
+  // PLT entries of x86), so all target-dependent sections go to one task and
+  // are written in order. The task is the first one to let it start early.
+  std::vector<WriteTask> tasks;
+  tasks.push_back(WriteTask(*this));
+
+  SectionList::const_iterator sect, sectEnd = pSections.end();
+  for (sect = pSections.begin(); sect != sectEnd; ++sect) {
+    MemoryRegion* region = requestRegion(pOutput, **sect);
+    if (NULL == region)
+      continue;
+
+    if (LDFileFormat::Target == (*sect)->kind()) {
+      tasks.front().addSection(**sect, *region);
+      continue;
+    }
+
+    // The CIE pointers of .eh_frame are written after its fragments, so it
+    // is not split.
+    const SectionData* sd = GetSectionData(**sect);
+    if (NULL == sd || (*sect)->size() <= WriteTask::ChunkSize ||
+        LDFileFormat::EhFrame == (*sect)->kind()) {
+      tasks.push_back(WriteTask(*this));
+      tasks.back().addSection(**sect, *region);
+      continue;
+    }
+
+    // Split a large section (e.g., .debug_info) into runs of fragments, so
+    // that one section does not keep the other threads waiting.
+    SectionData::const_iterator frag, fragEnd = sd->end();
+    SectionData::const_iterator begin = sd->begin();
+    size_t begin_offset = 0, cur_offset = 0;
+    for (frag = sd->begin(); frag != fragEnd; ++frag) {
+      cur_offset += frag->size();
+      if (cur_offset - begin_offset < WriteTask::ChunkSize)
+        continue;
+
+      SectionData::const_iterator next = frag;
+      ++next;
+      tasks.push_back(WriteTask(*this));
+      tasks.back().addFragments(**sect, *region, begin, next, begin_offset);
+      begin = next;
+      begin_offset = cur_offset;
+    }
+    if (begin != fragEnd) {
+      tasks.push_back(WriteTask(*this));
+      tasks.back().addFragments(**sect, *region, begin, fragEnd, begin_offset);
+    }
+  }
+
+  ThreadPool::TaskList task_list;
+  std::vector<WriteTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  double start = GetWallTime();
+  ThreadPool pool(m_Config.options().numOfThreads());
+  pool.run(task_list);
+  double elapsed = GetWallTime() - start;
+
+  if (!m_Config.options().printStats())
+    return;
+
+  // Sum up the time of the jobs per section, and report in section order.
+  std::map<const LDSection*, double> sect_times;
+  for (task = tasks.begin(); task != taskEnd; ++task) {
+    WriteTask::const_iterator job, jobEnd = task->end();
+    for (job = task->begin(); job != jobEnd; ++job)
+      sect_times[job->section] += job->time;
+  }
+
+  mcld::outs() << "Output section write time ("
+               << pool.numOfThreads() << " threads, "
+               << llvm::format("%.3f", elapsed * 1000.0) << " ms):\n";
+  for (sect = pSections.begin(); sect != sectEnd; ++sect) {
+    std::map<const LDSection*, double>::iterator entry =
+      sect_times.find(*sect);
+    if (sect_times.end() == entry)
+      continue;
+    mcld::outs() << llvm::format("  %-24s %12llu bytes %10.3f ms\n",
+                                 (*sect)->name().c_str(),
+                                 (unsigned long long)(*sect)->size(),
+                                 entry->second * 1000.0);
+  }
+}
+
 llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
                                               MemoryArea& pOutput)
 {
@@ -133,6 +420,9 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
     // Allow backend to sort symbols before emitting
     target().orderSymbolTable(pModule);
 
+    // Pack the relative relocations before .dynamic counts them
+    target().packRelocations();
+
     // Write out the interpreter section: .interp
     target().emitInterp(pOutput);
 
@@ -149,20 +439,18 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
     // Iterate over the loadable segments and write the corresponding sections
     ELFSegmentFactory::iterator seg, segEnd = target().elfSegmentTable().end();
 
+    SectionList sections;
     for (seg = target().elfSegmentTable().begin(); seg != segEnd; ++seg) {
-      if (llvm::ELF::PT_LOAD == (*seg)->type()) {
-        ELFSegment::iterator sect, sectEnd = (*seg)->end();
-        for (sect = (*seg)->begin(); sect != sectEnd; ++sect)
-          writeSection(pOutput, *sect);
-      }
+      if (llvm::ELF::PT_LOAD == (*seg)->type())
+        sections.insert(sections.end(), (*seg)->begin(), (*seg)->end());
     }
+    writeSections(sections, pOutput);
   } else {
     // Write out regular ELF sections
-    Module::iterator sect, sectEnd = pModule.end();
-    for (sect = pModule.begin(); sect != sectEnd; ++sect)
-      writeSection(pOutput, *sect);
+    SectionList sections(pModule.begin(), pModule.end());
+    writeSections(sections, pOutput);
 
-    emitShStrTab(target().getOutputFormat()->getShStrTab(), pModule, pOutput);
+    emitShStrTab(target().getOutputFormat()->getShStrTab(), pOutput);
 
     if (m_Config.targets().is32Bits()) {
       // Write out ELF header
@@ -251,11 +539,7 @@ void ELFObjectWriter::writeELFHeader(const LinkerConfig& pConfig,
 uint64_t ELFObjectWriter::getEntryPoint(const LinkerConfig& pConfig,
                                         const Module& pModule) const
 {
-  llvm::StringRef entry_name;
-  if (pModule.getScript().hasEntry())
-    entry_name = pModule.getScript().entry();
-  else
-    entry_name = target().getInfo().entry();
+  llvm::StringRef entry_name = target().getEntry(pModule);
 
   uint64_t result = 0x0;
 
@@ -308,11 +592,11 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
   ElfXX_Shdr* shdr = (ElfXX_Shdr*)region->start();
 
   // Iterate the SectionTable in LDContext
+  const StringTableBuilder& shstrtab = target().shStrTabBuilder();
   unsigned int sectIdx = 0;
-  unsigned int shstridx = 0; // NULL section has empty name
   for (; sectIdx < sectNum; ++sectIdx) {
     const LDSection *ld_sect   = pModule.getSectionTable().at(sectIdx);
-    shdr[sectIdx].sh_name      = shstridx;
+    shdr[sectIdx].sh_name      = shstrtab.getOffset(ld_sect->name());
     shdr[sectIdx].sh_type      = ld_sect->type();
     shdr[sectIdx].sh_flags     = ld_sect->flag();
     shdr[sectIdx].sh_addr      = ld_sect->addr();
@@ -322,9 +606,6 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
     shdr[sectIdx].sh_entsize   = getSectEntrySize<SIZE>(*ld_sect);
     shdr[sectIdx].sh_link      = getSectLink(*ld_sect, pConfig);
     shdr[sectIdx].sh_info      = getSectInfo(*ld_sect);
-
-    // adjust strshidx
-    shstridx += ld_sect->name().size() + 1;
   }
 }
 
@@ -365,18 +646,11 @@ void ELFObjectWriter::emitProgramHeader(MemoryArea& pOutput) const
 /// emitShStrTab - emit section string table
 void
 ELFObjectWriter::emitShStrTab(const LDSection& pShStrTab,
-                              const Module& pModule,
                               MemoryArea& pOutput)
 {
   // write out data
   MemoryRegion* region = pOutput.request(pShStrTab.offset(), pShStrTab.size());
-  unsigned char* data = region->start();
-  size_t shstrsize = 0;
-  Module::const_iterator section, sectEnd = pModule.end();
-  for (section = pModule.begin(); section != sectEnd; ++section) {
-    strcpy((char*)(data + shstrsize), (*section)->name().data());
-    shstrsize += (*section)->name().size() + 1;
-  }
+  target().shStrTabBuilder().emit((char*)region->start());
 }
 
 /// emitSectionData
@@ -537,6 +811,8 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const
     return sizeof(ElfXX_Rel);
   if (llvm::ELF::SHT_RELA == pSection.type())
     return sizeof(ElfXX_Rela);
+  if (ELFFileFormat::SHT_RELR == pSection.type())
+    return SIZE / 8;
   if (llvm::ELF::SHT_HASH     == pSection.type() ||
       llvm::ELF::SHT_GNU_HASH == pSection.type())
     return sizeof(ElfXX_Word);
@@ -610,67 +886,6 @@ uint64_t ELFObjectWriter::getLastStartOffset<64>(const Module& pModule) const
 void ELFObjectWriter::emitSectionData(const SectionData& pSD,
                                       MemoryRegion& pRegion) const
 {
-  SectionData::const_iterator fragIter, fragEnd = pSD.end();
-  size_t cur_offset = 0;
-  for (fragIter = pSD.begin(); fragIter != fragEnd; ++fragIter) {
-    size_t size = fragIter->size();
-    switch(fragIter->getKind()) {
-      case Fragment::Region: {
-        const RegionFragment& region_frag = llvm::cast<RegionFragment>(*fragIter);
-        const uint8_t* from = region_frag.getRegion().start();
-        memcpy(pRegion.getBuffer(cur_offset), from, size);
-        break;
-      }
-      case Fragment::Alignment: {
-        // TODO: emit values with different sizes (> 1 byte), and emit nops
-        const AlignFragment& align_frag = llvm::cast<AlignFragment>(*fragIter);
-        uint64_t count = size / align_frag.getValueSize();
-        switch (align_frag.getValueSize()) {
-          case 1u:
-            std::memset(pRegion.getBuffer(cur_offset),
-                        align_frag.getValue(),
-                        count);
-            break;
-          default:
-            llvm::report_fatal_error("unsupported value size for align fragment emission yet.\n");
-            break;
-        }
-        break;
-      }
-      case Fragment::Fillment: {
-        const FillFragment& fill_frag = llvm::cast<FillFragment>(*fragIter);
-        if (0 == size ||
-            0 == fill_frag.getValueSize() ||
-            0 == fill_frag.size()) {
-          // ignore virtual fillment
-          break;
-        }
-
-        uint64_t num_tiles = fill_frag.size() / fill_frag.getValueSize();
-        for (uint64_t i = 0; i != num_tiles; ++i) {
-          std::memset(pRegion.getBuffer(cur_offset),
-                      fill_frag.getValue(),
-                      fill_frag.getValueSize());
-        }
-        break;
-      }
-      case Fragment::Stub: {
-        const Stub& stub_frag = llvm::cast<Stub>(*fragIter);
-        memcpy(pRegion.getBuffer(cur_offset), stub_frag.getContent(), size);
-        break;
-      }
-      case Fragment::Null: {
-        assert(0x0 == size);
-        break;
-      }
-      case Fragment::Target:
-        llvm::report_fatal_error("Target fragment should not be in a regular section.\n");
-        break;
-      default:
-        llvm::report_fatal_error("invalid fragment should not be in a regular section.\n");
-        break;
-    }
-    cur_offset += size;
-  }
+  EmitFragments(pSD.begin(), pSD.end(), 0, pRegion);
 }
 
@@ -11,9 +11,11 @@
 #include <mcld/IRBuilder.h>
 #include <mcld/Fragment/FillFragment.h>
 #include <mcld/LD/EhFrame.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/Target/GNULDBackend.h>
 #include <mcld/Target/GNUInfo.h>
+#include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/Object/ObjectBuilder.h>
@@ -134,20 +136,24 @@ bool ELFReader<32, true>::readSymbols(Input& pInput,
     if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
       section = pInput.context()->getSection(st_shndx);
 
-    // get ld_name
-    std::string ld_name;
+    // get ld_name and its hash value. The name refers to the string table
+    // and is copied only if a new symbol is created.
+    llvm::StringRef ld_name;
+    uint32_t ld_hash = 0;
     if (ResolveInfo::Section == ld_type) {
       // Section symbol's st_name is the section index.
       assert(NULL != section && "get a invalid section");
       ld_name = section->name();
+      ld_hash = NamePool::Hash(ld_name);
     }
     else {
-      ld_name = std::string(pStrTab + st_name);
+      ld_name = NamePool::Scan(pStrTab + st_name, ld_hash);
     }
 
     LDSymbol *psym =
         pBuilder.AddSymbol(pInput,
                            ld_name,
+                           ld_hash,
                            ld_type,
                            ld_desc,
                            ld_binding,
@@ -350,6 +356,7 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
   uint32_t sh_link      = 0x0;
   uint32_t sh_info      = 0x0;
   uint32_t sh_addralign = 0x0;
+  uint32_t sh_entsize   = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -375,6 +382,8 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
     shoff += shentsize;
   }
 
+  pInput.memArea()->advise(pInput.fileOffset() + shoff, shnum * shentsize,
+                           FileHandle::WillNeed);
   shdr_region = pInput.memArea()->request(pInput.fileOffset() + shoff,
                                           shnum * shentsize);
   llvm::ELF::Elf32_Shdr * shdrTab =
@@ -409,6 +418,7 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
       sh_link      = shdrTab[idx].sh_link;
       sh_info      = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize   = shdrTab[idx].sh_entsize;
     }
     else {
       sh_name      = mcld::bswap32(shdrTab[idx].sh_name);
@@ -419,6 +429,7 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
       sh_link      = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info      = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap32(shdrTab[idx].sh_addralign);
+      sh_entsize   = mcld::bswap32(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(pInput,
@@ -429,6 +440,7 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = { section, sh_link, sh_info };
@@ -457,6 +469,62 @@ ELFReader<32, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
   return true;
 }
 
+/// readSymbol - read a symbol of an input shared object and create LDSymbol
+LDSymbol* ELFReader<32, true>::readSymbol(Input& pInput,
+                                         IRBuilder& pBuilder,
+                                         const MemoryRegion& pRegion,
+                                         const char* pStrTab,
+                                         size_t pIdx) const
+{
+  assert(Input::DynObj == pInput.type() && "read a symbol of a non-dynobj");
+  const llvm::ELF::Elf32_Sym* symtab =
+                 reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.start());
+
+  uint32_t st_name  = 0x0;
+  uint32_t st_value = 0x0;
+  uint32_t st_size  = 0x0;
+  uint8_t  st_info  = symtab[pIdx].st_info;
+  uint8_t  st_other = symtab[pIdx].st_other;
+  uint16_t st_shndx = 0x0;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    st_name  = symtab[pIdx].st_name;
+    st_value = symtab[pIdx].st_value;
+    st_size  = symtab[pIdx].st_size;
+    st_shndx = symtab[pIdx].st_shndx;
+  }
+  else {
+    st_name  = mcld::bswap32(symtab[pIdx].st_name);
+    st_value = mcld::bswap32(symtab[pIdx].st_value);
+    st_size  = mcld::bswap32(symtab[pIdx].st_size);
+    st_shndx = mcld::bswap16(symtab[pIdx].st_shndx);
+  }
+
+  ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
+  ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+  ResolveInfo::Binding ld_binding =
+                             getSymBinding((st_info >> 4), st_shndx, st_other);
+  uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+  ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+
+  LDSection* section = NULL;
+  if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
+    section = pInput.context()->getSection(st_shndx);
+
+  uint32_t ld_hash = 0;
+  llvm::StringRef ld_name = NamePool::Scan(pStrTab + st_name, ld_hash);
+
+  return pBuilder.AddSymbol(pInput,
+                            ld_name,
+                            ld_hash,
+                            ld_type,
+                            ld_desc,
+                            ld_binding,
+                            st_size,
+                            ld_value,
+                            section, ld_vis);
+}
+
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<32, true>::readSignature(Input& pInput,
@@ -679,20 +747,24 @@ bool ELFReader<64, true>::readSymbols(Input& pInput,
     if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
       section = pInput.context()->getSection(st_shndx);
 
-    // get ld_name
-    std::string ld_name;
+    // get ld_name and its hash value. The name refers to the string table
+    // and is copied only if a new symbol is created.
+    llvm::StringRef ld_name;
+    uint32_t ld_hash = 0;
     if (ResolveInfo::Section == ld_type) {
       // Section symbol's st_name is the section index.
       assert(NULL != section && "get a invalid section");
       ld_name = section->name();
+      ld_hash = NamePool::Hash(ld_name);
     }
     else {
-      ld_name = std::string(pStrTab + st_name);
+      ld_name = NamePool::Scan(pStrTab + st_name, ld_hash);
     }
 
     LDSymbol *psym =
             pBuilder.AddSymbol(pInput,
                                ld_name,
+                               ld_hash,
                                ld_type,
                                ld_desc,
                                ld_binding,
@@ -891,6 +963,7 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
   uint32_t sh_link      = 0x0;
   uint32_t sh_info      = 0x0;
   uint64_t sh_addralign = 0x0;
+  uint64_t sh_entsize   = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -916,6 +989,8 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
     shoff += shentsize;
   }
 
+  pInput.memArea()->advise(pInput.fileOffset() + shoff, shnum * shentsize,
+                           FileHandle::WillNeed);
   shdr_region = pInput.memArea()->request(pInput.fileOffset() + shoff,
                                           shnum * shentsize);
   llvm::ELF::Elf64_Shdr * shdrTab =
@@ -950,6 +1025,7 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
       sh_link      = shdrTab[idx].sh_link;
       sh_info      = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize   = shdrTab[idx].sh_entsize;
     }
     else {
       sh_name      = mcld::bswap32(shdrTab[idx].sh_name);
@@ -960,6 +1036,7 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
       sh_link      = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info      = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap64(shdrTab[idx].sh_addralign);
+      sh_entsize   = mcld::bswap64(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(pInput,
@@ -970,6 +1047,7 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = { section, sh_link, sh_info };
@@ -998,6 +1076,62 @@ ELFReader<64, true>::readSectionHeaders(Input& pInput, void* pELFHeader) const
   return true;
 }
 
+/// readSymbol - read a symbol of an input shared object and create LDSymbol
+LDSymbol* ELFReader<64, true>::readSymbol(Input& pInput,
+                                         IRBuilder& pBuilder,
+                                         const MemoryRegion& pRegion,
+                                         const char* pStrTab,
+                                         size_t pIdx) const
+{
+  assert(Input::DynObj == pInput.type() && "read a symbol of a non-dynobj");
+  const llvm::ELF::Elf64_Sym* symtab =
+                 reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.start());
+
+  uint32_t st_name  = 0x0;
+  uint64_t st_value = 0x0;
+  uint64_t st_size  = 0x0;
+  uint8_t  st_info  = symtab[pIdx].st_info;
+  uint8_t  st_other = symtab[pIdx].st_other;
+  uint16_t st_shndx = 0x0;
+
+  if (llvm::sys::IsLittleEndianHost) {
+    st_name  = symtab[pIdx].st_name;
+    st_value = symtab[pIdx].st_value;
+    st_size  = symtab[pIdx].st_size;
+    st_shndx = symtab[pIdx].st_shndx;
+  }
+  else {
+    st_name  = mcld::bswap32(symtab[pIdx].st_name);
+    st_value = mcld::bswap64(symtab[pIdx].st_value);
+    st_size  = mcld::bswap64(symtab[pIdx].st_size);
+    st_shndx = mcld::bswap16(symtab[pIdx].st_shndx);
+  }
+
+  ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
+  ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+  ResolveInfo::Binding ld_binding =
+                             getSymBinding((st_info >> 4), st_shndx, st_other);
+  uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+  ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+
+  LDSection* section = NULL;
+  if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
+    section = pInput.context()->getSection(st_shndx);
+
+  uint32_t ld_hash = 0;
+  llvm::StringRef ld_name = NamePool::Scan(pStrTab + st_name, ld_hash);
+
+  return pBuilder.AddSymbol(pInput,
+                            ld_name,
+                            ld_hash,
+                            ld_type,
+                            ld_desc,
+                            ld_binding,
+                            st_size,
+                            ld_value,
+                            section, ld_vis);
+}
+
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<64, true>::readSignature(Input& pInput,
@@ -10,13 +10,18 @@
 #include <mcld/LD/LDSection.h>
 #include <mcld/Support/GCFactory.h>
 #include <mcld/Config/Config.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 #include <cassert>
 
 using namespace mcld;
 
 typedef GCFactory<ELFSegment, MCLD_SEGMENTS_PER_OUTPUT> ELFSegmentFactory;
-static llvm::ManagedStatic<ELFSegmentFactory> g_ELFSegmentFactory;
+
+static inline ELFSegmentFactory& GetELFSegmentFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<ELFSegmentFactory>(LinkContext::ELFSegmentArena);
+}
 
 //===----------------------------------------------------------------------===//
 // ELFSegment
@@ -88,19 +93,19 @@ void ELFSegment::append(LDSection* pSection)
 
 ELFSegment* ELFSegment::Create(uint32_t pType, uint32_t pFlag)
 {
-  ELFSegment* seg = g_ELFSegmentFactory->allocate();
+  ELFSegment* seg = GetELFSegmentFactory().allocate();
   new (seg) ELFSegment(pType, pFlag);
   return seg;
 }
 
 void ELFSegment::Destroy(ELFSegment*& pSegment)
 {
-  g_ELFSegmentFactory->destroy(pSegment);
-  g_ELFSegmentFactory->deallocate(pSegment);
+  GetELFSegmentFactory().destroy(pSegment);
+  GetELFSegmentFactory().deallocate(pSegment);
   pSegment = NULL;
 }
 
 void ELFSegment::Clear()
 {
-  g_ELFSegmentFactory->clear();
+  GetELFSegmentFactory().clear();
 }
@@ -7,19 +7,114 @@
 //
 //===----------------------------------------------------------------------===//
 #include <mcld/LD/EhFrame.h>
+#include <mcld/LD/LDContext.h>
 #include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/SectionData.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Fragment/Relocation.h>
 #include <mcld/Object/ObjectBuilder.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/GCFactory.h>
+#include <mcld/Support/LinkContext.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/Support/Casting.h>
+
+#include <cstring>
+#include <string>
 
 using namespace mcld;
 
 typedef GCFactory<EhFrame, MCLD_SECTIONS_PER_INPUT> EhFrameFactory;
 
-static llvm::ManagedStatic<EhFrameFactory> g_EhFrameFactory;
+static inline EhFrameFactory& GetEhFrameFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<EhFrameFactory>(LinkContext::EhFrameArena);
+}
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+typedef std::vector<Relocation*> RelocList;
+typedef llvm::DenseMap<const Fragment*, RelocList> RelocMap;
+
+/// GetRelocData - the relocations applied to pSection in pInput
+static RelocData* GetRelocData(const Input& pInput, const LDSection& pSection)
+{
+  LDContext::const_sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    if (&pSection == (*rs)->getLink() &&
+        LDFileFormat::Ignore != (*rs)->kind() &&
+        (*rs)->hasRelocData())
+      return (*rs)->getRelocData();
+  }
+  return NULL;
+}
+
+template<typename T>
+static void AppendKey(std::string& pKey, T pValue)
+{
+  pKey.append(reinterpret_cast<const char*>(&pValue), sizeof(T));
+}
+
+/// GetCIEKey - the contents of pCIE followed by its relocations. Two CIEs
+/// with the same key are identical in the output.
+static std::string GetCIEKey(const EhFrame::CIE& pCIE, const RelocList* pRelocs)
+{
+  const MemoryRegion& region = pCIE.getRegion();
+  std::string key(reinterpret_cast<const char*>(region.start()),
+                  region.size());
+  if (NULL == pRelocs)
+    return key;
+
+  RelocList::const_iterator reloc, rEnd = pRelocs->end();
+  for (reloc = pRelocs->begin(); reloc != rEnd; ++reloc) {
+    AppendKey(key, (*reloc)->targetRef().offset());
+    AppendKey(key, (*reloc)->type());
+    AppendKey(key, (*reloc)->symInfo());
+    AppendKey(key, (*reloc)->addend());
+  }
+  return key;
+}
+
+/// IsDeadFDE - is the function described by pFDE discarded?
+static bool IsDeadFDE(const EhFrame::FDE& pFDE, const RelocList* pRelocs)
+{
+  // --icf redirects the symbols of a folded function to the kept one, so only
+  // the section recorded before that tells whether the function is discarded.
+  if (NULL != pFDE.getFunction())
+    return (LDFileFormat::Ignore == pFDE.getFunction()->kind());
+
+  // The PC Begin field refers to the function. The relocation against the
+  // section symbol of a discarded section is not read at all.
+  if (NULL == pRelocs)
+    return true;
+
+  RelocList::const_iterator reloc, rEnd = pRelocs->end();
+  for (reloc = pRelocs->begin(); reloc != rEnd; ++reloc) {
+    if (pFDE.getDataStart() != (*reloc)->targetRef().offset())
+      continue;
+
+    // A local symbol in a discarded group section is undefined, and a symbol
+    // in a garbage-collected section is in an ignored section.
+    const ResolveInfo* info = (*reloc)->symInfo();
+    if (NULL == info)
+      return false;
+    if (info->isLocal() && info->isUndef())
+      return true;
+    const LDSymbol* symbol = info->outSymbol();
+    if (NULL == symbol || !symbol->hasFragRef())
+      return false;
+    return (LDFileFormat::Ignore ==
+            symbol->fragRef()->frag()->getParent()->getSection().kind());
+  }
+  return true;
+}
 
 //===----------------------------------------------------------------------===//
 // EhFrame::CIE
@@ -35,8 +130,9 @@ EhFrame::FDE::FDE(MemoryRegion& pRegion,
                   const EhFrame::CIE& pCIE,
                   uint32_t pDataStart)
   : RegionFragment(pRegion),
-    m_CIE(pCIE),
-    m_DataStart(pDataStart) {
+    m_pCIE(&pCIE),
+    m_DataStart(pDataStart),
+    m_pFunction(NULL) {
 }
 
 //===----------------------------------------------------------------------===//
@@ -60,7 +156,7 @@ EhFrame::~EhFrame()
 
 EhFrame* EhFrame::Create(LDSection& pSection)
 {
-  EhFrame* result = g_EhFrameFactory->allocate();
+  EhFrame* result = GetEhFrameFactory().allocate();
   new (result) EhFrame(pSection);
   return result;
 }
@@ -68,13 +164,13 @@ EhFrame* EhFrame::Create(LDSection& pSection)
 void EhFrame::Destroy(EhFrame*& pSection)
 {
   pSection->~EhFrame();
-  g_EhFrameFactory->deallocate(pSection);
+  GetEhFrameFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void EhFrame::Clear()
 {
-  g_EhFrameFactory->clear();
+  GetEhFrameFactory().clear();
 }
 
 const LDSection& EhFrame::getSection() const
@@ -140,3 +236,135 @@ EhFrame& EhFrame::merge(EhFrame& pOther)
   return *this;
 }
 
+EhFrame& EhFrame::merge(const Input& pInput, EhFrame& pOther)
+{
+  // If the section has no relocations, we can not tell which functions the
+  // FDEs belong to. Keep all of them.
+  RelocData* reloc_data = GetRelocData(pInput, pOther.getSection());
+  RelocMap relocs;
+  if (NULL != reloc_data) {
+    RelocData::iterator reloc, rEnd = reloc_data->end();
+    for (reloc = reloc_data->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      relocs[relocation->targetRef().frag()].push_back(relocation);
+    }
+  }
+
+  // 1. find the live FDEs, and count them for each CIE
+  llvm::DenseMap<const CIE*, size_t> num_of_fdes;
+  llvm::DenseSet<const Fragment*> dropped;
+  FDEList fdes;
+  fdes.reserve(pOther.numOfFDEs());
+  for (fde_iterator fde = pOther.fde_begin(); fde != pOther.fde_end(); ++fde) {
+    RelocMap::const_iterator entry = relocs.find(*fde);
+    if (NULL != reloc_data &&
+        IsDeadFDE(**fde, (relocs.end() == entry) ? NULL : &entry->second)) {
+      dropped.insert(*fde);
+      continue;
+    }
+    ++num_of_fdes[&(*fde)->getCIE()];
+    fdes.push_back(*fde);
+  }
+
+  // 2. fold the CIEs with the same key into the first one
+  llvm::DenseMap<const CIE*, CIE*> folded;
+  for (cie_iterator cie = pOther.cie_begin(); cie != pOther.cie_end(); ++cie) {
+    if (0 == num_of_fdes.lookup(*cie)) {
+      dropped.insert(*cie);
+      continue;
+    }
+
+    RelocMap::const_iterator entry = relocs.find(*cie);
+    std::string key =
+      GetCIEKey(**cie, (relocs.end() == entry) ? NULL : &entry->second);
+    CIEMap::iterator kept = m_CIEMap.find(key);
+    if (m_CIEMap.end() != kept) {
+      folded[*cie] = kept->getValue();
+      dropped.insert(*cie);
+      continue;
+    }
+    m_CIEMap[key] = *cie;
+    m_CIEs.push_back(*cie);
+  }
+
+  m_FDEs.reserve(fdes.size() + m_FDEs.size());
+  for (fde_iterator fde = fdes.begin(); fde != fdes.end(); ++fde) {
+    llvm::DenseMap<const CIE*, CIE*>::iterator cie =
+      folded.find(&(*fde)->getCIE());
+    if (folded.end() != cie)
+      (*fde)->setCIE(*cie->second);
+    m_FDEs.push_back(*fde);
+  }
+
+  // 3. drop the relocations of the dropped entries
+  if (NULL != reloc_data) {
+    RelocData::RelocationListType& list = reloc_data->getRelocationList();
+    RelocData::iterator reloc = list.begin();
+    while (reloc != list.end()) {
+      if (0 != dropped.count(llvm::cast<Relocation>(reloc)->targetRef().frag()))
+        list.remove(reloc);
+      else
+        ++reloc;
+    }
+  }
+
+  // 4. move the rest. The dropped entries stay in pOther, so the input
+  // symbols referring to them are still valid.
+  SectionData* dropped_data = SectionData::Create(pOther.getSection());
+  SectionData::FragmentListType& from =
+    pOther.getSectionData()->getFragmentList();
+  SectionData::iterator frag = from.begin();
+  while (frag != from.end()) {
+    if (0 == dropped.count(&*frag)) {
+      ++frag;
+      continue;
+    }
+    Fragment* entry = from.remove(frag);
+    entry->setParent(dropped_data);
+    dropped_data->getFragmentList().push_back(entry);
+  }
+  ObjectBuilder::MoveSectionData(*pOther.getSectionData(), *m_pSectionData);
+  pOther.m_pSectionData = dropped_data;
+
+  pOther.m_CIEs.clear();
+  pOther.m_FDEs.clear();
+  return *this;
+}
+
+void EhFrame::setUpFunctions(const Input& pInput)
+{
+  RelocData* reloc_data = GetRelocData(pInput, getSection());
+  if (NULL == reloc_data)
+    return;
+
+  llvm::DenseMap<const Fragment*, FDE*> fdes;
+  for (fde_iterator fde = fde_begin(); fde != fde_end(); ++fde)
+    fdes[*fde] = *fde;
+
+  // The relocation at the PC Begin field refers to the function.
+  RelocData::iterator reloc, rEnd = reloc_data->end();
+  for (reloc = reloc_data->begin(); reloc != rEnd; ++reloc) {
+    Relocation* relocation = llvm::cast<Relocation>(reloc);
+    FDE* fde = fdes.lookup(relocation->targetRef().frag());
+    if (NULL == fde || fde->getDataStart() != relocation->targetRef().offset())
+      continue;
+
+    const ResolveInfo* info = relocation->symInfo();
+    if (NULL == info || NULL == info->outSymbol() ||
+        !info->outSymbol()->hasFragRef())
+      continue;
+    fde->setFunction(
+      info->outSymbol()->fragRef()->frag()->getParent()->getSection());
+  }
+}
+
+void EhFrame::emitCIEPointers(MemoryRegion& pRegion) const
+{
+  // The CIE pointer is the word before the data of an FDE. It is the offset
+  // from itself back to the CIE.
+  for (const_fde_iterator fde = fde_begin(); fde != fde_end(); ++fde) {
+    uint64_t field = (*fde)->getOffset() + (*fde)->getDataStart() - 4;
+    uint32_t pointer = field - (*fde)->getCIE().getOffset();
+    std::memcpy(pRegion.getBuffer(field), &pointer, sizeof(pointer));
+  }
+}
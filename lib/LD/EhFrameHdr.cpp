@@ -8,8 +8,10 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/LD/EhFrameHdr.h>
 
+#include <mcld/ADT/SizeTraits.h>
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MemoryRegion.h>
+#include <mcld/Support/ThreadPool.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/LD/LDSection.h>
 
@@ -18,6 +20,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 using namespace mcld;
 using namespace llvm::dwarf;
@@ -25,22 +28,266 @@ using namespace llvm::dwarf;
 //===----------------------------------------------------------------------===//
 // Helper Function
 //===----------------------------------------------------------------------===//
-namespace bit32 {
+namespace {
 
-typedef std::pair<SizeTraits<32>::Address, SizeTraits<32>::Address> Entry;
+/// An entry of the binary search table. The high 32 bits are the sort key,
+/// the initial location with the sign bit flipped, and the low 32 bits are
+/// the address of the FDE. Both are relative to .eh_frame_hdr.
+typedef uint64_t Entry;
 
-bool EntryCompare(const Entry& pX, const Entry& pY)
-{ return (pX.first < pY.first); }
+typedef std::vector<Entry> EntryList;
 
-} // bit32 namespace
+// the number of FDEs worth a thread
+const size_t MinEntriesPerTask = 4096;
+
+// the radix sort takes 8 bits of the key in a pass
+const unsigned int RadixBits = 8;
+const unsigned int NumOfBuckets = 1 << RadixBits;
+const unsigned int NumOfPasses = 32 / RadixBits;
+
+/// ComputePCBegin - return the address of FDE's pc
+/// @ref binutils gold: ehframe.cc:222
+template<size_t SIZE>
+typename SizeTraits<SIZE>::Address
+ComputePCBegin(const EhFrame::FDE& pFDE,
+               const uint8_t* pEhFrame,
+               typename SizeTraits<SIZE>::Address pEhFrameAddr)
+{
+  typedef typename SizeTraits<SIZE>::Address Address;
+
+  uint8_t fde_encoding = pFDE.getCIE().getFDEEncode();
+  unsigned int eh_value = fde_encoding & 0x7;
+
+  // check the size to read in
+  size_t pc_size = 0x0;
+  switch (eh_value) {
+    case DW_EH_PE_absptr:
+      pc_size = SIZE / 8;
+      break;
+    case DW_EH_PE_udata2:
+      pc_size = 2;
+      break;
+    case DW_EH_PE_udata4:
+      pc_size = 4;
+      break;
+    case DW_EH_PE_udata8:
+      pc_size = 8;
+      break;
+    default:
+      // TODO
+      break;
+  }
+
+  uint64_t pc = 0x0;
+  const uint8_t* field = pEhFrame + pFDE.getOffset() + pFDE.getDataStart();
+  std::memcpy(&pc, field, pc_size);
+
+  // adjust the signed value
+  bool is_signed = (fde_encoding & DW_EH_PE_signed) != 0x0;
+  if (is_signed && DW_EH_PE_udata2 == eh_value)
+    pc = (pc ^ 0x8000) - 0x8000;
+  else if (is_signed && DW_EH_PE_udata4 == eh_value)
+    pc = (pc ^ 0x80000000) - 0x80000000;
+
+  // handle eh application
+  switch (fde_encoding & 0x70)
+  {
+    case DW_EH_PE_absptr:
+      break;
+    case DW_EH_PE_pcrel:
+      pc += pEhFrameAddr + pFDE.getOffset() + pFDE.getDataStart();
+      break;
+    case DW_EH_PE_datarel:
+      // TODO
+      break;
+    default:
+      // TODO
+      break;
+  }
+  return static_cast<Address>(pc);
+}
+
+/** \class DecodeTask
+ *  \brief DecodeTask builds the table entries of a range of FDEs.
+ */
+template<size_t SIZE>
+class DecodeTask : public ThreadPool::Task
+{
+public:
+  typedef typename SizeTraits<SIZE>::Address Address;
+
+public:
+  DecodeTask(EhFrame::const_fde_iterator pBegin,
+             EhFrame::const_fde_iterator pEnd,
+             const uint8_t* pEhFrame,
+             Address pEhFrameAddr,
+             Address pEhFrameHdrAddr,
+             Entry* pEntries)
+    : m_Begin(pBegin), m_End(pEnd), m_pEhFrame(pEhFrame),
+      m_EhFrameAddr(pEhFrameAddr), m_EhFrameHdrAddr(pEhFrameHdrAddr),
+      m_pEntries(pEntries) {
+  }
+
+  void run()
+  {
+    Entry* entry = m_pEntries;
+    for (EhFrame::const_fde_iterator fde = m_Begin; fde != m_End; ++fde) {
+      Address fde_pc = ComputePCBegin<SIZE>(**fde, m_pEhFrame, m_EhFrameAddr);
+      Address fde_addr = m_EhFrameAddr + (*fde)->getOffset();
+      uint32_t key = static_cast<uint32_t>(fde_pc - m_EhFrameHdrAddr);
+      uint32_t value = static_cast<uint32_t>(fde_addr - m_EhFrameHdrAddr);
+      *entry++ = (Entry(key ^ 0x80000000) << 32) | value;
+    }
+  }
+
+private:
+  EhFrame::const_fde_iterator m_Begin;
+  EhFrame::const_fde_iterator m_End;
+  const uint8_t* m_pEhFrame;
+  Address m_EhFrameAddr;
+  Address m_EhFrameHdrAddr;
+  Entry* m_pEntries;
+};
+
+/** \class RadixSortTask
+ *  \brief RadixSortTask runs one pass of the radix sort on a block of
+ *  entries. A pass first counts the digits of every block, and then
+ *  scatters the blocks to the positions given by the counts of all blocks.
+ */
+class RadixSortTask : public ThreadPool::Task
+{
+public:
+  RadixSortTask(const Entry* pBegin, const Entry* pEnd)
+    : m_pBegin(pBegin), m_pEnd(pEnd), m_Shift(0), m_bScatter(false),
+      m_pTo(NULL), m_pTable(NULL) {
+  }
+
+  /// count - set up the task to count the digits at pShift
+  void count(unsigned int pShift)
+  {
+    m_Shift = pShift;
+    m_bScatter = false;
+  }
+
+  /// scatter - set up the task to scatter the block to pTo. If pTable is not
+  /// NULL, write the entries into the binary search table pTable instead.
+  void scatter(Entry* pTo, uint32_t* pTable)
+  {
+    m_bScatter = true;
+    m_pTo = pTo;
+    m_pTable = pTable;
+  }
+
+  /// setSource - the block to sort in the next pass
+  void setSource(const Entry* pBegin, const Entry* pEnd)
+  {
+    m_pBegin = pBegin;
+    m_pEnd = pEnd;
+  }
+
+  size_t* buckets() { return m_Buckets; }
+
+  void run()
+  {
+    if (!m_bScatter) {
+      std::memset(m_Buckets, 0, sizeof(m_Buckets));
+      for (const Entry* entry = m_pBegin; entry != m_pEnd; ++entry)
+        ++m_Buckets[digit(*entry)];
+      return;
+    }
+
+    for (const Entry* entry = m_pBegin; entry != m_pEnd; ++entry) {
+      size_t pos = m_Buckets[digit(*entry)]++;
+      if (NULL == m_pTable) {
+        m_pTo[pos] = *entry;
+        continue;
+      }
+      m_pTable[2 * pos] = static_cast<uint32_t>(*entry >> 32) ^ 0x80000000;
+      m_pTable[2 * pos + 1] = static_cast<uint32_t>(*entry);
+    }
+  }
+
+private:
+  unsigned int digit(Entry pEntry) const
+  { return (pEntry >> (32 + m_Shift)) & (NumOfBuckets - 1); }
+
+private:
+  const Entry* m_pBegin;
+  const Entry* m_pEnd;
+  unsigned int m_Shift;
+  bool m_bScatter;
+  Entry* m_pTo;
+  uint32_t* m_pTable;
+  size_t m_Buckets[NumOfBuckets];
+};
+
+/// RadixSort - sort pEntries by the keys and write them into pTable
+void RadixSort(EntryList& pEntries, uint32_t* pTable, ThreadPool& pPool)
+{
+  size_t size = pEntries.size();
+  size_t num_tasks = (size + MinEntriesPerTask - 1) / MinEntriesPerTask;
+  if (num_tasks > pPool.numOfThreads())
+    num_tasks = pPool.numOfThreads();
+  size_t block = (size + num_tasks - 1) / num_tasks;
+
+  EntryList buffer(size);
+  Entry* from = &pEntries[0];
+  Entry* to = &buffer[0];
+
+  std::vector<RadixSortTask> tasks;
+  tasks.reserve(num_tasks);
+  for (size_t begin = 0; begin < size; begin += block) {
+    size_t end = (begin + block < size) ? begin + block : size;
+    tasks.push_back(RadixSortTask(from + begin, from + end));
+  }
+
+  ThreadPool::TaskList task_list;
+  std::vector<RadixSortTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  for (unsigned int pass = 0; pass < NumOfPasses; ++pass) {
+    for (task = tasks.begin(); task != taskEnd; ++task)
+      task->count(pass * RadixBits);
+    pPool.run(task_list);
+
+    // Turn the counts into the positions. The entries of a digit in the
+    // earlier blocks go first, so the sort is stable.
+    size_t pos = 0;
+    for (unsigned int digit = 0; digit < NumOfBuckets; ++digit) {
+      for (task = tasks.begin(); task != taskEnd; ++task) {
+        size_t count = task->buckets()[digit];
+        task->buckets()[digit] = pos;
+        pos += count;
+      }
+    }
+
+    bool last = (NumOfPasses - 1 == pass);
+    for (task = tasks.begin(); task != taskEnd; ++task)
+      task->scatter(to, last ? pTable : NULL);
+    pPool.run(task_list);
+
+    // the next pass reads the same blocks of the sorted entries
+    size_t begin = 0;
+    for (task = tasks.begin(); task != taskEnd; ++task, begin += block) {
+      size_t end = (begin + block < size) ? begin + block : size;
+      task->setSource(to + begin, to + end);
+    }
+    std::swap(from, to);
+  }
+}
+
+} // anonymous namespace
 
 //===----------------------------------------------------------------------===//
-// Template Specification Functions
+// Template Functions
 //===----------------------------------------------------------------------===//
-/// emitOutput<32> - write out eh_frame_hdr
-template<>
-void EhFrameHdr::emitOutput<32>(MemoryArea& pOutput)
+/// emitOutput - write out eh_frame_hdr
+template<size_t SIZE>
+void EhFrameHdr::emitOutput(MemoryArea& pOutput, unsigned int pNumOfThreads)
 {
+  typedef typename SizeTraits<SIZE>::Address Address;
+
   MemoryRegion* ehframehdr_region =
     pOutput.request(m_EhFrameHdr.offset(), m_EhFrameHdr.size());
 
@@ -77,36 +324,50 @@ void EhFrameHdr::emitOutput<32>(MemoryArea& pOutput)
     // table_enc
     data[3] = DW_EH_PE_datarel | DW_EH_PE_sdata4;
 
-    // prepare the binary search table
-    typedef std::vector<bit32::Entry> SearchTableType;
-    SearchTableType search_table;
-    EhFrame::const_fde_iterator fde, fde_end = m_EhFrame.getEhFrame()->fde_end();
-    for(fde = m_EhFrame.getEhFrame()->fde_begin(); fde != fde_end; ++fde) {
-      assert(*fde != NULL);
-      SizeTraits<32>::Offset offset;
-      SizeTraits<32>::Address fde_pc;
-      SizeTraits<32>::Address fde_addr;
-      offset = (*fde)->getOffset();
-      fde_pc = computePCBegin(**fde, *ehframe_region);
-      fde_addr = m_EhFrame.addr() + offset;
-      search_table.push_back(std::make_pair(fde_pc, fde_addr));
+    // decode the PC Begin values of the FDEs
+    const EhFrame* eh_frame = m_EhFrame.getEhFrame();
+    size_t size = eh_frame->numOfFDEs();
+    size_t num_tasks = (size + MinEntriesPerTask - 1) / MinEntriesPerTask;
+    if (num_tasks > pNumOfThreads)
+      num_tasks = pNumOfThreads;
+    if (0 == num_tasks)
+      num_tasks = 1;
+    size_t block = (size + num_tasks - 1) / num_tasks;
+
+    EntryList search_table(size);
+    std::vector<DecodeTask<SIZE> > tasks;
+    tasks.reserve(num_tasks);
+    for (size_t begin = 0; begin < size; begin += block) {
+      size_t end = (begin + block < size) ? begin + block : size;
+      tasks.push_back(DecodeTask<SIZE>(eh_frame->fde_begin() + begin,
+                                       eh_frame->fde_begin() + end,
+                                       ehframe_region->start(),
+                                       static_cast<Address>(m_EhFrame.addr()),
+                                       static_cast<Address>(m_EhFrameHdr.addr()),
+                                       &search_table[begin]));
     }
 
-    std::sort(search_table.begin(), search_table.end(), bit32::EntryCompare);
+    ThreadPool::TaskList task_list;
+    typename std::vector<DecodeTask<SIZE> >::iterator task,
+      taskEnd = tasks.end();
+    for (task = tasks.begin(); task != taskEnd; ++task)
+      task_list.push_back(&*task);
 
-    // write out the binary search table
-    uint32_t* bst = (uint32_t*)(data + 12);
-    SearchTableType::const_iterator entry, entry_end = search_table.end();
-    size_t id = 0;
-    for (entry = search_table.begin(); entry != entry_end; ++entry) {
-      bst[id++] = (*entry).first - m_EhFrameHdr.addr();
-      bst[id++] = (*entry).second - m_EhFrameHdr.addr();
-    }
+    ThreadPool pool(pNumOfThreads);
+    pool.run(task_list);
+
+    // sort the binary search table into the output
+    RadixSort(search_table, (uint32_t*)(data + 12), pool);
   }
   pOutput.release(ehframehdr_region);
   pOutput.release(ehframe_region);
 }
 
+template void EhFrameHdr::emitOutput<32>(MemoryArea& pOutput,
+                                         unsigned int pNumOfThreads);
+template void EhFrameHdr::emitOutput<64>(MemoryArea& pOutput,
+                                         unsigned int pNumOfThreads);
+
 //===----------------------------------------------------------------------===//
 // EhFrameHdr
 //===----------------------------------------------------------------------===//
@@ -137,61 +398,3 @@ void EhFrameHdr::sizeOutput()
     size += 8 * m_EhFrame.getEhFrame()->numOfFDEs();
   m_EhFrameHdr.setSize(size);
 }
-
-/// computePCBegin - return the address of FDE's pc
-/// @ref binutils gold: ehframe.cc:222
-uint32_t EhFrameHdr::computePCBegin(const EhFrame::FDE& pFDE,
-                                    const MemoryRegion& pEhFrameRegion)
-{
-  uint8_t fde_encoding = pFDE.getCIE().getFDEEncode();
-  unsigned int eh_value = fde_encoding & 0x7;
-
-  // check the size to read in
-  if (eh_value == llvm::dwarf::DW_EH_PE_absptr) {
-    eh_value = DW_EH_PE_udata4;
-  }
-
-  size_t pc_size = 0x0;
-  switch (eh_value) {
-    case DW_EH_PE_udata2:
-      pc_size = 2;
-      break;
-    case DW_EH_PE_udata4:
-      pc_size = 4;
-      break;
-    case DW_EH_PE_udata8:
-      pc_size = 8;
-      break;
-    default:
-      // TODO
-      break;
-  }
-
-  SizeTraits<32>::Address pc = 0x0;
-  const uint8_t* offset = (const uint8_t*) pEhFrameRegion.start() +
-                          pFDE.getOffset() +
-                          pFDE.getDataStart();
-  std::memcpy(&pc, offset, pc_size);
-
-  // adjust the signed value
-  bool is_signed = (fde_encoding & llvm::dwarf::DW_EH_PE_signed) != 0x0;
-  if (DW_EH_PE_udata2 == eh_value && is_signed)
-    pc = (pc ^ 0x8000) - 0x8000;
-
-  // handle eh application
-  switch (fde_encoding & 0x70)
-  {
-    case DW_EH_PE_absptr:
-      break;
-    case DW_EH_PE_pcrel:
-      pc += m_EhFrame.addr() + pFDE.getOffset() + pFDE.getDataStart();
-      break;
-    case DW_EH_PE_datarel:
-      // TODO
-      break;
-    default:
-      // TODO
-      break;
-  }
-  return pc;
-}
@@ -13,6 +13,7 @@
 #include <mcld/LinkerConfig.h>
 #include <mcld/MC/Attribute.h>
 #include <mcld/MC/Input.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/ELFObjectReader.h>
 #include <mcld/Support/FileSystem.h>
@@ -102,50 +103,72 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
   if (pArchive.getARFile().attribute()->isWholeArchive())
     return includeAllMembers(pConfig, pArchive);
 
+  const NamePool::UndefList& undefs = m_Module.getNamePool().undefs();
+
   // if this is the first time read this archive, setup symtab and strtab
   if (pArchive.getSymbolTable().empty()) {
-  // read the symtab of the archive
-  readSymbolTable(pArchive);
-
-  // read the strtab of the archive
-  readStringTable(pArchive);
+    // read the symtab of the archive
+    readSymbolTable(pArchive);
+
+    // read the strtab of the archive
+    readStringTable(pArchive);
+
+    // add root archive to ArchiveMemberMap
+    pArchive.addArchiveMember(pArchive.getARFile().name(),
+                              pArchive.inputs().root(),
+                              &InputTree::Downward);
+
+    // scan the whole symtab once. The undefined symbols introduced from now
+    // on are caught by the worklist below.
+    pArchive.setUndefCursor(undefs.size());
+    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx)
+      includeSymbol(pConfig, pArchive, idx);
+  }
 
-  // add root archive to ArchiveMemberMap
-  pArchive.addArchiveMember(pArchive.getARFile().name(),
-                            pArchive.inputs().root(),
-                            &InputTree::Downward);
+  // include the needed members in the archive and build up the input tree.
+  // Only the symbols which became undefined since the last visit are looked
+  // up, and including a member may append more of them to the worklist.
+  while (pArchive.getUndefCursor() < undefs.size()) {
+    const ResolveInfo* info = undefs[pArchive.getUndefCursor()];
+    pArchive.setUndefCursor(pArchive.getUndefCursor() + 1);
+
+    llvm::StringRef name(info->name(), info->nameSize());
+    for (size_t idx = pArchive.findSymbol(name);
+         idx < pArchive.numOfSymbols();
+         idx = pArchive.getNextSymbol(idx)) {
+      includeSymbol(pConfig, pArchive, idx);
+    }
   }
 
-  // include the needed members in the archive and build up the input tree
-  bool willSymResolved;
-  do {
-    willSymResolved = false;
-    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx) {
-      // bypass if we already decided to include this symbol or not
-      if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(idx))
-        continue;
+  return true;
+}
 
-      // bypass if another symbol with the same object file offset is included
-      if (pArchive.hasObjectMember(pArchive.getObjFileOffset(idx))) {
-        pArchive.setSymbolStatus(idx, Archive::Symbol::Include);
-        continue;
-      }
-
-      // check if we should include this defined symbol
-      Archive::Symbol::Status status =
-        shouldIncludeSymbol(pArchive.getSymbolName(idx));
-      if (Archive::Symbol::Unknown != status)
-        pArchive.setSymbolStatus(idx, status);
-
-      if (Archive::Symbol::Include == status) {
-        // include the object member from the given offset
-        includeMember(pConfig, pArchive, pArchive.getObjFileOffset(idx));
-        willSymResolved = true;
-      } // end of if
-    } // end of for
-  } while (willSymResolved);
+/// includeSymbol - decide whether the symtab entry at the given index is
+/// needed, and include the object member defining it if so
+void GNUArchiveReader::includeSymbol(const LinkerConfig& pConfig,
+                                     Archive& pArchive,
+                                     size_t pSymIdx)
+{
+  // bypass if we already decided to include this symbol or not
+  if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(pSymIdx))
+    return;
+
+  // bypass if another symbol with the same object file offset is included
+  if (pArchive.hasObjectMember(pArchive.getObjFileOffset(pSymIdx))) {
+    pArchive.setSymbolStatus(pSymIdx, Archive::Symbol::Include);
+    return;
+  }
 
-  return true;
+  // check if we should include this defined symbol
+  Archive::Symbol::Status status =
+    shouldIncludeSymbol(pArchive.getSymbolName(pSymIdx));
+  if (Archive::Symbol::Unknown != status)
+    pArchive.setSymbolStatus(pSymIdx, status);
+
+  if (Archive::Symbol::Include == status) {
+    // include the object member from the given offset
+    includeMember(pConfig, pArchive, pArchive.getObjFileOffset(pSymIdx));
+  }
 }
 
 /// readMemberHeader - read the header of a member in a archive file and then
@@ -0,0 +1,372 @@
+//===- GarbageCollection.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/GarbageCollection.h>
+#include <mcld/Fragment/Fragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/EhFrame.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/NamePool.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Object/SectionMap.h>
+#include <mcld/Target/TargetLDBackend.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/LinkerScript.h>
+#include <mcld/Module.h>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+/// IsCIdentifier - the linker defines __start_X and __stop_X for a section X
+/// whose name is a C identifier, and programs reach X through them.
+static bool IsCIdentifier(llvm::StringRef pName)
+{
+  if (pName.empty())
+    return false;
+  for (size_t i = 0; i < pName.size(); ++i) {
+    char c = pName[i];
+    if (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+      continue;
+    if (i != 0 && c >= '0' && c <= '9')
+      continue;
+    return false;
+  }
+  return true;
+}
+
+/// IsInitFini - the dynamic linker and the startup files reach these sections
+/// without any relocation.
+static bool IsInitFini(const LDSection& pSection)
+{
+  switch (pSection.type()) {
+    case llvm::ELF::SHT_INIT_ARRAY:
+    case llvm::ELF::SHT_FINI_ARRAY:
+    case llvm::ELF::SHT_PREINIT_ARRAY:
+      return true;
+    default:
+      break;
+  }
+
+  llvm::StringRef name(pSection.name());
+  return (name == ".init" || name == ".fini" || name == ".jcr" ||
+          name.startswith(".init_array") || name.startswith(".fini_array") ||
+          name.startswith(".preinit_array") ||
+          name.startswith(".ctors") || name.startswith(".dtors"));
+}
+
+//===----------------------------------------------------------------------===//
+// GarbageCollection
+//===----------------------------------------------------------------------===//
+GarbageCollection::GarbageCollection(const LinkerConfig& pConfig,
+                                     const TargetLDBackend& pBackend,
+                                     Module& pModule)
+  : m_Config(pConfig), m_Backend(pBackend), m_Module(pModule) {
+}
+
+GarbageCollection::~GarbageCollection()
+{
+}
+
+bool GarbageCollection::run()
+{
+  // 1. get the entry sections and the edges between input sections
+  SectionVecTy entry;
+  getEntrySections(entry);
+  setUpReachedSections(entry);
+
+  // 2. mark all sections reached from the entries
+  findReferencedSections(entry);
+
+  // 3. strip the others
+  stripSections();
+  return true;
+}
+
+bool GarbageCollection::isCollectable(const LDSection& pSection)
+{
+  if (LDFileFormat::Regular != pSection.kind() &&
+      LDFileFormat::BSS != pSection.kind())
+    return false;
+  return (0 != (pSection.flag() & llvm::ELF::SHF_ALLOC));
+}
+
+void GarbageCollection::setUpReachedSections(SectionVecTy& pEntry)
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+
+      // the section applied by the relocations. It is Ignore if it is a
+      // discarded group section.
+      const LDSection* apply = (*rs)->getLink();
+      if (NULL == apply || LDFileFormat::Ignore == apply->kind())
+        continue;
+
+      if (LDFileFormat::EhFrame == apply->kind()) {
+        setUpEhFrameEdges(*apply, *(*rs)->getRelocData(), pEntry);
+        continue;
+      }
+
+      RelocData::const_iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        const LDSection* target =
+          getTargetSection(*llvm::cast<Relocation>(reloc));
+        if (NULL != target && target != apply && isCollectable(*target))
+          addEdge(*apply, *target);
+      }
+    }
+  }
+}
+
+void GarbageCollection::setUpEhFrameEdges(const LDSection& pEhFrame,
+                                          const RelocData& pRelocs,
+                                          SectionVecTy& pEntry)
+{
+  // If the reader did not split .eh_frame into CIEs and FDEs, we can not tell
+  // which function an entry belongs to. Keep everything it refers to.
+  llvm::DenseSet<const Fragment*> fdes;
+  if (pEhFrame.hasEhFrame()) {
+    const EhFrame* eh_frame = pEhFrame.getEhFrame();
+    EhFrame::const_fde_iterator fde, fdeEnd = eh_frame->fde_end();
+    for (fde = eh_frame->fde_begin(); fde != fdeEnd; ++fde)
+      fdes.insert(*fde);
+  }
+
+  // The PC Begin field is the first relocated field of an FDE. The section it
+  // refers to is the function that owns the FDE.
+  typedef std::pair<FragmentRef::Offset, const LDSection*> OwnerTy;
+  llvm::DenseMap<const Fragment*, OwnerTy> owners;
+  RelocData::const_iterator reloc, rEnd = pRelocs.end();
+  for (reloc = pRelocs.begin(); reloc != rEnd; ++reloc) {
+    const Relocation& relocation = *llvm::cast<Relocation>(reloc);
+    const Fragment* frag = relocation.targetRef().frag();
+    if (0 == fdes.count(frag))
+      continue;
+
+    FragmentRef::Offset offset = relocation.targetRef().offset();
+    llvm::DenseMap<const Fragment*, OwnerTy>::iterator owner =
+      owners.find(frag);
+    if (owners.end() == owner)
+      owners[frag] = std::make_pair(offset, getTargetSection(relocation));
+    else if (offset < owner->second.first)
+      owner->second = std::make_pair(offset, getTargetSection(relocation));
+  }
+
+  for (reloc = pRelocs.begin(); reloc != rEnd; ++reloc) {
+    const Relocation& relocation = *llvm::cast<Relocation>(reloc);
+    const LDSection* target = getTargetSection(relocation);
+    if (NULL == target || !isCollectable(*target))
+      continue;
+
+    const Fragment* frag = relocation.targetRef().frag();
+    if (0 == fdes.count(frag)) {
+      // CIEs are always kept, so are their personality routines.
+      pEntry.push_back(target);
+      continue;
+    }
+
+    const LDSection* owner = owners[frag].second;
+    if (NULL == owner || !isCollectable(*owner)) {
+      // the function is always kept, so is its FDE.
+      pEntry.push_back(target);
+    }
+    else if (owner != target) {
+      // the LSDA of the function
+      addEdge(*owner, *target);
+    }
+  }
+}
+
+void GarbageCollection::getEntrySections(SectionVecTy& pEntry)
+{
+  // 1. the sections that can not be garbage collected, and the collectable
+  // sections that must be kept. Only the allocatable ones refer to the
+  // others; references from debug and other non-allocatable sections do not
+  // keep anything alive. .eh_frame is handled in setUpEhFrameEdges.
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      const LDSection* section = *sect;
+      if (isCollectable(*section)) {
+        if (isKept(**obj, *section))
+          pEntry.push_back(section);
+        continue;
+      }
+
+      if (0 == (section->flag() & llvm::ELF::SHF_ALLOC))
+        continue;
+
+      switch (section->kind()) {
+        case LDFileFormat::Ignore:
+        case LDFileFormat::Null:
+        case LDFileFormat::EhFrame:
+          continue;
+        default:
+          pEntry.push_back(section);
+          break;
+      }
+    }
+  }
+
+  // 2. the entry symbol
+  addEntrySymbol(m_Module.getNamePool().findSymbol(m_Backend.getEntry(m_Module)),
+                 pEntry);
+
+  // 3. the exported dynamic symbols
+  if (LinkerConfig::DynObj == m_Config.codeGenType() ||
+      m_Config.options().exportDynamic()) {
+    Module::const_sym_iterator symbol, symEnd = m_Module.sym_end();
+    for (symbol = m_Module.sym_begin(); symbol != symEnd; ++symbol) {
+      const ResolveInfo* info = (*symbol)->resolveInfo();
+      if (!info->isDefine() || info->isLocal() ||
+          ResolveInfo::Hidden == info->visibility() ||
+          ResolveInfo::Internal == info->visibility())
+        continue;
+      addEntrySymbol(*symbol, pEntry);
+    }
+  }
+
+  // 4. the regular definitions used by dynamic objects
+  const NamePool::DynRefList& dyn_refs = m_Module.getNamePool().dynRefs();
+  NamePool::DynRefList::const_iterator ref, refEnd = dyn_refs.end();
+  for (ref = dyn_refs.begin(); ref != refEnd; ++ref) {
+    if ((*ref)->isDefine() && !(*ref)->isDyn())
+      addEntrySymbol((*ref)->outSymbol(), pEntry);
+  }
+}
+
+void GarbageCollection::findReferencedSections(SectionVecTy& pEntry)
+{
+  // pEntry is the worklist
+  while (!pEntry.empty()) {
+    const LDSection* section = pEntry.back();
+    pEntry.pop_back();
+    if (!m_ReferencedSections.insert(section).second)
+      continue;
+
+    SectionIndexMap::const_iterator index = m_EdgeIndex.find(section);
+    if (m_EdgeIndex.end() == index)
+      continue;
+
+    const SectionVecTy& edges = m_Edges[index->second];
+    SectionVecTy::const_iterator to, toEnd = edges.end();
+    for (to = edges.begin(); to != toEnd; ++to) {
+      if (0 == m_ReferencedSections.count(*to))
+        pEntry.push_back(*to);
+    }
+  }
+}
+
+void GarbageCollection::stripSections()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (isCollectable(**sect) && 0 == m_ReferencedSections.count(*sect))
+        (*sect)->setKind(LDFileFormat::Ignore);
+    }
+  }
+
+  // The relocations of the kept non-allocatable sections (e.g., debug
+  // sections) and the FDEs of the stripped functions may still refer to the
+  // stripped sections. Their symbols resolve to zero, as if they were
+  // defined in a discarded group section.
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext* context = (*obj)->context();
+    for (size_t idx = 0; idx < context->numOfSymbols(); ++idx) {
+      LDSymbol* symbol = context->getSymbol(idx);
+      if (NULL == symbol)
+        continue;
+
+      if (isDead(*symbol)) {
+        symbol->setFragmentRef(FragmentRef::Null());
+        symbol->setValue(0x0);
+      }
+
+      LDSymbol* out_symbol = symbol->resolveInfo()->outSymbol();
+      if (NULL != out_symbol && isDead(*out_symbol)) {
+        out_symbol->setFragmentRef(FragmentRef::Null());
+        out_symbol->setValue(0x0);
+      }
+    }
+  }
+}
+
+bool GarbageCollection::isKept(const Input& pInput,
+                               const LDSection& pSection) const
+{
+  if (IsInitFini(pSection) || IsCIdentifier(pSection.name()))
+    return true;
+
+  // KEEP() in the linker script
+  const SectionMap& section_map = m_Module.getScript().sectionMap();
+  if (section_map.empty())
+    return false;
+  SectionMap::const_mapping pair =
+    section_map.find(pInput.path().native(), pSection.name());
+  return (NULL != pair.second && InputSectDesc::Keep == pair.second->policy());
+}
+
+void GarbageCollection::addEntrySymbol(const LDSymbol* pSymbol,
+                                       SectionVecTy& pEntry) const
+{
+  if (NULL == pSymbol)
+    return;
+
+  const LDSection* section = getSymbolSection(*pSymbol);
+  if (NULL != section && isCollectable(*section))
+    pEntry.push_back(section);
+}
+
+void GarbageCollection::addEdge(const LDSection& pFrom, const LDSection& pTo)
+{
+  std::pair<SectionIndexMap::iterator, bool> index =
+    m_EdgeIndex.insert(std::make_pair(&pFrom, m_Edges.size()));
+  if (index.second)
+    m_Edges.push_back(SectionVecTy());
+  m_Edges[index.first->second].push_back(&pTo);
+}
+
+const LDSection*
+GarbageCollection::getTargetSection(const Relocation& pReloc)
+{
+  const ResolveInfo* info = pReloc.symInfo();
+  if (NULL == info || !info->isDefine())
+    return NULL;
+
+  const LDSymbol* symbol = info->outSymbol();
+  if (NULL == symbol)
+    return NULL;
+
+  return getSymbolSection(*symbol);
+}
+
+bool GarbageCollection::isDead(const LDSymbol& pSymbol)
+{
+  const LDSection* section = getSymbolSection(pSymbol);
+  return (NULL != section && LDFileFormat::Ignore == section->kind());
+}
+
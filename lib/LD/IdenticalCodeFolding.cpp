@@ -0,0 +1,492 @@
+//===- IdenticalCodeFolding.cpp -------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/IdenticalCodeFolding.h>
+#include <mcld/Fragment/Fragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/NamePool.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/Relocator.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Support/MemoryRegion.h>
+#include <mcld/Target/TargetLDBackend.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/Module.h>
+
+#include <llvm/ADT/Hashing.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <functional>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding::StaticLess
+//===----------------------------------------------------------------------===//
+/// StaticLess - order the candidates by everything except the classes of the
+/// referred candidates.
+class IdenticalCodeFolding::StaticLess
+{
+public:
+  explicit StaticLess(const CandidateList& pCandidates)
+    : m_Candidates(pCandidates) { }
+
+  bool operator()(int pX, int pY) const
+  {
+    const Candidate& x = m_Candidates[pX];
+    const Candidate& y = m_Candidates[pY];
+    if (x.hash != y.hash)
+      return x.hash < y.hash;
+
+    const LDSection& xs = *x.section;
+    const LDSection& ys = *y.section;
+    if (xs.size() != ys.size())
+      return xs.size() < ys.size();
+    if (xs.align() != ys.align())
+      return xs.align() < ys.align();
+    if (xs.flag() != ys.flag())
+      return xs.flag() < ys.flag();
+
+    int content = x.content.compare(y.content);
+    if (0 != content)
+      return content < 0;
+
+    if (x.refs.size() != y.refs.size())
+      return x.refs.size() < y.refs.size();
+
+    std::less<const void*> ptr_less;
+    for (size_t i = 0; i < x.refs.size(); ++i) {
+      const Reference& xr = x.refs[i];
+      const Reference& yr = y.refs[i];
+      if (xr.offset != yr.offset)
+        return xr.offset < yr.offset;
+      if (xr.type != yr.type)
+        return xr.type < yr.type;
+      if (xr.addend != yr.addend)
+        return xr.addend < yr.addend;
+      if (xr.target_offset != yr.target_offset)
+        return xr.target_offset < yr.target_offset;
+      if ((xr.candidate < 0) != (yr.candidate < 0))
+        return xr.candidate < 0;
+      if (xr.target != yr.target)
+        return ptr_less(xr.target, yr.target);
+    }
+    return false;
+  }
+
+private:
+  const CandidateList& m_Candidates;
+};
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding::ClassLess
+//===----------------------------------------------------------------------===//
+/// ClassLess - order the candidates in the same class by the classes of the
+/// referred candidates.
+class IdenticalCodeFolding::ClassLess
+{
+public:
+  ClassLess(const CandidateList& pCandidates, const std::vector<int>& pClass)
+    : m_Candidates(pCandidates), m_Class(pClass) { }
+
+  bool operator()(int pX, int pY) const
+  {
+    int cmp = compare(pX, pY);
+    return (0 != cmp) ? (cmp < 0) : (pX < pY);
+  }
+
+  bool equal(int pX, int pY) const
+  { return 0 == compare(pX, pY); }
+
+private:
+  int compare(int pX, int pY) const
+  {
+    const ReferenceList& x = m_Candidates[pX].refs;
+    const ReferenceList& y = m_Candidates[pY].refs;
+    for (size_t i = 0; i < x.size(); ++i) {
+      if (x[i].candidate < 0)
+        continue;
+      int xc = m_Class[x[i].candidate];
+      int yc = m_Class[y[i].candidate];
+      if (xc != yc)
+        return (xc < yc) ? -1 : 1;
+    }
+    return 0;
+  }
+
+private:
+  const CandidateList& m_Candidates;
+  const std::vector<int>& m_Class;
+};
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding
+//===----------------------------------------------------------------------===//
+IdenticalCodeFolding::IdenticalCodeFolding(const LinkerConfig& pConfig,
+                                           TargetLDBackend& pBackend,
+                                           Module& pModule)
+  : m_Config(pConfig), m_Backend(pBackend), m_Module(pModule) {
+}
+
+IdenticalCodeFolding::~IdenticalCodeFolding()
+{
+}
+
+size_t IdenticalCodeFolding::foldIdenticalCode()
+{
+  if (GeneralOptions::ICF_Safe == m_Config.options().getICFMode())
+    findAddressTakenSections();
+
+  findCandidates();
+  if (m_Candidates.size() < 2)
+    return 0;
+  setUpReferences();
+
+  // iterate to the fixed point
+  std::vector<int> order, cls;
+  partition(order, cls);
+  while (refine(order, cls))
+    ;
+
+  return foldSections(order, cls);
+}
+
+void IdenticalCodeFolding::findAddressTakenSections()
+{
+  // 1. the sections referred by the relocations which may take the address.
+  // References from .eh_frame and the non-allocatable sections do not call
+  // or compare functions.
+  Relocator* relocator = m_Backend.getRelocator();
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+
+      const LDSection* apply = (*rs)->getLink();
+      if (NULL == apply ||
+          LDFileFormat::Ignore == apply->kind() ||
+          LDFileFormat::EhFrame == apply->kind() ||
+          0 == (apply->flag() & llvm::ELF::SHF_ALLOC))
+        continue;
+
+      RelocData::const_iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        const Relocation& relocation = *llvm::cast<Relocation>(reloc);
+        uint64_t offset = 0;
+        const LDSection* target = getTarget(relocation, offset);
+        if (NULL != target &&
+            relocator->mayHaveFunctionPointerAccess(relocation))
+          m_AddressTaken.insert(target);
+      }
+    }
+  }
+
+  // 2. the sections defining the symbols which other modules may refer to
+  std::vector<const LDSymbol*> exported;
+  if (LinkerConfig::DynObj == m_Config.codeGenType() ||
+      m_Config.options().exportDynamic()) {
+    Module::const_sym_iterator symbol, symEnd = m_Module.sym_end();
+    for (symbol = m_Module.sym_begin(); symbol != symEnd; ++symbol) {
+      const ResolveInfo* info = (*symbol)->resolveInfo();
+      if (!info->isLocal() &&
+          ResolveInfo::Hidden != info->visibility() &&
+          ResolveInfo::Internal != info->visibility())
+        exported.push_back(*symbol);
+    }
+  }
+
+  const NamePool::DynRefList& dyn_refs = m_Module.getNamePool().dynRefs();
+  NamePool::DynRefList::const_iterator ref, refEnd = dyn_refs.end();
+  for (ref = dyn_refs.begin(); ref != refEnd; ++ref)
+    exported.push_back((*ref)->outSymbol());
+
+  std::vector<const LDSymbol*>::iterator sym, symEnd = exported.end();
+  for (sym = exported.begin(); sym != symEnd; ++sym) {
+    if (NULL == *sym)
+      continue;
+    const LDSection* section = getSymbolSection(**sym);
+    if (NULL != section)
+      m_AddressTaken.insert(section);
+  }
+}
+
+bool IdenticalCodeFolding::isCandidate(const LDSection& pSection) const
+{
+  if (LDFileFormat::Regular != pSection.kind() ||
+      0 == pSection.size() ||
+      !pSection.hasSectionData() ||
+      !llvm::StringRef(pSection.name()).startswith(".text."))
+    return false;
+
+  uint32_t flags = llvm::ELF::SHF_ALLOC | llvm::ELF::SHF_EXECINSTR;
+  if (flags != (pSection.flag() & flags))
+    return false;
+
+  if (0 != m_AddressTaken.count(&pSection))
+    return false;
+
+  // Only the sections read as a single region. The readers put an alignment
+  // and a null fragment around it.
+  const RegionFragment* region = NULL;
+  SectionData::const_iterator frag, fragEnd = pSection.getSectionData()->end();
+  for (frag = pSection.getSectionData()->begin(); frag != fragEnd; ++frag) {
+    switch (frag->getKind()) {
+      case Fragment::Alignment:
+      case Fragment::Null:
+        break;
+      case Fragment::Region:
+        if (NULL != region)
+          return false;
+        region = llvm::cast<RegionFragment>(&*frag);
+        break;
+      default:
+        return false;
+    }
+  }
+  return (NULL != region &&
+          0 == region->getOffset() &&
+          pSection.size() == region->getRegion().size());
+}
+
+void IdenticalCodeFolding::findCandidates()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (!isCandidate(**sect))
+        continue;
+
+      const RegionFragment* region = NULL;
+      SectionData::iterator frag, fragEnd = (*sect)->getSectionData()->end();
+      for (frag = (*sect)->getSectionData()->begin(); frag != fragEnd; ++frag) {
+        if (NULL != (region = llvm::dyn_cast<RegionFragment>(&*frag)))
+          break;
+      }
+
+      Candidate candidate;
+      candidate.section = *sect;
+      candidate.content =
+        llvm::StringRef(reinterpret_cast<const char*>(
+                          region->getRegion().start()),
+                        region->getRegion().size());
+      candidate.hash = 0;
+      m_CandidateMap[*sect] = m_Candidates.size();
+      m_Candidates.push_back(candidate);
+    }
+  }
+}
+
+void IdenticalCodeFolding::setUpReferences()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+
+      CandidateMap::iterator apply = m_CandidateMap.find((*rs)->getLink());
+      if (m_CandidateMap.end() == apply)
+        continue;
+
+      ReferenceList& refs = m_Candidates[apply->second].refs;
+      RelocData::const_iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        const Relocation& relocation = *llvm::cast<Relocation>(reloc);
+        Reference ref;
+        ref.offset = relocation.targetRef().frag()->getOffset() +
+                     relocation.targetRef().offset();
+        ref.type = relocation.type();
+        ref.addend = relocation.addend();
+        ref.target_offset = 0;
+        ref.candidate = -1;
+
+        const LDSection* target = getTarget(relocation, ref.target_offset);
+        if (NULL == target) {
+          ref.target = relocation.symInfo();
+        }
+        else {
+          CandidateMap::iterator to = m_CandidateMap.find(target);
+          if (m_CandidateMap.end() == to) {
+            ref.target = target;
+          }
+          else {
+            // decided by the class of the candidate
+            ref.target = NULL;
+            ref.candidate = to->second;
+          }
+        }
+        refs.push_back(ref);
+      }
+    }
+  }
+
+  CandidateList::iterator cand, candEnd = m_Candidates.end();
+  for (cand = m_Candidates.begin(); cand != candEnd; ++cand) {
+    std::stable_sort(cand->refs.begin(), cand->refs.end());
+
+    llvm::hash_code hash = llvm::hash_combine(cand->section->size(),
+                                              cand->section->align(),
+                                              cand->section->flag(),
+                                              cand->content);
+    ReferenceList::const_iterator ref, refEnd = cand->refs.end();
+    for (ref = cand->refs.begin(); ref != refEnd; ++ref) {
+      hash = llvm::hash_combine(hash, ref->offset, ref->type, ref->addend,
+                                ref->target_offset, ref->target);
+    }
+    cand->hash = hash;
+  }
+}
+
+void IdenticalCodeFolding::partition(std::vector<int>& pOrder,
+                                     std::vector<int>& pClass) const
+{
+  pOrder.resize(m_Candidates.size());
+  pClass.resize(m_Candidates.size());
+  for (size_t i = 0; i < m_Candidates.size(); ++i)
+    pOrder[i] = i;
+
+  StaticLess less(m_Candidates);
+  std::sort(pOrder.begin(), pOrder.end(), less);
+
+  int cls = 0;
+  pClass[pOrder[0]] = cls;
+  for (size_t i = 1; i < pOrder.size(); ++i) {
+    if (less(pOrder[i - 1], pOrder[i]))
+      ++cls;
+    pClass[pOrder[i]] = cls;
+  }
+}
+
+bool IdenticalCodeFolding::refine(std::vector<int>& pOrder,
+                                  std::vector<int>& pClass) const
+{
+  // The classes of this round are decided by the classes of the last round.
+  std::vector<int> last(pClass);
+  int num_classes = 0;
+  for (size_t i = 0; i < pOrder.size(); ++i)
+    num_classes = std::max(num_classes, last[i] + 1);
+
+  ClassLess less(m_Candidates, last);
+  bool changed = false;
+  size_t begin = 0;
+  while (begin < pOrder.size()) {
+    size_t end = begin + 1;
+    while (end < pOrder.size() && last[pOrder[end]] == last[pOrder[begin]])
+      ++end;
+
+    if (end - begin > 1) {
+      std::sort(pOrder.begin() + begin, pOrder.begin() + end, less);
+      for (size_t i = begin + 1; i < end; ++i) {
+        if (less.equal(pOrder[i - 1], pOrder[i]))
+          pClass[pOrder[i]] = pClass[pOrder[i - 1]];
+        else {
+          pClass[pOrder[i]] = num_classes++;
+          changed = true;
+        }
+      }
+    }
+    begin = end;
+  }
+  return changed;
+}
+
+size_t IdenticalCodeFolding::foldSections(const std::vector<int>& pOrder,
+                                          const std::vector<int>& pClass)
+{
+  // fold each class into its member which comes first in the input order
+  llvm::DenseMap<const LDSection*, LDSection*> folded;
+  size_t begin = 0;
+  while (begin < pOrder.size()) {
+    size_t end = begin + 1;
+    int kept = pOrder[begin];
+    while (end < pOrder.size() && pClass[pOrder[end]] == pClass[kept]) {
+      kept = std::min(kept, pOrder[end]);
+      ++end;
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+      if (pOrder[i] == kept)
+        continue;
+      LDSection* section = m_Candidates[pOrder[i]].section;
+      section->setKind(LDFileFormat::Ignore);
+      folded[section] = m_Candidates[kept].section;
+    }
+    begin = end;
+  }
+
+  if (folded.empty())
+    return 0;
+
+  // redirect the symbols defined in the folded sections
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext* context = (*obj)->context();
+    for (size_t idx = 0; idx < context->numOfSymbols(); ++idx) {
+      LDSymbol* symbol = context->getSymbol(idx);
+      if (NULL == symbol)
+        continue;
+
+      LDSymbol* out_symbol = symbol->resolveInfo()->outSymbol();
+      LDSymbol* symbols[2] = { symbol, out_symbol };
+      for (int i = 0; i < 2; ++i) {
+        if (NULL == symbols[i])
+          continue;
+        const LDSection* section = getSymbolSection(*symbols[i]);
+        if (NULL == section)
+          continue;
+        llvm::DenseMap<const LDSection*, LDSection*>::iterator kept =
+          folded.find(section);
+        if (folded.end() != kept)
+          redirect(*symbols[i], *kept->second);
+      }
+    }
+  }
+  return folded.size();
+}
+
+void IdenticalCodeFolding::redirect(LDSymbol& pSymbol, LDSection& pKept)
+{
+  // The kept section has the same layout, so the offset is the same.
+  uint64_t offset = pSymbol.fragRef()->frag()->getOffset() +
+                    pSymbol.fragRef()->offset();
+  pSymbol.setFragmentRef(FragmentRef::Create(pKept, offset));
+}
+
+const LDSection* IdenticalCodeFolding::getTarget(const Relocation& pReloc,
+                                                 uint64_t& pOffset)
+{
+  const ResolveInfo* info = pReloc.symInfo();
+  if (NULL == info || !info->isDefine())
+    return NULL;
+
+  const LDSymbol* symbol = info->outSymbol();
+  if (NULL == symbol)
+    return NULL;
+
+  const LDSection* section = getSymbolSection(*symbol);
+  if (NULL == section)
+    return NULL;
+
+  pOffset = symbol->fragRef()->frag()->getOffset() +
+            symbol->fragRef()->offset();
+  return section;
+}
@@ -7,16 +7,26 @@
 //
 //===----------------------------------------------------------------------===//
 #include <mcld/LD/LDSection.h>
+#include <mcld/Support/LinkContext.h>
 
 #include <mcld/Support/GCFactory.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 using namespace mcld;
 
 typedef GCFactory<LDSection, MCLD_SECTIONS_PER_INPUT> SectionFactory;
 
-static llvm::ManagedStatic<SectionFactory> g_SectFactory;
+static inline SectionFactory& GetSectFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<SectionFactory>(LinkContext::LDSectionArena);
+}
+
+static inline LinkContext::Lock& GetSectFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::LDSectionArena);
+}
 
 //===----------------------------------------------------------------------===//
 // LDSection
@@ -30,6 +40,7 @@ LDSection::LDSection()
     m_Offset(~uint64_t(0)),
     m_Addr(0x0),
     m_Align(0),
+    m_EntSize(0),
     m_Info(0),
     m_pLink(NULL),
     m_Index(0) {
@@ -50,6 +61,7 @@ LDSection::LDSection(const std::string& pName,
     m_Offset(~uint64_t(0)),
     m_Addr(pAddr),
     m_Align(0),
+    m_EntSize(0),
     m_Info(0),
     m_pLink(NULL),
     m_Index(0) {
@@ -72,21 +84,23 @@ LDSection* LDSection::Create(const std::string& pName,
                              uint64_t pSize,
                              uint64_t pAddr)
 {
-  LDSection* result = g_SectFactory->allocate();
+  llvm::sys::SmartScopedLock<true> locker(GetSectFactoryLock());
+  LDSection* result = GetSectFactory().allocate();
   new (result) LDSection(pName, pKind, pType, pFlag, pSize, pAddr);
   return result;
 }
 
 void LDSection::Destroy(LDSection*& pSection)
 {
-  g_SectFactory->destroy(pSection);
-  g_SectFactory->deallocate(pSection);
+  llvm::sys::SmartScopedLock<true> locker(GetSectFactoryLock());
+  GetSectFactory().destroy(pSection);
+  GetSectFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void LDSection::Clear()
 {
-  g_SectFactory->clear();
+  GetSectFactory().clear();
 }
 
 bool LDSection::hasSectionData() const
@@ -11,7 +11,9 @@
 #include <mcld/Config/Config.h>
 #include <mcld/Fragment/FragmentRef.h>
 #include <mcld/Fragment/NullFragment.h>
+#include <mcld/LD/SectionData.h>
 #include <mcld/Support/GCFactory.h>
+#include <mcld/Support/LinkContext.h>
 
 #include <cstring>
 
@@ -23,7 +25,11 @@ typedef GCFactory<LDSymbol, MCLD_SYMBOLS_PER_INPUT> LDSymbolFactory;
 
 static llvm::ManagedStatic<LDSymbol> g_NullSymbol;
 static llvm::ManagedStatic<NullFragment> g_NullSymbolFragment;
-static llvm::ManagedStatic<LDSymbolFactory> g_LDSymbolFactory;
+static inline LDSymbolFactory& GetLDSymbolFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<LDSymbolFactory>(LinkContext::LDSymbolArena);
+}
 
 //===----------------------------------------------------------------------===//
 // LDSymbol
@@ -52,7 +58,7 @@ LDSymbol& LDSymbol::operator=(const LDSymbol& pCopy)
 
 LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo)
 {
-  LDSymbol* result = g_LDSymbolFactory->allocate();
+  LDSymbol* result = GetLDSymbolFactory().allocate();
   new (result) LDSymbol();
   result->setResolveInfo(pResolveInfo);
   return result;
@@ -61,19 +67,21 @@ LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo)
 void LDSymbol::Destroy(LDSymbol*& pSymbol)
 {
   pSymbol->~LDSymbol();
-  g_LDSymbolFactory->deallocate(pSymbol);
+  GetLDSymbolFactory().deallocate(pSymbol);
   pSymbol = NULL;
 }
 
 void LDSymbol::Clear()
 {
-  g_LDSymbolFactory->clear();
+  GetLDSymbolFactory().clear();
 }
 
 LDSymbol* LDSymbol::Null()
 {
   // lazy initialization
   if (NULL == g_NullSymbol->resolveInfo()) {
+    // The null symbol outlives any link, so is its fragment reference.
+    LinkContext::Scope scope(LinkContext::Default());
     g_NullSymbol->setResolveInfo(*ResolveInfo::Null());
     g_NullSymbol->setFragmentRef(FragmentRef::Create(*g_NullSymbolFragment, 0));
     ResolveInfo::Null()->setSymPtr(&*g_NullSymbol);
@@ -101,3 +109,14 @@ bool LDSymbol::hasFragRef() const
   return !m_pFragRef->isNull();
 }
 
+const LDSection* mcld::getSymbolSection(const LDSymbol& pSymbol)
+{
+  // The fragment of the null symbol belongs to no section.
+  if (pSymbol.isNull() || !pSymbol.hasFragRef())
+    return NULL;
+
+  const SectionData* data = pSymbol.fragRef()->frag()->getParent();
+  if (NULL == data)
+    return NULL;
+  return &data->getSection();
+}
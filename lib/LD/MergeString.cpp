@@ -0,0 +1,211 @@
+//===- MergeString.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/MergeString.h>
+#include <mcld/ADT/SizeTraits.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/Support/MsgHandling.h>
+
+#include <llvm/ADT/Hashing.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+static inline bool IsTerminator(const char* pData, uint32_t pEntSize)
+{
+  for (uint32_t i = 0; i < pEntSize; ++i) {
+    if ('\0' != pData[i])
+      return false;
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// MergeString
+//===----------------------------------------------------------------------===//
+MergeString::MergeString(uint32_t pEntSize, uint32_t pAlign)
+  : m_EntSize(pEntSize), m_Align((0 == pAlign) ? 1 : pAlign),
+    m_pData(NULL), m_Size(0) {
+  assert(0 != m_EntSize);
+}
+
+MergeString::~MergeString()
+{
+  free(m_pData);
+}
+
+void MergeString::addSection(LDSection& pSection, llvm::StringRef pContent)
+{
+  assert(!pContent.empty() &&
+         IsTerminator(pContent.end() - m_EntSize, m_EntSize));
+
+  m_SectionMap[&pSection] = m_Sections.size();
+  m_Sections.push_back(Section());
+  m_Sections.back().section = &pSection;
+  m_Sections.back().content = pContent;
+}
+
+void MergeString::split(size_t pIdx)
+{
+  Section& sect = m_Sections[pIdx];
+  const char* data = sect.content.data();
+  uint64_t size = sect.content.size();
+
+  uint64_t start = 0;
+  for (uint64_t pos = 0; pos + m_EntSize <= size; pos += m_EntSize) {
+    if (!IsTerminator(data + pos, m_EntSize))
+      continue;
+
+    Piece piece;
+    piece.input_offset = start;
+    piece.output_offset = 0;
+    piece.size = pos + m_EntSize - start;
+    piece.hash = static_cast<uint32_t>(
+      static_cast<size_t>(llvm::hash_value(
+        llvm::StringRef(data + start, piece.size))));
+    piece.owner_sect = pIdx;
+    piece.owner_piece = sect.pieces.size();
+    sect.pieces.push_back(piece);
+    start = pos + m_EntSize;
+  }
+}
+
+llvm::StringRef MergeString::getPiece(uint32_t pSect, uint32_t pPiece) const
+{
+  const Section& sect = m_Sections[pSect];
+  const Piece& piece = sect.pieces[pPiece];
+  return sect.content.substr(piece.input_offset, piece.size);
+}
+
+void MergeString::dedup(unsigned int pShard)
+{
+  // count the pieces in this shard to size the table
+  size_t count = 0;
+  for (size_t s = 0; s < m_Sections.size(); ++s) {
+    const PieceList& pieces = m_Sections[s].pieces;
+    for (size_t p = 0; p < pieces.size(); ++p) {
+      if (pShard == getShard(pieces[p].hash))
+        ++count;
+    }
+  }
+  if (0 == count)
+    return;
+
+  // open addressing with linear probing. A bucket holds the section index
+  // in the high 32 bits and the piece index in the low 32 bits.
+  const uint64_t empty = ~uint64_t(0);
+  std::vector<uint64_t> buckets(llvm::NextPowerOf2(count * 2), empty);
+  uint32_t mask = buckets.size() - 1;
+
+  for (size_t s = 0; s < m_Sections.size(); ++s) {
+    PieceList& pieces = m_Sections[s].pieces;
+    for (size_t p = 0; p < pieces.size(); ++p) {
+      Piece& piece = pieces[p];
+      if (pShard != getShard(piece.hash))
+        continue;
+
+      llvm::StringRef content = getPiece(s, p);
+      uint32_t idx = piece.hash & mask;
+      while (true) {
+        if (empty == buckets[idx]) {
+          // the first occurrence
+          buckets[idx] = (uint64_t(s) << 32) | p;
+          break;
+        }
+
+        uint32_t os = buckets[idx] >> 32;
+        uint32_t op = buckets[idx] & 0xffffffff;
+        if (m_Sections[os].pieces[op].hash == piece.hash &&
+            getPiece(os, op) == content) {
+          piece.owner_sect = os;
+          piece.owner_piece = op;
+          break;
+        }
+        idx = (idx + 1) & mask;
+      }
+    }
+  }
+}
+
+void MergeString::layout()
+{
+  // The owner of a piece always comes before the piece in input order, so
+  // its output offset is known when we meet the piece.
+  uint64_t offset = 0;
+  SectionList::iterator sect, sectEnd = m_Sections.end();
+  for (sect = m_Sections.begin(); sect != sectEnd; ++sect) {
+    PieceList::iterator piece, pieceEnd = sect->pieces.end();
+    for (piece = sect->pieces.begin(); piece != pieceEnd; ++piece) {
+      const Piece& owner =
+        m_Sections[piece->owner_sect].pieces[piece->owner_piece];
+      if (&owner == &*piece) {
+        alignAddress(offset, m_Align);
+        piece->output_offset = offset;
+        offset += piece->size;
+      }
+      else
+        piece->output_offset = owner.output_offset;
+    }
+  }
+
+  m_Size = offset;
+  m_pData = static_cast<uint8_t*>(calloc(1, (0 == m_Size) ? 1 : m_Size));
+  if (NULL == m_pData)
+    fatal(diag::fail_allocate_memory_merge_string);
+
+  for (sect = m_Sections.begin(); sect != sectEnd; ++sect) {
+    PieceList::iterator piece, pieceEnd = sect->pieces.end();
+    for (piece = sect->pieces.begin(); piece != pieceEnd; ++piece) {
+      const Piece& owner =
+        m_Sections[piece->owner_sect].pieces[piece->owner_piece];
+      if (&owner == &*piece)
+        memcpy(m_pData + piece->output_offset,
+               sect->content.data() + piece->input_offset,
+               piece->size);
+    }
+  }
+}
+
+uint64_t MergeString::getOutputOffset(const LDSection& pSection,
+                                      uint64_t pOffset) const
+{
+  SectionMap::const_iterator entry = m_SectionMap.find(&pSection);
+  assert(m_SectionMap.end() != entry);
+
+  // find the last piece starting at or before pOffset
+  const PieceList& pieces = m_Sections[entry->second].pieces;
+  if (pieces.empty())
+    return pOffset;
+
+  size_t low = 0, high = pieces.size();
+  while (high - low > 1) {
+    size_t mid = low + (high - low) / 2;
+    if (pieces[mid].input_offset <= pOffset)
+      low = mid;
+    else
+      high = mid;
+  }
+  return pieces[low].output_offset + (pOffset - pieces[low].input_offset);
+}
+
+uint64_t MergeString::inputSize() const
+{
+  uint64_t size = 0;
+  SectionList::const_iterator sect, sectEnd = m_Sections.end();
+  for (sect = m_Sections.begin(); sect != sectEnd; ++sect)
+    size += sect->content.size();
+  return size;
+}
+
@@ -0,0 +1,380 @@
+//===- MergeStringFactory.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/MergeStringFactory.h>
+#include <mcld/Fragment/Fragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/MergeString.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Object/ObjectBuilder.h>
+#include <mcld/Object/SectionMap.h>
+#include <mcld/Support/MemoryRegion.h>
+#include <mcld/Support/ThreadPool.h>
+#include <mcld/IRBuilder.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/LinkerScript.h>
+#include <mcld/Module.h>
+
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+using namespace mcld;
+
+namespace {
+
+/// SplitTask - split an input section of a MergeString into pieces
+class SplitTask : public ThreadPool::Task
+{
+public:
+  SplitTask(MergeString& pMergeString, size_t pIdx)
+    : m_pMergeString(&pMergeString), m_Idx(pIdx) {
+  }
+
+  void run() { m_pMergeString->split(m_Idx); }
+
+private:
+  MergeString* m_pMergeString;
+  size_t m_Idx;
+};
+
+/// DedupTask - deduplicate a shard of a MergeString
+class DedupTask : public ThreadPool::Task
+{
+public:
+  DedupTask(MergeString& pMergeString, unsigned int pShard)
+    : m_pMergeString(&pMergeString), m_Shard(pShard) {
+  }
+
+  void run() { m_pMergeString->dedup(m_Shard); }
+
+private:
+  MergeString* m_pMergeString;
+  unsigned int m_Shard;
+};
+
+/// LayoutTask - build the merged content of a MergeString
+class LayoutTask : public ThreadPool::Task
+{
+public:
+  explicit LayoutTask(MergeString& pMergeString)
+    : m_pMergeString(&pMergeString) {
+  }
+
+  void run() { m_pMergeString->layout(); }
+
+private:
+  MergeString* m_pMergeString;
+};
+
+template<typename TaskType>
+void RunTasks(std::vector<TaskType>& pTasks, unsigned int pNumOfThreads)
+{
+  ThreadPool::TaskList task_list;
+  task_list.reserve(pTasks.size());
+  typename std::vector<TaskType>::iterator task, taskEnd = pTasks.end();
+  for (task = pTasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(pNumOfThreads);
+  pool.run(task_list);
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// MergeStringFactory::Domain
+//===----------------------------------------------------------------------===//
+bool MergeStringFactory::Domain::operator<(const Domain& pOther) const
+{
+  if (name != pOther.name)
+    return name < pOther.name;
+  if (flag != pOther.flag)
+    return flag < pOther.flag;
+  if (entsize != pOther.entsize)
+    return entsize < pOther.entsize;
+  return align < pOther.align;
+}
+
+//===----------------------------------------------------------------------===//
+// MergeStringFactory
+//===----------------------------------------------------------------------===//
+MergeStringFactory::MergeStringFactory(const LinkerConfig& pConfig,
+                                       Module& pModule)
+  : m_Config(pConfig), m_Module(pModule) {
+}
+
+MergeStringFactory::~MergeStringFactory()
+{
+  std::vector<MergeString*>::iterator ms, msEnd = m_MergeStrings.end();
+  for (ms = m_MergeStrings.begin(); ms != msEnd; ++ms)
+    delete *ms;
+}
+
+uint64_t MergeStringFactory::mergeStrings()
+{
+  SectionSetTy excluded;
+  findExcludedSections(excluded);
+  collectSections(excluded);
+  if (m_MergeStrings.empty())
+    return 0;
+
+  merge();
+
+  // create the fragments of the merged content first, so that symbols can
+  // refer to them.
+  uint64_t saved = 0;
+  std::vector<MergeString*>::iterator ms, msEnd = m_MergeStrings.end();
+  for (ms = m_MergeStrings.begin(); ms != msEnd; ++ms) {
+    m_Fragments[*ms] = IRBuilder::CreateRegion((*ms)->data(), (*ms)->size());
+    saved += (*ms)->inputSize() - (*ms)->size();
+  }
+
+  rewriteRelocations();
+  rewriteSymbols();
+  replaceSections();
+  return saved;
+}
+
+void MergeStringFactory::findExcludedSections(SectionSetTy& pExcluded) const
+{
+  Module::const_obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    const LDContext* context = (*obj)->context();
+    LDContext::const_sect_iterator rs, rsEnd = context->relocSectEnd();
+    for (rs = context->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+
+      // the content of a section with relocations can not be shared
+      if (NULL != (*rs)->getLink())
+        pExcluded.insert((*rs)->getLink());
+
+      if (llvm::ELF::SHT_REL != (*rs)->type())
+        continue;
+
+      RelocData::const_iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        const ResolveInfo* info = llvm::cast<Relocation>(reloc)->symInfo();
+        if (ResolveInfo::Section != info->type() || NULL == info->outSymbol())
+          continue;
+        const LDSection* target = getSymbolSection(*info->outSymbol());
+        if (NULL != target)
+          pExcluded.insert(target);
+      }
+    }
+  }
+}
+
+bool MergeStringFactory::getContent(const LDSection& pSection,
+                                    llvm::StringRef& pContent) const
+{
+  if (LDFileFormat::Regular != pSection.kind() &&
+      LDFileFormat::Debug != pSection.kind())
+    return false;
+
+  uint32_t flags = llvm::ELF::SHF_MERGE | llvm::ELF::SHF_STRINGS;
+  if (flags != (pSection.flag() & flags) ||
+      0 == pSection.entSize() ||
+      0 == pSection.size() ||
+      0 != (pSection.size() % pSection.entSize()) ||
+      !pSection.hasSectionData())
+    return false;
+
+  // the readers read a mergeable section as a single region
+  const RegionFragment* region = NULL;
+  SectionData::const_iterator frag, fragEnd = pSection.getSectionData()->end();
+  for (frag = pSection.getSectionData()->begin(); frag != fragEnd; ++frag) {
+    switch (frag->getKind()) {
+      case Fragment::Alignment:
+      case Fragment::Null:
+        break;
+      case Fragment::Region:
+        if (NULL != region)
+          return false;
+        region = llvm::cast<RegionFragment>(&*frag);
+        break;
+      default:
+        return false;
+    }
+  }
+  if (NULL == region ||
+      0 != region->getOffset() ||
+      pSection.size() != region->getRegion().size())
+    return false;
+
+  llvm::StringRef content(
+    reinterpret_cast<const char*>(region->getRegion().start()),
+    region->getRegion().size());
+
+  // the last string must be terminated
+  llvm::StringRef last = content.substr(content.size() - pSection.entSize());
+  if (last.find_first_not_of('\0') != llvm::StringRef::npos)
+    return false;
+
+  pContent = content;
+  return true;
+}
+
+void MergeStringFactory::collectSections(const SectionSetTy& pExcluded)
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      llvm::StringRef content;
+      if (0 != pExcluded.count(*sect) || !getContent(**sect, content))
+        continue;
+
+      // merge the sections going to the same output section, as
+      // ObjectBuilder::MergeSection will do.
+      SectionMap::const_mapping pair =
+        m_Module.getScript().sectionMap().find((*obj)->path().native(),
+                                               (*sect)->name());
+      if (NULL != pair.first && pair.first->isDiscard())
+        continue;
+
+      Domain domain;
+      domain.name = (NULL == pair.first) ? (*sect)->name()
+                                         : pair.first->name();
+      domain.flag = (*sect)->flag();
+      domain.entsize = (*sect)->entSize();
+      domain.align = (*sect)->align();
+
+      DomainMap::iterator entry = m_Domains.find(domain);
+      if (m_Domains.end() == entry) {
+        MergeString* ms = new MergeString(domain.entsize, domain.align);
+        m_MergeStrings.push_back(ms);
+        entry = m_Domains.insert(std::make_pair(domain, ms)).first;
+      }
+      entry->second->addSection(**sect, content);
+      m_SectionMap[*sect] = entry->second;
+    }
+  }
+}
+
+void MergeStringFactory::merge()
+{
+  unsigned int threads = m_Config.options().numOfThreads();
+
+  std::vector<SplitTask> split_tasks;
+  std::vector<DedupTask> dedup_tasks;
+  std::vector<LayoutTask> layout_tasks;
+  std::vector<MergeString*>::iterator ms, msEnd = m_MergeStrings.end();
+  for (ms = m_MergeStrings.begin(); ms != msEnd; ++ms) {
+    for (size_t idx = 0; idx < (*ms)->numOfSections(); ++idx)
+      split_tasks.push_back(SplitTask(**ms, idx));
+    for (unsigned int shard = 0; shard < MergeString::NumOfShards; ++shard)
+      dedup_tasks.push_back(DedupTask(**ms, shard));
+    layout_tasks.push_back(LayoutTask(**ms));
+  }
+
+  RunTasks(split_tasks, threads);
+  RunTasks(dedup_tasks, threads);
+  RunTasks(layout_tasks, threads);
+}
+
+void MergeStringFactory::rewriteRelocations()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        const ResolveInfo* info = relocation->symInfo();
+        if (ResolveInfo::Section != info->type() || NULL == info->outSymbol())
+          continue;
+
+        const LDSection* target = getSymbolSection(*info->outSymbol());
+        if (NULL == target)
+          continue;
+        MergeStringMap::iterator entry = m_SectionMap.find(target);
+        if (m_SectionMap.end() == entry)
+          continue;
+
+        // The addend is the offset in the section. Leave the out-of-range
+        // ones alone as we can not tell which string they refer to.
+        if (relocation->addend() <= target->size())
+          relocation->setAddend(
+            entry->second->getOutputOffset(*target, relocation->addend()));
+      }
+    }
+  }
+}
+
+void MergeStringFactory::rewriteSymbols()
+{
+  // An output symbol may be visited from several inputs. Once moved, it
+  // refers to the first section of the MergeString, so move it only once.
+  llvm::DenseSet<LDSymbol*> moved;
+
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext* context = (*obj)->context();
+    for (size_t idx = 0; idx < context->numOfSymbols(); ++idx) {
+      LDSymbol* symbol = context->getSymbol(idx);
+      if (NULL == symbol)
+        continue;
+
+      LDSymbol* symbols[2] = { symbol, symbol->resolveInfo()->outSymbol() };
+      for (int i = 0; i < 2; ++i) {
+        if (NULL == symbols[i])
+          continue;
+
+        const LDSection* section = getSymbolSection(*symbols[i]);
+        if (NULL == section)
+          continue;
+        MergeStringMap::iterator entry = m_SectionMap.find(section);
+        if (m_SectionMap.end() == entry || !moved.insert(symbols[i]).second)
+          continue;
+
+        // A section symbol stands for the beginning of the merged content,
+        // the addends of the relocations against it are mapped already.
+        uint64_t offset = 0;
+        if (ResolveInfo::Section != symbols[i]->resolveInfo()->type()) {
+          const FragmentRef* ref = symbols[i]->fragRef();
+          offset = entry->second->getOutputOffset(*section,
+                                                  ref->frag()->getOffset() +
+                                                  ref->offset());
+        }
+        symbols[i]->setFragmentRef(
+          FragmentRef::Create(*m_Fragments[entry->second], offset));
+      }
+    }
+  }
+}
+
+void MergeStringFactory::replaceSections()
+{
+  std::vector<MergeString*>::iterator ms, msEnd = m_MergeStrings.end();
+  for (ms = m_MergeStrings.begin(); ms != msEnd; ++ms) {
+    // the first input section holds the merged content
+    LDSection& leader = (*ms)->getSection(0);
+    SectionData* data = leader.getSectionData();
+    data->getFragmentList().clear();
+    ObjectBuilder::AppendFragment(*m_Fragments[*ms], *data);
+    leader.setSize((*ms)->size());
+
+    for (size_t idx = 1; idx < (*ms)->numOfSections(); ++idx)
+      (*ms)->getSection(idx).setKind(LDFileFormat::Ignore);
+  }
+}
+
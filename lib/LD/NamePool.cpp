@@ -10,6 +10,8 @@
 #include <mcld/LD/NamePool.h>
 #include <mcld/LD/StaticResolver.h>
 
+#include <cassert>
+
 using namespace mcld;
 
 //===----------------------------------------------------------------------===//
@@ -64,34 +66,47 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
                               ResolveInfo* pOldInfo,
                               Resolver::Result& pResult)
 {
+  insertSymbol(pName, Hash(pName), pIsDyn, pType, pDesc, pBinding, pSize,
+               pValue, pVisibility, pOldInfo, pResult);
+}
+
+/// insertSymbol - insert a symbol whose hash value is pHash
+void NamePool::insertSymbol(const llvm::StringRef& pName,
+                            uint32_t pHash,
+                            bool pIsDyn,
+                            ResolveInfo::Type pType,
+                            ResolveInfo::Desc pDesc,
+                            ResolveInfo::Binding pBinding,
+                            ResolveInfo::SizeType pSize,
+                            LDSymbol::ValueType pValue,
+                            ResolveInfo::Visibility pVisibility,
+                            ResolveInfo* pOldInfo,
+                            Resolver::Result& pResult)
+{
+  assert(pHash == Hash(pName));
   // We should check if there is any symbol with the same name existed.
   // If it already exists, we should use resolver to decide which symbol
   // should be reserved. Otherwise, we insert the symbol and set up its
   // attributes.
   bool exist = false;
-  ResolveInfo* old_symbol = m_Table.insert(pName, exist);
-  ResolveInfo* new_symbol = NULL;
-  if (exist && old_symbol->isSymbol()) {
-    new_symbol = m_Table.getEntryFactory().produce(pName);
-  }
-  else {
-    exist = false;
-    new_symbol = old_symbol;
-  }
-
-  new_symbol->setIsSymbol(true);
-  new_symbol->setSource(pIsDyn);
-  new_symbol->setType(pType);
-  new_symbol->setDesc(pDesc);
-  new_symbol->setBinding(pBinding);
-  new_symbol->setVisibility(pVisibility);
-  new_symbol->setSize(pSize);
-
-  if (!exist) {
+  ResolveInfo* old_symbol = m_Table.insert(pName, pHash, exist);
+  if (!exist || !old_symbol->isSymbol()) {
     // old_symbol is neither existed nor a symbol.
-    pResult.info      = new_symbol;
+    old_symbol->setIsSymbol(true);
+    old_symbol->setSource(pIsDyn);
+    old_symbol->setType(pType);
+    old_symbol->setDesc(pDesc);
+    old_symbol->setBinding(pBinding);
+    old_symbol->setVisibility(pVisibility);
+    old_symbol->setSize(pSize);
+
+    pResult.info      = old_symbol;
     pResult.existent  = false;
     pResult.overriden = true;
+    if (old_symbol->isUndef() && !old_symbol->isWeak())
+      m_Undefs.push_back(old_symbol);
+    if (pIsDyn)
+      m_DynRefs.push_back(old_symbol);
     return;
   }
   else if (NULL != pOldInfo) {
@@ -99,21 +114,49 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
     pOldInfo->override(*old_symbol);
   }
 
-  // exist and is a symbol
+  // exist and is a symbol. The new symbol has the same name, so resolve
+  // only its attributes. They override old_symbol in place.
+  SymbolDescriptor new_symbol;
+  new_symbol.setIsSymbol(true);
+  new_symbol.setSource(pIsDyn);
+  new_symbol.setType(pType);
+  new_symbol.setDesc(pDesc);
+  new_symbol.setBinding(pBinding);
+  new_symbol.setVisibility(pVisibility);
+  new_symbol.setSize(pSize);
+
   // symbol resolution
   bool override = false;
   unsigned int action = Resolver::LastAction;
-  if (m_pResolver->resolve(*old_symbol, *new_symbol, override, pValue)) {
+  if (m_pResolver->resolve(*old_symbol, new_symbol, override, pValue)) {
     pResult.info      = old_symbol;
     pResult.existent  = true;
     pResult.overriden = override;
   }
   else {
-      m_pResolver->resolveAgain(*this, action, *old_symbol, *new_symbol, pResult);
+      m_pResolver->resolveAgain(*this, action, *old_symbol, new_symbol, pResult);
   }
 
-  m_Table.getEntryFactory().destroy(new_symbol);
-  return;
+  // a weak or dynamic undefined symbol may be overriden by a non-weak
+  // undefined one, and then archive members defining it are needed
+  if (pResult.overriden && pResult.info->isUndef() && !pResult.info->isWeak())
+    m_Undefs.push_back(pResult.info);
+
+  if (pIsDyn)
+    m_DynRefs.push_back(pResult.info);
+}
+
+/// Scan - get a null-terminated name and its hash value in one pass
+llvm::StringRef NamePool::Scan(const char* pStr, uint32_t& pHash)
+{
+  // the same as hash::StringHash<hash::DJB>
+  uint32_t hash_val = 5381;
+  const char* cur = pStr;
+  for (; '\0' != *cur; ++cur)
+    hash_val = ((hash_val << 5) + hash_val) + *cur;
+
+  pHash = hash_val;
+  return llvm::StringRef(pStr, cur - pStr);
 }
 
 llvm::StringRef NamePool::insertString(const llvm::StringRef& pString)
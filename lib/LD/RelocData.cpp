@@ -8,14 +8,24 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/LD/RelocData.h>
 #include <mcld/Support/GCFactory.h>
+#include <mcld/Support/LinkContext.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 using namespace mcld;
 
 typedef GCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
 
-static llvm::ManagedStatic<RelocDataFactory> g_RelocDataFactory;
+static inline RelocDataFactory& GetRelocDataFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<RelocDataFactory>(LinkContext::RelocDataArena);
+}
+
+static inline LinkContext::Lock& GetRelocDataFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::RelocDataArena);
+}
 
 //===----------------------------------------------------------------------===//
 // RelocData
@@ -30,21 +40,23 @@ RelocData::RelocData(LDSection &pSection)
 
 RelocData* RelocData::Create(LDSection& pSection)
 {
-  RelocData* result = g_RelocDataFactory->allocate();
+  llvm::sys::SmartScopedLock<true> locker(GetRelocDataFactoryLock());
+  RelocData* result = GetRelocDataFactory().allocate();
   new (result) RelocData(pSection);
   return result;
 }
 
 void RelocData::Destroy(RelocData*& pSection)
 {
+  llvm::sys::SmartScopedLock<true> locker(GetRelocDataFactoryLock());
   pSection->~RelocData();
-  g_RelocDataFactory->deallocate(pSection);
+  GetRelocDataFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void RelocData::Clear()
 {
-  g_RelocDataFactory->clear();
+  GetRelocDataFactory().clear();
 }
 
 RelocData& RelocData::append(Relocation& pRelocation)
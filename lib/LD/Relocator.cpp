@@ -12,6 +12,7 @@
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/Module.h>
+#include <mcld/Support/MsgHandling.h>
 
 using namespace mcld;
 
@@ -46,3 +47,32 @@ void Relocator::partialScanRelocation(Relocation& pReloc,
   }
 }
 
+void Relocator::reportResult(const Relocation& pReloc, Result pResult) const
+{
+  switch (pResult) {
+    case OK: {
+      // do nothing
+      return;
+    }
+    case Overflow: {
+      error(diag::result_overflow) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case BadReloc: {
+      error(diag::result_badreloc) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case Unsupport: {
+      fatal(diag::unsupported_relocation) << pReloc.type()
+                                          << "mclinker@googlegroups.com";
+      return;
+    }
+    case Unknown: {
+      fatal(diag::unknown_relocation) << pReloc.type()
+                                      << pReloc.symInfo()->name();
+      return;
+    }
+  } // end of switch
+}
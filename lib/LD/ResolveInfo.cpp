@@ -19,25 +19,21 @@ using namespace mcld;
 static ResolveInfo* g_NullResolveInfo = NULL;
 
 //===----------------------------------------------------------------------===//
-// ResolveInfo
+// SymbolDescriptor
 //===----------------------------------------------------------------------===//
-ResolveInfo::ResolveInfo()
+SymbolDescriptor::SymbolDescriptor()
   : m_Size(0), m_BitField(0) {
   m_Ptr.sym_ptr = 0;
 }
 
-ResolveInfo::~ResolveInfo()
-{
-}
-
-void ResolveInfo::override(const ResolveInfo& pFrom)
+void SymbolDescriptor::override(const SymbolDescriptor& pFrom)
 {
   m_Size = pFrom.m_Size;
   overrideAttributes(pFrom);
   overrideVisibility(pFrom);
 }
 
-void ResolveInfo::overrideAttributes(const ResolveInfo& pFrom)
+void SymbolDescriptor::overrideAttributes(const SymbolDescriptor& pFrom)
 {
   m_BitField &= ~RESOLVE_MASK;
   m_BitField |= (pFrom.m_BitField & RESOLVE_MASK);
@@ -45,7 +41,7 @@ void ResolveInfo::overrideAttributes(const ResolveInfo& pFrom)
 
 /// overrideVisibility - override the visibility
 ///   always use the most strict visibility
-void ResolveInfo::overrideVisibility(const ResolveInfo& pFrom)
+void SymbolDescriptor::overrideVisibility(const SymbolDescriptor& pFrom)
 {
   // Reference: Google gold linker: resolve.cc
   //
@@ -72,17 +68,17 @@ void ResolveInfo::overrideVisibility(const ResolveInfo& pFrom)
   }
 }
 
-void ResolveInfo::setRegular()
+void SymbolDescriptor::setRegular()
 {
   m_BitField &= (~dynamic_flag);
 }
 
-void ResolveInfo::setDynamic()
+void SymbolDescriptor::setDynamic()
 {
   m_BitField |= dynamic_flag;
 }
 
-void ResolveInfo::setSource(bool pIsDyn)
+void SymbolDescriptor::setSource(bool pIsDyn)
 {
   if (pIsDyn)
     m_BitField |= dynamic_flag;
@@ -90,19 +86,19 @@ void ResolveInfo::setSource(bool pIsDyn)
     m_BitField &= (~dynamic_flag);
 }
 
-void ResolveInfo::setType(uint32_t pType)
+void SymbolDescriptor::setType(uint32_t pType)
 {
   m_BitField &= ~TYPE_MASK;
   m_BitField |= ((pType << TYPE_OFFSET) & TYPE_MASK);
 }
 
-void ResolveInfo::setDesc(uint32_t pDesc)
+void SymbolDescriptor::setDesc(uint32_t pDesc)
 {
   m_BitField &= ~DESC_MASK;
   m_BitField |= ((pDesc << DESC_OFFSET) & DESC_MASK);
 }
 
-void ResolveInfo::setBinding(uint32_t pBinding)
+void SymbolDescriptor::setBinding(uint32_t pBinding)
 {
   m_BitField &= ~BINDING_MASK;
   if (pBinding == Local || pBinding == Absolute)
@@ -111,24 +107,24 @@ void ResolveInfo::setBinding(uint32_t pBinding)
     m_BitField |= weak_flag;
 }
 
-void ResolveInfo::setReserved(uint32_t pReserved)
+void SymbolDescriptor::setReserved(uint32_t pReserved)
 {
   m_BitField &= ~RESERVED_MASK;
   m_BitField |= ((pReserved << RESERVED_OFFSET) & RESERVED_MASK);
 }
 
-void ResolveInfo::setOther(uint32_t pOther)
+void SymbolDescriptor::setOther(uint32_t pOther)
 {
-  setVisibility(static_cast<ResolveInfo::Visibility>(pOther & 0x3));
+  setVisibility(static_cast<SymbolDescriptor::Visibility>(pOther & 0x3));
 }
 
-void ResolveInfo::setVisibility(ResolveInfo::Visibility pVisibility)
+void SymbolDescriptor::setVisibility(SymbolDescriptor::Visibility pVisibility)
 {
   m_BitField &= ~VISIBILITY_MASK;
   m_BitField |= pVisibility << VISIBILITY_OFFSET;
 }
 
-void ResolveInfo::setIsSymbol(bool pIsSymbol)
+void SymbolDescriptor::setIsSymbol(bool pIsSymbol)
 {
   if (pIsSymbol)
     m_BitField |= symbol_flag;
@@ -136,99 +132,110 @@ void ResolveInfo::setIsSymbol(bool pIsSymbol)
     m_BitField &= ~symbol_flag;
 }
 
-bool ResolveInfo::isNull() const
-{
-  return (this == Null());
-}
-
-bool ResolveInfo::isDyn() const
+bool SymbolDescriptor::isDyn() const
 {
   return (dynamic_flag == (m_BitField & DYN_MASK));
 }
 
-bool ResolveInfo::isUndef() const
+bool SymbolDescriptor::isUndef() const
 {
   return (undefine_flag == (m_BitField & DESC_MASK));
 }
 
-bool ResolveInfo::isDefine() const
+bool SymbolDescriptor::isDefine() const
 {
   return (define_flag == (m_BitField & DESC_MASK));
 }
 
-bool ResolveInfo::isCommon() const
+bool SymbolDescriptor::isCommon() const
 {
   return (common_flag == (m_BitField & DESC_MASK));
 }
 
-bool ResolveInfo::isIndirect() const
+bool SymbolDescriptor::isIndirect() const
 {
   return (indirect_flag == (m_BitField & DESC_MASK));
 }
 
 // isGlobal - [L,W] == [0, 0]
-bool ResolveInfo::isGlobal() const
+bool SymbolDescriptor::isGlobal() const
 {
   return (global_flag == (m_BitField & BINDING_MASK));
 }
 
 // isWeak - [L,W] == [0, 1]
-bool ResolveInfo::isWeak() const
+bool SymbolDescriptor::isWeak() const
 {
   return (weak_flag == (m_BitField & BINDING_MASK));
 }
 
 // isLocal - [L,W] == [1, 0]
-bool ResolveInfo::isLocal() const
+bool SymbolDescriptor::isLocal() const
 {
   return (local_flag == (m_BitField & BINDING_MASK));
 }
 
 // isAbsolute - [L,W] == [1, 1]
-bool ResolveInfo::isAbsolute() const
+bool SymbolDescriptor::isAbsolute() const
 {
   return (absolute_flag == (m_BitField & BINDING_MASK));
 }
 
-bool ResolveInfo::isSymbol() const
+bool SymbolDescriptor::isSymbol() const
 {
   return (symbol_flag == (m_BitField & SYMBOL_MASK));
 }
 
-bool ResolveInfo::isString() const
+bool SymbolDescriptor::isString() const
 {
   return (string_flag == (m_BitField & SYMBOL_MASK));
 }
 
-uint32_t ResolveInfo::type() const
+uint32_t SymbolDescriptor::type() const
 {
   return (m_BitField & TYPE_MASK) >> TYPE_OFFSET;
 }
 
-uint32_t ResolveInfo::desc() const
+uint32_t SymbolDescriptor::desc() const
 {
   return (m_BitField & DESC_MASK) >> DESC_OFFSET;
 }
 
-uint32_t ResolveInfo::binding() const
+uint32_t SymbolDescriptor::binding() const
 {
   if (m_BitField & LOCAL_MASK) {
     if (m_BitField & GLOBAL_MASK) {
-      return ResolveInfo::Absolute;
+      return SymbolDescriptor::Absolute;
     }
-    return ResolveInfo::Local;
+    return SymbolDescriptor::Local;
   }
   return m_BitField & GLOBAL_MASK;
 }
 
-uint32_t ResolveInfo::reserved() const
+uint32_t SymbolDescriptor::reserved() const
 {
   return (m_BitField & RESERVED_MASK) >> RESERVED_OFFSET;
 }
 
-ResolveInfo::Visibility ResolveInfo::visibility() const
+SymbolDescriptor::Visibility SymbolDescriptor::visibility() const
 {
-  return static_cast<ResolveInfo::Visibility>((m_BitField & VISIBILITY_MASK) >> VISIBILITY_OFFSET);
+  return static_cast<SymbolDescriptor::Visibility>((m_BitField & VISIBILITY_MASK) >> VISIBILITY_OFFSET);
+}
+
+//===----------------------------------------------------------------------===//
+// ResolveInfo
+//===----------------------------------------------------------------------===//
+ResolveInfo::ResolveInfo()
+{
+}
+
+ResolveInfo::~ResolveInfo()
+{
+}
+
+bool ResolveInfo::isNull() const
+{
+  return (this == Null());
 }
 
 bool ResolveInfo::compare(const ResolveInfo::key_type& pKey)
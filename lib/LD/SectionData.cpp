@@ -7,45 +7,105 @@
 //
 //===----------------------------------------------------------------------===//
 #include <mcld/LD/SectionData.h>
+#include <mcld/Support/LinkContext.h>
 
 #include <mcld/LD/LDSection.h>
 #include <mcld/Support/GCFactory.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
+
+#include <algorithm>
 
 using namespace mcld;
 
 typedef GCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
 
-static llvm::ManagedStatic<SectDataFactory> g_SectDataFactory;
+static inline SectDataFactory& GetSectDataFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<SectDataFactory>(LinkContext::SectionDataArena);
+}
+
+static inline LinkContext::Lock& GetSectDataFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::SectionDataArena);
+}
 
 //===----------------------------------------------------------------------===//
 // SectionData
 //===----------------------------------------------------------------------===//
 SectionData::SectionData()
-  : m_pSection(NULL) {
+  : m_pSection(NULL), m_IndexVersion(0), m_bIndexValid(false) {
 }
 
 SectionData::SectionData(LDSection &pSection)
-  : m_pSection(&pSection) {
+  : m_pSection(&pSection), m_IndexVersion(0), m_bIndexValid(false) {
 }
 
 SectionData* SectionData::Create(LDSection& pSection)
 {
-  SectionData* result = g_SectDataFactory->allocate();
+  llvm::sys::SmartScopedLock<true> locker(GetSectDataFactoryLock());
+  SectionData* result = GetSectDataFactory().allocate();
   new (result) SectionData(pSection);
   return result;
 }
 
 void SectionData::Destroy(SectionData*& pSection)
 {
+  llvm::sys::SmartScopedLock<true> locker(GetSectDataFactoryLock());
   pSection->~SectionData();
-  g_SectDataFactory->deallocate(pSection);
+  GetSectDataFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void SectionData::Clear()
 {
-  g_SectDataFactory->clear();
+  GetSectDataFactory().clear();
+}
+
+void SectionData::buildOffsetIndex()
+{
+  m_FragEnds.clear();
+  m_IndexedFrags.clear();
+  m_FragPositions.clear();
+
+  uint64_t offset = 0;
+  iterator frag, fragEnd = m_Fragments.end();
+  for (frag = m_Fragments.begin(); frag != fragEnd; ++frag) {
+    m_FragPositions[&*frag] = m_FragEnds.size();
+    offset += frag->size();
+    m_FragEnds.push_back(offset);
+    m_IndexedFrags.push_back(&*frag);
+  }
+
+  m_IndexVersion = m_Fragments.version();
+  m_bIndexValid = true;
+}
+
+Fragment* SectionData::locate(const Fragment& pFrag, uint64_t& pOffset)
+{
+  if (!m_bIndexValid || m_IndexVersion != m_Fragments.version())
+    buildOffsetIndex();
+
+  FragPositionMap::const_iterator pos = m_FragPositions.find(&pFrag);
+  if (m_FragPositions.end() == pos)
+    return NULL;
+
+  size_t first = pos->second;
+  uint64_t target = pOffset;
+  if (0 != first)
+    target += m_FragEnds[first - 1];
+
+  // the first fragment whose end reaches the target
+  std::vector<uint64_t>::const_iterator end =
+    std::lower_bound(m_FragEnds.begin() + first, m_FragEnds.end(), target);
+  if (m_FragEnds.end() == end)
+    return NULL;
+
+  size_t idx = end - m_FragEnds.begin();
+  pOffset = target;
+  if (0 != idx)
+    pOffset -= m_FragEnds[idx - 1];
+  return m_IndexedFrags[idx];
 }
 
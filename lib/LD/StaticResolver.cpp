@@ -19,7 +19,7 @@ StaticResolver::~StaticResolver()
 }
 
 bool StaticResolver::resolve(ResolveInfo& __restrict__ pOld,
-                             const ResolveInfo& __restrict__ pNew,
+                             const SymbolDescriptor& __restrict__ pNew,
                              bool &pOverride, LDSymbol::ValueType pValue) const
 {
 
@@ -145,7 +145,7 @@ bool StaticResolver::resolve(ResolveInfo& __restrict__ pOld,
       /* Fall through */
       case IND: {        /* override by indirect symbol.  */
         if (NULL == pNew.link()) {
-          fatal(diag::indirect_refer_to_inexist) << pNew.name();
+          fatal(diag::indirect_refer_to_inexist) << pOld.name();
           break;
         }
 
@@ -178,12 +178,12 @@ bool StaticResolver::resolve(ResolveInfo& __restrict__ pOld,
             old->override(pNew);
             break;
           } else {
-            error(diag::multiple_absolute_definitions) << pNew.name()
+            error(diag::multiple_absolute_definitions) << pOld.name()
               << pOld.outSymbol()->value() << pValue;
             break;
           }
         }
-        error(diag::multiple_definitions) << pNew.name();
+        error(diag::multiple_definitions) << pOld.name();
         break;
       }
       case REFC: {       /* Mark indirect symbol referenced and then CYCLE.  */
@@ -198,7 +198,7 @@ bool StaticResolver::resolve(ResolveInfo& __restrict__ pOld,
         break;
       }
       default: {
-        error(diag::undefined_situation) << action << old->name() << pNew.name();
+        error(diag::undefined_situation) << action << old->name() << pOld.name();
         return false;
       }
     } // end of the big switch (action)
@@ -0,0 +1,125 @@
+//===- StringTableBuilder.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/StringTableBuilder.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace mcld;
+
+typedef llvm::StringMapEntry<uint64_t> EntryType;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+/// ReverseGreater - compare the reversed strings in descending order. If one
+/// string is a suffix of the other, the longer one comes first.
+static bool ReverseGreater(const EntryType* pX, const EntryType* pY)
+{
+  llvm::StringRef x = pX->getKey();
+  llvm::StringRef y = pY->getKey();
+  size_t i = x.size(), j = y.size();
+  while (0 != i && 0 != j) {
+    --i;
+    --j;
+    if (x[i] != y[j])
+      return static_cast<unsigned char>(x[i]) >
+             static_cast<unsigned char>(y[j]);
+  }
+  return i > j;
+}
+
+//===----------------------------------------------------------------------===//
+// StringTableBuilder
+//===----------------------------------------------------------------------===//
+StringTableBuilder::StringTableBuilder()
+  : m_Size(1), m_bFinalized(false) {
+}
+
+StringTableBuilder::~StringTableBuilder()
+{
+}
+
+void StringTableBuilder::add(llvm::StringRef pString)
+{
+  // the empty string is always at offset 0
+  if (pString.empty() || m_Offsets.end() != m_Offsets.find(pString))
+    return;
+
+  if (!m_bFinalized) {
+    m_Offsets[pString] = 0;
+    return;
+  }
+
+  // append the late string to keep the laid out offsets
+  m_Offsets[pString] = m_Size;
+  m_Size += pString.size() + 1;
+}
+
+void StringTableBuilder::finalize()
+{
+  std::vector<EntryType*> entries;
+  entries.reserve(m_Offsets.size());
+  OffsetMap::iterator entry, entryEnd = m_Offsets.end();
+  for (entry = m_Offsets.begin(); entry != entryEnd; ++entry)
+    entries.push_back(&*entry);
+
+  std::sort(entries.begin(), entries.end(), ReverseGreater);
+
+  // A suffix of the previous written string shares its tail. Since the
+  // strings are sorted by the reversed contents, all the suffixes of a string
+  // follow it.
+  m_Size = 1;
+  llvm::StringRef previous;
+  std::vector<EntryType*>::iterator it, itEnd = entries.end();
+  for (it = entries.begin(); it != itEnd; ++it) {
+    llvm::StringRef str = (*it)->getKey();
+    if (previous.endswith(str)) {
+      (*it)->second = m_Size - 1 - str.size();
+      continue;
+    }
+    (*it)->second = m_Size;
+    m_Size += str.size() + 1;
+    previous = str;
+  }
+  m_bFinalized = true;
+}
+
+uint64_t StringTableBuilder::getOffset(llvm::StringRef pString) const
+{
+  assert(m_bFinalized);
+  if (pString.empty())
+    return 0;
+
+  OffsetMap::const_iterator entry = m_Offsets.find(pString);
+  assert(m_Offsets.end() != entry && "string is not in the table");
+  return entry->second;
+}
+
+void StringTableBuilder::emit(char* pBuffer) const
+{
+  assert(m_bFinalized);
+  // The strings sharing a tail write the same bytes, so the order does not
+  // matter.
+  memset(pBuffer, 0, m_Size);
+  OffsetMap::const_iterator entry, entryEnd = m_Offsets.end();
+  for (entry = m_Offsets.begin(); entry != entryEnd; ++entry)
+    memcpy(pBuffer + entry->second, entry->getKey().data(),
+           entry->getKey().size());
+}
+
+void StringTableBuilder::clear()
+{
+  m_Offsets.clear();
+  m_Size = 1;
+  m_bFinalized = false;
+}
+
@@ -47,14 +47,22 @@ Stub* StubFactory::create(Relocation& pReloc,
                                   pReloc.place(),
                                   pTargetSymValue);
   if (NULL != prototype) {
-    // find the island for the input relocation
-    BranchIsland* island = pBRIslandFactory.find(*(pReloc.targetRef().frag()));
+    // find the islands around the input relocation
+    std::pair<BranchIsland*, BranchIsland*> islands =
+      pBRIslandFactory.getIslands(*(pReloc.targetRef().frag()),
+                                  pReloc.targetRef().offset());
+    BranchIsland* island =
+      (NULL != islands.second) ? islands.second : islands.first;
     if (NULL == island) {
       return NULL;
     }
 
-    // find if there is such a stub in the island already
-    Stub* stub = island->findStub(prototype, pReloc);
+    // find if there is such a stub in either island already
+    Stub* stub = NULL;
+    if (NULL != islands.first)
+      stub = islands.first->findStub(prototype, pReloc);
+    if (NULL == stub && NULL != islands.second)
+      stub = islands.second->findStub(prototype, pReloc);
     if (NULL != stub) {
       // reset the branch target to the stub instead!
       pReloc.setSymInfo(stub->symInfo());
@@ -135,6 +135,10 @@ bool InputBuilder::setMemory(Input& pInput,
   if (!memory->handler()->isGood())
     return false;
 
+  // slice the regions of a read-only input from a single mapping
+  if (m_Config.options().mapWholeInputs())
+    memory->mapWhole();
+
   pInput.setMemArea(memory);
   return true;
 }
@@ -16,11 +16,11 @@ using namespace mcld::sys::fs;
 // MCLDDirectory
 //===----------------------------------------------------------------------===//
 MCLDDirectory::MCLDDirectory()
-  : Directory(), m_Name(), m_bInSysroot(false) {
+  : Directory(), m_Name(), m_bInSysroot(false), m_bIndexed(false) {
 }
 
 MCLDDirectory::MCLDDirectory(const char* pName)
-  : Directory(), m_Name(pName) {
+  : Directory(), m_Name(pName), m_bIndexed(false) {
   Directory::m_Path.assign(pName);
 
   if (!Directory::m_Path.empty())
@@ -34,7 +34,7 @@ MCLDDirectory::MCLDDirectory(const char* pName)
 }
 
 MCLDDirectory::MCLDDirectory(const std::string &pName)
-  : Directory(), m_Name(pName) {
+  : Directory(), m_Name(pName), m_bIndexed(false) {
   Directory::m_Path.assign(pName);
 
   if (!Directory::m_Path.empty())
@@ -48,7 +48,7 @@ MCLDDirectory::MCLDDirectory(const std::string &pName)
 }
 
 MCLDDirectory::MCLDDirectory(llvm::StringRef pName)
-  : Directory(), m_Name(pName.data(), pName.size()) {
+  : Directory(), m_Name(pName.data(), pName.size()), m_bIndexed(false) {
   Directory::m_Path.assign(pName.str());
 
   if (!Directory::m_Path.empty())
@@ -78,6 +78,7 @@ MCLDDirectory &MCLDDirectory::assign(llvm::StringRef pName)
   Directory::m_SymLinkStatus = FileStatus();
   Directory::m_Cache.clear();
   Directory::m_Handler = 0;
+  clearIndex();
   return (*this);
 }
 
@@ -99,6 +100,61 @@ void MCLDDirectory::setSysroot(const sys::fs::Path& pSysroot)
     Directory::m_Path.native() += old_path;
     detail::canonicalize(Directory::m_Path.native());
     detail::open_dir(*this);
+    clearIndex();
   }
 }
 
+Path* MCLDDirectory::find(llvm::StringRef pFileName)
+{
+  if (!m_bIndexed)
+    buildIndex();
+
+  PathCache::iterator entry = m_Index.find(pFileName);
+  if (m_Index.end() == entry)
+    return NULL;
+  return &entry.getEntry()->value();
+}
+
+void MCLDDirectory::buildIndex()
+{
+  iterator entry = begin(), enEnd = end();
+  for (; entry != enEnd; ++entry) {
+    if (NULL == entry.path())
+      continue;
+    const std::string& path = entry.path()->native();
+    addIndex(llvm::StringRef(path).substr(path.rfind(separator) + 1));
+  }
+  m_bIndexed = true;
+}
+
+void MCLDDirectory::buildIndex(const std::vector<std::string>& pFileNames)
+{
+  std::vector<std::string>::const_iterator name, nEnd = pFileNames.end();
+  for (name = pFileNames.begin(); name != nEnd; ++name)
+    addIndex(*name);
+  m_bIndexed = true;
+}
+
+void MCLDDirectory::addIndex(llvm::StringRef pFileName)
+{
+  bool exist = false;
+  PathCache::entry_type* entry = m_Index.insert(pFileName, exist);
+  if (exist)
+    return;
+
+  std::string path(Directory::m_Path.native());
+  path.append(pFileName.data(), pFileName.size());
+  entry->setValue(path);
+
+  // pFileName may be a temporary. Let the key refer to the path we keep.
+  const std::string& native = entry->value().native();
+  entry->key() = llvm::StringRef(native).substr(native.size() -
+                                                pFileName.size());
+}
+
+void MCLDDirectory::clearIndex()
+{
+  m_Index.clear();
+  m_bIndexed = false;
+}
+
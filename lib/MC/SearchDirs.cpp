@@ -8,8 +8,13 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/MC/SearchDirs.h>
 #include <mcld/MC/MCLDDirectory.h>
+#include <mcld/Support/FileHandle.h>
 #include <mcld/Support/FileSystem.h>
 
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
 using namespace mcld;
 
 //===----------------------------------------------------------------------===//
@@ -21,18 +26,26 @@ static inline void SpecToFilename(const std::string& pSpec, std::string& pFile)
   pFile += pSpec;
 }
 
+/// The first line of the index cache file. Bump the version when the format
+/// changes, and the old files are ignored.
+static const char IndexCacheHeader[] = "# mcld search directory listings v1";
+
+/// A directory modified in the last seconds may be modified again without
+/// changing its time stamp, so its listing is not cached.
+static const std::time_t RacyInterval = 2;
+
 //===----------------------------------------------------------------------===//
 // SearchDirs
 //===----------------------------------------------------------------------===//
 SearchDirs::SearchDirs()
-{
+  : m_bListingsChanged(false) {
   // a magic number 8, no why.
   // please prove it or change it
   m_DirList.reserve(8);
 }
 
 SearchDirs::SearchDirs(const sys::fs::Path& pSysRoot)
-  : m_SysRoot(pSysRoot) {
+  : m_SysRoot(pSysRoot), m_bListingsChanged(false) {
   // a magic number 8, no why.
   // please prove it or change it
   m_DirList.reserve(8);
@@ -40,6 +53,9 @@ SearchDirs::SearchDirs(const sys::fs::Path& pSysRoot)
 
 SearchDirs::~SearchDirs()
 {
+  if (m_bListingsChanged)
+    saveIndexCache();
+
   iterator dir, dirEnd = end();
   for (dir = begin(); dir!=dirEnd; ++dir) {
     delete (*dir);
@@ -73,136 +89,205 @@ bool SearchDirs::insert(const sys::fs::Path& pPath)
   return insert(pPath.native());
 }
 
+bool SearchDirs::setIndexCache(const sys::fs::Path& pCacheFile)
+{
+  m_IndexCache = pCacheFile;
+  m_Listings.clear();
+  m_bListingsChanged = false;
+  return loadIndexCache();
+}
+
 mcld::sys::fs::Path*
 SearchDirs::find(const std::string& pNamespec, mcld::Input::Type pType)
+{
+  return lookup(pNamespec, pType);
+}
+
+const mcld::sys::fs::Path*
+SearchDirs::find(const std::string& pNamespec, mcld::Input::Type pType) const
+{
+  return lookup(pNamespec, pType);
+}
+
+mcld::sys::fs::Path*
+SearchDirs::lookup(const std::string& pNamespec, mcld::Input::Type pType) const
 {
   assert(Input::DynObj  == pType ||
          Input::Archive == pType ||
          Input::Script  == pType);
 
-  std::string file;
+  std::string file, shared, archive;
   switch(pType) {
   case Input::Script:
     file.assign(pNamespec);
     break;
   case Input::DynObj:
+    SpecToFilename(pNamespec, shared);
+    shared += sys::fs::detail::shared_library_extension;
+    /** Fall through **/
   case Input::Archive :
-    SpecToFilename(pNamespec, file);
+    SpecToFilename(pNamespec, archive);
+    archive += sys::fs::detail::static_library_extension;
     break;
   default:
     break;
   } // end of switch
 
   // for all MCLDDirectorys
-  DirList::iterator mcld_dir, mcld_dir_end = m_DirList.end();
+  DirList::const_iterator mcld_dir, mcld_dir_end = m_DirList.end();
   for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
+    if (!(*mcld_dir)->isIndexed())
+      index(**mcld_dir);
 
+    sys::fs::Path* path = NULL;
     switch(pType) {
-    case Input::Script: {
-      while (entry != enEnd) {
-        if (file == entry.path()->filename())
-          return entry.path();
-        ++entry;
-      }
+    case Input::Script:
+      path = (*mcld_dir)->find(file);
+      break;
+    case Input::DynObj:
+      path = (*mcld_dir)->find(shared);
+      if (NULL != path)
+        break;
+      /** Fall through **/
+    case Input::Archive :
+      path = (*mcld_dir)->find(archive);
       break;
-    }
-    case Input::DynObj: {
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() ) {
-          if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-            return entry.path();
-          }
-        }
-        ++entry;
-      }
-    }
-    /** Fall through **/
-    case Input::Archive : {
-      entry = (*mcld_dir)->begin();
-      enEnd = (*mcld_dir)->end();
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() &&
-            mcld::sys::fs::detail::static_library_extension ==
-              entry.path()->extension().native()) {
-          return entry.path();
-        }
-        ++entry;
-      }
-    }
     default:
       break;
     } // end of switch
+
+    if (NULL != path)
+      return path;
   } // end of for
   return NULL;
 }
 
-const mcld::sys::fs::Path*
-SearchDirs::find(const std::string& pNamespec, mcld::Input::Type pType) const
+void SearchDirs::index(MCLDDirectory& pDir) const
 {
-  assert(Input::DynObj  == pType ||
-         Input::Archive == pType ||
-         Input::Script  == pType);
+  std::time_t time = 0;
+  if (m_IndexCache.empty() ||
+      !sys::fs::detail::last_write_time(pDir.path(), time)) {
+    pDir.buildIndex();
+    return;
+  }
 
-  std::string file;
-  switch(pType) {
-  case Input::Script:
-    file.assign(pNamespec);
-    break;
-  case Input::DynObj:
-  case Input::Archive :
-    SpecToFilename(pNamespec, file);
-    break;
-  default:
-    break;
-  } // end of switch
+  const std::string& dir = pDir.path().native();
+  ListingMap::iterator listing = m_Listings.find(dir);
+  if (m_Listings.end() != listing && time == listing->getValue().time) {
+    pDir.buildIndex(listing->getValue().names);
+    return;
+  }
 
-  // for all MCLDDirectorys
-  DirList::const_iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
+  pDir.buildIndex();
 
-    switch(pType) {
-    case Input::Script: {
-      while (entry != enEnd) {
-        if (file == entry.path()->filename())
-          return entry.path();
-        ++entry;
-      }
-      break;
-    }
-    case Input::DynObj: {
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() ) {
-          if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-            return entry.path();
-          }
-        }
-        ++entry;
+  // The cached listing, if any, is out of date.
+  if (m_Listings.end() != listing) {
+    m_Listings.erase(listing);
+    m_bListingsChanged = true;
+  }
+
+  if (std::time(NULL) - time < RacyInterval ||
+      std::string::npos != dir.find('\n'))
+    return;
+
+  std::vector<std::string> names;
+  MCLDDirectory::iterator entry = pDir.begin(), enEnd = pDir.end();
+  for (; entry != enEnd; ++entry) {
+    if (NULL == entry.path())
+      continue;
+    names.push_back(entry.path()->filename().native());
+    // a name that the cache file can not hold
+    if (std::string::npos != names.back().find('\n'))
+      return;
+  }
+
+  Listing& cached = m_Listings[dir];
+  cached.time = time;
+  cached.names.swap(names);
+  m_bListingsChanged = true;
+}
+
+/// The index cache file is a text file:
+///   # mcld search directory listings v1
+///   D <time stamp> <directory>
+///   F <file name>
+///   F <file name>
+///   D <time stamp> <directory>
+///   ...
+bool SearchDirs::loadIndexCache()
+{
+  if (!exists(m_IndexCache))
+    return true;
+
+  FileHandle file;
+  if (!file.open(m_IndexCache, FileHandle::ReadOnly))
+    return false;
+
+  std::string content(file.size(), '\0');
+  if (!content.empty() && !file.read(&content[0], 0, content.size())) {
+    file.close();
+    return false;
+  }
+  file.close();
+
+  std::pair<llvm::StringRef, llvm::StringRef> line =
+                                        llvm::StringRef(content).split('\n');
+  // an unknown version is not an error. The file will be rewritten.
+  if (IndexCacheHeader != line.first)
+    return true;
+
+  Listing* listing = NULL;
+  while (!line.second.empty()) {
+    line = line.second.split('\n');
+    llvm::StringRef record = line.first;
+    if (record.size() < 2 || ' ' != record[1])
+      continue;
+
+    if ('D' == record[0]) {
+      std::pair<llvm::StringRef, llvm::StringRef> field =
+                                              record.substr(2).split(' ');
+      unsigned long long time = 0;
+      if (field.first.getAsInteger(10, time) || field.second.empty()) {
+        listing = NULL;
+        continue;
       }
+      listing = &m_Listings[field.second];
+      listing->time = static_cast<std::time_t>(time);
+      listing->names.clear();
     }
-    /** Fall through **/
-    case Input::Archive : {
-      entry = (*mcld_dir)->begin();
-      enEnd = (*mcld_dir)->end();
-      while ( entry!=enEnd ) {
-        if (file == entry.path()->stem().native() &&
-            mcld::sys::fs::detail::static_library_extension ==
-              entry.path()->extension().native()) {
-          return entry.path();
-        }
-        ++entry;
-      }
+    else if ('F' == record[0] && NULL != listing) {
+      listing->names.push_back(record.substr(2).str());
     }
-    default:
-      break;
-    } // end of switch
-  } // end of for 
-  return NULL;
+  }
+  return true;
+}
+
+void SearchDirs::saveIndexCache() const
+{
+  // Write to a unique temporary file and rename it, so that the concurrent
+  // links never see a partial file.
+  int fd = -1;
+  llvm::SmallString<128> temp;
+  if (llvm::sys::fs::unique_file(m_IndexCache.native() + "-%%%%%%", fd, temp))
+    return;
+
+  llvm::raw_fd_ostream out(fd, true);
+  out << IndexCacheHeader << "\n";
+  ListingMap::const_iterator listing, lEnd = m_Listings.end();
+  for (listing = m_Listings.begin(); listing != lEnd; ++listing) {
+    out << "D " << static_cast<unsigned long long>(listing->getValue().time)
+        << " " << listing->getKey() << "\n";
+    const std::vector<std::string>& names = listing->getValue().names;
+    std::vector<std::string>::const_iterator name, nEnd = names.end();
+    for (name = names.begin(); name != nEnd; ++name)
+      out << "F " << *name << "\n";
+  }
+  out.close();
+
+  bool existed = false;
+  if (out.has_error() ||
+      llvm::sys::fs::rename(temp.str(), m_IndexCache.native())) {
+    out.clear_error();
+    llvm::sys::fs::remove(temp.str(), existed);
+  }
 }
@@ -68,6 +68,7 @@ SymbolCategory::~SymbolCategory()
 SymbolCategory& SymbolCategory::add(LDSymbol& pSymbol, Category::Type pTarget)
 {
   Category* current = m_pRegular;
+  m_Positions[&pSymbol] = m_OutputSymbols.size();
   m_OutputSymbols.push_back(&pSymbol);
 
   // use non-stable bubble sort to arrange the order of symbols.
@@ -77,10 +78,8 @@ SymbolCategory& SymbolCategory::add(LDSymbol& pSymbol, Category::Type pTarget)
       break;
     }
     else {
-      if (!current->empty()) {
-        std::swap(m_OutputSymbols[current->begin],
-                  m_OutputSymbols[current->end]);
-      }
+      if (!current->empty())
+        swap(current->begin, current->end);
       current->end++;
       current->begin++;
       current = current->prev;
@@ -123,12 +122,7 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
   assert(!current->empty());
 
   // find the position of source
-  size_t pos = current->begin;
-  while (pos != current->end) {
-    if (m_OutputSymbols[pos] == &pSymbol)
-      break;
-    ++pos;
-  }
+  size_t pos = position(pSymbol, *current);
 
   // if symbol is not in the given source category, then do nothing
   if (current->end == pos)
@@ -145,7 +139,7 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
       else {
         assert(!current->isLast() && "target category is wrong.");
         rear = current->end - 1;
-        std::swap(m_OutputSymbols[pos], m_OutputSymbols[rear]);
+        swap(pos, rear);
         pos = rear;
         current->next->begin--;
         current->end--;
@@ -166,7 +160,7 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
       }
       else {
         assert(!current->isFirst() && "target category is wrong.");
-        std::swap(m_OutputSymbols[current->begin], m_OutputSymbols[pos]);
+        swap(current->begin, pos);
         pos = current->begin;
         current->begin++;
         current->prev->end++;
@@ -199,7 +193,7 @@ SymbolCategory& SymbolCategory::changeCommonsToGlobal()
       m_pDynamic->begin--;
       break;
     case Category::Regular:
-      std::swap(m_OutputSymbols[pos], m_OutputSymbols[m_pDynamic->end - 1]);
+      swap(pos, m_pDynamic->end - 1);
       m_pCommon->end--;
       m_pDynamic->begin--;
       m_pDynamic->end--;
@@ -213,6 +207,41 @@ SymbolCategory& SymbolCategory::changeCommonsToGlobal()
   return *this;
 }
 
+void SymbolCategory::swap(size_t pX, size_t pY)
+{
+  if (pX == pY)
+    return;
+  std::swap(m_OutputSymbols[pX], m_OutputSymbols[pY]);
+  m_Positions[m_OutputSymbols[pX]] = pX;
+  m_Positions[m_OutputSymbols[pY]] = pY;
+}
+
+size_t SymbolCategory::position(const LDSymbol& pSymbol,
+                                const Category& pCategory)
+{
+  PositionMap::iterator entry = m_Positions.find(&pSymbol);
+  if (m_Positions.end() == entry)
+    return pCategory.end;
+
+  size_t pos = entry->second;
+  if (pos < m_OutputSymbols.size() && m_OutputSymbols[pos] == &pSymbol) {
+    if (pos >= pCategory.begin && pos < pCategory.end)
+      return pos;
+    return pCategory.end;
+  }
+
+  // The symbols are reordered through the iterators, e.g., the dynamic
+  // symbols sorted by their hash buckets. Scan the category and fix the
+  // position.
+  for (pos = pCategory.begin; pos != pCategory.end; ++pos) {
+    if (m_OutputSymbols[pos] == &pSymbol) {
+      entry->second = pos;
+      break;
+    }
+  }
+  return pos;
+}
+
 SymbolCategory& SymbolCategory::changeToDynamic(LDSymbol& pSymbol)
 {
   assert(NULL != pSymbol.resolveInfo());
@@ -89,7 +89,11 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
       else
         eh_frame = IRBuilder::CreateEhFrame(*target);
 
-      eh_frame->merge(*pInputSection.getEhFrame());
+      // A relocatable output keeps all entries for the next link.
+      if (LinkerConfig::Object == m_Config.codeGenType())
+        eh_frame->merge(*pInputSection.getEhFrame());
+      else
+        eh_frame->merge(pInputFile, *pInputSection.getEhFrame());
       UpdateSectionAlign(*target, pInputSection);
       return target;
     }
@@ -19,7 +19,11 @@
 #include <mcld/LD/ArchiveReader.h>
 #include <mcld/LD/ObjectReader.h>
 #include <mcld/LD/DynObjReader.h>
+#include <mcld/LD/EhFrame.h>
+#include <mcld/LD/GarbageCollection.h>
 #include <mcld/LD/GroupReader.h>
+#include <mcld/LD/IdenticalCodeFolding.h>
+#include <mcld/LD/MergeStringFactory.h>
 #include <mcld/LD/BinaryReader.h>
 #include <mcld/LD/ObjectWriter.h>
 #include <mcld/LD/ResolveInfo.h>
@@ -36,18 +40,201 @@
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/ThreadPool.h>
 #include <mcld/Target/TargetLDBackend.h>
 #include <mcld/Fragment/Relocation.h>
 #include <mcld/Object/ObjectBuilder.h>
 
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/Host.h>
+#include <vector>
 
 
 #include <mcld/Script/StringList.h>
 #include <mcld/Script/WildcardPattern.h>
 using namespace llvm;
 using namespace mcld;
+
+namespace {
+
+/// ReadSectionsTask - read the section headers and the regular sections of a
+/// relocatable object.
+class ReadSectionsTask : public ThreadPool::Task
+{
+public:
+  ReadSectionsTask(ObjectReader& pReader, Input& pInput)
+    : m_pReader(&pReader), m_pInput(&pInput) {
+  }
+
+  void run() {
+    if (m_pReader->readHeader(*m_pInput))
+      m_pReader->readRegularSections(*m_pInput);
+  }
+
+private:
+  ObjectReader* m_pReader;
+  Input* m_pInput;
+};
+
+/// ReadRelocationsTask - read the relocation sections of a relocatable object.
+class ReadRelocationsTask : public ThreadPool::Task
+{
+public:
+  ReadRelocationsTask(ObjectReader& pReader, Input& pInput)
+    : m_pReader(&pReader), m_pInput(&pInput), m_bResult(false) {
+  }
+
+  void run() { m_bResult = m_pReader->readRelocations(*m_pInput); }
+
+  bool result() const { return m_bResult; }
+
+private:
+  ObjectReader* m_pReader;
+  Input* m_pInput;
+  bool m_bResult;
+};
+
+/// isBypassed - the relocations in pRelocSect are not applied if
+/// 1. its section kind is changed to Ignore. (The target section is a
+/// discarded group section.)
+/// 2. it has no reloc data. (All symbols in the input relocs are in the
+/// discarded group sections)
+static bool isBypassed(const LDSection& pRelocSect)
+{
+  return (LDFileFormat::Ignore == pRelocSect.kind() ||
+          !pRelocSect.hasRelocData());
+}
+
+/// writeRelocationResult - write the relocation target data to the output
+static void writeRelocationResult(Relocation& pReloc,
+                                  Relocator& pRelocator,
+                                  bool pSwap,
+                                  uint8_t* pOutput)
+{
+  // get output file offset
+  size_t out_offset =
+                 pReloc.targetRef().frag()->getParent()->getSection().offset() +
+                 pReloc.targetRef().getOutputOffset();
+
+  uint8_t* target_addr = pOutput + out_offset;
+  // byte swapping if target and host has different endian, and then write back
+  if (pSwap) {
+     uint64_t tmp_data = 0;
+
+     switch(pReloc.size(pRelocator)) {
+       case 8u:
+         std::memcpy(target_addr, &pReloc.target(), 1);
+         break;
+
+       case 16u:
+         tmp_data = mcld::bswap16(pReloc.target());
+         std::memcpy(target_addr, &tmp_data, 2);
+         break;
+
+       case 32u:
+         tmp_data = mcld::bswap32(pReloc.target());
+         std::memcpy(target_addr, &tmp_data, 4);
+         break;
+
+       case 64u:
+         tmp_data = mcld::bswap64(pReloc.target());
+         std::memcpy(target_addr, &tmp_data, 8);
+         break;
+
+       default:
+         break;
+    }
+  }
+  else
+    std::memcpy(target_addr, &pReloc.target(), pReloc.size(pRelocator)/8);
+}
+
+/// ApplyRelocationsTask - apply the relocations of an input which the
+/// relocator allows to apply concurrently. The errors are kept and reported
+/// later in input order.
+class ApplyRelocationsTask : public ThreadPool::Task
+{
+public:
+  typedef std::pair<Relocation*, Relocator::Result> Failure;
+  typedef std::vector<Failure> FailureList;
+
+public:
+  ApplyRelocationsTask(Relocator& pRelocator, Input& pInput)
+    : m_pRelocator(&pRelocator), m_pInput(&pInput) {
+  }
+
+  void run() {
+    LDContext::sect_iterator rs, rsEnd = m_pInput->context()->relocSectEnd();
+    for (rs = m_pInput->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (isBypassed(**rs))
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        if (!m_pRelocator->mayApplyConcurrently(*relocation))
+          continue;
+        Relocator::Result result = m_pRelocator->applyRelocation(*relocation);
+        if (Relocator::OK != result)
+          m_Failures.push_back(std::make_pair(relocation, result));
+      }
+    }
+  }
+
+  Input& input() { return *m_pInput; }
+
+  const FailureList& failures() const { return m_Failures; }
+
+private:
+  Relocator* m_pRelocator;
+  Input* m_pInput;
+  FailureList m_Failures;
+};
+
+/// SyncRelocationsTask - write the relocation results of an input to the
+/// output.
+class SyncRelocationsTask : public ThreadPool::Task
+{
+public:
+  SyncRelocationsTask(Relocator& pRelocator, bool pSwap, Input& pInput,
+                      uint8_t* pOutput)
+    : m_pRelocator(&pRelocator), m_bSwap(pSwap), m_pInput(&pInput),
+      m_pOutput(pOutput) {
+  }
+
+  void run() {
+    LDContext::sect_iterator rs, rsEnd = m_pInput->context()->relocSectEnd();
+    for (rs = m_pInput->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (isBypassed(**rs))
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+
+        // bypass the relocation with NONE type. This is to avoid overwrite
+        // the target result by NONE type relocation if there is a place which
+        // has two relocations to apply to, and one of it is NONE type. The
+        // result we want is the value of the other relocation result. For
+        // example, in .exidx, there are usually an R_ARM_NONE and
+        // R_ARM_PREL31 apply to the same place
+        if (0x0 == relocation->type())
+          continue;
+        writeRelocationResult(*relocation, *m_pRelocator, m_bSwap, m_pOutput);
+      }
+    }
+  }
+
+private:
+  Relocator* m_pRelocator;
+  bool m_bSwap;
+  Input* m_pInput;
+  uint8_t* m_pOutput;
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// ObjectLinker
+//===----------------------------------------------------------------------===//
 ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
                            TargetLDBackend& pLDBackend)
   : m_Config(pConfig),
@@ -60,7 +247,8 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
     m_pGroupReader(NULL),
     m_pBinaryReader(NULL),
     m_pScriptReader(NULL),
-    m_pWriter(NULL) {
+    m_pWriter(NULL),
+    m_pMergeStringFactory(NULL) {
 }
 
 ObjectLinker::~ObjectLinker()
@@ -72,6 +260,7 @@ ObjectLinker::~ObjectLinker()
   delete m_pBinaryReader;
   delete m_pScriptReader;
   delete m_pWriter;
+  delete m_pMergeStringFactory;
 }
 
 bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder)
@@ -110,8 +299,45 @@ bool ObjectLinker::initStdSections()
   return true;
 }
 
+void ObjectLinker::readObjectsInParallel(llvm::DenseSet<Input*>& pParsed)
+{
+  std::vector<ReadSectionsTask> tasks;
+  Module::input_iterator input, inEnd = m_pModule->input_end();
+  for (input = m_pModule->input_begin(); input!=inEnd; ++input) {
+    // members of groups are read by GroupReader
+    if (isGroup(input) || Input::Unknown != (*input)->type())
+      continue;
+
+    bool doContinue = false;
+    if (getBinaryReader()->isMyFormat(**input, doContinue))
+      continue;
+    if (doContinue && getObjectReader()->isMyFormat(**input, doContinue)) {
+      tasks.push_back(ReadSectionsTask(*getObjectReader(), **input));
+      pParsed.insert(*input);
+    }
+  }
+
+  ThreadPool::TaskList task_list;
+  task_list.reserve(tasks.size());
+  std::vector<ReadSectionsTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(m_Config.options().numOfThreads());
+  pool.run(task_list);
+}
+
 void ObjectLinker::normalize()
 {
+  // read the self-contained parts of relocatable objects concurrently
+  llvm::DenseSet<Input*> parsed;
+  if (m_Config.options().numOfThreads() > 1)
+    readObjectsInParallel(parsed);
+
+  // look up the new symbols in the shared objects read lazily
+  if (m_Config.options().lazyDynObjSymbols())
+    m_pBuilder->setDynObjReader(getDynObjReader());
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input!=inEnd; ++input) {
@@ -139,6 +365,15 @@ void ObjectLinker::normalize()
       continue;
     }
 
+    // a relocatable object whose headers are already read
+    if (parsed.count(*input)) {
+      (*input)->setType(Input::Object);
+      getObjectReader()->readSections(**input);
+      getObjectReader()->readSymbols(**input);
+      m_pModule->getObjectList().push_back(*input);
+      continue;
+    }
+
     bool doContinue = false;
     // read input as a binary file
     if (getBinaryReader()->isMyFormat(**input, doContinue)) {
@@ -189,6 +424,9 @@ void ObjectLinker::normalize()
         << m_Config.targets().triple().str();
     }
   } // end of for
+
+  m_pBuilder->setDynObjReader(NULL);
+  getDynObjReader()->finishLazyImport();
 }
 
 bool ObjectLinker::linkable() const
@@ -234,17 +472,80 @@ bool ObjectLinker::readRelocations()
 {
   // Bitcode is read by the other path. This function reads relocation sections
   // in object files.
+  std::vector<ReadRelocationsTask> tasks;
   mcld::InputTree::bfs_iterator input, inEnd = m_pModule->getInputTree().bfs_end();
   for (input=m_pModule->getInputTree().bfs_begin(); input!=inEnd; ++input) {
-    if ((*input)->type() == Input::Object && (*input)->hasMemArea()) {
-      if (!getObjectReader()->readRelocations(**input))
-        return false;
-    }
+    if ((*input)->type() == Input::Object && (*input)->hasMemArea())
+      tasks.push_back(ReadRelocationsTask(*getObjectReader(), **input));
     // ignore the other kinds of files.
   }
+
+  // Each input only appends relocations to its own relocation sections, so
+  // the inputs can be read concurrently.
+  ThreadPool::TaskList task_list;
+  task_list.reserve(tasks.size());
+  std::vector<ReadRelocationsTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(m_Config.options().numOfThreads());
+  pool.run(task_list);
+
+  for (task = tasks.begin(); task != taskEnd; ++task) {
+    if (!task->result())
+      return false;
+  }
   return true;
 }
 
+/// dataStrippingOpt - remove the unused data (--gc-sections) and fold the
+/// identical code (--icf)
+void ObjectLinker::dataStrippingOpt()
+{
+  // A relocatable output keeps everything for the next link.
+  if (LinkerConfig::Object == m_Config.codeGenType())
+    return;
+
+  bool do_gc = m_Config.options().GCSections();
+  bool do_icf = (GeneralOptions::ICF_None != m_Config.options().getICFMode());
+  if (!do_gc && !do_icf)
+    return;
+
+  // Record the functions of the FDEs before their symbols are redirected.
+  Module::obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (LDFileFormat::EhFrame == (*sect)->kind() && (*sect)->hasEhFrame())
+        (*sect)->getEhFrame()->setUpFunctions(**obj);
+    }
+  }
+
+  if (do_gc) {
+    GarbageCollection GC(m_Config, m_LDBackend, *m_pModule);
+    GC.run();
+  }
+
+  // Fold after GC so that the dead sections are not compared.
+  if (do_icf) {
+    IdenticalCodeFolding ICF(m_Config, m_LDBackend, *m_pModule);
+    ICF.foldIdenticalCode();
+  }
+}
+
+/// mergeStrings - merge the strings of SHF_MERGE|SHF_STRINGS sections
+void ObjectLinker::mergeStrings()
+{
+  // A relocatable output keeps the input strings for the next link.
+  if (LinkerConfig::Object == m_Config.codeGenType())
+    return;
+
+  // The factory owns the merged content until the output is emitted.
+  delete m_pMergeStringFactory;
+  m_pMergeStringFactory = new MergeStringFactory(m_Config, *m_pModule);
+  m_pMergeStringFactory->mergeStrings();
+}
+
 /// mergeSections - put allinput sections into output sections
 bool ObjectLinker::mergeSections()
 {
@@ -615,26 +916,47 @@ bool ObjectLinker::relocation()
   if (LinkerConfig::Object == m_Config.codeGenType())
     return true;
 
-  // apply all relocations of all inputs
+  Relocator& relocator = *m_LDBackend.getRelocator();
+
+  // 1. apply the relocations which the relocator allows to apply
+  // concurrently. They only write their own target data, so the inputs are
+  // applied in parallel.
+  std::vector<ApplyRelocationsTask> tasks;
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeApply(**input);
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input)
+    tasks.push_back(ApplyRelocationsTask(relocator, **input));
+
+  ThreadPool::TaskList task_list;
+  task_list.reserve(tasks.size());
+  std::vector<ApplyRelocationsTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(m_Config.options().numOfThreads());
+  pool.run(task_list);
+
+  // 2. in input order, report the errors of step 1 and apply the other
+  // relocations, which may set up GOT, PLT and dynamic relocation entries
+  for (task = tasks.begin(); task != taskEnd; ++task) {
+    ApplyRelocationsTask::FailureList::const_iterator failure,
+      failEnd = task->failures().end();
+    for (failure = task->failures().begin(); failure != failEnd; ++failure)
+      relocator.reportResult(*failure->first, failure->second);
+
+    Input& obj = task->input();
+    relocator.initializeApply(obj);
+    LDContext::sect_iterator rs, rsEnd = obj.context()->relocSectEnd();
+    for (rs = obj.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (isBypassed(**rs))
         continue;
       RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
       for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
         Relocation* relocation = llvm::cast<Relocation>(reloc);
-        relocation->apply(*m_LDBackend.getRelocator());
+        if (!relocator.mayApplyConcurrently(*relocation))
+          relocation->apply(relocator);
       } // for all relocations
     } // for all relocation section
-    m_LDBackend.getRelocator()->finalizeApply(**input);
+    relocator.finalizeApply(obj);
   } // for all inputs
 
   // apply relocations created by relaxation
@@ -644,7 +966,7 @@ bool ObjectLinker::relocation()
     BranchIsland& island = *facIter;
     BranchIsland::reloc_iterator iter, iterEnd = island.reloc_end();
     for (iter = island.reloc_begin(); iter != iterEnd; ++iter)
-      (*iter)->apply(*m_LDBackend.getRelocator());
+      (*iter)->apply(relocator);
   }
   return true;
 }
@@ -676,35 +998,25 @@ void ObjectLinker::normalSyncRelocationResult(MemoryArea& pOutput)
   MemoryRegion* region = pOutput.request(0, pOutput.handler()->size());
 
   uint8_t* data = region->getBuffer();
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  bool swap =
+    (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian());
 
-  // sync all relocations of all inputs
+  // sync all relocations of all inputs. The inputs write disjoint places of
+  // the output, so they are synced in parallel.
+  std::vector<SyncRelocationsTask> tasks;
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input)
+    tasks.push_back(SyncRelocationsTask(relocator, swap, **input, data));
 
-        // bypass the relocation with NONE type. This is to avoid overwrite the
-        // target result by NONE type relocation if there is a place which has
-        // two relocations to apply to, and one of it is NONE type. The result
-        // we want is the value of the other relocation result. For example,
-        // in .exidx, there are usually an R_ARM_NONE and R_ARM_PREL31 apply to
-        // the same place
-        if (0x0 == relocation->type())
-          continue;
-        writeRelocationResult(*relocation, data);
-      } // for all relocations
-    } // for all relocation section
-  } // for all inputs
+  ThreadPool::TaskList task_list;
+  task_list.reserve(tasks.size());
+  std::vector<SyncRelocationsTask>::iterator task, taskEnd = tasks.end();
+  for (task = tasks.begin(); task != taskEnd; ++task)
+    task_list.push_back(&*task);
+
+  ThreadPool pool(m_Config.options().numOfThreads());
+  pool.run(task_list);
 
   // sync relocations created by relaxation
   BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
@@ -714,7 +1026,7 @@ void ObjectLinker::normalSyncRelocationResult(MemoryArea& pOutput)
     BranchIsland::reloc_iterator iter, iterEnd = island.reloc_end();
     for (iter = island.reloc_begin(); iter != iterEnd; ++iter) {
       Relocation* reloc = *iter;
-      writeRelocationResult(*reloc, data);
+      writeRelocationResult(*reloc, relocator, swap, data);
     }
   }
 
@@ -726,6 +1038,9 @@ void ObjectLinker::partialSyncRelocationResult(MemoryArea& pOutput)
   MemoryRegion* region = pOutput.request(0, pOutput.handler()->size());
 
   uint8_t* data = region->getBuffer();
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  bool swap =
+    (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian());
 
   // traverse outputs' LDSection to get RelocData
   Module::iterator sectIter, sectEnd = m_pModule->end();
@@ -746,51 +1061,10 @@ void ObjectLinker::partialSyncRelocationResult(MemoryArea& pOutput)
       // the same place
       if (0x0 == reloc->type())
         continue;
-      writeRelocationResult(*reloc, data);
+      writeRelocationResult(*reloc, relocator, swap, data);
     }
   }
 
   pOutput.clear();
 }
 
-void ObjectLinker::writeRelocationResult(Relocation& pReloc, uint8_t* pOutput)
-{
-  // get output file offset
-  size_t out_offset =
-                 pReloc.targetRef().frag()->getParent()->getSection().offset() +
-                 pReloc.targetRef().getOutputOffset();
-
-  uint8_t* target_addr = pOutput + out_offset;
-  // byte swapping if target and host has different endian, and then write back
-  if(llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian()) {
-     uint64_t tmp_data = 0;
-
-     switch(pReloc.size(*m_LDBackend.getRelocator())) {
-       case 8u:
-         std::memcpy(target_addr, &pReloc.target(), 1);
-         break;
-
-       case 16u:
-         tmp_data = mcld::bswap16(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 2);
-         break;
-
-       case 32u:
-         tmp_data = mcld::bswap32(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 4);
-         break;
-
-       case 64u:
-         tmp_data = mcld::bswap64(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 8);
-         break;
-
-       default:
-         break;
-    }
-  }
-  else
-    std::memcpy(target_addr, &pReloc.target(),
-                                      pReloc.size(*m_LDBackend.getRelocator())/8);
-}
-
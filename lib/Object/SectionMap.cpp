@@ -15,14 +15,6 @@
 #include <cassert>
 #include <cstring>
 #include <climits>
-#if !defined(MCLD_ON_WIN32)
-#include <fnmatch.h>
-#define fnmatch0(pattern,string) (fnmatch(pattern,string,0) == 0)
-#else
-#include <windows.h>
-#include <shlwapi.h>
-#define fnmatch0(pattern,string) (PathMatchSpec(string, pattern) == true)
-#endif
 
 using namespace mcld;
 //===----------------------------------------------------------------------===//
@@ -105,6 +97,10 @@ bool SectionMap::Output::hasContent() const
 //===----------------------------------------------------------------------===//
 // SectionMap
 //===----------------------------------------------------------------------===//
+SectionMap::SectionMap()
+  : m_bCompiled(false) {
+}
+
 SectionMap::~SectionMap()
 {
   iterator out, outBegin = begin(), outEnd = end();
@@ -124,29 +120,19 @@ SectionMap::const_mapping
 SectionMap::find(const std::string& pInputFile,
                  const std::string& pInputSection) const
 {
-  const_iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::const_iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  unsigned int index = match(pInputFile, pInputSection);
+  if (SectionMatcher::NoMatch == index)
+    return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  return std::make_pair(m_Mappings[index].first, m_Mappings[index].second);
 }
 
 SectionMap::mapping SectionMap::find(const std::string& pInputFile,
                                      const std::string& pInputSection)
 {
-  iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((Output*)NULL, (Input*)NULL);
+  unsigned int index = match(pInputFile, pInputSection);
+  if (SectionMatcher::NoMatch == index)
+    return std::make_pair((Output*)NULL, (Input*)NULL);
+  return m_Mappings[index];
 }
 
 SectionMap::const_iterator
@@ -192,6 +178,7 @@ SectionMap::insert(const std::string& pInputSection,
     } else {
       Input* input = new Input(pInputSection);
       (*out)->append(input);
+      invalidate();
       return std::make_pair(std::make_pair(*out, input), true);
     }
   }
@@ -200,6 +187,7 @@ SectionMap::insert(const std::string& pInputSection,
   m_OutputDescList.push_back(output);
   Input* input = new Input(pInputSection);
   output->append(input);
+  invalidate();
 
   return std::make_pair(std::make_pair(output, input), true);
 }
@@ -229,6 +217,7 @@ SectionMap::insert(const InputSectDesc& pInputDesc,
     } else {
       Input* input = new Input(pInputDesc);
       (*out)->append(input);
+      invalidate();
       return std::make_pair(std::make_pair(*out, input), true);
     }
   }
@@ -237,6 +226,7 @@ SectionMap::insert(const InputSectDesc& pInputDesc,
   m_OutputDescList.push_back(output);
   Input* input = new Input(pInputDesc);
   output->append(input);
+  invalidate();
 
   return std::make_pair(std::make_pair(output, input), true);
 }
@@ -247,38 +237,35 @@ SectionMap::insert(iterator pPosition, LDSection* pSection)
   Output* output = new Output(pSection->name());
   output->append(new Input(pSection->name()));
   output->setSection(pSection);
+  invalidate();
   return m_OutputDescList.insert(pPosition, output);
 }
 
-bool SectionMap::matched(const SectionMap::Input& pInput,
-                         const std::string& pInputFile,
-                         const std::string& pInputSection) const
+void SectionMap::invalidate()
 {
-  bool result = false;
-  if (pInput.spec().hasFile() &&
-      fnmatch0(pInput.spec().file().name().c_str(), pInputFile.c_str()))
-    result = true;
-
-  if (pInput.spec().hasExcludeFiles()) {
-    StringList::const_iterator file, fileEnd;
-    fileEnd = pInput.spec().excludeFiles().end();
-    for (file = pInput.spec().excludeFiles().begin(); file != fileEnd; ++file) {
-      if (fnmatch0((*file)->name().c_str(), pInputFile.c_str())) {
-        return false;
-      }
-    }
-  }
+  llvm::sys::SmartScopedLock<true> locker(m_CompileLock);
+  m_bCompiled = false;
+}
 
-  if (pInput.spec().hasSections()) {
-    StringList::const_iterator sect, sectEnd = pInput.spec().sections().end();
-    for (sect = pInput.spec().sections().begin(); sect != sectEnd; ++sect) {
-      if (fnmatch0((*sect)->name().c_str(), pInputSection.c_str())) {
-        result = true;
-        break;
+unsigned int SectionMap::match(const std::string& pInputFile,
+                               const std::string& pInputSection) const
+{
+  {
+    llvm::sys::SmartScopedLock<true> locker(m_CompileLock);
+    if (!m_bCompiled) {
+      m_Matcher.clear();
+      m_Mappings.clear();
+      const_iterator out, outBegin = begin(), outEnd = end();
+      for (out = outBegin; out != outEnd; ++out) {
+        Output::const_iterator in, inBegin = (*out)->begin(),
+                                   inEnd = (*out)->end();
+        for (in = inBegin; in != inEnd; ++in) {
+          m_Matcher.addRule((*in)->spec());
+          m_Mappings.push_back(std::make_pair(*out, *in));
+        }
       }
+      m_bCompiled = true;
     }
-    if (sect == sectEnd)
-      result = false;
   }
-  return result;
+  return m_Matcher.match(pInputFile, pInputSection);
 }
@@ -0,0 +1,220 @@
+//===- SectionMatcher.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Object/SectionMatcher.h>
+#include <mcld/Script/WildcardPattern.h>
+#include <mcld/Script/StringList.h>
+#include <algorithm>
+#if !defined(MCLD_ON_WIN32)
+#include <fnmatch.h>
+#define fnmatch0(pattern,string) (fnmatch(pattern,string,0) == 0)
+#else
+#include <windows.h>
+#include <shlwapi.h>
+#define fnmatch0(pattern,string) (PathMatchSpec(string, pattern) == true)
+#endif
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// SectionMatcher::Glob
+//===----------------------------------------------------------------------===//
+SectionMatcher::Glob::Glob()
+  : m_Kind(Literal), m_PrefixSize(0) {
+}
+
+SectionMatcher::Glob::Glob(const std::string& pPattern)
+  : m_Pattern(pPattern) {
+  m_PrefixSize = pPattern.find_first_of("*?[\\");
+  if (std::string::npos == m_PrefixSize) {
+    m_PrefixSize = pPattern.size();
+    m_Kind = Literal;
+  }
+  else if (m_PrefixSize + 1 == pPattern.size() &&
+           '*' == pPattern[m_PrefixSize])
+    m_Kind = PrefixAny;
+  else
+    m_Kind = General;
+}
+
+bool SectionMatcher::Glob::matches(const std::string& pString) const
+{
+  switch (m_Kind) {
+    case Literal:
+      return (m_Pattern == pString);
+    case PrefixAny:
+      return (0 == pString.compare(0, m_PrefixSize, m_Pattern, 0,
+                                   m_PrefixSize));
+    case General:
+    default:
+      return fnmatch0(m_Pattern.c_str(), pString.c_str());
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// SectionMatcher
+//===----------------------------------------------------------------------===//
+SectionMatcher::SectionMatcher()
+  : m_Trie(1) {
+}
+
+SectionMatcher::~SectionMatcher()
+{
+}
+
+unsigned int SectionMatcher::addRule(const InputSectDesc::Spec& pSpec)
+{
+  unsigned int index = m_Rules.size();
+  m_Rules.push_back(Rule());
+  Rule& rule = m_Rules.back();
+
+  rule.hasFile = pSpec.hasFile();
+  if (rule.hasFile)
+    rule.file = Glob(pSpec.file().name());
+
+  if (pSpec.hasExcludeFiles()) {
+    StringList::const_iterator file, fileEnd = pSpec.excludeFiles().end();
+    for (file = pSpec.excludeFiles().begin(); file != fileEnd; ++file)
+      rule.excludes.push_back(Glob((*file)->name()));
+  }
+
+  rule.hasSections = pSpec.hasSections();
+  if (rule.hasSections) {
+    StringList::const_iterator sect, sectEnd = pSpec.sections().end();
+    for (sect = pSpec.sections().begin(); sect != sectEnd; ++sect)
+      addSectionPattern(index, (*sect)->name());
+  }
+  else if (rule.hasFile) {
+    // the file pattern alone decides the rule
+    m_FileRules.push_back(index);
+  }
+
+  m_Results.clear();
+  return index;
+}
+
+void SectionMatcher::clear()
+{
+  m_Rules.clear();
+  m_Literals.clear();
+  m_Trie.clear();
+  m_Trie.resize(1);
+  m_FileRules.clear();
+  m_Results.clear();
+}
+
+unsigned int SectionMatcher::match(const std::string& pInputFile,
+                                   const std::string& pInputSection) const
+{
+  // a file name never has a NUL, so the key is unique for each pair
+  std::string key;
+  key.reserve(pInputFile.size() + pInputSection.size() + 1);
+  key.append(pInputFile);
+  key.push_back('\0');
+  key.append(pInputSection);
+
+  {
+    llvm::sys::SmartScopedLock<true> locker(m_ResultLock);
+    llvm::StringMap<unsigned int>::iterator entry = m_Results.find(key);
+    if (m_Results.end() != entry)
+      return entry->getValue();
+  }
+
+  unsigned int result = lookup(pInputFile, pInputSection);
+
+  llvm::sys::SmartScopedLock<true> locker(m_ResultLock);
+  m_Results[key] = result;
+  return result;
+}
+
+void SectionMatcher::addSectionPattern(unsigned int pRule,
+                                       const std::string& pPattern)
+{
+  Glob glob(pPattern);
+  if (Glob::Literal == glob.kind()) {
+    RuleList& rules = m_Literals[pPattern];
+    if (rules.empty() || rules.back() != pRule)
+      rules.push_back(pRule);
+    return;
+  }
+
+  llvm::StringRef prefix = glob.prefix();
+  unsigned int node = 0;
+  for (size_t i = 0; i < prefix.size(); ++i) {
+    std::map<char, unsigned int>::iterator child =
+                                          m_Trie[node].children.find(prefix[i]);
+    if (m_Trie[node].children.end() != child) {
+      node = child->second;
+      continue;
+    }
+    unsigned int next = m_Trie.size();
+    m_Trie.push_back(TrieNode());
+    m_Trie[node].children[prefix[i]] = next;
+    node = next;
+  }
+  m_Trie[node].candidates.push_back(std::make_pair(pRule, glob));
+}
+
+bool SectionMatcher::acceptFile(const Rule& pRule,
+                                const std::string& pInputFile) const
+{
+  std::vector<Glob>::const_iterator file, fileEnd = pRule.excludes.end();
+  for (file = pRule.excludes.begin(); file != fileEnd; ++file) {
+    if (file->matches(pInputFile))
+      return false;
+  }
+
+  // a rule with section patterns ignores its file pattern
+  if (pRule.hasSections)
+    return true;
+  return (pRule.hasFile && pRule.file.matches(pInputFile));
+}
+
+unsigned int SectionMatcher::lookup(const std::string& pInputFile,
+                                    const std::string& pInputSection) const
+{
+  // collect the rules whose section patterns match pInputSection
+  RuleList rules(m_FileRules);
+
+  llvm::StringMap<RuleList>::const_iterator literal =
+                                              m_Literals.find(pInputSection);
+  if (m_Literals.end() != literal)
+    rules.insert(rules.end(), literal->getValue().begin(),
+                              literal->getValue().end());
+
+  unsigned int node = 0;
+  for (size_t i = 0; ; ++i) {
+    const TrieNode& trie = m_Trie[node];
+    std::vector<TrieNode::Candidate>::const_iterator cand, candEnd;
+    candEnd = trie.candidates.end();
+    for (cand = trie.candidates.begin(); cand != candEnd; ++cand) {
+      // the trie has matched the prefix of a PrefixAny pattern
+      if (Glob::PrefixAny == cand->second.kind() ||
+          cand->second.matches(pInputSection))
+        rules.push_back(cand->first);
+    }
+
+    if (i == pInputSection.size())
+      break;
+    std::map<char, unsigned int>::const_iterator child =
+                                           trie.children.find(pInputSection[i]);
+    if (trie.children.end() == child)
+      break;
+    node = child->second;
+  }
+
+  // take the first rule which accepts pInputFile
+  std::sort(rules.begin(), rules.end());
+  RuleList::iterator rule, ruleEnd = std::unique(rules.begin(), rules.end());
+  for (rule = rules.begin(); rule != ruleEnd; ++rule) {
+    if (acceptFile(m_Rules[*rule], pInputFile))
+      return *rule;
+  }
+  return NoMatch;
+}
+
@@ -8,12 +8,17 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/Script/FileToken.h>
 #include <mcld/Support/GCFactory.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 
 using namespace mcld;
 
 typedef GCFactory<FileToken, MCLD_SYMBOLS_PER_INPUT> FileTokenFactory;
-static llvm::ManagedStatic<FileTokenFactory> g_FileTokenFactory;
+
+static inline FileTokenFactory& GetFileTokenFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<FileTokenFactory>(LinkContext::FileTokenArena);
+}
 
 //===----------------------------------------------------------------------===//
 // FileToken
@@ -33,19 +38,19 @@ FileToken::~FileToken()
 
 FileToken* FileToken::create(const std::string& pName, bool pAsNeeded)
 {
-  FileToken* result = g_FileTokenFactory->allocate();
+  FileToken* result = GetFileTokenFactory().allocate();
   new (result) FileToken(pName, pAsNeeded);
   return result;
 }
 
 void FileToken::destroy(FileToken*& pFileToken)
 {
-  g_FileTokenFactory->destroy(pFileToken);
-  g_FileTokenFactory->deallocate(pFileToken);
+  GetFileTokenFactory().destroy(pFileToken);
+  GetFileTokenFactory().deallocate(pFileToken);
   pFileToken = NULL;
 }
 
 void FileToken::clear()
 {
-  g_FileTokenFactory->clear();
+  GetFileTokenFactory().clear();
 }
@@ -8,12 +8,17 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/Script/NameSpec.h>
 #include <mcld/Support/GCFactory.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 
 using namespace mcld;
 
 typedef GCFactory<NameSpec, MCLD_SYMBOLS_PER_INPUT> NameSpecFactory;
-static llvm::ManagedStatic<NameSpecFactory> g_NameSpecFactory;
+
+static inline NameSpecFactory& GetNameSpecFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<NameSpecFactory>(LinkContext::NameSpecArena);
+}
 
 //===----------------------------------------------------------------------===//
 // NameSpec
@@ -33,19 +38,19 @@ NameSpec::~NameSpec()
 
 NameSpec* NameSpec::create(const std::string& pName, bool pAsNeeded)
 {
-  NameSpec* result = g_NameSpecFactory->allocate();
+  NameSpec* result = GetNameSpecFactory().allocate();
   new (result) NameSpec(pName, pAsNeeded);
   return result;
 }
 
 void NameSpec::destroy(NameSpec*& pNameSpec)
 {
-  g_NameSpecFactory->destroy(pNameSpec);
-  g_NameSpecFactory->deallocate(pNameSpec);
+  GetNameSpecFactory().destroy(pNameSpec);
+  GetNameSpecFactory().deallocate(pNameSpec);
   pNameSpec = NULL;
 }
 
 void NameSpec::clear()
 {
-  g_NameSpecFactory->clear();
+  GetNameSpecFactory().clear();
 }
@@ -12,7 +12,7 @@
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/Fragment/Fragment.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 
 using namespace mcld;
 
@@ -32,7 +32,12 @@ Operand::~Operand()
 // SymOperand
 //===----------------------------------------------------------------------===//
 typedef GCFactory<SymOperand, MCLD_SYMBOLS_PER_INPUT> SymOperandFactory;
-static llvm::ManagedStatic<SymOperandFactory> g_SymOperandFactory;
+
+static inline SymOperandFactory& GetSymOperandFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<SymOperandFactory>(LinkContext::SymOperandArena);
+}
 
 SymOperand::SymOperand()
   : Operand(Operand::SYMBOL)
@@ -57,28 +62,33 @@ bool SymOperand::isDot() const
 
 SymOperand* SymOperand::create(const std::string& pName)
 {
-  SymOperand* result = g_SymOperandFactory->allocate();
+  SymOperand* result = GetSymOperandFactory().allocate();
   new (result) SymOperand(pName);
   return result;
 }
 
 void SymOperand::destroy(SymOperand*& pOperand)
 {
-  g_SymOperandFactory->destroy(pOperand);
-  g_SymOperandFactory->deallocate(pOperand);
+  GetSymOperandFactory().destroy(pOperand);
+  GetSymOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SymOperand::clear()
 {
-  g_SymOperandFactory->clear();
+  GetSymOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // IntOperand
 //===----------------------------------------------------------------------===//
 typedef GCFactory<IntOperand, MCLD_SYMBOLS_PER_INPUT> IntOperandFactory;
-static llvm::ManagedStatic<IntOperandFactory> g_IntOperandFactory;
+
+static inline IntOperandFactory& GetIntOperandFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<IntOperandFactory>(LinkContext::IntOperandArena);
+}
 
 IntOperand::IntOperand()
   : Operand(Operand::INTEGER)
@@ -97,28 +107,33 @@ void IntOperand::dump() const
 
 IntOperand* IntOperand::create(uint64_t pValue)
 {
-  IntOperand* result = g_IntOperandFactory->allocate();
+  IntOperand* result = GetIntOperandFactory().allocate();
   new (result) IntOperand(pValue);
   return result;
 }
 
 void IntOperand::destroy(IntOperand*& pOperand)
 {
-  g_IntOperandFactory->destroy(pOperand);
-  g_IntOperandFactory->deallocate(pOperand);
+  GetIntOperandFactory().destroy(pOperand);
+  GetIntOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void IntOperand::clear()
 {
-  g_IntOperandFactory->clear();
+  GetIntOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // SectOperand
 //===----------------------------------------------------------------------===//
 typedef GCFactory<SectOperand, MCLD_SECTIONS_PER_INPUT> SectOperandFactory;
-static llvm::ManagedStatic<SectOperandFactory> g_SectOperandFactory;
+
+static inline SectOperandFactory& GetSectOperandFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<SectOperandFactory>(LinkContext::SectOperandArena);
+}
 SectOperand::SectOperand()
   : Operand(Operand::SECTION)
 {
@@ -136,21 +151,21 @@ void SectOperand::dump() const
 
 SectOperand* SectOperand::create(const std::string& pName)
 {
-  SectOperand* result = g_SectOperandFactory->allocate();
+  SectOperand* result = GetSectOperandFactory().allocate();
   new (result) SectOperand(pName);
   return result;
 }
 
 void SectOperand::destroy(SectOperand*& pOperand)
 {
-  g_SectOperandFactory->destroy(pOperand);
-  g_SectOperandFactory->deallocate(pOperand);
+  GetSectOperandFactory().destroy(pOperand);
+  GetSectOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SectOperand::clear()
 {
-  g_SectOperandFactory->clear();
+  GetSectOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
@@ -158,7 +173,13 @@ void SectOperand::clear()
 //===----------------------------------------------------------------------===//
 typedef GCFactory<SectDescOperand,
                   MCLD_SECTIONS_PER_INPUT> SectDescOperandFactory;
-static llvm::ManagedStatic<SectDescOperandFactory> g_SectDescOperandFactory;
+
+static inline SectDescOperandFactory& GetSectDescOperandFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<SectDescOperandFactory>(
+                                             LinkContext::SectDescOperandArena);
+}
 SectDescOperand::SectDescOperand()
   : Operand(Operand::SECTION_DESC), m_pOutputDesc(NULL)
 {
@@ -177,28 +198,33 @@ void SectDescOperand::dump() const
 
 SectDescOperand* SectDescOperand::create(const SectionMap::Output* pOutputDesc)
 {
-  SectDescOperand* result = g_SectDescOperandFactory->allocate();
+  SectDescOperand* result = GetSectDescOperandFactory().allocate();
   new (result) SectDescOperand(pOutputDesc);
   return result;
 }
 
 void SectDescOperand::destroy(SectDescOperand*& pOperand)
 {
-  g_SectDescOperandFactory->destroy(pOperand);
-  g_SectDescOperandFactory->deallocate(pOperand);
+  GetSectDescOperandFactory().destroy(pOperand);
+  GetSectDescOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SectDescOperand::clear()
 {
-  g_SectDescOperandFactory->clear();
+  GetSectDescOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // FragOperand
 //===----------------------------------------------------------------------===//
 typedef GCFactory<FragOperand, MCLD_SYMBOLS_PER_INPUT> FragOperandFactory;
-static llvm::ManagedStatic<FragOperandFactory> g_FragOperandFactory;
+
+static inline FragOperandFactory& GetFragOperandFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<FragOperandFactory>(LinkContext::FragOperandArena);
+}
 
 FragOperand::FragOperand()
   : Operand(Operand::FRAGMENT), m_pFragment(NULL)
@@ -223,19 +249,19 @@ uint64_t FragOperand::value() const
 
 FragOperand* FragOperand::create(Fragment& pFragment)
 {
-  FragOperand* result = g_FragOperandFactory->allocate();
+  FragOperand* result = GetFragOperandFactory().allocate();
   new (result) FragOperand(pFragment);
   return result;
 }
 
 void FragOperand::destroy(FragOperand*& pOperand)
 {
-  g_FragOperandFactory->destroy(pOperand);
-  g_FragOperandFactory->deallocate(pOperand);
+  GetFragOperandFactory().destroy(pOperand);
+  GetFragOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void FragOperand::clear()
 {
-  g_FragOperandFactory->clear();
+  GetFragOperandFactory().clear();
 }
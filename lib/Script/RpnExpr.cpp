@@ -11,13 +11,18 @@
 #include <mcld/Script/Operand.h>
 #include <mcld/Support/GCFactory.h>
 #include <mcld/Support/raw_ostream.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 #include <llvm/Support/Casting.h>
 
 using namespace mcld;
 
 typedef GCFactory<RpnExpr, MCLD_SYMBOLS_PER_INPUT> ExprFactory;
-static llvm::ManagedStatic<ExprFactory> g_ExprFactory;
+
+static inline ExprFactory& GetExprFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<ExprFactory>(LinkContext::RpnExprArena);
+}
 
 //===----------------------------------------------------------------------===//
 // RpnExpr
@@ -55,21 +60,21 @@ void RpnExpr::push_back(ExprToken* pToken)
 
 RpnExpr* RpnExpr::create()
 {
-  RpnExpr* result = g_ExprFactory->allocate();
+  RpnExpr* result = GetExprFactory().allocate();
   new (result) RpnExpr();
   return result;
 }
 
 void RpnExpr::destroy(RpnExpr*& pRpnExpr)
 {
-  g_ExprFactory->destroy(pRpnExpr);
-  g_ExprFactory->deallocate(pRpnExpr);
+  GetExprFactory().destroy(pRpnExpr);
+  GetExprFactory().deallocate(pRpnExpr);
   pRpnExpr = NULL;
 }
 
 void RpnExpr::clear()
 {
-  g_ExprFactory->clear();
+  GetExprFactory().clear();
 }
 
 RpnExpr::iterator RpnExpr::insert(iterator pPosition, ExprToken* pToken)
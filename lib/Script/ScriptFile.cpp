@@ -27,8 +27,8 @@
 #include <mcld/ADT/HashEntry.h>
 #include <mcld/ADT/HashTable.h>
 #include <mcld/ADT/StringHash.h>
+#include <mcld/Support/LinkContext.h>
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 #include <cassert>
 
 using namespace mcld;
@@ -39,7 +39,12 @@ typedef HashEntry<std::string,
 typedef HashTable<ParserStrEntry,
                   hash::StringHash<hash::DJB>,
                   EntryFactory<ParserStrEntry> > ParserStrPool;
-static llvm::ManagedStatic<ParserStrPool> g_ParserStrPool;
+
+static inline ParserStrPool& GetParserStrPool()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<ParserStrPool>(LinkContext::ParserStrPoolArena);
+}
 
 //===----------------------------------------------------------------------===//
 // ScriptFile
@@ -241,12 +246,12 @@ const std::string& ScriptFile::createParserStr(const char* pText,
 {
   bool exist = false;
   ParserStrEntry* entry =
-    g_ParserStrPool->insert(std::string(pText, pLength), exist);
+    GetParserStrPool().insert(std::string(pText, pLength), exist);
   return entry->key();
 }
 
 void ScriptFile::clearParserStrPool()
 {
-  g_ParserStrPool->clear();
+  GetParserStrPool().clear();
 }
 
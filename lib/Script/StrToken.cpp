@@ -8,12 +8,17 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/Script/StrToken.h>
 #include <mcld/Support/GCFactory.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 
 using namespace mcld;
 
 typedef GCFactory<StrToken, MCLD_SYMBOLS_PER_INPUT> StrTokenFactory;
-static llvm::ManagedStatic<StrTokenFactory> g_StrTokenFactory;
+
+static inline StrTokenFactory& GetStrTokenFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<StrTokenFactory>(LinkContext::StrTokenArena);
+}
 
 //===----------------------------------------------------------------------===//
 // StrToken
@@ -34,19 +39,19 @@ StrToken::~StrToken()
 
 StrToken* StrToken::create(const std::string& pString)
 {
-  StrToken* result = g_StrTokenFactory->allocate();
+  StrToken* result = GetStrTokenFactory().allocate();
   new (result) StrToken(String, pString);
   return result;
 }
 
 void StrToken::destroy(StrToken*& pStrToken)
 {
-  g_StrTokenFactory->destroy(pStrToken);
-  g_StrTokenFactory->deallocate(pStrToken);
+  GetStrTokenFactory().destroy(pStrToken);
+  GetStrTokenFactory().deallocate(pStrToken);
   pStrToken = NULL;
 }
 
 void StrToken::clear()
 {
-  g_StrTokenFactory->clear();
+  GetStrTokenFactory().clear();
 }
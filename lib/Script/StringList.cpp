@@ -10,12 +10,17 @@
 #include <mcld/Script/StrToken.h>
 #include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/GCFactory.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 
 using namespace mcld;
 
 typedef GCFactory<StringList, MCLD_SYMBOLS_PER_INPUT> StringListFactory;
-static llvm::ManagedStatic<StringListFactory> g_StringListFactory;
+
+static inline StringListFactory& GetStringListFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<StringListFactory>(LinkContext::StringListArena);
+}
 
 //===----------------------------------------------------------------------===//
 // StringList
@@ -35,19 +40,19 @@ void StringList::push_back(StrToken* pToken)
 
 StringList* StringList::create()
 {
-  StringList* result = g_StringListFactory->allocate();
+  StringList* result = GetStringListFactory().allocate();
   new (result) StringList();
   return result;
 }
 
 void StringList::destroy(StringList*& pStringList)
 {
-  g_StringListFactory->destroy(pStringList);
-  g_StringListFactory->deallocate(pStringList);
+  GetStringListFactory().destroy(pStringList);
+  GetStringListFactory().deallocate(pStringList);
   pStringList = NULL;
 }
 
 void StringList::clear()
 {
-  g_StringListFactory->clear();
+  GetStringListFactory().clear();
 }
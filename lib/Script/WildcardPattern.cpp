@@ -9,14 +9,20 @@
 #include <mcld/Script/WildcardPattern.h>
 #include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/GCFactory.h>
-#include <llvm/Support/ManagedStatic.h>
+#include <mcld/Support/LinkContext.h>
 #include <cassert>
 
 using namespace mcld;
 
 typedef GCFactory<WildcardPattern,
                   MCLD_SYMBOLS_PER_INPUT> WildcardPatternFactory;
-static llvm::ManagedStatic<WildcardPatternFactory> g_WildcardPatternFactory;
+
+static inline WildcardPatternFactory& GetWildcardPatternFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<WildcardPatternFactory>(
+                                             LinkContext::WildcardPatternArena);
+}
 
 //===----------------------------------------------------------------------===//
 // WildcardPattern
@@ -38,19 +44,19 @@ WildcardPattern::~WildcardPattern()
 WildcardPattern* WildcardPattern::create(const std::string& pPattern,
                                          SortPolicy pPolicy)
 {
-  WildcardPattern* result = g_WildcardPatternFactory->allocate();
+  WildcardPattern* result = GetWildcardPatternFactory().allocate();
   new (result) WildcardPattern(pPattern, pPolicy);
   return result;
 }
 
 void WildcardPattern::destroy(WildcardPattern*& pWildcardPattern)
 {
-  g_WildcardPatternFactory->destroy(pWildcardPattern);
-  g_WildcardPatternFactory->deallocate(pWildcardPattern);
+  GetWildcardPatternFactory().destroy(pWildcardPattern);
+  GetWildcardPatternFactory().deallocate(pWildcardPattern);
   pWildcardPattern = NULL;
 }
 
 void WildcardPattern::clear()
 {
-  g_WildcardPatternFactory->clear();
+  GetWildcardPatternFactory().clear();
 }
@@ -137,6 +137,10 @@ bool parser<mcld::ZOption>::parse(llvm::cl::Option &O,
     Val.setKind(ZOption::Now);
   else if (0 == Arg.compare("origin"))
     Val.setKind(ZOption::Origin);
+  else if (0 == Arg.compare("pack-relative-relocs"))
+    Val.setKind(ZOption::PackRelativeRelocs);
+  else if (0 == Arg.compare("nopack-relative-relocs"))
+    Val.setKind(ZOption::NoPackRelativeRelocs);
   else if (Arg.startswith("common-page-size=")) {
     Val.setKind(ZOption::CommPageSize);
     long long unsigned size = 0;
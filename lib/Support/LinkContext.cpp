@@ -0,0 +1,81 @@
+//===- LinkContext.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/LinkContext.h>
+
+#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/ThreadLocal.h>
+
+using namespace mcld;
+
+static llvm::ManagedStatic<LinkContext> g_DefaultContext;
+static llvm::ManagedStatic<llvm::sys::ThreadLocal<LinkContext> >
+                                                            g_ActiveContext;
+
+//===----------------------------------------------------------------------===//
+// LinkContext::Scope
+//===----------------------------------------------------------------------===//
+LinkContext::Scope::Scope(LinkContext& pContext)
+  : m_pPrevious(LinkContext::GetActive()) {
+  LinkContext::SetActive(&pContext);
+}
+
+LinkContext::Scope::~Scope()
+{
+  LinkContext::SetActive(m_pPrevious);
+}
+
+//===----------------------------------------------------------------------===//
+// LinkContext
+//===----------------------------------------------------------------------===//
+LinkContext::LinkContext()
+{
+  for (unsigned int kind = 0; kind < NumOfArenas; ++kind)
+    m_Arenas[kind] = NULL;
+}
+
+LinkContext::~LinkContext()
+{
+  release();
+}
+
+LinkContext& LinkContext::Current()
+{
+  LinkContext* active = GetActive();
+  if (NULL == active)
+    return Default();
+  return *active;
+}
+
+LinkContext& LinkContext::Default()
+{
+  return *g_DefaultContext;
+}
+
+LinkContext* LinkContext::GetActive()
+{
+  return g_ActiveContext->get();
+}
+
+void LinkContext::SetActive(LinkContext* pContext)
+{
+  if (NULL == pContext)
+    g_ActiveContext->erase();
+  else
+    g_ActiveContext->set(pContext);
+}
+
+void LinkContext::release()
+{
+  llvm::sys::SmartScopedLock<true> locker(m_CreateLock);
+  for (unsigned int kind = 0; kind < NumOfArenas; ++kind) {
+    delete m_Arenas[kind];
+    m_Arenas[kind] = NULL;
+  }
+}
+
@@ -11,6 +11,7 @@
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/FileHandle.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/SystemUtils.h>
 
 using namespace mcld;
 
@@ -21,13 +22,13 @@ using namespace mcld;
 // This constructor is used for *SPECIAL* situation. I'm sorry I can not
 // reveal what is the special situation.
 MemoryArea::MemoryArea(Space& pUniverse)
-  : m_pFileHandle(NULL), m_Size(pUniverse.size()) {
+  : m_pFileHandle(NULL), m_Size(pUniverse.size()), m_pWhole(NULL) {
   m_SpaceMap.insert(std::make_pair(Key(pUniverse.start(), pUniverse.size()),
                                    &pUniverse));
 }
 
 MemoryArea::MemoryArea(FileHandle& pFileHandle)
-  : m_pFileHandle(&pFileHandle), m_Size(pFileHandle.size()) {
+  : m_pFileHandle(&pFileHandle), m_Size(pFileHandle.size()), m_pWhole(NULL) {
 }
 
 MemoryArea::~MemoryArea()
@@ -53,6 +54,11 @@ MemoryArea::~MemoryArea()
 //
 MemoryRegion* MemoryArea::request(size_t pOffset, size_t pLength)
 {
+  // a slice of the whole mapped file does not belong to any Space
+  if (NULL != m_pWhole && pOffset + pLength <= m_pWhole->size())
+    return MemoryRegion::Create(m_pWhole->memory() + pOffset, pLength);
+
+  llvm::sys::SmartScopedLock<true> locker(m_Lock);
   Space* space = find(pOffset, pLength);
   if (NULL == space) {
     // not found
@@ -80,6 +86,12 @@ void MemoryArea::release(MemoryRegion* pRegion)
   if (NULL == pRegion)
     return;
 
+  if (!pRegion->hasParent()) {
+    MemoryRegion::Destroy(pRegion);
+    return;
+  }
+
+  llvm::sys::SmartScopedLock<true> locker(m_Lock);
   Space *space = pRegion->parent();
   MemoryRegion::Destroy(pRegion);
 
@@ -113,6 +125,7 @@ void MemoryArea::release(MemoryRegion* pRegion)
 // clear - release all MemoryRegions
 void MemoryArea::clear()
 {
+  llvm::sys::SmartScopedLock<true> locker(m_Lock);
   SpaceMapType::iterator space, sEnd = m_SpaceMap.end();
   if (hasHandler() && m_pFileHandle->isWritable()) {
     for (space = m_SpaceMap.begin(); space != sEnd; ++space) {
@@ -131,6 +144,43 @@ void MemoryArea::clear()
   }
 
   m_SpaceMap.clear();
+
+  if (NULL != m_pWhole) {
+    Space::Release(m_pWhole, *m_pFileHandle);
+    Space::Destroy(m_pWhole);
+    m_pWhole = NULL;
+  }
+}
+
+// mapWhole - map the whole read-only file
+bool MemoryArea::mapWhole()
+{
+  llvm::sys::SmartScopedLock<true> locker(m_Lock);
+  if (NULL != m_pWhole)
+    return true;
+
+  if (NULL == m_pFileHandle || !m_pFileHandle->isReadable() ||
+      m_pFileHandle->isWritable() || 0 == m_Size)
+    return false;
+
+  m_pWhole = Space::Map(*m_pFileHandle);
+  return (NULL != m_pWhole);
+}
+
+// advise - the whole mapping starts at a page boundary, so round pOffset down
+// to the page boundary
+void MemoryArea::advise(size_t pOffset, size_t pLength,
+                        FileHandle::Advice pAdvice)
+{
+  if (NULL == m_pWhole || 0 == pLength || pOffset >= m_pWhole->size())
+    return;
+
+  size_t page_size = mcld::sys::GetPageSize();
+  size_t start = pOffset & ~(page_size - 1);
+  size_t end = pOffset + pLength;
+  if (end > m_pWhole->size())
+    end = m_pWhole->size();
+  m_pFileHandle->advise(m_pWhole->memory() + start, end - start, pAdvice);
 }
 
 //===--------------------------------------------------------------------===//
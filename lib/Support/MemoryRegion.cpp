@@ -8,12 +8,22 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/RegionFactory.h>
+#include <mcld/Support/LinkContext.h>
 
-#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 using namespace mcld;
 
-static llvm::ManagedStatic<RegionFactory> g_RegionFactory;
+static inline RegionFactory& GetRegionFactory()
+{
+  LinkContext& context = LinkContext::Current();
+  return context.arena<RegionFactory>(LinkContext::MemoryRegionArena);
+}
+
+static inline LinkContext::Lock& GetRegionFactoryLock()
+{
+  return LinkContext::Current().lock(LinkContext::MemoryRegionArena);
+}
 
 //===----------------------------------------------------------------------===//
 // MemoryRegion
@@ -32,12 +42,14 @@ MemoryRegion::~MemoryRegion()
 
 MemoryRegion* MemoryRegion::Create(void* pStart, size_t pSize)
 {
-  return g_RegionFactory->produce(static_cast<Address>(pStart), pSize);
+  llvm::sys::SmartScopedLock<true> locker(GetRegionFactoryLock());
+  return GetRegionFactory().produce(static_cast<Address>(pStart), pSize);
 }
 
 MemoryRegion* MemoryRegion::Create(void* pStart, size_t pSize, Space& pSpace)
 {
-  MemoryRegion* result = g_RegionFactory->produce(static_cast<Address>(pStart),
+  llvm::sys::SmartScopedLock<true> locker(GetRegionFactoryLock());
+  MemoryRegion* result = GetRegionFactory().produce(static_cast<Address>(pStart),
                                                   pSize);
   result->setParent(pSpace);
   pSpace.addRegion(*result);
@@ -51,7 +63,9 @@ void MemoryRegion::Destroy(MemoryRegion*& pRegion)
 
   if (pRegion->hasParent())
     pRegion->parent()->removeRegion(*pRegion);
-  g_RegionFactory->destruct(pRegion);
+
+  llvm::sys::SmartScopedLock<true> locker(GetRegionFactoryLock());
+  GetRegionFactory().destruct(pRegion);
   pRegion = NULL;
 }
 
@@ -0,0 +1,141 @@
+//===- SHA1.cpp -----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/SHA1.h>
+
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+static inline uint32_t Rotl(uint32_t pValue, unsigned int pBits)
+{
+  return (pValue << pBits) | (pValue >> (32 - pBits));
+}
+
+static inline uint32_t ReadBE32(const uint8_t* pData)
+{
+  return (uint32_t(pData[0]) << 24) | (uint32_t(pData[1]) << 16) |
+         (uint32_t(pData[2]) << 8) | uint32_t(pData[3]);
+}
+
+//===----------------------------------------------------------------------===//
+// SHA1
+//===----------------------------------------------------------------------===//
+SHA1::SHA1()
+{
+  reset();
+}
+
+void SHA1::reset()
+{
+  m_State[0] = 0x67452301;
+  m_State[1] = 0xefcdab89;
+  m_State[2] = 0x98badcfe;
+  m_State[3] = 0x10325476;
+  m_State[4] = 0xc3d2e1f0;
+  m_Length = 0;
+  m_BufferSize = 0;
+}
+
+void SHA1::compress(const uint8_t* pBlock)
+{
+  uint32_t w[80];
+  for (unsigned int i = 0; i < 16; ++i)
+    w[i] = ReadBE32(pBlock + i * 4);
+  for (unsigned int i = 16; i < 80; ++i)
+    w[i] = Rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  uint32_t a = m_State[0], b = m_State[1], c = m_State[2],
+           d = m_State[3], e = m_State[4];
+  for (unsigned int i = 0; i < 80; ++i) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5a827999;
+    }
+    else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ed9eba1;
+    }
+    else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8f1bbcdc;
+    }
+    else {
+      f = b ^ c ^ d;
+      k = 0xca62c1d6;
+    }
+    uint32_t temp = Rotl(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = Rotl(b, 30);
+    b = a;
+    a = temp;
+  }
+
+  m_State[0] += a;
+  m_State[1] += b;
+  m_State[2] += c;
+  m_State[3] += d;
+  m_State[4] += e;
+}
+
+void SHA1::update(const void* pData, size_t pSize)
+{
+  const uint8_t* data = static_cast<const uint8_t*>(pData);
+  m_Length += pSize;
+
+  // fill up the pending block first
+  if (0 != m_BufferSize) {
+    size_t count = BlockSize - m_BufferSize;
+    if (count > pSize)
+      count = pSize;
+    memcpy(m_Buffer + m_BufferSize, data, count);
+    m_BufferSize += count;
+    data += count;
+    pSize -= count;
+    if (BlockSize != m_BufferSize)
+      return;
+    compress(m_Buffer);
+    m_BufferSize = 0;
+  }
+
+  for (; pSize >= BlockSize; data += BlockSize, pSize -= BlockSize)
+    compress(data);
+
+  memcpy(m_Buffer, data, pSize);
+  m_BufferSize = pSize;
+}
+
+void SHA1::final(uint8_t pDigest[DigestSize])
+{
+  uint64_t bits = m_Length * 8;
+
+  // append the bit '1', pad with zeros, and end with the 64-bit length
+  uint8_t pad[BlockSize * 2];
+  size_t pad_size = (m_BufferSize < BlockSize - 8) ?
+                    (BlockSize - m_BufferSize) :
+                    (BlockSize * 2 - m_BufferSize);
+  memset(pad, 0, pad_size);
+  pad[0] = 0x80;
+  for (unsigned int i = 0; i < 8; ++i)
+    pad[pad_size - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+  update(pad, pad_size);
+
+  for (unsigned int i = 0; i < 5; ++i) {
+    pDigest[i * 4]     = static_cast<uint8_t>(m_State[i] >> 24);
+    pDigest[i * 4 + 1] = static_cast<uint8_t>(m_State[i] >> 16);
+    pDigest[i * 4 + 2] = static_cast<uint8_t>(m_State[i] >> 8);
+    pDigest[i * 4 + 3] = static_cast<uint8_t>(m_State[i]);
+  }
+  reset();
+}
+
@@ -150,6 +150,17 @@ Space* Space::Create(FileHandle& pHandler, size_t pStart, size_t pSize)
   return result;
 }
 
+Space* Space::Map(FileHandle& pHandler)
+{
+  void* memory = NULL;
+  if (!pHandler.mmap(memory, 0, pHandler.size())) {
+    error(diag::err_cannot_mmap_file) << pHandler.path() << 0
+                                      << pHandler.size();
+    return NULL;
+  }
+  return new Space(MMAPED, memory, pHandler.size());
+}
+
 void Space::Destroy(Space*& pSpace)
 {
   delete pSpace;
@@ -0,0 +1,85 @@
+//===- ThreadPool.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Config/Config.h"
+#include <mcld/Support/ThreadPool.h>
+#include <mcld/Support/LinkContext.h>
+
+#include <llvm/Support/Threading.h>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// ThreadPool
+//===----------------------------------------------------------------------===//
+ThreadPool::ThreadPool(unsigned int pNumOfThreads)
+  : m_NumOfThreads(pNumOfThreads), m_pTasks(NULL), m_pContext(NULL),
+    m_Cursor(0) {
+  if (0 == m_NumOfThreads)
+    m_NumOfThreads = 1;
+
+  // ManagedStatic objects (the global factories) are constructed lazily. Let
+  // LLVM guard their construction before any helper thread exists.
+  if (m_NumOfThreads > 1)
+    llvm::llvm_start_multithreaded();
+}
+
+ThreadPool::~ThreadPool()
+{
+}
+
+void ThreadPool::run(TaskList& pTasks)
+{
+  if (pTasks.empty())
+    return;
+
+  m_pTasks = &pTasks;
+  m_pContext = LinkContext::GetActive();
+  m_Cursor = 0;
+
+  unsigned int helpers = m_NumOfThreads - 1;
+  if (helpers >= pTasks.size())
+    helpers = pTasks.size() - 1;
+
+  if (0 == helpers)
+    work();
+  else
+    spawn(helpers);
+
+  m_pTasks = NULL;
+  m_pContext = NULL;
+}
+
+void ThreadPool::work()
+{
+  size_t size = m_pTasks->size();
+  while (true) {
+    size_t idx = llvm::sys::AtomicIncrement(&m_Cursor) - 1;
+    if (idx >= size)
+      return;
+    (*m_pTasks)[idx]->run();
+  }
+}
+
+void* ThreadPool::Worker(void* pPool)
+{
+  ThreadPool* pool = static_cast<ThreadPool*>(pPool);
+  LinkContext::SetActive(pool->m_pContext);
+  pool->work();
+  LinkContext::SetActive(NULL);
+  return NULL;
+}
+
+//===----------------------------------------------------------------------===//
+// Platform-dependent members
+#if defined(MCLD_ON_UNIX)
+#include "Unix/Thread.inc"
+#endif
+#if defined(MCLD_ON_WIN32)
+#include "Windows/Thread.inc"
+#endif
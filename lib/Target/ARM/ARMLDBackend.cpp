@@ -40,6 +40,7 @@
 #include <mcld/LD/ELFFileFormat.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/ELFSegment.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/Target/GNUInfo.h>
 #include <mcld/Object/ObjectBuilder.h>
 
@@ -509,113 +510,63 @@ ARMGNULDBackend::getTargetSectionOrder(const LDSection& pSectHdr) const
   return SHO_UNDEFINED;
 }
 
-/// doRelax
-bool
-ARMGNULDBackend::doRelax(Module& pModule, IRBuilder& pBuilder, bool& pFinished)
+/// mayNeedStub - the branches may need stubs
+bool ARMGNULDBackend::mayNeedStub(const Relocation& pRel) const
 {
-  assert(NULL != getStubFactory() && NULL != getBRIslandFactory());
-
-  bool isRelaxed = false;
-  ELFFileFormat* file_format = getOutputFormat();
-  // check branch relocs and create the related stubs if needed
-  Module::obj_iterator input, inEnd = pModule.obj_end();
-  for (input = pModule.obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
-
-        switch (relocation->type()) {
-          case llvm::ELF::R_ARM_PC24:
-          case llvm::ELF::R_ARM_CALL:
-          case llvm::ELF::R_ARM_JUMP24:
-          case llvm::ELF::R_ARM_PLT32:
-          case llvm::ELF::R_ARM_THM_CALL:
-          case llvm::ELF::R_ARM_THM_XPC22:
-          case llvm::ELF::R_ARM_THM_JUMP24:
-          case llvm::ELF::R_ARM_THM_JUMP19: {
-            // calculate the possible symbol value
-            uint64_t sym_value = 0x0;
-            LDSymbol* symbol = relocation->symInfo()->outSymbol();
-            if (symbol->hasFragRef()) {
-              uint64_t value = symbol->fragRef()->getOutputOffset();
-              uint64_t addr =
-                symbol->fragRef()->frag()->getParent()->getSection().addr();
-              sym_value = addr + value;
-            }
-            if (relocation->symInfo()->isGlobal() &&
-                (relocation->symInfo()->reserved() & ARMRelocator::ReservePLT) != 0x0) {
-              // FIXME: we need to find out the address of the specific plt entry
-              assert(file_format->hasPLT());
-              sym_value = file_format->getPLT().addr();
-            }
-
-            Stub* stub = getStubFactory()->create(*relocation, // relocation
-                                                  sym_value, // symbol value
-                                                  pBuilder,
-                                                  *getBRIslandFactory());
-            if (NULL != stub) {
-              // a stub symbol should be local
-              assert(NULL != stub->symInfo() && stub->symInfo()->isLocal());
-              LDSection& symtab = file_format->getSymTab();
-              LDSection& strtab = file_format->getStrTab();
-
-              // increase the size of .symtab and .strtab if needed
-              if (config().targets().is32Bits())
-                symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf32_Sym));
-              else
-                symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf64_Sym));
-              symtab.setInfo(symtab.getInfo() + 1);
-              strtab.setSize(strtab.size() + stub->symInfo()->nameSize() + 1);
-
-              isRelaxed = true;
-            }
-            break;
-          }
-          case llvm::ELF::R_ARM_V4BX:
-            /* FIXME: bypass R_ARM_V4BX relocation now */
-            break;
-          default:
-            break;
-        } // end of switch
-
-      } // for all relocations
-    } // for all relocation section
-  } // for all inputs
-
-  // find the first fragment w/ invalid offset due to stub insertion
-  Fragment* invalid = NULL;
-  pFinished = true;
-  for (BranchIslandFactory::iterator island = getBRIslandFactory()->begin(),
-       island_end = getBRIslandFactory()->end(); island != island_end; ++island) {
-    if ((*island).end() == file_format->getText().getSectionData()->end())
-      break;
-
-    Fragment* exit = (*island).end();
-    if (((*island).offset() + (*island).size()) > exit->getOffset()) {
-      invalid = exit;
-      pFinished = false;
-      break;
-    }
+  switch (pRel.type()) {
+    case llvm::ELF::R_ARM_PC24:
+    case llvm::ELF::R_ARM_CALL:
+    case llvm::ELF::R_ARM_JUMP24:
+    case llvm::ELF::R_ARM_PLT32:
+    case llvm::ELF::R_ARM_THM_CALL:
+    case llvm::ELF::R_ARM_THM_XPC22:
+    case llvm::ELF::R_ARM_THM_JUMP24:
+    case llvm::ELF::R_ARM_THM_JUMP19:
+      return true;
+    case llvm::ELF::R_ARM_V4BX:
+      /* FIXME: bypass R_ARM_V4BX relocation now */
+    default:
+      return false;
   }
+}
 
-  // reset the offset of invalid fragments
-  while (NULL != invalid) {
-    invalid->setOffset(invalid->getPrevNode()->getOffset() +
-                       invalid->getPrevNode()->size());
-    invalid = invalid->getNextNode();
+/// getBranchTarget - a branch to a global symbol with a PLT entry reaches the
+/// PLT
+uint64_t ARMGNULDBackend::getBranchTarget(const Relocation& pRel) const
+{
+  if (pRel.symInfo()->isGlobal() &&
+      (pRel.symInfo()->reserved() & ARMRelocator::ReservePLT) != 0x0) {
+    // FIXME: we need to find out the address of the specific plt entry
+    assert(getOutputFormat()->hasPLT());
+    return getOutputFormat()->getPLT().addr();
   }
+  return GNULDBackend::getBranchTarget(pRel);
+}
 
-  // reset the size of .text
-  if (isRelaxed) {
-    file_format->getText().setSize(
-      file_format->getText().getSectionData()->back().getOffset() +
-      file_format->getText().getSectionData()->back().size());
-  }
-  return isRelaxed;
+/// relaxRelocation - create the stub of a branch if needed
+bool ARMGNULDBackend::relaxRelocation(IRBuilder& pBuilder, Relocation& pRel)
+{
+  Stub* stub = getStubFactory()->create(pRel, // relocation
+                                        getBranchTarget(pRel), // symbol value
+                                        pBuilder,
+                                        *getBRIslandFactory());
+  if (NULL == stub)
+    return false;
+
+  // a stub symbol should be local
+  assert(NULL != stub->symInfo() && stub->symInfo()->isLocal());
+  LDSection& symtab = getOutputFormat()->getSymTab();
+  LDSection& strtab = getOutputFormat()->getStrTab();
+
+  // increase the size of .symtab and .strtab if needed
+  if (config().targets().is32Bits())
+    symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf32_Sym));
+  else
+    symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf64_Sym));
+  symtab.setInfo(symtab.getInfo() + 1);
+  strTabBuilder().add(stub->symInfo()->name());
+  strtab.setSize(strTabBuilder().size());
+  return true;
 }
 
 /// initTargetStubs
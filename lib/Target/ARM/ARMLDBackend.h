@@ -124,14 +124,20 @@ private:
   /// FIXME: if we can handle arm attributes, we may refine this!
   uint64_t maxBranchOffset() { return THM_MAX_FWD_BRANCH_OFFSET; }
 
+  /// maxBwdBranchOffset
+  uint64_t maxBwdBranchOffset() { return -THM_MAX_BWD_BRANCH_OFFSET; }
+
   /// mayRelax - Backends should override this function if they need relaxation
   bool mayRelax() { return true; }
 
-  /// doRelax - Backend can orevride this function to add its relaxation
-  /// implementation. Return true if the output (e.g., .text) is "relaxed"
-  /// (i.e. layout is changed), and set pFinished to true if everything is fit,
-  /// otherwise set it to false.
-  bool doRelax(Module& pModule, IRBuilder& pBuilder, bool& pFinished);
+  /// mayNeedStub - the branches may need stubs
+  bool mayNeedStub(const Relocation& pRel) const;
+
+  /// getBranchTarget - the address reached by a branch
+  uint64_t getBranchTarget(const Relocation& pRel) const;
+
+  /// relaxRelocation - create the stub of a branch if needed
+  bool relaxRelocation(IRBuilder& pBuilder, Relocation& pRel);
 
   /// initTargetStubs
   bool initTargetStubs();
@@ -78,6 +78,33 @@ Relocator::Size ARMRelocator::getSize(Relocation::Type pType) const
   return 32;
 }
 
+bool ARMRelocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const
+{
+  switch (pReloc.type()) {
+    case llvm::ELF::R_ARM_PC24:
+    case llvm::ELF::R_ARM_PLT32:
+    case llvm::ELF::R_ARM_CALL:
+    case llvm::ELF::R_ARM_JUMP24:
+    case llvm::ELF::R_ARM_THM_CALL:
+    case llvm::ELF::R_ARM_THM_XPC22:
+    case llvm::ELF::R_ARM_THM_JUMP24:
+    case llvm::ELF::R_ARM_THM_JUMP19:
+    case llvm::ELF::R_ARM_THM_JUMP11:
+    case llvm::ELF::R_ARM_THM_JUMP8:
+    case llvm::ELF::R_ARM_THM_JUMP6:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool ARMRelocator::mayApplyConcurrently(const Relocation& pReloc) const
+{
+  // The GOT, PLT and dynamic relocation entries are set up by the first
+  // relocation applied against the symbol.
+  return (None == pReloc.symInfo()->reserved());
+}
+
 void ARMRelocator::addCopyReloc(ResolveInfo& pSym)
 {
   Relocation& rel_entry = *getTarget().getRelDyn().consumeEntry();
@@ -88,6 +88,10 @@ public:
 
   Size getSize(Relocation::Type pType) const;
 
+  bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
+
+  bool mayApplyConcurrently(const Relocation& pReloc) const;
+
   const SymGOTMap& getSymGOTMap() const { return m_SymGOTMap; }
   SymGOTMap&       getSymGOTMap()       { return m_SymGOTMap; }
 
@@ -158,6 +158,20 @@ void ELFDynamic::reserveEntries(const ELFFileFormat& pFormat)
     reserveOne(llvm::ELF::DT_RELAENT); // DT_RELAENT
   }
 
+  if (m_Config.options().hasCombReloc() &&
+      0x0 != m_Backend.getRelativeRelocType()) {
+    if (pFormat.hasRelDyn())
+      reserveOne(0x6ffffffa); // DT_RELCOUNT
+    if (pFormat.hasRelaDyn())
+      reserveOne(0x6ffffff9); // DT_RELACOUNT
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    reserveOne(ELFFileFormat::DT_RELR); // DT_RELR
+    reserveOne(ELFFileFormat::DT_RELRSZ); // DT_RELRSZ
+    reserveOne(ELFFileFormat::DT_RELRENT); // DT_RELRENT
+  }
+
   uint64_t dt_flags = 0x0;
   if (m_Config.options().hasOrigin())
     dt_flags |= llvm::ELF::DF_ORIGIN;
@@ -267,6 +281,22 @@ void ELFDynamic::applyEntries(const ELFFileFormat& pFormat)
     applyOne(llvm::ELF::DT_RELAENT, m_pEntryFactory->relaSize()); // DT_RELAENT
   }
 
+  if (m_Config.options().hasCombReloc() &&
+      0x0 != m_Backend.getRelativeRelocType()) {
+    if (pFormat.hasRelDyn())
+      applyOne(0x6ffffffa, m_Backend.numOfRelativeRelocs()); // DT_RELCOUNT
+    if (pFormat.hasRelaDyn())
+      applyOne(0x6ffffff9, m_Backend.numOfRelativeRelocs()); // DT_RELACOUNT
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    applyOne(ELFFileFormat::DT_RELR, pFormat.getRelrDyn().addr()); // DT_RELR
+    uint64_t relr_size = m_Config.targets().bitclass() / 8;
+    applyOne(ELFFileFormat::DT_RELRSZ,
+             m_Backend.numOfRelrEntries() * relr_size); // DT_RELRSZ
+    applyOne(ELFFileFormat::DT_RELRENT, relr_size); // DT_RELRENT
+  }
+
   if (m_Backend.hasTextRel()) {
     applyOne(llvm::ELF::DT_TEXTREL, 0x0); // DT_TEXTREL
 
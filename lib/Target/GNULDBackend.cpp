@@ -26,21 +26,26 @@
 #include <mcld/LD/LDContext.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/LD/EhFrameHdr.h>
+#include <mcld/LD/BuildID.h>
 #include <mcld/LD/RelocData.h>
 #include <mcld/LD/RelocationFactory.h>
 #include <mcld/LD/BranchIslandFactory.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/ELFSegment.h>
 #include <mcld/LD/StubFactory.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/LD/ELFFileFormat.h>
 #include <mcld/LD/ELFObjectFileFormat.h>
 #include <mcld/LD/ELFDynObjFileFormat.h>
 #include <mcld/LD/ELFExecFileFormat.h>
 #include <mcld/Target/ELFDynamic.h>
 #include <mcld/Target/GNUInfo.h>
+#include <mcld/Target/OutputRelocSection.h>
+#include <mcld/Target/OutputRelrSection.h>
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/MemoryAreaFactory.h>
 #include <mcld/Object/ObjectBuilder.h>
 #include <mcld/Object/SectionMap.h>
@@ -48,8 +53,10 @@
 #include <mcld/Script/Operand.h>
 #include <mcld/Script/OutputSectDesc.h>
 #include <mcld/Fragment/FillFragment.h>
+#include <mcld/Fragment/RegionFragment.h>
 #include <mcld/MC/Attribute.h>
 
+#include <llvm/Support/Casting.h>
 #include <llvm/Support/Host.h>
 
 namespace {
@@ -70,6 +77,20 @@ static bool isCIdentifier(const std::string& pName)
               == std::string::npos);
 }
 
+/// getRpath - the string of DT_RPATH/DT_RUNPATH, the paths joined by ':'
+static std::string getRpath(const mcld::GeneralOptions& pOptions)
+{
+  std::string result;
+  mcld::GeneralOptions::const_rpath_iterator rpath,
+    rpathEnd = pOptions.rpath_end();
+  for (rpath = pOptions.rpath_begin(); rpath != rpathEnd; ++rpath) {
+    if (!result.empty())
+      result += ':';
+    result += *rpath;
+  }
+  return result;
+}
+
 } // anonymous namespace
 
 using namespace mcld;
@@ -88,6 +109,12 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
     m_pBRIslandFactory(NULL),
     m_pStubFactory(NULL),
     m_pEhFrameHdr(NULL),
+    m_pBuildID(NULL),
+    m_pRelrDyn(NULL),
+    m_NumOfRelativeRelocs(0),
+    m_pStrTabBuilder(NULL),
+    m_pDynStrTabBuilder(NULL),
+    m_pShStrTabBuilder(NULL),
     m_bHasTextRel(false),
     m_bHasStaticTLS(false),
     f_pPreInitArrayStart(NULL),
@@ -111,6 +138,9 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
     f_p_End(NULL) {
   m_pELFSegmentTable = new ELFSegmentFactory();
   m_pSymIndexMap = new HashTableType(1024);
+  m_pStrTabBuilder = new StringTableBuilder();
+  m_pDynStrTabBuilder = new StringTableBuilder();
+  m_pShStrTabBuilder = new StringTableBuilder();
 }
 
 GNULDBackend::~GNULDBackend()
@@ -122,8 +152,13 @@ GNULDBackend::~GNULDBackend()
   delete m_pObjectFileFormat;
   delete m_pSymIndexMap;
   delete m_pEhFrameHdr;
+  delete m_pBuildID;
+  delete m_pRelrDyn;
   delete m_pBRIslandFactory;
   delete m_pStubFactory;
+  delete m_pStrTabBuilder;
+  delete m_pDynStrTabBuilder;
+  delete m_pShStrTabBuilder;
 }
 
 size_t GNULDBackend::sectionStartOffset() const
@@ -740,13 +775,14 @@ const ELFFileFormat* GNULDBackend::getOutputFormat() const
 /// sizeShstrtab - compute the size of .shstrtab
 void GNULDBackend::sizeShstrtab(Module& pModule)
 {
-  size_t shstrtab = 0;
   // compute the size of .shstrtab section.
+  m_pShStrTabBuilder->clear();
   Module::const_iterator sect, sectEnd = pModule.end();
   for (sect = pModule.begin(); sect != sectEnd; ++sect) {
-    shstrtab += (*sect)->name().size() + 1;
+    m_pShStrTabBuilder->add((*sect)->name());
   } // end of for
-  getOutputFormat()->getShStrTab().setSize(shstrtab);
+  m_pShStrTabBuilder->finalize();
+  getOutputFormat()->getShStrTab().setSize(m_pShStrTabBuilder->size());
 }
 
 /// sizeNamePools - compute the size of regular name pools
@@ -761,10 +797,9 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   size_t symtab = 1;
   size_t dynsym = config().isCodeStatic()? 0 : 1;
 
-  // size of string tables starts from 1 to hold the null character in their
-  // first byte
-  size_t strtab   = 1;
-  size_t dynstr   = config().isCodeStatic()? 0 : 1;
+  // the names are deduplicated and tail-merged by StringTableBuilder
+  m_pStrTabBuilder->clear();
+  m_pDynStrTabBuilder->clear();
   size_t hash     = 0;
   size_t gnuhash  = 0;
 
@@ -780,8 +815,10 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
     ++symtab;
     if (hasEntryInStrTab(**symbol))
-      strtab += (*symbol)->nameSize() + 1;
+      m_pStrTabBuilder->add(llvm::StringRef((*symbol)->name(),
+                                            (*symbol)->nameSize()));
   }
+  m_pStrTabBuilder->finalize();
   symtab_local_cnt = 1 + symbols.numOfFiles() + symbols.numOfLocals() +
                      symbols.numOfLocalDyns();
 
@@ -790,7 +827,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   switch(config().codeGenType()) {
     case LinkerConfig::DynObj: {
       // soname
-      dynstr += config().options().soname().size() + 1;
+      m_pDynStrTabBuilder->add(config().options().soname());
     }
     /** fall through **/
     case LinkerConfig::Exec:
@@ -801,7 +838,8 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
           ++dynsym;
           if (hasEntryInStrTab(**symbol))
-            dynstr += (*symbol)->nameSize() + 1;
+            m_pDynStrTabBuilder->add(llvm::StringRef((*symbol)->name(),
+                                                     (*symbol)->nameSize()));
         }
         dynsym_local_cnt = 1 + symbols.numOfLocalDyns();
 
@@ -837,7 +875,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         Module::const_lib_iterator lib, libEnd = pModule.lib_end();
         for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
           if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
-            dynstr += (*lib)->name().size() + 1;
+            m_pDynStrTabBuilder->add((*lib)->name());
             dynamic().reserveNeedEntry();
           }
         }
@@ -845,12 +883,9 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         // add DT_RPATH
         if (!config().options().getRpathList().empty()) {
           dynamic().reserveNeedEntry();
-          GeneralOptions::const_rpath_iterator rpath,
-            rpathEnd = config().options().rpath_end();
-          for (rpath = config().options().rpath_begin();
-               rpath != rpathEnd; ++rpath)
-            dynstr += (*rpath).size() + 1;
+          m_pDynStrTabBuilder->add(getRpath(config().options()));
         }
+        m_pDynStrTabBuilder->finalize();
 
         // set size
         if (config().targets().is32Bits()) {
@@ -860,7 +895,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
           file_format->getDynSymTab().setSize(dynsym *
                                               sizeof(llvm::ELF::Elf64_Sym));
         }
-        file_format->getDynStrTab().setSize(dynstr);
+        file_format->getDynStrTab().setSize(m_pDynStrTabBuilder->size());
         file_format->getHashTab().setSize(hash);
         file_format->getGNUHashTab().setSize(gnuhash);
 
@@ -881,7 +916,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         file_format->getSymTab().setSize(symtab*sizeof(llvm::ELF::Elf32_Sym));
       else
         file_format->getSymTab().setSize(symtab*sizeof(llvm::ELF::Elf64_Sym));
-      file_format->getStrTab().setSize(strtab);
+      file_format->getStrTab().setSize(m_pStrTabBuilder->size());
 
       // set .symtab sh_info to one greater than the symbol table
       // index of the last local symbol
@@ -901,15 +936,14 @@ void GNULDBackend::sizeNamePools(Module& pModule)
 /// emitSymbol32 - emit an ELF32 symbol
 void GNULDBackend::emitSymbol32(llvm::ELF::Elf32_Sym& pSym,
                                 LDSymbol& pSymbol,
-                                char* pStrtab,
-                                size_t pStrtabsize,
+                                const StringTableBuilder& pStrTab,
                                 size_t pSymtabIdx)
 {
    // FIXME: check the endian between host and target
    // write out symbol
    if (hasEntryInStrTab(pSymbol)) {
-     pSym.st_name  = pStrtabsize;
-     strcpy((pStrtab + pStrtabsize), pSymbol.name());
+     pSym.st_name  = pStrTab.getOffset(llvm::StringRef(pSymbol.name(),
+                                                       pSymbol.nameSize()));
    }
    else {
      pSym.st_name  = 0;
@@ -924,15 +958,14 @@ void GNULDBackend::emitSymbol32(llvm::ELF::Elf32_Sym& pSym,
 /// emitSymbol64 - emit an ELF64 symbol
 void GNULDBackend::emitSymbol64(llvm::ELF::Elf64_Sym& pSym,
                                 LDSymbol& pSymbol,
-                                char* pStrtab,
-                                size_t pStrtabsize,
+                                const StringTableBuilder& pStrTab,
                                 size_t pSymtabIdx)
 {
    // FIXME: check the endian between host and target
    // write out symbol
    if (hasEntryInStrTab(pSymbol)) {
-     pSym.st_name  = pStrtabsize;
-     strcpy((pStrtab + pStrtabsize), pSymbol.name());
+     pSym.st_name  = pStrTab.getOffset(llvm::StringRef(pSymbol.name(),
+                                                       pSymbol.nameSize()));
    }
    else {
      pSym.st_name  = 0;
@@ -973,14 +1006,14 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
                                       << config().targets().bitclass();
   }
 
-  // set up strtab_region
-  char* strtab = (char*)strtab_region->start();
+  // emit .strtab
+  m_pStrTabBuilder->emit((char*)strtab_region->start());
 
   // emit the first ELF symbol
   if (config().targets().is32Bits())
-    emitSymbol32(symtab32[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol32(symtab32[0], *LDSymbol::Null(), *m_pStrTabBuilder, 0);
   else
-    emitSymbol64(symtab64[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol64(symtab64[0], *LDSymbol::Null(), *m_pStrTabBuilder, 0);
 
   bool sym_exist = false;
   HashTableType::entry_type* entry = NULL;
@@ -990,7 +1023,6 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
   }
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
 
   const Module::SymbolTable& symbols = pModule.getSymbolTable();
   Module::const_sym_iterator symbol, symEnd;
@@ -1002,12 +1034,10 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
       entry->setValue(symIdx);
     }
     if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol32(symtab32[symIdx], **symbol, *m_pStrTabBuilder, symIdx);
     else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol64(symtab64[symIdx], **symbol, *m_pStrTabBuilder, symIdx);
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 }
 
@@ -1048,17 +1078,16 @@ void GNULDBackend::emitDynNamePools(Module& pModule, MemoryArea& pOutput)
                                       << config().targets().bitclass();
   }
 
-  // set up strtab_region
-  char* strtab = (char*)strtab_region->start();
+  // emit .dynstr
+  m_pDynStrTabBuilder->emit((char*)strtab_region->start());
 
   // emit the first ELF symbol
   if (config().targets().is32Bits())
-    emitSymbol32(symtab32[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol32(symtab32[0], *LDSymbol::Null(), *m_pDynStrTabBuilder, 0);
   else
-    emitSymbol64(symtab64[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol64(symtab64[0], *LDSymbol::Null(), *m_pDynStrTabBuilder, 0);
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
 
   Module::SymbolTable& symbols = pModule.getSymbolTable();
   // emit .gnu.hash
@@ -1075,60 +1104,46 @@ void GNULDBackend::emitDynNamePools(Module& pModule, MemoryArea& pOutput)
   Module::const_sym_iterator symbol, symEnd = symbols.dynamicEnd();
   for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
     if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol32(symtab32[symIdx], **symbol, *m_pDynStrTabBuilder, symIdx);
     else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol64(symtab64[symIdx], **symbol, *m_pDynStrTabBuilder, symIdx);
     // maintain output's symbol and index map
     entry = m_pSymIndexMap->insert(*symbol, sym_exist);
     entry->setValue(symIdx);
     // sum up counters
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 
   // emit DT_NEED
-  // add DT_NEED strings into .dynstr
+  // the DT_NEED strings are in .dynstr
   ELFDynamic::iterator dt_need = dynamic().needBegin();
   Module::const_lib_iterator lib, libEnd = pModule.lib_end();
   for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
     if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
-      strcpy((strtab + strtabsize), (*lib)->name().c_str());
-      (*dt_need)->setValue(llvm::ELF::DT_NEEDED, strtabsize);
-      strtabsize += (*lib)->name().size() + 1;
+      (*dt_need)->setValue(llvm::ELF::DT_NEEDED,
+                           m_pDynStrTabBuilder->getOffset((*lib)->name()));
       ++dt_need;
     }
   }
 
   if (!config().options().getRpathList().empty()) {
+    uint64_t rpath =
+      m_pDynStrTabBuilder->getOffset(getRpath(config().options()));
     if (!config().options().hasNewDTags())
-      (*dt_need)->setValue(llvm::ELF::DT_RPATH, strtabsize);
+      (*dt_need)->setValue(llvm::ELF::DT_RPATH, rpath);
     else
-      (*dt_need)->setValue(llvm::ELF::DT_RUNPATH, strtabsize);
+      (*dt_need)->setValue(llvm::ELF::DT_RUNPATH, rpath);
     ++dt_need;
-
-    GeneralOptions::const_rpath_iterator rpath,
-      rpathEnd = config().options().rpath_end();
-    for (rpath = config().options().rpath_begin(); rpath != rpathEnd; ++rpath) {
-      memcpy((strtab + strtabsize), (*rpath).data(), (*rpath).size());
-      strtabsize += (*rpath).size();
-      strtab[strtabsize++] = (rpath + 1 == rpathEnd ? '\0' : ':');
-    }
   }
 
   // initialize value of ELF .dynamic section
   if (LinkerConfig::DynObj == config().codeGenType()) {
     // set pointer to SONAME entry in dynamic string table.
-    dynamic().applySoname(strtabsize);
+    dynamic().applySoname(
+      m_pDynStrTabBuilder->getOffset(config().options().soname()));
   }
   dynamic().applyEntries(*file_format);
   dynamic().emit(dyn_sect, *dyn_region);
-
-  // emit soname
-  if (LinkerConfig::DynObj == config().codeGenType()) {
-    strcpy((strtab + strtabsize), config().options().soname().c_str());
-    strtabsize += config().options().soname().size() + 1;
-  }
 }
 
 /// emitELFHashTab - emit .hash
@@ -1325,6 +1340,14 @@ void GNULDBackend::emitInterp(MemoryArea& pOutput)
   }
 }
 
+/// getEntry - get the entry point name
+llvm::StringRef GNULDBackend::getEntry(const Module& pModule) const
+{
+  if (pModule.getScript().hasEntry())
+    return pModule.getScript().entry();
+  return getInfo().entry();
+}
+
 bool GNULDBackend::hasEntryInStrTab(const LDSymbol& pSym) const
 {
   return ResolveInfo::Section != pSym.type();
@@ -2507,6 +2530,7 @@ void GNULDBackend::layout(Module& pModule)
     std::stable_sort(sectionMap.begin(),
                      sectionMap.end(),
                      SectionMap::SHOCompare());
+    sectionMap.invalidate();
   }
 
   // 3. update output sections in Module
@@ -2552,6 +2576,15 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder)
     m_pEhFrameHdr->sizeOutput();
   }
 
+  if ((LinkerConfig::Exec == config().codeGenType() ||
+       LinkerConfig::DynObj == config().codeGenType()) &&
+      config().options().hasBuildID()) {
+    // init BuildID and size the output section
+    m_pBuildID = new BuildID(getOutputFormat()->getNoteGNUBuildID(),
+                             config());
+    m_pBuildID->sizeOutput();
+  }
+
   // change .tbss and .tdata section symbol from Local to LocalDyn category
   if (NULL != f_pTDATA)
     pModule.getSymbolTable().changeToDynamic(*f_pTDATA);
@@ -2639,8 +2672,18 @@ void GNULDBackend::postProcessing(MemoryArea& pOutput)
   if (LinkerConfig::Object != config().codeGenType() &&
       config().options().hasEhFrameHdr() && getOutputFormat()->hasEhFrame()) {
     // emit eh_frame_hdr
-    m_pEhFrameHdr->emitOutput<32>(pOutput);
+    if (config().targets().is32Bits())
+      m_pEhFrameHdr->emitOutput<32>(pOutput,
+                                    config().options().numOfThreads());
+    else if (config().targets().is64Bits())
+      m_pEhFrameHdr->emitOutput<64>(pOutput,
+                                    config().options().numOfThreads());
   }
+
+  // emit .note.gnu.build-id. The digest covers the whole output file, so
+  // this must be the last one.
+  if (NULL != m_pBuildID)
+    m_pBuildID->emitOutput(pOutput, config().options().numOfThreads());
 }
 
 /// getHashBucketCount - calculate hash bucket count.
@@ -2968,11 +3011,111 @@ void GNULDBackend::sortRelocation(LDSection& pSection)
   }
 }
 
+/// mayPackRelativeRelocs - if the relative relocations go to .relr.dyn
+bool GNULDBackend::mayPackRelativeRelocs() const
+{
+  return config().options().hasPackRelativeRelocs() &&
+         config().isCodeIndep() &&
+         !config().isCodeStatic() &&
+         0x0 != getRelativeRelocType();
+}
+
+/// isPackablePlace - if the place of pReloc is word-aligned in the output
+bool GNULDBackend::isPackablePlace(const Relocation& pReloc,
+                                   const LDSection& pTarget) const
+{
+  if (!mayPackRelativeRelocs())
+    return false;
+
+  // the fragments of .eh_frame and the mergeable sections are not the whole
+  // input section
+  if (LDFileFormat::EhFrame == pTarget.kind() ||
+      0x0 != (pTarget.flag() & llvm::ELF::SHF_MERGE))
+    return false;
+
+  const Fragment* frag = pReloc.targetRef().frag();
+  if (NULL == frag || !llvm::isa<RegionFragment>(frag))
+    return false;
+
+  // the input section is placed at its alignment
+  uint64_t word = config().targets().bitclass() / 8;
+  return (0 == (pTarget.align() % word)) &&
+         (0 == (pReloc.targetRef().offset() % word));
+}
+
+/// sizeRelrDyn - size .relr.dyn by the relative entries of pRelDyn
+size_t GNULDBackend::sizeRelrDyn(OutputRelocSection& pRelDyn)
+{
+  size_t num = pRelDyn.numOfRelocs();
+  if (!mayPackRelativeRelocs() || 0 == pRelDyn.numOfRelatives())
+    return num;
+
+  ELFFileFormat* format = getOutputFormat();
+  if (NULL == m_pRelrDyn)
+    m_pRelrDyn = new OutputRelrSection(format->getRelrDyn(),
+                                       config().targets().bitclass(),
+                                       config().targets().isLittleEndian());
+  m_pRelrDyn->sizeOutput(pRelDyn.numOfRelatives());
+  return num - pRelDyn.numOfRelatives();
+}
+
+/// packRelocations - move the relative relocations to .relr.dyn
+void GNULDBackend::packRelocations()
+{
+  if (0x0 == getRelativeRelocType())
+    return;
+
+  ELFFileFormat* format = getOutputFormat();
+  LDSection* rel_dyn = NULL;
+  if (format->getRelDyn().hasRelocData())
+    rel_dyn = &format->getRelDyn();
+  else if (format->getRelaDyn().hasRelocData())
+    rel_dyn = &format->getRelaDyn();
+  if (NULL == rel_dyn)
+    return;
+
+  RelocData& relocs = *rel_dyn->getRelocData();
+  if (NULL != m_pRelrDyn) {
+    // .rel.dyn is sized without the relocations reserved for .relr.dyn, so
+    // every one of them must move, even if it relocates a packed place again
+    size_t num = m_pRelrDyn->pack(relocs, getRelativeRelocType());
+    if (num != m_pRelrDyn->capacity())
+      fatal(diag::reserve_entry_number_mismatch_relr);
+
+    if (config().options().printStats()) {
+      mcld::outs() << "relative relocations packed: " << num << " into "
+                   << m_pRelrDyn->numOfEntries() << " entries\n";
+    }
+  }
+
+  m_NumOfRelativeRelocs = 0;
+  RelocData::iterator reloc, relocEnd = relocs.end();
+  for (reloc = relocs.begin(); reloc != relocEnd; ++reloc) {
+    if (getRelativeRelocType() == reloc->type())
+      ++m_NumOfRelativeRelocs;
+  }
+}
+
+size_t GNULDBackend::numOfRelrEntries() const
+{
+  if (NULL == m_pRelrDyn)
+    return 0;
+  return m_pRelrDyn->numOfEntries();
+}
+
+/// emitRelrDyn - emit .relr.dyn
+void GNULDBackend::emitRelrDyn(MemoryRegion& pRegion) const
+{
+  assert(NULL != m_pRelrDyn);
+  m_pRelrDyn->emit(pRegion);
+}
+
 /// initBRIslandFactory - initialize the branch island factory for relaxation
 bool GNULDBackend::initBRIslandFactory()
 {
   if (NULL == m_pBRIslandFactory) {
-    m_pBRIslandFactory = new BranchIslandFactory(maxBranchOffset());
+    m_pBRIslandFactory = new BranchIslandFactory(maxBranchOffset(),
+                                                 maxBwdBranchOffset());
   }
   return true;
 }
@@ -2991,18 +3134,102 @@ bool GNULDBackend::relax(Module& pModule, IRBuilder& pBuilder)
   if (!mayRelax())
     return true;
 
+  assert(NULL != getStubFactory() && NULL != getBRIslandFactory());
   getBRIslandFactory()->group(pModule);
 
-  bool finished = true;
-  do {
-    if (doRelax(pModule, pBuilder, finished)) {
-      setOutputSectionAddress(pModule);
+  // collect the relocations which may need stubs once
+  std::vector<Relocation*> branches;
+  Module::obj_iterator input, inEnd = pModule.obj_end();
+  for (input = pModule.obj_begin(); input != inEnd; ++input) {
+    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        if (mayNeedStub(*relocation))
+          branches.push_back(relocation);
+      }
+    }
+  }
+
+  // The distance between a branch and its target when the branch was last
+  // examined. A branch needs another look only if the distance changes.
+  std::vector<uint64_t> distances(branches.size());
+  std::vector<size_t> worklist(branches.size());
+  for (size_t i = 0; i < branches.size(); ++i)
+    worklist[i] = i;
+
+  while (!worklist.empty()) {
+    bool relaxed = false;
+    std::vector<size_t>::iterator idx, idxEnd = worklist.end();
+    for (idx = worklist.begin(); idx != idxEnd; ++idx) {
+      Relocation& branch = *branches[*idx];
+      if (relaxRelocation(pBuilder, branch))
+        relaxed = true;
+      distances[*idx] = getBranchTarget(branch) - branch.place();
+    }
+
+    if (!relaxed)
+      break;
+
+    // Stubs are inserted into the branch islands. In each section, reset the
+    // offsets of the fragments after the first island that overflows into
+    // its exit. The islands of a section are produced next to each other.
+    SectionData* reset = NULL;
+    BranchIslandFactory::iterator island = getBRIslandFactory()->begin();
+    BranchIslandFactory::iterator islandEnd = getBRIslandFactory()->end();
+    for (; island != islandEnd; ++island) {
+      SectionData* sd = (*island).getParent();
+      if (sd == reset || (*island).end() == sd->end())
+        continue;
+
+      Fragment* exit = (*island).end();
+      if (((*island).offset() + (*island).size()) <= exit->getOffset())
+        continue;
+
+      Fragment* invalid = exit;
+      while (NULL != invalid) {
+        invalid->setOffset(invalid->getPrevNode()->getOffset() +
+                           invalid->getPrevNode()->size());
+        invalid = invalid->getNextNode();
+      }
+      reset = sd;
+    }
+
+    // reset the size of the sections with islands and the addresses of the
+    // output sections
+    for (island = getBRIslandFactory()->begin(); island != islandEnd; ++island) {
+      SectionData* sd = (*island).getParent();
+      sd->getSection().setSize(sd->back().getOffset() + sd->back().size());
+    }
+    setOutputSectionAddress(pModule);
+
+    // re-examine the branches whose source or target moved
+    worklist.clear();
+    for (size_t i = 0; i < branches.size(); ++i) {
+      if (getBranchTarget(*branches[i]) - branches[i]->place() != distances[i])
+        worklist.push_back(i);
     }
-  } while (!finished);
+  }
 
   return true;
 }
 
+/// getBranchTarget - the address reached by a relocation collected by
+/// mayNeedStub
+uint64_t GNULDBackend::getBranchTarget(const Relocation& pRel) const
+{
+  const LDSymbol* symbol = pRel.symInfo()->outSymbol();
+  if (!symbol->hasFragRef())
+    return 0x0;
+
+  uint64_t value = symbol->fragRef()->getOutputOffset();
+  uint64_t addr = symbol->fragRef()->frag()->getParent()->getSection().addr();
+  return addr + value;
+}
+
 bool GNULDBackend::DynsymCompare::needGNUHash(const LDSymbol& X) const
 {
   // FIXME: in bfd and gold linker, an undefined symbol might be hashed
@@ -3020,7 +3247,15 @@ bool GNULDBackend::DynsymCompare::operator()(const LDSymbol* X,
 bool GNULDBackend::RelocCompare::operator()(const Relocation* X,
                                             const Relocation* Y) const
 {
-  // 1. compare if relocation is relative
+  // 1. compare if relocation is relative. The relative ones go first for
+  // DT_RELCOUNT and DT_RELACOUNT.
+  uint32_t relative = m_Backend.getRelativeRelocType();
+  if (0x0 != relative && X->type() != Y->type()) {
+    if (relative == X->type())
+      return true;
+    if (relative == Y->type())
+      return false;
+  }
   if (X->symInfo() == NULL) {
     if (Y->symInfo() != NULL)
       return true;
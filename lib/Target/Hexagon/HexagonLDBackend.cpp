@@ -33,6 +33,7 @@
 #include <mcld/LD/ELFFileFormat.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/ELFSegment.h>
+#include <mcld/LD/StringTableBuilder.h>
 
 #include <cstring>
 
@@ -553,7 +554,9 @@ bool HexagonLDBackend::initTargetStubs()
 bool HexagonLDBackend::initBRIslandFactory()
 {
   if (NULL == m_pBRIslandFactory) {
-    m_pBRIslandFactory = new BranchIslandFactory(maxBranchOffset(), 0);
+    m_pBRIslandFactory = new BranchIslandFactory(maxBranchOffset(),
+                                                 maxBwdBranchOffset(),
+                                                 0);
   }
   return true;
 }
@@ -566,90 +569,37 @@ bool HexagonLDBackend::initStubFactory()
   return true;
 }
 
-bool HexagonLDBackend::doRelax(Module& pModule, IRBuilder& pBuilder,
-                               bool& pFinished)
+bool HexagonLDBackend::mayNeedStub(const Relocation& pRel) const
 {
-  assert(NULL != getStubFactory() && NULL != getBRIslandFactory());
-  bool isRelaxed = false;
-  ELFFileFormat* file_format = getOutputFormat();
-  // check branch relocs and create the related stubs if needed
-  Module::obj_iterator input, inEnd = pModule.obj_end();
-  for (input = pModule.obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        switch (reloc->type()) {
-          case llvm::ELF::R_HEX_B22_PCREL:
-          case llvm::ELF::R_HEX_B15_PCREL:
-          case llvm::ELF::R_HEX_B7_PCREL:
-          case llvm::ELF::R_HEX_B13_PCREL:
-          case llvm::ELF::R_HEX_B9_PCREL: {
-            Relocation* relocation = llvm::cast<Relocation>(reloc);
-            uint64_t sym_value = 0x0;
-            LDSymbol* symbol = relocation->symInfo()->outSymbol();
-            if (symbol->hasFragRef()) {
-              uint64_t value = symbol->fragRef()->getOutputOffset();
-              uint64_t addr =
-                symbol->fragRef()->frag()->getParent()->getSection().addr();
-              sym_value = addr + value;
-            }
-            Stub* stub = getStubFactory()->create(*relocation, // relocation
-                                                  sym_value, //symbol value
-                                                  pBuilder,
-                                                  *getBRIslandFactory());
-            if (NULL != stub) {
-              assert(NULL != stub->symInfo());
-              // increase the size of .symtab and .strtab
-              LDSection& symtab = file_format->getSymTab();
-              LDSection& strtab = file_format->getStrTab();
-              symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf32_Sym));
-              strtab.setSize(strtab.size() + stub->symInfo()->nameSize() + 1);
-              isRelaxed = true;
-            }
-          }
-          break;
-
-          default:
-            break;
-        }
-      }
-    }
-  }
-
-  // find the first fragment w/ invalid offset due to stub insertion
-  Fragment* invalid = NULL;
-  pFinished = true;
-  for (BranchIslandFactory::iterator island = getBRIslandFactory()->begin(),
-       island_end = getBRIslandFactory()->end(); island != island_end; ++island)
-  {
-    if ((*island).end() == file_format->getText().getSectionData()->end())
-      break;
-
-    Fragment* exit = (*island).end();
-    if (((*island).offset() + (*island).size()) > exit->getOffset()) {
-      invalid = exit;
-      pFinished = false;
-      break;
-    }
-  }
-
-  // reset the offset of invalid fragments
-  while (NULL != invalid) {
-    invalid->setOffset(invalid->getPrevNode()->getOffset() +
-                       invalid->getPrevNode()->size());
-    invalid = invalid->getNextNode();
+  switch (pRel.type()) {
+    case llvm::ELF::R_HEX_B22_PCREL:
+    case llvm::ELF::R_HEX_B15_PCREL:
+    case llvm::ELF::R_HEX_B7_PCREL:
+    case llvm::ELF::R_HEX_B13_PCREL:
+    case llvm::ELF::R_HEX_B9_PCREL:
+      return true;
+    default:
+      return false;
   }
+}
 
-  // reset the size of .text
-  if (isRelaxed) {
-    file_format->getText().setSize(
-      file_format->getText().getSectionData()->back().getOffset() +
-      file_format->getText().getSectionData()->back().size());
-  }
-  return isRelaxed;
+bool HexagonLDBackend::relaxRelocation(IRBuilder& pBuilder, Relocation& pRel)
+{
+  Stub* stub = getStubFactory()->create(pRel, // relocation
+                                        getBranchTarget(pRel), //symbol value
+                                        pBuilder,
+                                        *getBRIslandFactory());
+  if (NULL == stub)
+    return false;
+
+  assert(NULL != stub->symInfo());
+  // increase the size of .symtab and .strtab
+  LDSection& symtab = getOutputFormat()->getSymTab();
+  LDSection& strtab = getOutputFormat()->getStrTab();
+  symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf32_Sym));
+  strTabBuilder().add(stub->symInfo()->name());
+  strtab.setSize(strTabBuilder().size());
+  return true;
 }
 
 /// finalizeSymbol - finalize the symbol value
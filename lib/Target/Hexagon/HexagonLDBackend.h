@@ -103,7 +103,9 @@ public:
 
   bool mayRelax() { return true; }
 
-  bool doRelax(Module& pModule, IRBuilder& pBuilder, bool& pFinished);
+  bool mayNeedStub(const Relocation& pRel) const;
+
+  bool relaxRelocation(IRBuilder& pBuilder, Relocation& pRel);
 
   bool initTargetStubs();
 
@@ -87,6 +87,33 @@ Relocator::Size HexagonRelocator::getSize(Relocation::Type pType) const {
   return 32;
 }
 
+bool HexagonRelocator::mayHaveFunctionPointerAccess(
+    const Relocation &pReloc) const {
+  switch (pReloc.type()) {
+  case llvm::ELF::R_HEX_B22_PCREL:
+  case llvm::ELF::R_HEX_B15_PCREL:
+  case llvm::ELF::R_HEX_B13_PCREL:
+  case llvm::ELF::R_HEX_B9_PCREL:
+  case llvm::ELF::R_HEX_B7_PCREL:
+  case llvm::ELF::R_HEX_B32_PCREL_X:
+  case llvm::ELF::R_HEX_B22_PCREL_X:
+  case llvm::ELF::R_HEX_B15_PCREL_X:
+  case llvm::ELF::R_HEX_B13_PCREL_X:
+  case llvm::ELF::R_HEX_B9_PCREL_X:
+  case llvm::ELF::R_HEX_B7_PCREL_X:
+  case llvm::ELF::R_HEX_PLT_B22_PCREL:
+    return false;
+  default:
+    return true;
+  }
+}
+
+bool HexagonRelocator::mayApplyConcurrently(const Relocation &pReloc) const {
+  // The GOT, PLT and dynamic relocation entries are set up by the first
+  // relocation applied against the symbol.
+  return (None == pReloc.symInfo()->reserved());
+}
+
 void HexagonRelocator::scanRelocation(Relocation &pReloc, IRBuilder &pLinker,
                                       Module &pModule, LDSection &pSection) {
   if (LinkerConfig::Object == config().codeGenType())
@@ -112,6 +112,10 @@ public:
 
   Size getSize(Relocation::Type pType) const;
 
+  bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
+
+  bool mayApplyConcurrently(const Relocation& pReloc) const;
+
   const SymPLTMap& getSymPLTMap() const { return m_SymPLTMap; }
   SymPLTMap&       getSymPLTMap()       { return m_SymPLTMap; }
 
@@ -25,6 +25,7 @@
 #include <mcld/LD/LDContext.h>
 #include <mcld/LD/StubFactory.h>
 #include <mcld/LD/ELFFileFormat.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/MC/Attribute.h>
 #include <mcld/Fragment/FillFragment.h>
 #include <mcld/Support/MemoryRegion.h>
@@ -667,17 +668,8 @@ void MipsGNULDBackend::doCreateProgramHdrs(Module& pModule)
 
 bool MipsGNULDBackend::relaxRelocation(IRBuilder& pBuilder, Relocation& pRel)
 {
-  uint64_t sym_value = 0x0;
-
-  LDSymbol* symbol = pRel.symInfo()->outSymbol();
-  if (symbol->hasFragRef()) {
-    uint64_t value = symbol->fragRef()->getOutputOffset();
-    uint64_t addr = symbol->fragRef()->frag()->getParent()->getSection().addr();
-    sym_value = addr + value;
-  }
-
-  Stub* stub =
-    getStubFactory()->create(pRel, sym_value, pBuilder, *getBRIslandFactory());
+  Stub* stub = getStubFactory()->create(pRel, getBranchTarget(pRel), pBuilder,
+                                        *getBRIslandFactory());
 
   if (NULL == stub)
     return false;
@@ -687,74 +679,15 @@ bool MipsGNULDBackend::relaxRelocation(IRBuilder& pBuilder, Relocation& pRel)
   LDSection& symtab = getOutputFormat()->getSymTab();
   LDSection& strtab = getOutputFormat()->getStrTab();
   symtab.setSize(symtab.size() + sizeof(llvm::ELF::Elf32_Sym));
-  strtab.setSize(strtab.size() + stub->symInfo()->nameSize() + 1);
+  strTabBuilder().add(stub->symInfo()->name());
+  strtab.setSize(strTabBuilder().size());
 
   return true;
 }
 
-bool MipsGNULDBackend::doRelax(Module& pModule, IRBuilder& pBuilder,
-                               bool& pFinished)
+bool MipsGNULDBackend::mayNeedStub(const Relocation& pRel) const
 {
-  assert(NULL != getStubFactory() && NULL != getBRIslandFactory());
-
-  bool isRelaxed = false;
-
-  for (Module::obj_iterator input = pModule.obj_begin();
-       input != pModule.obj_end(); ++input) {
-    LDContext* context = (*input)->context();
-
-    for (LDContext::sect_iterator rs = context->relocSectBegin();
-         rs != context->relocSectEnd(); ++rs) {
-      LDSection* sec = *rs;
-
-      if (LDFileFormat::Ignore == sec->kind() || !sec->hasRelocData())
-        continue;
-
-      for (RelocData::iterator reloc = sec->getRelocData()->begin();
-           reloc != sec->getRelocData()->end(); ++reloc) {
-        if (llvm::ELF::R_MIPS_26 != reloc->type())
-          continue;
-
-        if (relaxRelocation(pBuilder, *llvm::cast<Relocation>(reloc)))
-          isRelaxed = true;
-      }
-    }
-  }
-
-  SectionData* textData = getOutputFormat()->getText().getSectionData();
-
-  // find the first fragment w/ invalid offset due to stub insertion
-  Fragment* invalid = NULL;
-  pFinished = true;
-  for (BranchIslandFactory::iterator ii = getBRIslandFactory()->begin(),
-                                     ie = getBRIslandFactory()->end();
-       ii != ie; ++ii)
-  {
-    BranchIsland& island = *ii;
-    if (island.end() == textData->end())
-      break;
-
-    Fragment* exit = island.end();
-    if ((island.offset() + island.size()) > exit->getOffset()) {
-      invalid = exit;
-      pFinished = false;
-      break;
-    }
-  }
-
-  // reset the offset of invalid fragments
-  while (NULL != invalid) {
-    invalid->setOffset(invalid->getPrevNode()->getOffset() +
-                       invalid->getPrevNode()->size());
-    invalid = invalid->getNextNode();
-  }
-
-  // reset the size of .text
-  if (isRelaxed)
-    getOutputFormat()->getText().setSize(textData->back().getOffset() +
-                                         textData->back().size());
-
-  return isRelaxed;
+  return llvm::ELF::R_MIPS_26 == pRel.type();
 }
 
 bool MipsGNULDBackend::initTargetStubs()
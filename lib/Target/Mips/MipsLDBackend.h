@@ -131,13 +131,10 @@ private:
   void defineGOTSymbol(IRBuilder& pBuilder);
   void defineGOTPLTSymbol(IRBuilder& pBuilder);
 
-  bool relaxRelocation(IRBuilder& pBuilder, Relocation& pRel);
-
   /// emitSymbol32 - emit an ELF32 symbol, override parent's function
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    const StringTableBuilder& pStrTab,
                     size_t pSymtabIdx);
 
   /// doCreateProgramHdrs - backend can implement this function to create the
@@ -147,11 +144,11 @@ private:
   /// mayRelax - Backends should override this function if they need relaxation
   bool mayRelax() { return true; }
 
-  /// doRelax - Backend can orevride this function to add its relaxation
-  /// implementation. Return true if the output (e.g., .text) is "relaxed"
-  /// (i.e. layout is changed), and set pFinished to true if everything is fit,
-  /// otherwise set it to false.
-  bool doRelax(Module& pModule, IRBuilder& pBuilder, bool& pFinished);
+  /// mayNeedStub - R_MIPS_26 may need a LA25 stub
+  bool mayNeedStub(const Relocation& pRel) const;
+
+  /// relaxRelocation - create the LA25 stub of pRel if needed
+  bool relaxRelocation(IRBuilder& pBuilder, Relocation& pRel);
 
   /// initTargetStubs
   bool initTargetStubs();
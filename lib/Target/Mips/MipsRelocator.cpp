@@ -232,6 +232,17 @@ Relocator::Size MipsRelocator::getSize(Relocation::Type pType) const
   return ApplyFunctions[pType & 0xff].size;
 }
 
+bool MipsRelocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const
+{
+  switch (pReloc.type() & 0xff) {
+    case llvm::ELF::R_MIPS_26:
+    case llvm::ELF::R_MIPS_PC16:
+      return false;
+    default:
+      return true;
+  }
+}
+
 void MipsRelocator::scanRelocation(Relocation& pReloc,
                                    IRBuilder& pBuilder,
                                    Module& pModule,
@@ -120,6 +120,8 @@ public:
 
   Size getSize(Relocation::Type pType) const;
 
+  bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
+
 protected:
   /// setupRelDynEntry - create dynamic relocation entry.
   virtual void setupRelDynEntry(FragmentRef& pFragRef, ResolveInfo* pSym) = 0;
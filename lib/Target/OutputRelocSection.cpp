@@ -25,7 +25,8 @@ OutputRelocSection::OutputRelocSection(Module& pModule, LDSection& pSection)
   : m_Module(pModule),
     m_pRelocData(NULL),
     m_isVisit(false),
-    m_ValidEntryIterator(){
+    m_ValidEntryIterator(),
+    m_NumOfRelatives(0) {
   assert(!pSection.hasRelocData() && "Given section is not a relocation section");
   m_pRelocData = IRBuilder::CreateRelocData(pSection);
 }
@@ -40,6 +41,12 @@ void OutputRelocSection::reserveEntry(size_t pNum)
     m_pRelocData->append(*Relocation::Create());
 }
 
+void OutputRelocSection::reserveRelativeEntry(size_t pNum)
+{
+  reserveEntry(pNum);
+  m_NumOfRelatives += pNum;
+}
+
 Relocation* OutputRelocSection::consumeEntry()
 {
   // first time visit this function, set m_ValidEntryIterator to
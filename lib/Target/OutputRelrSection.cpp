@@ -0,0 +1,124 @@
+//===- OutputRelrSection.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Target/OutputRelrSection.h>
+
+#include <mcld/IRBuilder.h>
+#include <mcld/ADT/SizeTraits.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/Support/MemoryRegion.h>
+
+#include <llvm/Support/Host.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+static bool PlaceLess(const Relocation* pX, const Relocation* pY)
+{
+  return pX->place() < pY->place();
+}
+
+//===----------------------------------------------------------------------===//
+// OutputRelrSection
+//===----------------------------------------------------------------------===//
+OutputRelrSection::OutputRelrSection(LDSection& pSection,
+                                     unsigned int pBitClass,
+                                     bool pIsLittleEndian)
+  : m_Section(pSection), m_BitClass(pBitClass),
+    m_IsLittleEndian(pIsLittleEndian), m_Capacity(0) {
+}
+
+OutputRelrSection::~OutputRelrSection()
+{
+}
+
+void OutputRelrSection::sizeOutput(size_t pNum)
+{
+  if (!m_Section.hasRelocData())
+    IRBuilder::CreateRelocData(m_Section);
+  m_Capacity = pNum;
+  m_Section.setSize(pNum * entrySize());
+}
+
+size_t OutputRelrSection::pack(RelocData& pRelocData, Relocation::Type pType)
+{
+  const uint64_t word = entrySize();
+  std::vector<Relocation*> relocs;
+  RelocData::iterator reloc, relocEnd = pRelocData.end();
+  for (reloc = pRelocData.begin(); reloc != relocEnd; ++reloc) {
+    if (pType == reloc->type() && 0 == (reloc->place() % word))
+      relocs.push_back(&*reloc);
+  }
+  std::sort(relocs.begin(), relocs.end(), PlaceLess);
+
+  // Move the relocations with the lowest places. A place relocated twice is
+  // encoded once, because the place already holds the final link-time value
+  // and the dynamic linker must add the load bias to it only once.
+  std::vector<uint64_t> places;
+  size_t num = 0;
+  std::vector<Relocation*>::iterator it, itEnd = relocs.end();
+  for (it = relocs.begin(); it != itEnd && num < m_Capacity; ++it, ++num) {
+    uint64_t place = (*it)->place();
+    if (places.empty() || places.back() != place)
+      places.push_back(place);
+    pRelocData.getRelocationList().remove(RelocData::iterator(*it));
+    m_Section.getRelocData()->append(**it);
+  }
+
+  // encode the sorted places
+  const size_t bits = m_BitClass - 1;
+  m_Entries.clear();
+  size_t idx = 0;
+  while (idx < places.size()) {
+    m_Entries.push_back(places[idx]);
+    uint64_t base = places[idx] + word;
+    ++idx;
+    while (true) {
+      uint64_t bitmap = 0x0;
+      for (; idx < places.size(); ++idx) {
+        uint64_t delta = places[idx] - base;
+        if (delta >= bits * word)
+          break;
+        bitmap |= (uint64_t)1 << (delta / word);
+      }
+      if (0x0 == bitmap)
+        break;
+      m_Entries.push_back((bitmap << 1) | 0x1);
+      base += bits * word;
+    }
+  }
+  return num;
+}
+
+void OutputRelrSection::emit(MemoryRegion& pRegion) const
+{
+  size_t num = m_Section.size() / entrySize();
+  assert(m_Entries.size() <= num);
+
+  // an empty bitmap relocates nothing
+  bool swap = (llvm::sys::IsLittleEndianHost != m_IsLittleEndian);
+  uint8_t* data = pRegion.getBuffer();
+  for (size_t idx = 0; idx < num; ++idx) {
+    uint64_t entry = (idx < m_Entries.size()) ? m_Entries[idx] : 0x1;
+    if (32 == m_BitClass) {
+      uint32_t word = swap ? mcld::bswap32(entry) : entry;
+      memcpy(data + idx * 4, &word, 4);
+    }
+    else {
+      uint64_t word = swap ? mcld::bswap64(entry) : entry;
+      memcpy(data + idx * 8, &word, 8);
+    }
+  }
+}
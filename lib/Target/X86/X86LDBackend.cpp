@@ -22,6 +22,7 @@
 #include <mcld/Fragment/RegionFragment.h>
 #include <mcld/Support/MemoryRegion.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/TargetRegistry.h>
 #include <mcld/Object/ObjectBuilder.h>
 
@@ -379,7 +380,7 @@ void X86_32GNULDBackend::setRelDynSize()
 {
   ELFFileFormat* file_format = getOutputFormat();
   file_format->getRelDyn().setSize
-    (m_pRelDyn->numOfRelocs() * getRelEntrySize());
+    (sizeRelrDyn(*m_pRelDyn) * getRelEntrySize());
 }
 
 void X86_32GNULDBackend::setRelPLTSize()
@@ -496,7 +497,15 @@ void X86_64GNULDBackend::setRelDynSize()
 {
   ELFFileFormat* file_format = getOutputFormat();
   file_format->getRelaDyn().setSize
-    (m_pRelDyn->numOfRelocs() * getRelaEntrySize());
+    (sizeRelrDyn(*m_pRelDyn) * getRelaEntrySize());
+}
+
+uint32_t X86_64GNULDBackend::getRelativeRelocType() const
+{
+  // the places of x32 are not the words of R_X86_64_64
+  if (llvm::ELF::R_X86_64_64 != getPointerRelType())
+    return 0x0;
+  return llvm::ELF::R_X86_64_RELATIVE;
 }
 
 void X86_64GNULDBackend::setRelPLTSize()
@@ -550,6 +559,13 @@ void X86_64GNULDBackend::setGOTSectionSize(IRBuilder& pBuilder)
   // set .got size
   if (!m_pGOT->empty())
     m_pGOT->finalizeSectionSize();
+
+  if (config().options().printStats()) {
+    const X86_64Relocator* relocator =
+      static_cast<const X86_64Relocator*>(m_pRelocator);
+    mcld::outs() << "GOTPCREL relocations relaxed: "
+                 << relocator->numOfRelaxedGOTPCREL() << "\n";
+  }
 }
 
 uint64_t X86_64GNULDBackend::emitGOTSectionData(MemoryRegion& pRegion) const
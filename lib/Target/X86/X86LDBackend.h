@@ -169,6 +169,10 @@ public:
 
   const X86_32GOTPLT& getGOTPLT() const;
 
+  /// getRelativeRelocType - the type of the relative dynamic relocation
+  uint32_t getRelativeRelocType() const
+  { return llvm::ELF::R_386_RELATIVE; }
+
 private:
   /// initRelocator - create and initialize Relocator.
   bool initRelocator();
@@ -209,6 +213,9 @@ public:
 
   const X86_64GOTPLT& getGOTPLT() const;
 
+  /// getRelativeRelocType - the type of the relative dynamic relocation
+  uint32_t getRelativeRelocType() const;
+
 private:
   /// initRelocator - create and initialize Relocator.
   bool initRelocator();
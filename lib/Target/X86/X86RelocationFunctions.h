@@ -84,6 +84,12 @@ DECL_X86_64_APPLY_RELOC_FUNC(signed32)         \
 DECL_X86_64_APPLY_RELOC_FUNC(gotpcrel)         \
 DECL_X86_64_APPLY_RELOC_FUNC(plt32)            \
 DECL_X86_64_APPLY_RELOC_FUNC(rel)              \
+DECL_X86_64_APPLY_RELOC_FUNC(tls_gd)           \
+DECL_X86_64_APPLY_RELOC_FUNC(tls_ld)           \
+DECL_X86_64_APPLY_RELOC_FUNC(dtpoff32)         \
+DECL_X86_64_APPLY_RELOC_FUNC(dtpoff64)         \
+DECL_X86_64_APPLY_RELOC_FUNC(gottpoff)         \
+DECL_X86_64_APPLY_RELOC_FUNC(tpoff32)          \
 DECL_X86_64_APPLY_RELOC_FUNC(unsupport)
 
 #define DECL_X86_64_APPLY_RELOC_FUNC_PTRS \
@@ -104,13 +110,13 @@ DECL_X86_64_APPLY_RELOC_FUNC(unsupport)
   { &abs,               14, "R_X86_64_8",               8  },  \
   { &rel,               15, "R_X86_64_PC8",             8  },  \
   { &none,              16, "R_X86_64_DTPMOD64",        0  },  \
-  { &unsupport,         17, "R_X86_64_DTPOFF64",        0  },  \
+  { &dtpoff64,          17, "R_X86_64_DTPOFF64",        64 },  \
   { &none,              18, "R_X86_64_TPOFF64",         0  },  \
-  { &unsupport,         19, "R_X86_64_TLSGD",           0  },  \
-  { &unsupport,         20, "R_X86_64_TLSLD",           0  },  \
-  { &unsupport,         21, "R_X86_64_DTPOFF32",        0  },  \
-  { &unsupport,         22, "R_X86_64_GOTTPOFF",        0  },  \
-  { &unsupport,         23, "R_X86_64_TPOFF32",         0  },  \
+  { &tls_gd,            19, "R_X86_64_TLSGD",           32 },  \
+  { &tls_ld,            20, "R_X86_64_TLSLD",           32 },  \
+  { &dtpoff32,          21, "R_X86_64_DTPOFF32",        32 },  \
+  { &gottpoff,          22, "R_X86_64_GOTTPOFF",        32 },  \
+  { &tpoff32,           23, "R_X86_64_TPOFF32",         32 },  \
   { &unsupport,         24, "R_X86_64_PC64",            64 },  \
   { &unsupport,         25, "R_X86_64_GOTOFF64",        64 },  \
   { &unsupport,         26, "R_X86_64_GOTPC32",         32 },  \
@@ -125,4 +131,10 @@ DECL_X86_64_APPLY_RELOC_FUNC(unsupport)
   { &unsupport,         35, "R_X86_64_TLSDESC_CALL",    0  },  \
   { &none,              36, "R_X86_64_TLSDESC",         0  },  \
   { &none,              37, "R_X86_64_IRELATIVE",       0  },  \
-  { &none,              38, "R_X86_64_RELATIVE64",      0  }
+  { &none,              38, "R_X86_64_RELATIVE64",      0  },  \
+  { &unsupport,         39, "",                         0  },  \
+  { &unsupport,         40, "",                         0  },  \
+  { &gotpcrel,          41, "R_X86_64_GOTPCRELX",       32 },  \
+  { &gotpcrel,          42, "R_X86_64_REX_GOTPCRELX",   32 },  \
+  { &unsupport,         43, "",                         0  },  \
+  { &none,              44, "R_X86_64_OPT",             32 }
@@ -10,18 +10,26 @@
 #include "X86RelocationFunctions.h"
 
 #include <mcld/LinkerConfig.h>
+#include <mcld/ADT/SizeTraits.h>
 #include <mcld/IRBuilder.h>
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Support/MemoryRegion.h>
 #include <mcld/LD/ELFFileFormat.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/ELFSegment.h>
 #include <mcld/Object/ObjectBuilder.h>
 
 #include <llvm/ADT/Twine.h>
+#include <llvm/Support/Casting.h>
 #include <llvm/Support/DataTypes.h>
 #include <llvm/Support/ELF.h>
 
+#include <cstring>
+
 using namespace mcld;
 
 //===--------------------------------------------------------------------===//
@@ -88,6 +96,106 @@ void X86Relocator::scanRelocation(Relocation& pReloc,
     fatal(diag::undefined_reference) << rsym->name();
 }
 
+bool X86Relocator::isCallOrJump(const Relocation& pReloc)
+{
+  const FragmentRef& ref = pReloc.targetRef();
+  if (0 == ref.offset() || !llvm::isa<RegionFragment>(ref.frag()))
+    return false;
+
+  // The byte before a field in data is not an opcode.
+  const SectionData* data = ref.frag()->getParent();
+  if (NULL == data ||
+      0 == (data->getSection().flag() & llvm::ELF::SHF_EXECINSTR))
+    return false;
+
+  // A RIP-relative operand follows a ModRM byte with mod == 00, so it never
+  // looks like these opcodes.
+  const RegionFragment* frag = llvm::cast<RegionFragment>(ref.frag());
+  const uint8_t* code = frag->getRegion().start();
+  uint8_t opcode = code[ref.offset() - 1];
+  if (0xe8 == opcode || 0xe9 == opcode)
+    return true;
+  return (ref.offset() >= 2 && 0x0f == code[ref.offset() - 2] &&
+          0x80 == (opcode & 0xf0));
+}
+
+bool X86Relocator::mayRelaxTLS() const
+{
+  return (LinkerConfig::DynObj != config().codeGenType());
+}
+
+bool X86Relocator::mayRelaxTLSToLE(const ResolveInfo& pSym) const
+{
+  // The offset of a TLS symbol defined in the executable is known, even if
+  // the executable is position independent.
+  if (!mayRelaxTLS() || pSym.isDyn())
+    return false;
+  return (!pSym.isUndef() || config().isCodeStatic());
+}
+
+bool X86Relocator::matchCode(const Relocation& pReloc,
+                             int64_t pOffset,
+                             const uint8_t* pCode,
+                             size_t pSize)
+{
+  const FragmentRef& ref = pReloc.targetRef();
+  if (pOffset < 0 || !llvm::isa<RegionFragment>(ref.frag()))
+    return false;
+
+  const RegionFragment* frag = llvm::cast<RegionFragment>(ref.frag());
+  if (pOffset + pSize > frag->getRegion().size())
+    return false;
+  return (0 == memcmp(frag->getRegion().start() + pOffset, pCode, pSize));
+}
+
+Relocation* X86Relocator::getNextCall(Relocation& pReloc,
+                                      LDSection& pSection,
+                                      uint64_t pOffset,
+                                      const char* pCallee)
+{
+  RelocData::iterator next(pReloc);
+  if (pSection.getRelocData()->end() == ++next)
+    return NULL;
+
+  Relocation* call = llvm::cast<Relocation>(next);
+  if (call->targetRef().frag() != pReloc.targetRef().frag() ||
+      call->targetRef().offset() != pOffset ||
+      NULL == call->symInfo() ||
+      0 != strcmp(call->symInfo()->name(), pCallee))
+    return NULL;
+  return call;
+}
+
+void X86Relocator::rewriteCode(Relocation& pReloc,
+                               uint64_t pOffset,
+                               const uint8_t* pCode,
+                               size_t pSize,
+                               Relocation::Type pOptType,
+                               LDSection& pSection)
+{
+  assert(pSize >= 4);
+  Fragment& frag = *pReloc.targetRef().frag();
+  size_t pos = 0;
+  while (pos < pSize) {
+    // the last word may overlap the previous one
+    if (pos + 4 > pSize)
+      pos = pSize - 4;
+
+    Relocation* reloc = Relocation::Create(pOptType,
+                                          *FragmentRef::Create(frag,
+                                                               pOffset + pos),
+                                          0x0);
+    reloc->setSymInfo(pReloc.symInfo());
+    reloc->target() = (uint32_t)pCode[pos] |
+                      ((uint32_t)pCode[pos + 1] << 8) |
+                      ((uint32_t)pCode[pos + 2] << 16) |
+                      ((uint32_t)pCode[pos + 3] << 24);
+    pSection.getRelocData()->getRelocationList().insert(
+      RelocData::iterator(pReloc), reloc);
+    pos += 4;
+  }
+}
+
 void X86Relocator::addCopyReloc(ResolveInfo& pSym, X86GNULDBackend& pTarget)
 {
   Relocation& rel_entry = *pTarget.getRelDyn().consumeEntry();
@@ -97,6 +205,17 @@ void X86Relocator::addCopyReloc(ResolveInfo& pSym, X86GNULDBackend& pTarget)
   rel_entry.setSymInfo(&pSym);
 }
 
+/// mayPackDynRel - the dynamic relocation against pSym is a relative one and
+/// goes to .relr.dyn
+bool X86Relocator::mayPackDynRel(const ResolveInfo& pSym,
+                                 const X86GNULDBackend& pTarget)
+{
+  // the same condition as helper_use_relative_reloc
+  if (pSym.isDyn() || pSym.isUndef() || pTarget.isSymbolPreemptible(pSym))
+    return false;
+  return pTarget.mayPackRelativeRelocs();
+}
+
 /// defineSymbolforCopyReloc
 /// For a symbol needing copy relocation, define a copy symbol in the BSS
 /// section and all other reference to this symbol should refer to this
@@ -204,6 +323,29 @@ Relocator::Size X86_32Relocator::getSize(Relocation::Type pType) const
   return X86_32ApplyFunctions[pType].size;;
 }
 
+bool
+X86_32Relocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const
+{
+  switch (pReloc.type()) {
+    case llvm::ELF::R_386_PLT32:
+      return false;
+    case llvm::ELF::R_386_PC32:
+      return !isCallOrJump(pReloc);
+    default:
+      return true;
+  }
+}
+
+bool X86_32Relocator::mayApplyConcurrently(const Relocation& pReloc) const
+{
+  // The GOT, PLT and dynamic relocation entries are set up by the first
+  // relocation applied against the symbol, and the module ID entry of
+  // R_386_TLS_LDM by the first R_386_TLS_LDM.
+  if (llvm::ELF::R_386_TLS_LDM == pReloc.type())
+    return false;
+  return (None == pReloc.symInfo()->reserved());
+}
+
 void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
                                      IRBuilder& pBuilder,
                                      Module& pModule,
@@ -214,6 +356,9 @@ void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
 
   switch(pReloc.type()){
 
+    case llvm::ELF::R_386_NONE:
+      return;
+
     case llvm::ELF::R_386_32:
     case llvm::ELF::R_386_16:
     case llvm::ELF::R_386_8:
@@ -221,7 +366,11 @@ void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
       // a dynamic relocations with RELATIVE type to this location is needed.
       // Reserve an entry in .rel.dyn
       if (config().isCodeIndep()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (llvm::ELF::R_386_32 == pReloc.type() &&
+            getTarget().isPackablePlace(pReloc, *pSection.getLink()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set Rel bit
         rsym->setReserved(rsym->reserved() | ReserveRel);
         getTarget().checkAndSetHasTextRel(*pSection.getLink());
@@ -255,7 +404,10 @@ void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
       // entry in .rel.dyn
       if (LinkerConfig::DynObj ==
                    config().codeGenType() || rsym->isUndef() || rsym->isDyn()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (mayPackDynRel(*rsym, getTarget()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set GOTRel bit
         rsym->setReserved(rsym->reserved() | GOTRel);
         return;
@@ -270,7 +422,11 @@ void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
       return;
 
     case llvm::ELF::R_386_TLS_GD: {
-      // FIXME: no linker optimization for TLS relocation
+      // relax to local-exec when linking an executable
+      if (mayRelaxTLS() && convertTLSGD(pReloc, pSection, true)) {
+        scanLocalReloc(pReloc, pBuilder, pModule, pSection);
+        return;
+      }
       if (rsym->reserved() & GOTRel)
         return;
       getTarget().getGOT().reserve(2);
@@ -299,6 +455,14 @@ void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
     }
 
     case llvm::ELF::R_386_TLS_LDM:
+      // R_386_TLS_LDO_32 is resolved to the offset to the thread pointer in
+      // an executable, so the sequence must be relaxed to local-exec
+      if (mayRelaxTLS()) {
+        if (!convertTLSLDMtoLE(pReloc, pSection))
+          error(diag::invalid_tls_sequence) << getName(pReloc.type())
+                                            << rsym->name();
+        return;
+      }
       getTLSModuleID();
       return;
 
@@ -370,6 +534,9 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
   ResolveInfo* rsym = pReloc.symInfo();
 
   switch(pReloc.type()) {
+    case llvm::ELF::R_386_NONE:
+      return;
+
     case llvm::ELF::R_386_32:
     case llvm::ELF::R_386_16:
     case llvm::ELF::R_386_8:
@@ -392,7 +559,13 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
 
       if (getTarget().symbolNeedsDynRel(*rsym, (rsym->reserved() & ReservePLT), true)) {
         // symbol needs dynamic relocation entry, reserve an entry in .rel.dyn
-        getTarget().getRelDyn().reserveEntry();
+        if (llvm::ELF::R_386_32 == pReloc.type() &&
+            !getTarget().symbolNeedsCopyReloc(pReloc, *rsym) &&
+            mayPackDynRel(*rsym, getTarget()) &&
+            getTarget().isPackablePlace(pReloc, *pSection.getLink()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         if (getTarget().symbolNeedsCopyReloc(pReloc, *rsym)) {
           LDSymbol& cpy_sym = defineSymbolforCopyReloc(pBuilder, *rsym, getTarget());
           addCopyReloc(*cpy_sym.resolveInfo(), getTarget());
@@ -458,7 +631,10 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
       // entry in .rel.dyn
       if (LinkerConfig::DynObj ==
                    config().codeGenType() || rsym->isUndef() || rsym->isDyn()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (mayPackDynRel(*rsym, getTarget()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set GOTRel bit
         rsym->setReserved(rsym->reserved() | GOTRel);
         return;
@@ -503,7 +679,12 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
       return;
 
     case llvm::ELF::R_386_TLS_GD: {
-      // FIXME: no linker optimization for TLS relocation
+      // relax to local-exec or initial-exec when linking an executable
+      if (mayRelaxTLS() &&
+          convertTLSGD(pReloc, pSection, mayRelaxTLSToLE(*rsym))) {
+        scanGlobalReloc(pReloc, pBuilder, pModule, pSection);
+        return;
+      }
       if (rsym->reserved() & GOTRel)
         return;
       // reserve two pairs of got entry and dynamic relocation
@@ -516,6 +697,14 @@ void X86_32Relocator::scanGlobalReloc(Relocation& pReloc,
     }
 
     case llvm::ELF::R_386_TLS_LDM:
+      // R_386_TLS_LDO_32 is resolved to the offset to the thread pointer in
+      // an executable, so the sequence must be relaxed to local-exec
+      if (mayRelaxTLS()) {
+        if (!convertTLSLDMtoLE(pReloc, pSection))
+          error(diag::invalid_tls_sequence) << getName(pReloc.type())
+                                            << rsym->name();
+        return;
+      }
       getTLSModuleID();
       return;
 
@@ -650,6 +839,77 @@ void X86_32Relocator::convertTLSIEtoLE(Relocation& pReloc,
   pReloc.setType(llvm::ELF::R_386_TLS_LE);
 }
 
+/// convert the R_386_TLS_GD sequence to R_386_TLS_LE or R_386_TLS_GOTIE
+bool X86_32Relocator::convertTLSGD(Relocation& pReloc,
+                                   LDSection& pSection,
+                                   bool pToLE)
+{
+  assert(pReloc.type() == llvm::ELF::R_386_TLS_GD);
+
+  // leal x@tlsgd(,%ebx,1), %eax
+  // call ___tls_get_addr@plt
+  static const uint8_t lea[] = { 0x8d, 0x04, 0x1d };
+  static const uint8_t call[] = { 0xe8 };
+  uint64_t off = pReloc.targetRef().offset();
+  if (off < 3 ||
+      !matchCode(pReloc, off - 3, lea, sizeof(lea)) ||
+      !matchCode(pReloc, off + 4, call, sizeof(call)))
+    return false;
+
+  Relocation* next = getNextCall(pReloc, pSection, off + 5, "___tls_get_addr");
+  if (NULL == next)
+    return false;
+
+  // movl %gs:0, %eax
+  // leal x@ntpoff(%eax), %eax (local-exec)
+  // addl x@gotntpoff(%ebx), %eax (initial-exec)
+  uint8_t code[] = { 0x65, 0xa1, 0x00, 0x00, 0x00, 0x00, 0x8d, 0x80 };
+  if (!pToLE) {
+    code[6] = 0x03;
+    code[7] = 0x83;
+  }
+  rewriteCode(pReloc, off - 3, code, sizeof(code), R_386_TLS_OPT, pSection);
+
+  // the call is gone, and the operand of leal or addl takes its place
+  next->setType(llvm::ELF::R_386_NONE);
+  pReloc.targetRef().assign(*pReloc.targetRef().frag(), off + 5);
+  pReloc.setType(pToLE ? llvm::ELF::R_386_TLS_LE : llvm::ELF::R_386_TLS_GOTIE);
+  pReloc.target() = 0x0;
+  return true;
+}
+
+/// convert the R_386_TLS_LDM sequence to the local-exec one
+bool X86_32Relocator::convertTLSLDMtoLE(Relocation& pReloc,
+                                        LDSection& pSection)
+{
+  assert(pReloc.type() == llvm::ELF::R_386_TLS_LDM);
+
+  // leal x@tlsldm(%ebx), %eax
+  // call ___tls_get_addr@plt
+  static const uint8_t lea[] = { 0x8d, 0x83 };
+  static const uint8_t call[] = { 0xe8 };
+  uint64_t off = pReloc.targetRef().offset();
+  if (off < 2 ||
+      !matchCode(pReloc, off - 2, lea, sizeof(lea)) ||
+      !matchCode(pReloc, off + 4, call, sizeof(call)))
+    return false;
+
+  Relocation* next = getNextCall(pReloc, pSection, off + 5, "___tls_get_addr");
+  if (NULL == next)
+    return false;
+
+  // movl %gs:0, %eax
+  // nop
+  // leal 0(%esi,%eiz,1), %esi
+  static const uint8_t code[] = { 0x65, 0xa1, 0x00, 0x00, 0x00, 0x00,
+                                  0x90, 0x8d, 0x74, 0x26, 0x00 };
+  rewriteCode(pReloc, off - 2, code, sizeof(code), R_386_TLS_OPT, pSection);
+
+  next->setType(llvm::ELF::R_386_NONE);
+  pReloc.setType(llvm::ELF::R_386_NONE);
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Relocation helper function
 //===--------------------------------------------------------------------===//
@@ -794,6 +1054,19 @@ X86Relocator::Address helper_PLT(Relocation& pReloc, X86_32Relocator& pParent)
   return helper_PLT_ORG(pParent) + plt_entry.getOffset();
 }
 
+/// helper_TLS_SIZE - the size of the TLS segment. The thread pointer points
+/// to the end of the TLS block of the executable.
+static
+X86Relocator::Address helper_TLS_SIZE(X86_32Relocator& pParent)
+{
+  ELFSegmentFactory::const_iterator tls_seg =
+    pParent.getTarget().elfSegmentTable().find(llvm::ELF::PT_TLS,
+                                               llvm::ELF::PF_R,
+                                               0x0);
+  assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
+  return (*tls_seg)->memsz();
+}
+
 
 //=========================================//
 // Each relocation function implementation //
@@ -1027,7 +1300,6 @@ X86Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent)
 // R_386_TLS_LDM
 X86Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent)
 {
-  // FIXME: no linker optimization for TLS relocation
   const X86_32GOTEntry& got_entry = pParent.getTLSModuleID();
 
   // All GOT offsets are relative to the end of the GOT.
@@ -1043,9 +1315,18 @@ X86Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent)
 // R_386_TLS_LDO_32
 X86Relocator::Result tls_ldo_32(Relocation& pReloc, X86_32Relocator& pParent)
 {
-  // FIXME: no linker optimization for TLS relocation
   Relocator::DWord A = pReloc.target() + pReloc.addend();
   X86Relocator::Address S = pReloc.symValue();
+
+  // In an executable, R_386_TLS_LDM is relaxed to get the thread pointer, so
+  // the offset is relative to the thread pointer. (except for debug sections)
+  LDSection& target_sect = pReloc.targetRef().frag()->getParent()->getSection();
+  if (pParent.mayRelaxTLS() &&
+      0x0 != (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
+    pReloc.target() = S + A - helper_TLS_SIZE(pParent);
+    return X86Relocator::OK;
+  }
+
   pReloc.target() = S + A;
   return X86Relocator::OK;
 }
@@ -1135,15 +1416,9 @@ X86Relocator::Result tls_le(Relocation& pReloc, X86_32Relocator& pParent)
   }
 
   // perform static relocation
-  // get TLS segment
-  ELFSegmentFactory::const_iterator tls_seg =
-    pParent.getTarget().elfSegmentTable().find(llvm::ELF::PT_TLS,
-                                               llvm::ELF::PF_R,
-                                               0x0);
-  assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
   Relocator::DWord A = pReloc.target() + pReloc.addend();
   X86Relocator::Address S = pReloc.symValue();
-  pReloc.target() = S + A - (*tls_seg)->memsz();
+  pReloc.target() = S + A - helper_TLS_SIZE(pParent);
   return X86Relocator::OK;
 }
 
@@ -1180,7 +1455,8 @@ static const X86_64ApplyFunctionTriple X86_64ApplyFunctions[] = {
 //===--------------------------------------------------------------------===//
 X86_64Relocator::X86_64Relocator(X86_64GNULDBackend& pParent,
                                  const LinkerConfig& pConfig)
-  : X86Relocator(pConfig), m_Target(pParent) {
+  : X86Relocator(pConfig), m_Target(pParent), m_pTLSModuleID(NULL),
+    m_NumOfRelaxedGOTPCREL(0) {
 }
 
 Relocator::Result
@@ -1206,6 +1482,26 @@ Relocator::Size X86_64Relocator::getSize(Relocation::Type pType) const
   return X86_64ApplyFunctions[pType].size;
 }
 
+bool
+X86_64Relocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const
+{
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_PLT32:
+      return false;
+    case llvm::ELF::R_X86_64_PC32:
+      return !isCallOrJump(pReloc);
+    default:
+      return true;
+  }
+}
+
+bool X86_64Relocator::mayApplyConcurrently(const Relocation& pReloc) const
+{
+  // The GOT, PLT and dynamic relocation entries are set up by the first
+  // relocation applied against the symbol.
+  return (None == pReloc.symInfo()->reserved());
+}
+
 void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
                                      IRBuilder& pBuilder,
                                      Module& pModule,
@@ -1215,6 +1511,9 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
   ResolveInfo* rsym = pReloc.symInfo();
 
   switch(pReloc.type()){
+    case llvm::ELF::R_X86_64_NONE:
+      return;
+
     case llvm::ELF::R_X86_64_64:
     case llvm::ELF::R_X86_64_32:
     case llvm::ELF::R_X86_64_16:
@@ -1224,7 +1523,11 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
       // a dynamic relocations with RELATIVE type to this location is needed.
       // Reserve an entry in .rela.dyn
       if (config().isCodeIndep()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (llvm::ELF::R_X86_64_64 == pReloc.type() &&
+            getTarget().isPackablePlace(pReloc, *pSection.getLink()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set Rel bit
         rsym->setReserved(rsym->reserved() | ReserveRel);
         getTarget().checkAndSetHasTextRel(*pSection.getLink());
@@ -1237,6 +1540,12 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
       return;
 
     case llvm::ELF::R_X86_64_GOTPCREL:
+    case R_X86_64_GOTPCRELX:
+    case R_X86_64_REX_GOTPCRELX:
+      // no GOT entry is needed if the instruction can refer to the symbol
+      // directly
+      if (mayRelaxGOTPCREL(*rsym) && convertGOTPCREL(pReloc, pSection))
+        return;
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
       if (rsym->reserved() & (ReserveGOT | GOTRel))
@@ -1254,7 +1563,10 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
       // entry in .rela.dyn
       if (LinkerConfig::DynObj ==
                    config().codeGenType() || rsym->isUndef() || rsym->isDyn()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (mayPackDynRel(*rsym, getTarget()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set GOTRel bit
         rsym->setReserved(rsym->reserved() | GOTRel);
         return;
@@ -1263,6 +1575,67 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
       rsym->setReserved(rsym->reserved() | ReserveGOT);
       return;
 
+    case llvm::ELF::R_X86_64_TLSGD:
+      // relax to local-exec when linking an executable
+      if (mayRelaxTLS() && convertTLSGD(pReloc, pSection, true)) {
+        scanLocalReloc(pReloc, pBuilder, pModule, pSection);
+        return;
+      }
+      if (rsym->reserved() & GOTRel)
+        return;
+      // reserve two got entries and a dynamic relocation for the module index.
+      // The offset in the module is known.
+      getTarget().getGOT().reserve(2);
+      getTarget().getRelDyn().reserveEntry();
+      // set GOTRel bit
+      rsym->setReserved(rsym->reserved() | GOTRel);
+      return;
+
+    case llvm::ELF::R_X86_64_TLSLD:
+      // R_X86_64_DTPOFF32 is resolved to the offset to the thread pointer in
+      // an executable, so the sequence must be relaxed to local-exec
+      if (mayRelaxTLS()) {
+        if (!convertTLSLDtoLE(pReloc, pSection))
+          error(diag::invalid_tls_sequence) << getName(pReloc.type())
+                                            << rsym->name();
+        return;
+      }
+      getTLSModuleID();
+      return;
+
+    case llvm::ELF::R_X86_64_DTPOFF32:
+    case llvm::ELF::R_X86_64_DTPOFF64:
+      return;
+
+    case llvm::ELF::R_X86_64_GOTTPOFF:
+      getTarget().setHasStaticTLS();
+      if (mayRelaxTLSToLE(*rsym)) {
+        if (convertTLSIEtoLE(pReloc, pSection))
+          return;
+        // the got entry holds the known tp-relative offset
+        if (rsym->reserved() & (ReserveGOT | GOTRel))
+          return;
+        getTarget().getGOT().reserve();
+        rsym->setReserved(rsym->reserved() | ReserveGOT);
+        return;
+      }
+      if (rsym->reserved() & GOTRel)
+        return;
+      // reserve got and dyn relocation entries for tp-relative offset
+      getTarget().getGOT().reserve();
+      getTarget().getRelDyn().reserveEntry();
+      // set GOTRel bit
+      rsym->setReserved(rsym->reserved() | GOTRel);
+      return;
+
+    case llvm::ELF::R_X86_64_TPOFF32:
+      getTarget().setHasStaticTLS();
+      // the offset to the thread pointer is unknown in a shared object
+      if (LinkerConfig::DynObj == config().codeGenType())
+        error(diag::non_pic_relocation) << getName(pReloc.type())
+                                        << rsym->name();
+      return;
+
     default:
       fatal(diag::unsupported_relocation) << (int)pReloc.type()
                                           << "mclinker@googlegroups.com";
@@ -1279,6 +1652,9 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
   ResolveInfo* rsym = pReloc.symInfo();
 
   switch(pReloc.type()) {
+    case llvm::ELF::R_X86_64_NONE:
+      return;
+
     case llvm::ELF::R_X86_64_64:
     case llvm::ELF::R_X86_64_32:
     case llvm::ELF::R_X86_64_16:
@@ -1303,7 +1679,13 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
 
       if (getTarget().symbolNeedsDynRel(*rsym, (rsym->reserved() & ReservePLT), true)) {
         // symbol needs dynamic relocation entry, reserve an entry in .rela.dyn
-        getTarget().getRelDyn().reserveEntry();
+        if (llvm::ELF::R_X86_64_64 == pReloc.type() &&
+            !getTarget().symbolNeedsCopyReloc(pReloc, *rsym) &&
+            mayPackDynRel(*rsym, getTarget()) &&
+            getTarget().isPackablePlace(pReloc, *pSection.getLink()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         if (getTarget().symbolNeedsCopyReloc(pReloc, *rsym)) {
           LDSymbol& cpy_sym = defineSymbolforCopyReloc(pBuilder, *rsym, getTarget());
           addCopyReloc(*cpy_sym.resolveInfo(), getTarget());
@@ -1317,6 +1699,12 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       return;
 
     case llvm::ELF::R_X86_64_GOTPCREL:
+    case R_X86_64_GOTPCRELX:
+    case R_X86_64_REX_GOTPCRELX:
+      // no GOT entry is needed if the instruction can refer to the symbol
+      // directly
+      if (mayRelaxGOTPCREL(*rsym) && convertGOTPCREL(pReloc, pSection))
+        return;
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
       if (rsym->reserved() & (ReserveGOT | GOTRel))
@@ -1334,7 +1722,10 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       // entry in .rela.dyn
       if (LinkerConfig::DynObj ==
                    config().codeGenType() || rsym->isUndef() || rsym->isDyn()) {
-        getTarget().getRelDyn().reserveEntry();
+        if (mayPackDynRel(*rsym, getTarget()))
+          getTarget().getRelDyn().reserveRelativeEntry();
+        else
+          getTarget().getRelDyn().reserveEntry();
         // set GOTRel bit
         rsym->setReserved(rsym->reserved() | GOTRel);
         return;
@@ -1405,6 +1796,69 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       }
       return;
 
+    case llvm::ELF::R_X86_64_TLSGD:
+      // relax to local-exec or initial-exec when linking an executable
+      if (mayRelaxTLS() &&
+          convertTLSGD(pReloc, pSection, mayRelaxTLSToLE(*rsym))) {
+        scanGlobalReloc(pReloc, pBuilder, pModule, pSection);
+        return;
+      }
+      if (rsym->reserved() & GOTRel)
+        return;
+      // reserve two pairs of got entry and dynamic relocation
+      getTarget().getGOT().reserve(2);
+      getTarget().getRelDyn().reserveEntry(2);
+      getTarget().getRelDyn().addSymbolToDynSym(*rsym->outSymbol());
+      // set GOTRel bit
+      rsym->setReserved(rsym->reserved() | GOTRel);
+      return;
+
+    case llvm::ELF::R_X86_64_TLSLD:
+      // R_X86_64_DTPOFF32 is resolved to the offset to the thread pointer in
+      // an executable, so the sequence must be relaxed to local-exec
+      if (mayRelaxTLS()) {
+        if (!convertTLSLDtoLE(pReloc, pSection))
+          error(diag::invalid_tls_sequence) << getName(pReloc.type())
+                                            << rsym->name();
+        return;
+      }
+      getTLSModuleID();
+      return;
+
+    case llvm::ELF::R_X86_64_DTPOFF32:
+    case llvm::ELF::R_X86_64_DTPOFF64:
+      return;
+
+    case llvm::ELF::R_X86_64_GOTTPOFF:
+      getTarget().setHasStaticTLS();
+      if (mayRelaxTLSToLE(*rsym)) {
+        if (convertTLSIEtoLE(pReloc, pSection))
+          return;
+        // the got entry holds the known tp-relative offset
+        if (rsym->reserved() & (ReserveGOT | GOTRel))
+          return;
+        getTarget().getGOT().reserve();
+        rsym->setReserved(rsym->reserved() | ReserveGOT);
+        return;
+      }
+      if (rsym->reserved() & GOTRel)
+        return;
+      // reserve got and dyn relocation entries for tp-relative offset
+      getTarget().getGOT().reserve();
+      getTarget().getRelDyn().reserveEntry();
+      getTarget().getRelDyn().addSymbolToDynSym(*rsym->outSymbol());
+      // set GOTRel bit
+      rsym->setReserved(rsym->reserved() | GOTRel);
+      return;
+
+    case llvm::ELF::R_X86_64_TPOFF32:
+      getTarget().setHasStaticTLS();
+      // the offset to the thread pointer is unknown in a shared object
+      if (LinkerConfig::DynObj == config().codeGenType())
+        error(diag::non_pic_relocation) << getName(pReloc.type())
+                                        << rsym->name();
+      return;
+
     default:
       fatal(diag::unsupported_relocation) << (int)pReloc.type()
                                           << "mclinker@googlegroups.com";
@@ -1412,6 +1866,192 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
   } // end switch
 }
 
+// Create a GOT entry for the TLS module index
+X86_64GOTEntry& X86_64Relocator::getTLSModuleID()
+{
+  if (NULL != m_pTLSModuleID)
+    return *m_pTLSModuleID;
+
+  // Allocate 2 got entries and 1 dynamic reloc for R_X86_64_TLSLD
+  getTarget().getGOT().reserve(2);
+  m_pTLSModuleID = getTarget().getGOT().consume();
+  m_pTLSModuleID->setValue(0x0);
+  getTarget().getGOT().consume()->setValue(0x0);
+
+  getTarget().getRelDyn().reserveEntry();
+  Relocation* rel_entry = getTarget().getRelDyn().consumeEntry();
+  rel_entry->setType(llvm::ELF::R_X86_64_DTPMOD64);
+  rel_entry->targetRef().assign(*m_pTLSModuleID, 0x0);
+  rel_entry->setSymInfo(NULL);
+
+  return *m_pTLSModuleID;
+}
+
+/// convert the R_X86_64_TLSGD sequence to R_X86_64_TPOFF32 or
+/// R_X86_64_GOTTPOFF
+bool X86_64Relocator::convertTLSGD(Relocation& pReloc,
+                                   LDSection& pSection,
+                                   bool pToLE)
+{
+  assert(pReloc.type() == llvm::ELF::R_X86_64_TLSGD);
+
+  // .byte 0x66; leaq x@tlsgd(%rip), %rdi
+  // .word 0x6666; rex64; call __tls_get_addr@plt
+  static const uint8_t lea[] = { 0x66, 0x48, 0x8d, 0x3d };
+  static const uint8_t call[] = { 0x66, 0x66, 0x48, 0xe8 };
+  uint64_t off = pReloc.targetRef().offset();
+  if (off < 4 ||
+      !matchCode(pReloc, off - 4, lea, sizeof(lea)) ||
+      !matchCode(pReloc, off + 4, call, sizeof(call)))
+    return false;
+
+  Relocation* next = getNextCall(pReloc, pSection, off + 8, "__tls_get_addr");
+  if (NULL == next)
+    return false;
+
+  // movq %fs:0, %rax
+  // leaq x@tpoff(%rax), %rax (local-exec)
+  // addq x@gottpoff(%rip), %rax (initial-exec)
+  uint8_t code[] = { 0x64, 0x48, 0x8b, 0x04, 0x25, 0x00, 0x00, 0x00, 0x00,
+                     0x48, 0x8d, 0x80 };
+  if (!pToLE) {
+    code[10] = 0x03;
+    code[11] = 0x05;
+  }
+  rewriteCode(pReloc, off - 4, code, sizeof(code), R_X86_64_OPT, pSection);
+
+  // the call is gone, and the operand of leaq or addq takes its place
+  next->setType(llvm::ELF::R_X86_64_NONE);
+  pReloc.targetRef().assign(*pReloc.targetRef().frag(), off + 8);
+  if (pToLE) {
+    pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+    pReloc.setAddend(0x0);
+  }
+  else {
+    // the operand of addq is relative to the end of the sequence
+    pReloc.setType(llvm::ELF::R_X86_64_GOTTPOFF);
+    pReloc.setAddend(-4);
+  }
+  pReloc.target() = 0x0;
+  return true;
+}
+
+/// convert the R_X86_64_TLSLD sequence to the local-exec one
+bool X86_64Relocator::convertTLSLDtoLE(Relocation& pReloc,
+                                       LDSection& pSection)
+{
+  assert(pReloc.type() == llvm::ELF::R_X86_64_TLSLD);
+
+  // leaq x@tlsld(%rip), %rdi
+  // call __tls_get_addr@plt
+  static const uint8_t lea[] = { 0x48, 0x8d, 0x3d };
+  static const uint8_t call[] = { 0xe8 };
+  uint64_t off = pReloc.targetRef().offset();
+  if (off < 3 ||
+      !matchCode(pReloc, off - 3, lea, sizeof(lea)) ||
+      !matchCode(pReloc, off + 4, call, sizeof(call)))
+    return false;
+
+  Relocation* next = getNextCall(pReloc, pSection, off + 5, "__tls_get_addr");
+  if (NULL == next)
+    return false;
+
+  // .word 0x6666; .byte 0x66; movq %fs:0, %rax
+  static const uint8_t code[] = { 0x66, 0x66, 0x66, 0x64, 0x48, 0x8b,
+                                  0x04, 0x25, 0x00, 0x00, 0x00, 0x00 };
+  rewriteCode(pReloc, off - 3, code, sizeof(code), R_X86_64_OPT, pSection);
+
+  next->setType(llvm::ELF::R_X86_64_NONE);
+  pReloc.setType(llvm::ELF::R_X86_64_NONE);
+  return true;
+}
+
+/// convert R_X86_64_GOTTPOFF to R_X86_64_TPOFF32
+bool X86_64Relocator::convertTLSIEtoLE(Relocation& pReloc,
+                                       LDSection& pSection)
+{
+  assert(pReloc.type() == llvm::ELF::R_X86_64_GOTTPOFF);
+
+  const FragmentRef& ref = pReloc.targetRef();
+  uint64_t off = ref.offset();
+  if (off < 3 || !llvm::isa<RegionFragment>(ref.frag()))
+    return false;
+
+  // movq x@gottpoff(%rip), %reg -> movq $x@tpoff, %reg
+  // addq x@gottpoff(%rip), %reg -> addq $x@tpoff, %reg
+  const uint8_t* op =
+    llvm::cast<RegionFragment>(ref.frag())->getRegion().start() + off - 3;
+  if ((0x48 != op[0] && 0x4c != op[0]) ||
+      (0x8b != op[1] && 0x03 != op[1]) ||
+      0x05 != (op[2] & 0xc7))
+    return false;
+
+  uint8_t code[4];
+  // the register moves from ModRM.reg to ModRM.rm, so does the REX bit
+  code[0] = (0x4c == op[0]) ? 0x49 : 0x48;
+  code[1] = (0x8b == op[1]) ? 0xc7 : 0x81;
+  code[2] = 0xc0 | ((op[2] >> 3) & 0x7);
+  // the first byte of the operand is written by the relocation
+  code[3] = 0x0;
+  rewriteCode(pReloc, off - 3, code, sizeof(code), R_X86_64_OPT, pSection);
+
+  pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+  pReloc.setAddend(0x0);
+  pReloc.target() = 0x0;
+  return true;
+}
+
+bool X86_64Relocator::mayRelaxGOTPCREL(const ResolveInfo& pSym) const
+{
+  // The symbol must be defined in a section of the output and bound to the
+  // definition. The address of an absolute symbol is not PC-relative in a
+  // position independent output.
+  if (pSym.isDyn() || pSym.isUndef() || pSym.isAbsolute() ||
+      ResolveInfo::IndirectFunc == pSym.type())
+    return false;
+  if (NULL == pSym.outSymbol() || !pSym.outSymbol()->hasFragRef())
+    return false;
+  return !getTarget().isSymbolPreemptible(pSym);
+}
+
+/// convert the instruction of R_X86_64_GOTPCREL to refer to the symbol
+bool X86_64Relocator::convertGOTPCREL(Relocation& pReloc, LDSection& pSection)
+{
+  // The field must be the last operand of the instruction.
+  const FragmentRef& ref = pReloc.targetRef();
+  uint64_t off = ref.offset();
+  if ((Relocation::Address)-4 != pReloc.addend() ||
+      off < 2 || !llvm::isa<RegionFragment>(ref.frag()))
+    return false;
+
+  // movq foo@GOTPCREL(%rip), %reg -> leaq foo(%rip), %reg
+  // call *foo@GOTPCREL(%rip)      -> addr32 call foo
+  // jmp *foo@GOTPCREL(%rip)       -> nop; jmp foo
+  const uint8_t* op =
+    llvm::cast<RegionFragment>(ref.frag())->getRegion().start() + off - 2;
+  // the last two bytes are the operand written by the relocation
+  uint8_t code[4] = { 0x0, 0x0, 0x0, 0x0 };
+  if (0x8b == op[0] && 0x05 == (op[1] & 0xc7)) {
+    code[0] = 0x8d;
+    code[1] = op[1];
+  }
+  else if (0xff == op[0] && 0x15 == op[1]) {
+    code[0] = 0x67;
+    code[1] = 0xe8;
+  }
+  else if (0xff == op[0] && 0x25 == op[1]) {
+    code[0] = 0x90;
+    code[1] = 0xe9;
+  }
+  else
+    return false;
+
+  rewriteCode(pReloc, off - 2, code, sizeof(code), R_X86_64_OPT, pSection);
+  pReloc.setType(llvm::ELF::R_X86_64_PC32);
+  ++m_NumOfRelaxedGOTPCREL;
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Relocation helper function
 //===--------------------------------------------------------------------===//
@@ -1479,12 +2119,14 @@ X86_64GOTEntry& helper_get_GOT_and_init(Relocation& pReloc,
 					    llvm::ELF::R_X86_64_RELATIVE,
 					    pParent);
       rel_entry.setAddend(pReloc.symValue());
+      // keep the addend in the entry for .relr.dyn
+      got_entry->setValue(pReloc.symValue());
     }
     else {
       helper_DynRel(rsym, *got_entry, 0x0, llvm::ELF::R_X86_64_GLOB_DAT,
 		    pParent);
+      got_entry->setValue(0);
     }
-    got_entry->setValue(0);
   }
   else {
     fatal(diag::reserve_entry_number_mismatch_got);
@@ -1552,6 +2194,21 @@ X86Relocator::Address helper_PLT(Relocation& pReloc, X86_64Relocator& pParent)
   return helper_PLT_ORG(pParent) + plt_entry.getOffset();
 }
 
+/// helper_TLS_SIZE - the size of the TLS block of the executable. The thread
+/// pointer points to the end of the block.
+static
+X86Relocator::Address helper_TLS_SIZE(X86_64Relocator& pParent)
+{
+  ELFSegmentFactory::const_iterator tls_seg =
+    pParent.getTarget().elfSegmentTable().find(llvm::ELF::PT_TLS,
+                                               llvm::ELF::PF_R,
+                                               0x0);
+  assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
+  uint64_t size = (*tls_seg)->memsz();
+  alignAddress(size, (*tls_seg)->align());
+  return size;
+}
+
 //
 // R_X86_64_NONE
 X86Relocator::Result none(Relocation& pReloc, X86_64Relocator& pParent)
@@ -1592,6 +2249,10 @@ X86Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent)
     Relocation& rel_entry = helper_DynRel(rsym, *target_frag,
         target_fragref.offset(), pType, pParent);
     rel_entry.setAddend(S + A);
+    // the relocation may be packed into .relr.dyn, which keeps the addend
+    // in the place
+    if (llvm::ELF::R_X86_64_RELATIVE == pType)
+      pReloc.target() = S + A;
     return X86Relocator::OK;
   }
 
@@ -1726,6 +2387,129 @@ X86Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent)
   return X86Relocator::OK;
 }
 
+// R_X86_64_TLSGD: GOT(S) + GOT_ORG + A - P
+X86Relocator::Result tls_gd(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  // global-dynamic
+  ResolveInfo* rsym = pReloc.symInfo();
+  // must reserve two got entries
+  if (!(rsym->reserved() & X86Relocator::GOTRel)) {
+    return X86Relocator::BadReloc;
+  }
+
+  // set up the got entries of the module index and the offset in the module
+  // if they do not exist
+  X86_64GOTEntry* got_entry1 = pParent.getSymGOTMap().lookUp(*rsym);
+  if (NULL == got_entry1) {
+    X86_64GNULDBackend& ld_backend = pParent.getTarget();
+    got_entry1 = ld_backend.getGOT().consume();
+    pParent.getSymGOTMap().record(*rsym, *got_entry1);
+    X86_64GOTEntry* got_entry2 = ld_backend.getGOT().consume();
+    got_entry1->setValue(0x0);
+    got_entry2->setValue(0x0);
+    if (rsym->isLocal()) {
+      // the module index of this module, and the known offset
+      helper_DynRel(NULL, *got_entry1, 0x0, llvm::ELF::R_X86_64_DTPMOD64,
+                    pParent);
+      got_entry2->setValue(pReloc.symValue());
+    }
+    else {
+      helper_DynRel(rsym, *got_entry1, 0x0, llvm::ELF::R_X86_64_DTPMOD64,
+                    pParent);
+      helper_DynRel(rsym, *got_entry2, 0x0, llvm::ELF::R_X86_64_DTPOFF64,
+                    pParent);
+    }
+  }
+
+  Relocator::DWord      A       = pReloc.target() + pReloc.addend();
+  X86Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
+  pReloc.target() = got_entry1->getOffset() + GOT_ORG + A - pReloc.place();
+  return X86Relocator::OK;
+}
+
+// R_X86_64_TLSLD: GOT(module index) + GOT_ORG + A - P
+X86Relocator::Result tls_ld(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  const X86_64GOTEntry& got_entry = pParent.getTLSModuleID();
+  Relocator::DWord      A       = pReloc.target() + pReloc.addend();
+  X86Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
+  pReloc.target() = got_entry.getOffset() + GOT_ORG + A - pReloc.place();
+  return X86Relocator::OK;
+}
+
+// R_X86_64_DTPOFF32: S + A
+X86Relocator::Result dtpoff32(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  X86Relocator::Address S = pReloc.symValue();
+
+  // In an executable, R_X86_64_TLSLD is relaxed to get the thread pointer, so
+  // the offset is relative to the thread pointer. (except for debug sections)
+  LDSection& target_sect = pReloc.targetRef().frag()->getParent()->getSection();
+  if (pParent.mayRelaxTLS() &&
+      0x0 != (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
+    pReloc.target() = S + A - helper_TLS_SIZE(pParent);
+    return X86Relocator::OK;
+  }
+
+  pReloc.target() = S + A;
+  return X86Relocator::OK;
+}
+
+// R_X86_64_DTPOFF64: S + A
+X86Relocator::Result dtpoff64(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  // the same offset as R_X86_64_DTPOFF32 (movabsq $x@dtpoff, %reg), which is
+  // relative to the thread pointer once R_X86_64_TLSLD is relaxed
+  return dtpoff32(pReloc, pParent);
+}
+
+// R_X86_64_GOTTPOFF: GOT(S) + GOT_ORG + A - P
+X86Relocator::Result gottpoff(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  ResolveInfo* rsym = pReloc.symInfo();
+  if (!(rsym->reserved() & (X86Relocator::ReserveGOT | X86Relocator::GOTRel))) {
+    return X86Relocator::BadReloc;
+  }
+
+  // set up the got and dynamic relocation entries if not exist
+  X86_64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*rsym);
+  if (NULL == got_entry) {
+    got_entry = pParent.getTarget().getGOT().consume();
+    pParent.getSymGOTMap().record(*rsym, *got_entry);
+    if (rsym->reserved() & X86Relocator::ReserveGOT) {
+      // the tp-relative offset is known in the executable
+      got_entry->setValue(pReloc.symValue() - helper_TLS_SIZE(pParent));
+    }
+    else if (rsym->isLocal()) {
+      got_entry->setValue(0x0);
+      Relocation& rel_entry = helper_DynRel(NULL, *got_entry, 0x0,
+                                            llvm::ELF::R_X86_64_TPOFF64,
+                                            pParent);
+      rel_entry.setAddend(pReloc.symValue());
+    }
+    else {
+      got_entry->setValue(0x0);
+      helper_DynRel(rsym, *got_entry, 0x0, llvm::ELF::R_X86_64_TPOFF64,
+                    pParent);
+    }
+  }
+
+  Relocator::DWord      A       = pReloc.target() + pReloc.addend();
+  X86Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
+  pReloc.target() = got_entry->getOffset() + GOT_ORG + A - pReloc.place();
+  return X86Relocator::OK;
+}
+
+// R_X86_64_TPOFF32: S + A - TLS_SIZE
+X86Relocator::Result tpoff32(Relocation& pReloc, X86_64Relocator& pParent)
+{
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  X86Relocator::Address S = pReloc.symValue();
+  pReloc.target() = S + A - helper_TLS_SIZE(pParent);
+  return X86Relocator::OK;
+}
+
 X86Relocator::Result unsupport(Relocation& pReloc, X86_64Relocator& pParent)
 {
   return X86Relocator::Unsupport;
@@ -97,11 +97,54 @@ public:
                       Module& pModule,
                       LDSection& pSection);
 
+  /// mayRelaxTLS - can the general- and local-dynamic TLS accesses be relaxed?
+  /// This is true when linking an executable.
+  bool mayRelaxTLS() const;
+
+  /// mayRelaxTLSToLE - can a TLS access to pSym be relaxed to the local-exec
+  /// model?
+  bool mayRelaxTLSToLE(const ResolveInfo& pSym) const;
+
 protected:
+  /// isCallOrJump - is the 32-bit PC-relative field of pReloc the operand of
+  /// a call, jmp or jcc instruction? Fields outside executable sections never
+  /// are.
+  static bool isCallOrJump(const Relocation& pReloc);
+
+  /// -----  tls optimization  ----- ///
+  /// matchCode - are the bytes at pOffset of the target fragment of pReloc
+  /// equal to pCode?
+  static bool matchCode(const Relocation& pReloc,
+                        int64_t pOffset,
+                        const uint8_t* pCode,
+                        size_t pSize);
+
+  /// getNextCall - return the relocation after pReloc if it is the call to
+  /// pCallee at pOffset of the same fragment, otherwise return NULL
+  static Relocation* getNextCall(Relocation& pReloc,
+                                 LDSection& pSection,
+                                 uint64_t pOffset,
+                                 const char* pCallee);
+
+  /// rewriteCode - replace pSize (>= 4) bytes at pOffset of the target
+  /// fragment of pReloc by pCode. The bytes are written by relocations of
+  /// pOptType inserted before pReloc.
+  static void rewriteCode(Relocation& pReloc,
+                          uint64_t pOffset,
+                          const uint8_t* pCode,
+                          size_t pSize,
+                          Relocation::Type pOptType,
+                          LDSection& pSection);
+
   /// addCopyReloc - add a copy relocation into .rel.dyn for pSym
   /// @param pSym - A resolved copy symbol that defined in BSS section
   void addCopyReloc(ResolveInfo& pSym, X86GNULDBackend& pTarget);
 
+  /// mayPackDynRel - will the dynamic relocation against pSym be a relative
+  /// relocation which can be packed into .relr.dyn?
+  static bool mayPackDynRel(const ResolveInfo& pSym,
+                            const X86GNULDBackend& pTarget);
+
   /// defineSymbolforCopyReloc - allocate a space in BSS section and
   /// and force define the copy of pSym to BSS section
   /// @return the output LDSymbol of the copy symbol
@@ -153,6 +196,10 @@ public:
 
   Size getSize(Relocation::Type pType) const;
 
+  bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
+
+  bool mayApplyConcurrently(const Relocation& pReloc) const;
+
   const SymGOTMap& getSymGOTMap() const { return m_SymGOTMap; }
   SymGOTMap&       getSymGOTMap()       { return m_SymGOTMap; }
 
@@ -176,6 +223,14 @@ private:
   /// convert R_386_TLS_IE to R_386_TLS_LE
   void convertTLSIEtoLE(Relocation& pReloc, LDSection& pSection);
 
+  /// convert the R_386_TLS_GD sequence to R_386_TLS_LE (pToLE) or
+  /// R_386_TLS_GOTIE. Return false if the sequence is not recognized.
+  bool convertTLSGD(Relocation& pReloc, LDSection& pSection, bool pToLE);
+
+  /// convert the R_386_TLS_LDM sequence to the local-exec one. Return false
+  /// if the sequence is not recognized.
+  bool convertTLSLDMtoLE(Relocation& pReloc, LDSection& pSection);
+
 private:
   X86_32GNULDBackend& m_Target;
   SymGOTMap m_SymGOTMap;
@@ -192,6 +247,12 @@ public:
   typedef SymbolEntryMap<X86_64GOTEntry> SymGOTMap;
   typedef SymbolEntryMap<X86_64GOTEntry> SymGOTPLTMap;
 
+  enum {
+    R_X86_64_GOTPCRELX     = 41,
+    R_X86_64_REX_GOTPCRELX = 42,
+    R_X86_64_OPT           = 44 // mcld internal relocation type
+  };
+
 public:
   X86_64Relocator(X86_64GNULDBackend& pParent, const LinkerConfig& pConfig);
 
@@ -207,12 +268,22 @@ public:
 
   Size getSize(Relocation::Type pType) const;
 
+  bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
+
+  bool mayApplyConcurrently(const Relocation& pReloc) const;
+
   const SymGOTMap& getSymGOTMap() const { return m_SymGOTMap; }
   SymGOTMap&       getSymGOTMap()       { return m_SymGOTMap; }
 
   const SymGOTPLTMap& getSymGOTPLTMap() const { return m_SymGOTPLTMap; }
   SymGOTPLTMap&       getSymGOTPLTMap()       { return m_SymGOTPLTMap; }
 
+  X86_64GOTEntry& getTLSModuleID();
+
+  /// numOfRelaxedGOTPCREL - the number of GOTPCREL relocations converted to
+  /// direct references
+  size_t numOfRelaxedGOTPCREL() const { return m_NumOfRelaxedGOTPCREL; }
+
 private:
   void scanLocalReloc(Relocation& pReloc,
                       IRBuilder& pBuilder,
@@ -224,10 +295,35 @@ private:
                        Module& pModule,
                        LDSection& pSection);
 
+  /// -----  tls optimization  ----- ///
+  /// convert the R_X86_64_TLSGD sequence to R_X86_64_TPOFF32 (pToLE) or
+  /// R_X86_64_GOTTPOFF. Return false if the sequence is not recognized.
+  bool convertTLSGD(Relocation& pReloc, LDSection& pSection, bool pToLE);
+
+  /// convert the R_X86_64_TLSLD sequence to the local-exec one. Return false
+  /// if the sequence is not recognized.
+  bool convertTLSLDtoLE(Relocation& pReloc, LDSection& pSection);
+
+  /// convert R_X86_64_GOTTPOFF to R_X86_64_TPOFF32. Return false if the
+  /// instruction is not recognized.
+  bool convertTLSIEtoLE(Relocation& pReloc, LDSection& pSection);
+
+  /// -----  got optimization  ----- ///
+  /// mayRelaxGOTPCREL - can the got entry of pSym be replaced by a direct
+  /// reference?
+  bool mayRelaxGOTPCREL(const ResolveInfo& pSym) const;
+
+  /// convert the instruction loading the got entry of R_X86_64_GOTPCREL into
+  /// the one referring to the symbol by R_X86_64_PC32. Return false if the
+  /// instruction is not recognized.
+  bool convertGOTPCREL(Relocation& pReloc, LDSection& pSection);
+
 private:
   X86_64GNULDBackend& m_Target;
   SymGOTMap m_SymGOTMap;
   SymGOTPLTMap m_SymGOTPLTMap;
+  X86_64GOTEntry* m_pTLSModuleID;
+  size_t m_NumOfRelaxedGOTPCREL;
 };
 
 } // namespace of mcld
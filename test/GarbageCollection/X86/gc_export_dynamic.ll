@@ -0,0 +1,17 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --gc-sections \
+; RUN: --export-dynamic %p/obj/gc.o -o %t.exe
+; RUN: objdump -d %t.exe | FileCheck %s
+
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --gc-sections \
+; RUN: -shared %p/obj/gc.o -o %t.so
+; RUN: objdump -d %t.so | FileCheck %s
+
+; unused is exported and keeps its hidden callee. The hidden kept is not
+; exported.
+; CHECK-NOT: $0x2222
+; CHECK: $0x1111
+; CHECK-NOT: $0x2222
+; CHECK: $0xdead
+; CHECK-NOT: $0x2222
+; CHECK: $0xbeef
+; CHECK-NOT: $0x2222
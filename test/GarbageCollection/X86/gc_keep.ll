@@ -0,0 +1,13 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --gc-sections \
+; RUN: -T %p/src/keep.lds %p/obj/gc.o -o %t.exe
+
+; KEEP(*(.text.kept)) keeps kept, which nothing refers to
+; RUN: objdump -d %t.exe | FileCheck %s -check-prefix=KEEP
+; KEEP: $0x2222
+
+; RUN: objdump -d %t.exe | FileCheck %s -check-prefix=GC
+; GC-NOT: $0xdead
+; GC-NOT: $0xbeef
+; GC: $0x1111
+; GC-NOT: $0xdead
+; GC-NOT: $0xbeef
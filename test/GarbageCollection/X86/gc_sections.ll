@@ -0,0 +1,17 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu %p/obj/gc.o -o %t.nogc.exe
+; RUN: objdump -d %t.nogc.exe | FileCheck %s -check-prefix=NOGC
+; NOGC: $0x1111
+; NOGC: $0xdead
+; NOGC: $0xbeef
+; NOGC: $0x2222
+
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --gc-sections \
+; RUN: %p/obj/gc.o -o %t.exe
+; RUN: objdump -d %t.exe | FileCheck %s -check-prefix=GC
+; GC-NOT: $0xdead
+; GC-NOT: $0xbeef
+; GC-NOT: $0x2222
+; GC: $0x1111
+; GC-NOT: $0xdead
+; GC-NOT: $0xbeef
+; GC-NOT: $0x2222
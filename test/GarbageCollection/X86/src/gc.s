@@ -0,0 +1,35 @@
+# Each function is in its own section and loads a distinct constant, so the
+# disassembly of the output shows which sections are kept.
+
+	.section .text._start,"ax",@progbits
+	.globl	_start
+_start:
+	call	used
+	ret
+
+	.section .text.used,"ax",@progbits
+	.globl	used
+used:
+	movl	$0x1111, %eax
+	ret
+
+	.section .text.unused,"ax",@progbits
+	.globl	unused
+unused:
+	movl	$0xdead, %eax
+	call	unused_callee
+	ret
+
+	.section .text.unused_callee,"ax",@progbits
+	.globl	unused_callee
+	.hidden	unused_callee
+unused_callee:
+	movl	$0xbeef, %eax
+	ret
+
+	.section .text.kept,"ax",@progbits
+	.globl	kept
+	.hidden	kept
+kept:
+	movl	$0x2222, %eax
+	ret
@@ -0,0 +1,25 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --icf=all \
+; RUN: %p/obj/icf.o -o %t.all.exe
+; RUN: nm -P %t.all.exe | FileCheck %s -check-prefix=ALL
+
+; ALL: f1 T [[F:[0-9a-f]+]]
+; ALL-NEXT: f2 T [[F]]{{ }}
+; ALL-NEXT: g1 T [[G:[0-9a-f]+]]
+; ALL-NOT: g2 T [[G]]{{ }}
+; ALL: h1 T [[H:[0-9a-f]+]]
+; ALL-NEXT: h2 T [[H]]{{ }}
+; ALL-NEXT: k1 T [[K:[0-9a-f]+]]
+; ALL-NEXT: k2 T [[K]]{{ }}
+
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --icf=safe \
+; RUN: %p/obj/icf.o -o %t.safe.exe
+; RUN: nm -P %t.safe.exe | FileCheck %s -check-prefix=SAFE
+
+; SAFE: f1 T [[F:[0-9a-f]+]]
+; SAFE-NEXT: f2 T [[F]]{{ }}
+; SAFE-NEXT: g1 T [[G:[0-9a-f]+]]
+; SAFE-NOT: g2 T [[G]]{{ }}
+; SAFE: h1 T [[H:[0-9a-f]+]]
+; SAFE-NOT: h2 T [[H]]{{ }}
+; SAFE: k1 T [[K:[0-9a-f]+]]
+; SAFE-NEXT: k2 T [[K]]{{ }}
@@ -0,0 +1,15 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --icf=all \
+; RUN: %p/obj/icf_data.o -o %t.all.exe
+; RUN: nm -P %t.all.exe | FileCheck %s -check-prefix=ALL
+
+; ALL: m1 T [[M:[0-9a-f]+]]
+; ALL-NEXT: m2 T [[M]]{{ }}
+
+; The 0xe8 byte before the PC-relative word in .data is not a call.
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --icf=safe \
+; RUN: %p/obj/icf_data.o -o %t.safe.exe
+; RUN: nm -P %t.safe.exe | FileCheck %s -check-prefix=SAFE
+
+; SAFE: m1 T [[M:[0-9a-f]+]]
+; SAFE-NOT: m2 T [[M]]{{ }}
+; SAFE: m2 T
@@ -0,0 +1,19 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --icf=all --eh-frame-hdr \
+; RUN: %p/obj/icf.o -o %t.exe
+; RUN: readelf --debug-dump=frames %t.exe | FileCheck %s -check-prefix=FRAMES
+; RUN: readelf -x .eh_frame_hdr %t.exe | FileCheck %s -check-prefix=HDR
+
+; The FDEs of f2, h2 and k2 are dropped with them. The rest describe the
+; adjacent functions _start, f1, x1, x2, g1, g2, h1 and k1 once each.
+; FRAMES: FDE cie={{[0-9a-f]+}} pc={{[0-9a-f]+}}..[[PC1:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC1]]..[[PC2:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC2]]..[[PC3:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC3]]..[[PC4:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC4]]..[[PC5:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC5]]..[[PC6:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC6]]..[[PC7:[0-9a-f]+]]
+; FRAMES: FDE cie={{[0-9a-f]+}} pc=[[PC7]]..{{[0-9a-f]+}}
+; FRAMES-NOT: FDE
+
+; The binary search table has one entry for each FDE.
+; HDR: 011b033b {{[0-9a-f]+}} 08000000
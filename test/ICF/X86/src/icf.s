@@ -0,0 +1,70 @@
+# Every function is in its own .text.* section and has an FDE.
+#   f1, f2 - identical
+#   g1, g2 - identical except that g1 calls x1 and g2 calls x2
+#   h1, h2 - identical, but _start takes the address of h2
+#   k1, k2 - identical except that k1 calls f1 and k2 calls f2
+
+	.macro	func name
+	.section .text.\name,"ax",@progbits
+	.globl	\name
+	.type	\name, @function
+\name:
+	.cfi_startproc
+	.endm
+
+	.macro	endfunc name
+	ret
+	.cfi_endproc
+	.size	\name, .-\name
+	.endm
+
+	func	_start
+	call	f1
+	call	f2
+	call	g1
+	call	g2
+	call	h1
+	leaq	h2(%rip), %rax
+	call	k1
+	call	k2
+	endfunc	_start
+
+	func	f1
+	movl	$0x1111, %eax
+	endfunc	f1
+
+	func	f2
+	movl	$0x1111, %eax
+	endfunc	f2
+
+	func	x1
+	movl	$0x10, %eax
+	endfunc	x1
+
+	func	x2
+	movl	$0x20, %eax
+	endfunc	x2
+
+	func	g1
+	call	x1
+	endfunc	g1
+
+	func	g2
+	call	x2
+	endfunc	g2
+
+	func	h1
+	movl	$0x3333, %eax
+	endfunc	h1
+
+	func	h2
+	movl	$0x3333, %eax
+	endfunc	h2
+
+	func	k1
+	call	f1
+	endfunc	k1
+
+	func	k2
+	call	f2
+	endfunc	k2
@@ -0,0 +1,34 @@
+# m1 and m2 are identical. A data word that follows an 0xe8 byte takes the
+# address of m2, and only the code calls m1.
+
+	.macro	func name
+	.section .text.\name,"ax",@progbits
+	.globl	\name
+	.type	\name, @function
+\name:
+	.endm
+
+	.macro	endfunc name
+	ret
+	.size	\name, .-\name
+	.endm
+
+	func	_start
+	call	m1
+	endfunc	_start
+
+	func	m1
+	movl	$0x2222, %eax
+	endfunc	m1
+
+	func	m2
+	movl	$0x2222, %eax
+	endfunc	m2
+
+	.data
+	.globl	table
+	.type	table, @object
+table:
+	.byte	0xe8
+	.long	m2 - .
+	.size	table, .-table
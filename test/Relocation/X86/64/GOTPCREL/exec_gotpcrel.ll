@@ -0,0 +1,34 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --stats                \
+; RUN: %p/obj/gotpcrel.o -o %t.exe | FileCheck %s -check-prefix=STATS
+; RUN: objdump -d %t.exe | FileCheck %s -check-prefix=CODE
+; RUN: readelf -SW %t.exe | FileCheck %s -check-prefix=GOT
+
+; STATS: GOTPCREL relocations relaxed: 4
+
+; CODE: <_start>:
+; movq -> leaq, the register and REX prefix are kept
+; CODE-NEXT: 48 8d 05 {{.*}}<foo>
+; CODE-NEXT: 4c 8d 25 {{.*}}<foo>
+; call -> addr32 call
+; CODE-NEXT: 67 e8 {{.*}}<foo>
+; jmp -> nop; jmp
+; CODE-NEXT: 90
+; CODE-NEXT: e9 {{.*}}<foo>
+; not relaxed
+; CODE-NEXT: 48 03 05
+; CODE-NEXT: 48 8b 05
+
+; foo needs no GOT entry, bar and baz do
+; GOT: .got {{ *}}PROGBITS {{ *}}{{[0-9a-f]+}} {{[0-9a-f]+}} 000010
+
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu --stats -shared        \
+; RUN: %p/obj/gotpcrel.o -o %t.so | FileCheck %s -check-prefix=SHARED-STATS
+; RUN: objdump -d %t.so | FileCheck %s -check-prefix=SHARED
+
+; foo is preemptible in a shared object
+; SHARED-STATS: GOTPCREL relocations relaxed: 0
+; SHARED: <_start>:
+; SHARED-NEXT: 48 8b 05
+; SHARED-NEXT: 4c 8b 25
+; SHARED-NEXT: ff 15
+; SHARED-NEXT: ff 25
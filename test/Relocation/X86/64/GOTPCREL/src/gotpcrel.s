@@ -0,0 +1,28 @@
+# GOT-relative loads of symbols defined in the output
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	# relaxed
+	movq	foo@GOTPCREL(%rip), %rax
+	movq	foo@GOTPCREL(%rip), %r12
+	call	*foo@GOTPCREL(%rip)
+	jmp	*foo@GOTPCREL(%rip)
+	# not relaxed: the opcode, and the operand is not at the end
+	addq	bar@GOTPCREL(%rip), %rax
+	movq	baz@GOTPCREL+4(%rip), %rax
+	.size	_start, .-_start
+
+	.globl	foo
+	.type	foo, @function
+foo:
+	ret
+	.globl	bar
+	.type	bar, @function
+bar:
+	ret
+	.globl	baz
+	.type	baz, @function
+baz:
+	ret
@@ -0,0 +1,35 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared                \
+; RUN: %p/obj/relative.o -o %t.so
+; RUN: readelf -dW %t.so | FileCheck %s -check-prefix=DYN
+; RUN: readelf -rW %t.so | FileCheck %s -check-prefix=REL
+
+; The relative relocations are sorted first and counted by DT_RELACOUNT.
+; DYN: (RELACOUNT) {{ *}}5
+; REL: R_X86_64_RELATIVE
+; REL-NEXT: R_X86_64_RELATIVE
+; REL-NEXT: R_X86_64_RELATIVE
+; REL-NEXT: R_X86_64_RELATIVE
+; REL-NEXT: R_X86_64_RELATIVE
+; REL-NEXT: R_X86_64_64 {{.*}} g + 0
+
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared                \
+; RUN: -z pack-relative-relocs %p/obj/relative.o -o %t.relr.so
+; RUN: readelf -dW %t.relr.so | FileCheck %s -check-prefix=PACK-DYN
+; RUN: readelf -rW %t.relr.so | FileCheck %s -check-prefix=PACK-REL
+; RUN: readelf -x .relr.dyn %t.relr.so | FileCheck %s -check-prefix=RELR
+
+; Only the relocation of the misaligned place is left in .rela.dyn.
+; PACK-DYN: 0x{{0*}}24 {{.*}}0x{{[0-9a-f]+}}
+; PACK-DYN: 0x{{0*}}23 {{.*}}32
+; PACK-DYN: (RELACOUNT) {{ *}}1
+; PACK-REL: .rela.dyn
+; PACK-REL-NEXT: Offset
+; PACK-REL-NEXT: {{[0-9a-f]+}}1c {{.*}} R_X86_64_RELATIVE
+; PACK-REL-NEXT: R_X86_64_64 {{.*}} g + 0
+
+; .relr.dyn is sized for the four relative relocations of aligned places. l
+; is relocated twice, so the three places are encoded in an address and a
+; bitmap, and the rest is empty bitmaps.
+; RELR: Hex dump of section '.relr.dyn':
+; RELR-NEXT: {{[0-9a-f]+}} 00000000 07000000 00000000
+; RELR-NEXT: 01000000 00000000 01000000 00000000
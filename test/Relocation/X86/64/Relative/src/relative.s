@@ -0,0 +1,19 @@
+# pointers which need relative relocations in a shared object
+
+	.data
+	.align	8
+	.globl	g
+	.type	g, @object
+g:
+	.quad	l
+l:
+	.quad	l
+	.quad	l + 8
+	.long	0
+	# a misaligned place cannot be packed
+	.quad	l
+	.long	0
+	# a preemptible symbol needs a symbolic relocation
+	.quad	g
+	# relocate l again
+	.reloc	l, R_X86_64_64, l + 16
@@ -0,0 +1,39 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu                       \
+; RUN: %p/obj/tls_relax.o %p/obj/libtls.so.1 -o %t.exe
+; RUN: objdump -d %t.exe > %t.txt
+; RUN: readelf -rW %t.exe >> %t.txt
+; RUN: readelf -x .debug_info %t.exe >> %t.txt
+; RUN: cat %t.txt | FileCheck %s
+
+; The TLS block of the executable is tls_a, tls_b. tls_a@tpoff is -16 and
+; tls_b@tpoff is -8.
+
+; CHECK: <_start>:
+; general-dynamic -> local-exec
+; CHECK-NEXT: 64 48 8b 04 25 00 00
+; CHECK-NEXT: 00 00
+; CHECK-NEXT: 48 8d 80 f0 ff ff ff
+; general-dynamic -> initial-exec
+; CHECK-NEXT: 64 48 8b 04 25 00 00
+; CHECK-NEXT: 00 00
+; CHECK-NEXT: 48 03 05 {{.*}}# [[GOT:[0-9a-f]+]]
+; local-dynamic -> local-exec, R_X86_64_DTPOFF32 and R_X86_64_DTPOFF64
+; CHECK-NEXT: 66 66 66 64 48 8b 04
+; CHECK-NEXT: 25 00 00 00 00
+; CHECK-NEXT: 48 8d 88 f8 ff ff ff
+; CHECK-NEXT: 48 ba f8 ff ff ff ff
+; CHECK-NEXT: ff ff ff
+; initial-exec -> local-exec
+; CHECK-NEXT: 48 c7 c0 f0 ff ff ff
+; CHECK-NEXT: 49 81 c4 f8 ff ff ff
+; CHECK-NEXT: c3
+
+; only the initial-exec GOT entry of tls_ext needs a dynamic relocation
+; CHECK: .rela.dyn
+; CHECK-NOT: R_X86_64_DTPMOD64
+; CHECK: {{0+}}[[GOT]] {{[0-9a-f]+}} R_X86_64_TPOFF64 {{.*}} tls_ext + 0
+; CHECK-NOT: R_X86_64_DTPMOD64
+
+; debug information keeps the offsets in the TLS block
+; CHECK: .debug_info
+; CHECK-NEXT: 0x00000000 08000000 08000000
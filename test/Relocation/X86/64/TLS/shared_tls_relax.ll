@@ -0,0 +1,25 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared               \
+; RUN: %p/obj/tls_relax.o %p/obj/libtls.so.1 -o %t.so
+; RUN: objdump -d %t.so > %t.txt
+; RUN: readelf -rW %t.so >> %t.txt
+; RUN: cat %t.txt | FileCheck %s
+
+; Nothing is relaxed in a shared object.
+
+; CHECK: <_start>:
+; CHECK-NEXT: 66 48 8d 3d
+; CHECK: 66 66 48 e8
+; CHECK: 66 48 8d 3d
+; CHECK: 66 66 48 e8
+; CHECK: 48 8d 3d
+; CHECK-NEXT: e8
+; R_X86_64_DTPOFF32 and R_X86_64_DTPOFF64 are offsets in the TLS block
+; CHECK-NEXT: 48 8d 88 08 00 00 00
+; CHECK-NEXT: 48 ba 08 00 00 00 00
+; CHECK-NEXT: 00 00 00
+; CHECK-NEXT: 48 8b 05
+; CHECK-NEXT: 4c 03 25
+; CHECK-NEXT: c3
+
+; CHECK: .rela.dyn
+; CHECK: R_X86_64_DTPMOD64
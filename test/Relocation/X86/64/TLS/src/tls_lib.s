@@ -0,0 +1,16 @@
+# a shared object that defines a TLS variable and __tls_get_addr
+
+	.text
+	.globl	__tls_get_addr
+	.type	__tls_get_addr, @function
+__tls_get_addr:
+	ret
+	.size	__tls_get_addr, .-__tls_get_addr
+
+	.section	.tbss,"awT",@nobits
+	.align	4
+	.globl	tls_ext
+	.type	tls_ext, @object
+	.size	tls_ext, 4
+tls_ext:
+	.zero	4
@@ -0,0 +1,46 @@
+# TLS access sequences that are relaxed when linking an executable
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	# general-dynamic, defined in the executable -> local-exec
+	.byte	0x66
+	leaq	tls_a@tlsgd(%rip), %rdi
+	.word	0x6666
+	rex64
+	call	__tls_get_addr@PLT
+
+	# general-dynamic, defined in a shared object -> initial-exec
+	.byte	0x66
+	leaq	tls_ext@tlsgd(%rip), %rdi
+	.word	0x6666
+	rex64
+	call	__tls_get_addr@PLT
+
+	# local-dynamic -> local-exec
+	leaq	tls_b@tlsld(%rip), %rdi
+	call	__tls_get_addr@PLT
+	leaq	tls_b@dtpoff(%rax), %rcx
+	movabsq	$tls_b@dtpoff, %rdx
+
+	# initial-exec, defined in the executable -> local-exec
+	movq	tls_a@gottpoff(%rip), %rax
+	addq	tls_b@gottpoff(%rip), %r12
+	ret
+	.size	_start, .-_start
+
+	.section	.tdata,"awT",@progbits
+	.align	8
+	.globl	tls_a
+	.type	tls_a, @object
+tls_a:
+	.quad	1
+	.type	tls_b, @object
+tls_b:
+	.quad	2
+
+	# the offsets in debug information are not relative to the thread pointer
+	.section	.debug_info,"",@progbits
+	.long	tls_b@dtpoff
+	.quad	tls_b@dtpoff
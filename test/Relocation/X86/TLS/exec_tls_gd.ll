@@ -14,13 +14,9 @@
 ; RUN: %p/../../../libs/X86/Linux/ld-linux.so.2                     \
 ; RUN: -o %t.exe
 
-; check relocation type
+; the general-dynamic accesses are relaxed to local-exec, since all the TLS
+; symbols are defined in the executable
 ; RUN: readelf -r %t.exe | FileCheck %s -check-prefix=REL
-; REL: R_386_TLS_DTPMOD3 {{[0-9a-fA-F]+}} .tbss
-; REL-NEXT: R_386_TLS_DTPMOD3 {{[0-9a-fA-F]+}} .tdata
-; REL-NEXT: R_386_TLS_DTPMOD3 {{[0-9a-fA-F]+}} tls_nodef
-; REL-NEXT: R_386_TLS_DTPOFF3 {{[0-9a-fA-F]+}} tls_nodef
-; REL-NEXT: R_386_TLS_DTPMOD3 {{[0-9a-fA-F]+}} tls1
-; REL-NEXT: R_386_TLS_DTPOFF3 {{[0-9a-fA-F]+}} tls1
-; REL-NEXT: R_386_TLS_DTPMOD3 {{[0-9a-fA-F]+}} tls2
-; REL-NEXT: R_386_TLS_DTPOFF3 {{[0-9a-fA-F]+}} tls2
+; REL-NOT: R_386_TLS_DTPMOD3
+; REL-NOT: R_386_TLS_DTPOFF3
+; REL: R_386_JUMP_SLOT
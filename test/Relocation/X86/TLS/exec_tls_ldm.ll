@@ -16,9 +16,10 @@
 ; RUN: -o %t.exe
 
 
-; check relocation type
-; RUN: readelf -rW %t.exe | FileCheck %s 
-; CHECK: R_386_TLS_DTPMOD32
+; the local-dynamic accesses are relaxed to local-exec
+; RUN: readelf -rW %t.exe | FileCheck %s
+; CHECK-NOT: R_386_TLS_DTPMOD32
+; CHECK: R_386_JUMP_SLOT
 
 
 ; check the TLS segment
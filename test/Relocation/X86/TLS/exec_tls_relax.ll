@@ -0,0 +1,37 @@
+; RUN: %MCLinker -mtriple=x86-linux-gnu -march=x86                  \
+; RUN: %p/obj/tls_relax.o %p/obj/libtls.so.1 -o %t.exe
+; RUN: objdump -d %t.exe > %t.txt
+; RUN: readelf -rW %t.exe >> %t.txt
+; RUN: readelf -x .debug_info %t.exe >> %t.txt
+; RUN: cat %t.txt | FileCheck %s
+
+; The TLS block of the executable is tls_a, tls_b. tls_a@ntpoff is -8 and
+; tls_b@ntpoff is -4.
+
+; CHECK: <_start>:
+; general-dynamic -> local-exec
+; CHECK-NEXT: 65 a1 00 00 00 00
+; CHECK-NEXT: 8d 80 f8 ff ff ff
+; general-dynamic -> initial-exec
+; CHECK-NEXT: 65 a1 00 00 00 00
+; CHECK-NEXT: 03 83
+; local-dynamic -> local-exec, R_386_TLS_LDO_32
+; CHECK-NEXT: 65 a1 00 00 00 00
+; CHECK-NEXT: 90
+; CHECK-NEXT: 8d 74 26 00
+; CHECK-NEXT: 8d 88 fc ff ff ff
+; initial-exec -> local-exec
+; CHECK-NEXT: b8 f8 ff ff ff
+; CHECK-NEXT: c7 c1 fc ff ff ff
+; CHECK-NEXT: 81 c2 f8 ff ff ff
+; CHECK-NEXT: c3
+
+; only the initial-exec GOT entry of tls_ext needs a dynamic relocation
+; CHECK: .rel.dyn
+; CHECK-NOT: R_386_TLS_DTPMOD32
+; CHECK: R_386_TLS_TPOFF {{.*}} tls_ext
+; CHECK-NOT: R_386_TLS_DTPMOD32
+
+; debug information keeps the offsets in the TLS block
+; CHECK: .debug_info
+; CHECK-NEXT: 0x00000000 04000000
@@ -0,0 +1,16 @@
+# a shared object that defines a TLS variable and ___tls_get_addr
+
+	.text
+	.globl	___tls_get_addr
+	.type	___tls_get_addr, @function
+___tls_get_addr:
+	ret
+	.size	___tls_get_addr, .-___tls_get_addr
+
+	.section	.tbss,"awT",@nobits
+	.align	4
+	.globl	tls_ext
+	.type	tls_ext, @object
+	.size	tls_ext, 4
+tls_ext:
+	.zero	4
@@ -0,0 +1,39 @@
+# TLS access sequences that are relaxed when linking an executable
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	# general-dynamic, defined in the executable -> local-exec
+	leal	tls_a@tlsgd(,%ebx,1), %eax
+	call	___tls_get_addr@PLT
+
+	# general-dynamic, defined in a shared object -> initial-exec
+	leal	tls_ext@tlsgd(,%ebx,1), %eax
+	call	___tls_get_addr@PLT
+
+	# local-dynamic -> local-exec
+	leal	tls_b@tlsldm(%ebx), %eax
+	call	___tls_get_addr@PLT
+	leal	tls_b@dtpoff(%eax), %ecx
+
+	# initial-exec, defined in the executable -> local-exec
+	movl	tls_a@indntpoff, %eax
+	movl	tls_b@indntpoff, %ecx
+	addl	tls_a@indntpoff, %edx
+	ret
+	.size	_start, .-_start
+
+	.section	.tdata,"awT",@progbits
+	.align	4
+	.globl	tls_a
+	.type	tls_a, @object
+tls_a:
+	.long	1
+	.type	tls_b, @object
+tls_b:
+	.long	2
+
+	# the offsets in debug information are not relative to the thread pointer
+	.section	.debug_info,"",@progbits
+	.long	tls_b@dtpoff
@@ -18,6 +18,7 @@ class Module;
 class IRBuilder;
 class LinkerConfig;
 class Linker;
+class LinkContext;
 class Input;
 class MemoryArea;
 
@@ -55,6 +56,7 @@ public:
 
 private:
   const mcld::LinkerConfig *mLDConfig;
+  mcld::LinkContext *mContext;
   mcld::Module *mModule;
   mcld::Linker *mLinker;
   mcld::IRBuilder *mBuilder;
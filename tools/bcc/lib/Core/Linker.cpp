@@ -19,6 +19,7 @@
 #include <mcld/Linker.h>
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/LDContext.h>
+#include <mcld/Support/LinkContext.h>
 #include <mcld/Support/Path.h>
 
 using namespace bcc;
@@ -62,13 +63,13 @@ const char* Linker::GetErrorString(enum Linker::ErrorCode pErrCode) {
 // Linker
 //===----------------------------------------------------------------------===//
 Linker::Linker()
-  : mLDConfig(NULL), mModule(NULL), mLinker(NULL), mBuilder(NULL),
-    mOutputHandler(-1) {
+  : mLDConfig(NULL), mContext(NULL), mModule(NULL), mLinker(NULL),
+    mBuilder(NULL), mOutputHandler(-1) {
 }
 
 Linker::Linker(const LinkerConfig& pConfig)
-  : mLDConfig(NULL), mModule(NULL), mLinker(NULL), mBuilder(NULL),
-    mOutputHandler(-1) {
+  : mLDConfig(NULL), mContext(NULL), mModule(NULL), mLinker(NULL),
+    mBuilder(NULL), mOutputHandler(-1) {
 
   const std::string &triple = pConfig.getTriple();
 
@@ -82,9 +83,14 @@ Linker::Linker(const LinkerConfig& pConfig)
 }
 
 Linker::~Linker() {
-  delete mModule;
-  delete mLinker;
-  delete mBuilder;
+  if (NULL != mContext) {
+    mcld::LinkContext::Scope scope(*mContext);
+    delete mModule;
+    delete mLinker;
+    delete mBuilder;
+  }
+  // release all objects of the link at once
+  delete mContext;
 }
 
 enum Linker::ErrorCode Linker::extractFiles(const LinkerConfig& pConfig) {
@@ -102,12 +108,14 @@ enum Linker::ErrorCode Linker::config(const LinkerConfig& pConfig) {
 
   extractFiles(pConfig);
 
+  mContext = new mcld::LinkContext();
+
   mModule = new mcld::Module(
                    const_cast<mcld::LinkerScript&>(*pConfig.getLDScript()));
 
-  mBuilder = new mcld::IRBuilder(*mModule, *mLDConfig);
+  mBuilder = new mcld::IRBuilder(*mModule, *mLDConfig, *mContext);
 
-  mLinker = new mcld::Linker();
+  mLinker = new mcld::Linker(*mContext);
 
   mLinker->emulate(const_cast<mcld::LinkerScript&>(*pConfig.getLDScript()),
                    const_cast<mcld::LinkerConfig&>(*mLDConfig));
@@ -139,6 +147,7 @@ enum Linker::ErrorCode Linker::addObject(void* pMemory, size_t pSize) {
 }
 
 enum Linker::ErrorCode Linker::addCode(void* pMemory, size_t pSize) {
+  mcld::LinkContext::Scope scope(*mContext);
   mcld::Input* input = mBuilder->CreateInput("NAN", "NAN", mcld::Input::Object);
   mcld::LDSection* sect = mBuilder->CreateELFHeader(*input, ".text",
                                 llvm::ELF::SHT_PROGBITS,
@@ -31,6 +31,8 @@ public:
 
 private:
   bool& m_GCSections;
+  bool& m_LazyDynObjSymbols;
+  bool& m_MapWholeInputs;
   llvm::cl::opt<ICF>& m_ICF;
   llvm::cl::list<std::string>& m_Plugin;
   llvm::cl::list<std::string>& m_PluginOpt;
@@ -37,7 +37,11 @@ private:
   llvm::cl::opt<int>&   m_MaxWarnNum;
   llvm::cl::opt<Color>& m_Color;
   llvm::cl::opt<bool>&  m_PrintMap;
+  llvm::cl::opt<bool>&  m_PrintStats;
   bool& m_FatalWarnings;
+  llvm::cl::opt<bool>&  m_Threads;
+  llvm::cl::opt<bool>&  m_NoThreads;
+  llvm::cl::opt<unsigned int>& m_ThreadCount;
 };
 
 } // namespace of mcld
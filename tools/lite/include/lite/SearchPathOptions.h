@@ -32,6 +32,9 @@ private:
   llvm::cl::list<std::string,
                bool,
                llvm::cl::SearchDirParser>& m_SearchDirList;
+  llvm::cl::opt<mcld::sys::fs::Path,
+              false,
+              llvm::cl::parser<mcld::sys::fs::Path> >& m_LibraryIndexCache;
   llvm::cl::opt<bool>& m_NoStdlib;
   llvm::cl::list<std::string,
                bool,
@@ -13,7 +13,6 @@
 
 namespace {
 
-// Not supported yet
 bool ArgGCSections;
 
 llvm::cl::opt<bool, true> ArgGCSectionsFlag("gc-sections",
@@ -28,6 +27,34 @@ llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoGCSectionsFlag("no-gc-sect
   llvm::cl::desc("disable garbage collection of unused input sections."),
   llvm::cl::init(false));
 
+bool ArgLazyDynObjSymbols;
+
+llvm::cl::opt<bool, true> ArgLazyDynObjSymbolsFlag("lazy-dso-symbols",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::location(ArgLazyDynObjSymbols),
+  llvm::cl::desc("Read the symbols of shared objects only when they are referred."),
+  llvm::cl::init(false));
+
+llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoLazyDynObjSymbolsFlag("no-lazy-dso-symbols",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::location(ArgLazyDynObjSymbols),
+  llvm::cl::desc("Read all symbols of shared objects."),
+  llvm::cl::init(false));
+
+bool ArgMapWholeInputs;
+
+llvm::cl::opt<bool, true> ArgMapWholeInputsFlag("map-whole-inputs",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::location(ArgMapWholeInputs),
+  llvm::cl::desc("Map each read-only input file at once."),
+  llvm::cl::init(false));
+
+llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoMapWholeInputsFlag("no-map-whole-inputs",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::location(ArgMapWholeInputs),
+  llvm::cl::desc("Map or read the input files piece by piece."),
+  llvm::cl::init(false));
+
 llvm::cl::opt<mcld::OptimizationOptions::ICF> ArgICF("icf",
   llvm::cl::ZeroOrMore,
   llvm::cl::desc("Identical Code Folding"),
@@ -58,6 +85,8 @@ using namespace mcld;
 //===----------------------------------------------------------------------===//
 OptimizationOptions::OptimizationOptions()
   : m_GCSections(ArgGCSections),
+    m_LazyDynObjSymbols(ArgLazyDynObjSymbols),
+    m_MapWholeInputs(ArgMapWholeInputs),
     m_ICF(ArgICF),
     m_Plugin(ArgPlugin),
     m_PluginOpt(ArgPluginOpt) {
@@ -66,18 +95,25 @@ OptimizationOptions::OptimizationOptions()
 bool OptimizationOptions::parse(LinkerConfig& pConfig)
 {
   // set --gc-sections
-  if (m_GCSections) {
-    warning(mcld::diag::warn_unsupported_option) << ArgGCSectionsFlag.ArgStr;
-  }
+  pConfig.options().setGCSections(m_GCSections);
+
+  // set --lazy-dso-symbols
+  pConfig.options().setLazyDynObjSymbols(m_LazyDynObjSymbols);
+
+  // set --map-whole-inputs
+  pConfig.options().setMapWholeInputs(m_MapWholeInputs);
 
   // set --icf [mode]
   switch (m_ICF) {
-    case ICF_None:
-      break;
     case ICF_All:
+      pConfig.options().setICFMode(GeneralOptions::ICF_All);
+      break;
     case ICF_Safe:
+      pConfig.options().setICFMode(GeneralOptions::ICF_Safe);
+      break;
+    case ICF_None:
     default:
-      warning(mcld::diag::warn_unsupported_option) << m_ICF.ArgStr;
+      pConfig.options().setICFMode(GeneralOptions::ICF_None);
       break;
   }
 
@@ -147,6 +147,11 @@ llvm::cl::opt<mcld::GeneralOptions::HashStyle> ArgHashStyle("hash-style",
                  "both the classic ELF and new style GNU hash tables"),
        clEnumValEnd));
 
+llvm::cl::opt<std::string> ArgBuildID("build-id",
+  llvm::cl::desc("Request creation of \".note.gnu.build-id\" ELF note section."),
+  llvm::cl::value_desc("style"),
+  llvm::cl::ValueOptional);
+
 // Not supported yet {
 llvm::cl::opt<bool> ArgExportDynamic("export-dynamic",
   llvm::cl::desc("Export all dynamic symbols"),
@@ -156,11 +161,6 @@ llvm::cl::alias ArgExportDynamicAlias("E",
   llvm::cl::desc("alias for --export-dynamic"),
   llvm::cl::aliasopt(ArgExportDynamic));
 
-llvm::cl::opt<std::string> ArgBuildID("build-id",
-  llvm::cl::desc("Request creation of \".note.gnu.build-id\" ELF note section."),
-  llvm::cl::value_desc("style"),
-  llvm::cl::ValueOptional);
-
 llvm::cl::list<std::string> ArgExcludeLIBS("exclude-libs",
   llvm::cl::CommaSeparated,
   llvm::cl::desc("Exclude libraries from automatic export"),
@@ -222,7 +222,14 @@ bool OutputFormatOptions::parse(mcld::Module& pModule, LinkerConfig& pConfig)
   pConfig.options().setOMagic(m_OMagic);
   pConfig.options().setHashStyle(m_HashStyle);
   pConfig.options().setExportDynamic(m_ExportDynamic);
-  // build-id
+
+  // --build-id[=style]
+  if (m_BuildID.getNumOccurrences() &&
+      !pConfig.options().setBuildID(m_BuildID)) {
+    mcld::error(mcld::diag::err_invalid_build_id) << m_BuildID;
+    return false;
+  }
+
   // exclude-libs
 
   return true;
@@ -11,6 +11,7 @@
 #include <mcld/Config/Config.h>
 #include <mcld/Support/CommandLine.h>
 #include <mcld/Support/raw_ostream.h>
+#include <mcld/Support/SystemUtils.h>
 #include <llvm/Support/Process.h>
 
 #if defined(HAVE_UNISTD_H)
@@ -77,6 +78,10 @@ llvm::cl::alias ArgPrintMapAlias("print-map",
   llvm::cl::desc("alias for -M"),
   llvm::cl::aliasopt(ArgPrintMap));
 
+llvm::cl::opt<bool> ArgPrintStats("stats",
+  llvm::cl::desc("Print the time spent on writing each output section."),
+  llvm::cl::init(false));
+
 bool ArgFatalWarnings;
 
 llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoFatalWarnings("no-fatal-warnings",
@@ -91,6 +96,21 @@ llvm::cl::opt<bool, true> ArgFatalWarningsFlag("fatal-warnings",
   llvm::cl::init(false),
   llvm::cl::ValueDisallowed);
 
+llvm::cl::opt<bool> ArgThreads("threads",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::desc("Run the linker multi-threaded"),
+  llvm::cl::init(false));
+
+llvm::cl::opt<bool> ArgNoThreads("no-threads",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::desc("Run the linker single-threaded"),
+  llvm::cl::init(false));
+
+llvm::cl::opt<unsigned int> ArgThreadCount("thread-count",
+  llvm::cl::desc("Number of threads to use (default: number of CPUs)"),
+  llvm::cl::value_desc("count"),
+  llvm::cl::init(0));
+
 llvm::cl::opt<bool> ArgUseGold("use-gold",
   llvm::cl::desc("GCC/collect2 compatibility: uses ld.gold.  Ignored"),
   llvm::cl::init(false));
@@ -127,7 +147,11 @@ PreferenceOptions::PreferenceOptions()
     m_MaxWarnNum(ArgMaxWarnNum),
     m_Color(ArgColor),
     m_PrintMap(ArgPrintMap),
-    m_FatalWarnings(ArgFatalWarnings) {
+    m_PrintStats(ArgPrintStats),
+    m_FatalWarnings(ArgFatalWarnings),
+    m_Threads(ArgThreads),
+    m_NoThreads(ArgNoThreads),
+    m_ThreadCount(ArgThreadCount) {
 }
 
 bool PreferenceOptions::parse(LinkerConfig& pConfig)
@@ -159,6 +183,17 @@ bool PreferenceOptions::parse(LinkerConfig& pConfig)
     break;
   }
 
+  // set --stats
+  pConfig.options().setPrintStats(m_PrintStats);
+
+  // set --threads, --no-threads, --thread-count=N
+  if (!m_NoThreads) {
+    if (0 != m_ThreadCount)
+      pConfig.options().setNumOfThreads(m_ThreadCount);
+    else if (m_Threads)
+      pConfig.options().setNumOfThreads(mcld::sys::GetNumOfCPUs());
+  }
+
   mcld::outs().setColor(pConfig.options().color());
   mcld::errs().setColor(pConfig.options().color());
 
@@ -32,6 +32,13 @@ llvm::cl::alias ArgSearchDirListAlias("library-path",
   llvm::cl::desc("alias for -L"),
   llvm::cl::aliasopt(ArgSearchDirList));
 
+llvm::cl::opt<mcld::sys::fs::Path,
+              false,
+              llvm::cl::parser<mcld::sys::fs::Path> >
+ArgLibraryIndexCache("library-index-cache",
+  llvm::cl::desc("Cache the search directory listings in [file]"),
+  llvm::cl::value_desc("file"));
+
 llvm::cl::opt<bool> ArgNoStdlib("nostdlib",
   llvm::cl::desc("Only search lib dirs explicitly specified on cmdline"),
   llvm::cl::init(false));
@@ -70,6 +77,7 @@ using namespace mcld;
 SearchPathOptions::SearchPathOptions()
   : m_SysRoot(ArgSysRoot),
     m_SearchDirList(ArgSearchDirList),
+    m_LibraryIndexCache(ArgLibraryIndexCache),
     m_NoStdlib(ArgNoStdlib),
     m_RuntimePath(ArgRuntimePath),
     m_RuntimePathLink(ArgRuntimePathLink),
@@ -96,6 +104,15 @@ bool SearchPathOptions::parse(LinkerConfig& pConfig, LinkerScript& pScript)
     }
   }
 
+  // set --library-index-cache [file]
+  if (!m_LibraryIndexCache.empty()) {
+    if (!pScript.directories().setIndexCache(m_LibraryIndexCache)) {
+      errs() << "WARNING: can not read library index cache `"
+             << m_LibraryIndexCache.native()
+             << "'.\n";
+    }
+  }
+
   // set -no-stdlib
   pConfig.options().setNoStdlib(m_NoStdlib);
 
@@ -23,6 +23,7 @@
 #include <mcld/LinkerScript.h>
 #include <mcld/Linker.h>
 #include <mcld/IRBuilder.h>
+#include <mcld/Support/LinkContext.h>
 #include <mcld/MC/InputAction.h>
 #include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/MsgHandling.h>
@@ -115,10 +116,13 @@ int main(int argc, char* argv[])
   llvm::llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit.
   mcld::Initialize();
 
+  // The context outlives all objects of the link.
+  mcld::LinkContext context;
+  mcld::LinkContext::Scope scope(context);
   mcld::LinkerScript script;
   mcld::LinkerConfig config;
   mcld::Module module(script);
-  mcld::IRBuilder builder(module, config);
+  mcld::IRBuilder builder(module, config, context);
   std::vector<mcld::InputAction*> input_actions;
 
   if (!ConfigLinker(argc, argv, "MCLinker\n", module, script, config, builder,
@@ -128,7 +132,7 @@ int main(int argc, char* argv[])
     return 1;
   }
 
-  mcld::Linker linker;
+  mcld::Linker linker(context);
   if (!linker.emulate(script, config)) {
     mcld::errs() << argv[0]
                  << ": failed to emulate target!\n";
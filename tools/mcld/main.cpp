@@ -295,6 +295,11 @@ ArgSearchDirListAlias("library-path",
                       cl::desc("alias for -L"),
                       cl::aliasopt(ArgSearchDirList));
 
+static cl::opt<mcld::sys::fs::Path, false, llvm::cl::parser<mcld::sys::fs::Path> >
+ArgLibraryIndexCache("library-index-cache",
+                     cl::desc("Keep the listings of the search directories in the file and reuse them in the later links."),
+                     cl::value_desc("file"));
+
 static cl::opt<bool>
 ArgTrace("t",
          cl::desc("Print the names of the input files as ld processes them."));
@@ -528,9 +533,6 @@ ArgGPSize("G",
           cl::desc("Set the maximum size of objects to be optimized using GP"),
           cl::init(8));
 
-/// @{
-/// @name FIXME: begin of unsupported options
-/// @}
 static cl::opt<bool>
 ArgGCSections("gc-sections",
               cl::ZeroOrMore,
@@ -543,6 +545,30 @@ ArgNoGCSections("no-gc-sections",
                 cl::desc("disable garbage collection of unused input sections."),
                 cl::init(false));
 
+static cl::opt<bool>
+ArgLazyDynObjSymbols("lazy-dso-symbols",
+                     cl::ZeroOrMore,
+                     cl::desc("Read the symbols of shared objects only when they are referred."),
+                     cl::init(false));
+
+static cl::opt<bool>
+ArgNoLazyDynObjSymbols("no-lazy-dso-symbols",
+                       cl::ZeroOrMore,
+                       cl::desc("Read all symbols of shared objects."),
+                       cl::init(false));
+
+static cl::opt<bool>
+ArgMapWholeInputs("map-whole-inputs",
+                  cl::ZeroOrMore,
+                  cl::desc("Map each read-only input file at once."),
+                  cl::init(false));
+
+static cl::opt<bool>
+ArgNoMapWholeInputs("no-map-whole-inputs",
+                    cl::ZeroOrMore,
+                    cl::desc("Map or read the input files piece by piece."),
+                    cl::init(false));
+
 namespace icf {
 enum Mode {
   None,
@@ -565,6 +591,10 @@ ArgICF("icf",
            "Folds ctors, dtors and functions whose pointers are definitely not taken."),
          clEnumValEnd));
 
+/// @{
+/// @name FIXME: begin of unsupported options
+/// @}
+
 // FIXME: add this to target options?
 static cl::opt<bool>
 ArgFIXCA8("fix-cortex-a8",
@@ -747,6 +777,29 @@ ArgPrintMapAlias("print-map",
                  cl::desc("alias for -M"),
                  cl::aliasopt(ArgPrintMap));
 
+static cl::opt<bool>
+ArgPrintStats("stats",
+              cl::desc("Print the time spent on writing each output section."),
+              cl::init(false));
+
+static cl::opt<bool>
+ArgThreads("threads",
+           cl::ZeroOrMore,
+           cl::desc("Run the linker multi-threaded"),
+           cl::init(false));
+
+static cl::opt<bool>
+ArgNoThreads("no-threads",
+             cl::ZeroOrMore,
+             cl::desc("Run the linker single-threaded"),
+             cl::init(false));
+
+static cl::opt<unsigned int>
+ArgThreadCount("thread-count",
+               cl::desc("Number of threads to use (default: number of CPUs)"),
+               cl::value_desc("count"),
+               cl::init(0));
+
 static bool ArgFatalWarnings;
 
 static cl::opt<bool, true, cl::FalseParser>
@@ -1123,6 +1176,15 @@ static bool ProcessLinkerOptionsFromCommand(mcld::LinkerScript& pScript,
     }
   }
 
+  // --library-index-cache
+  if (!ArgLibraryIndexCache.empty()) {
+    if (!pScript.directories().setIndexCache(ArgLibraryIndexCache)) {
+      errs() << "WARNING: can not read library index cache `"
+             << ArgLibraryIndexCache.native()
+             << "'.\n";
+    }
+  }
+
   pConfig.options().setPIE(ArgPIE);
   pConfig.options().setTrace(ArgTrace);
   pConfig.options().setVerbose(ArgVerbose);
@@ -1144,8 +1206,28 @@ static bool ProcessLinkerOptionsFromCommand(mcld::LinkerScript& pScript,
   pConfig.options().setHashStyle(ArgHashStyle);
   pConfig.options().setNoStdlib(ArgNoStdlib);
   pConfig.options().setPrintMap(ArgPrintMap);
+  pConfig.options().setPrintStats(ArgPrintStats);
   pConfig.options().setGPSize(ArgGPSize);
 
+  // --gc-sections, --no-gc-sections
+  pConfig.options().setGCSections(ArgGCSections && !ArgNoGCSections);
+
+  // --lazy-dso-symbols, --no-lazy-dso-symbols
+  pConfig.options().setLazyDynObjSymbols(ArgLazyDynObjSymbols &&
+                                         !ArgNoLazyDynObjSymbols);
+
+  // --map-whole-inputs, --no-map-whole-inputs
+  pConfig.options().setMapWholeInputs(ArgMapWholeInputs &&
+                                      !ArgNoMapWholeInputs);
+
+  // --threads, --no-threads, --thread-count=N
+  if (!ArgNoThreads) {
+    if (0 != ArgThreadCount)
+      pConfig.options().setNumOfThreads(ArgThreadCount);
+    else if (ArgThreads)
+      pConfig.options().setNumOfThreads(mcld::sys::GetNumOfCPUs());
+  }
+
   if (ArgStripAll)
     pConfig.options().setStripSymbols(mcld::GeneralOptions::StripAllSymbols);
   else if (ArgDiscardAll)
@@ -1216,21 +1298,27 @@ static bool ProcessLinkerOptionsFromCommand(mcld::LinkerScript& pScript,
     pConfig.options().addZOption(*zOpt);
   }
 
-  if (ArgGCSections) {
-    mcld::warning(mcld::diag::warn_unsupported_option) << ArgGCSections.ArgStr;
-  }
-
   // set up icf mode
   switch (ArgICF) {
-    case icf::None:
-      break;
     case icf::All:
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICF_All);
+      break;
     case icf::Safe:
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICF_Safe);
+      break;
+    case icf::None:
     default:
-      mcld::warning(mcld::diag::warn_unsupported_option) << ArgICF.ArgStr;
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICF_None);
       break;
   }
 
+  // --build-id[=style]
+  if (ArgBuildID.getNumOccurrences() &&
+      !pConfig.options().setBuildID(ArgBuildID)) {
+    mcld::error(mcld::diag::err_invalid_build_id) << ArgBuildID;
+    return false;
+  }
+
   if (ArgFIXCA8) {
     mcld::warning(mcld::diag::warn_unsupported_option) << ArgFIXCA8.ArgStr;
   }
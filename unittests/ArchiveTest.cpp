@@ -0,0 +1,169 @@
+//===- ArchiveTest.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/IRBuilder.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/LinkerScript.h>
+#include <mcld/Module.h>
+#include <mcld/TargetOptions.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/Archive.h>
+#include <mcld/LD/ELFObjectReader.h>
+#include <mcld/LD/GNUArchiveReader.h>
+#include <mcld/LD/NamePool.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/MC/Input.h>
+#include <mcld/MC/InputBuilder.h>
+#include <mcld/Support/Path.h>
+#include <../lib/Target/X86/X86LDBackend.h>
+#include <../lib/Target/X86/X86GNUInfo.h>
+
+#include "ArchiveTest.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ArchiveTest::ArchiveTest()
+{
+  m_pConfig = new LinkerConfig("x86_64-linux-gnueabi");
+  m_pBuilder = new InputBuilder(*m_pConfig);
+  m_pInput = m_pBuilder->createInput("libsynthetic.a",
+                                     sys::fs::Path("libsynthetic.a"),
+                                     Input::Archive);
+  m_pNamePool = new NamePool(1024);
+  m_pTestee = new Archive(*m_pInput, *m_pBuilder);
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ArchiveTest::~ArchiveTest()
+{
+  delete m_pTestee;
+  delete m_pNamePool;
+  delete m_pBuilder;
+  delete m_pConfig;
+}
+
+// SetUp() will be called immediately before each test.
+void ArchiveTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void ArchiveTest::TearDown()
+{
+}
+
+static void insertUndef(NamePool& pPool, const char* pName)
+{
+  Resolver::Result result;
+  pPool.insertSymbol(pName, false, ResolveInfo::NoType, ResolveInfo::Undefined,
+                     ResolveInfo::Global, 0, 0, ResolveInfo::Default, NULL,
+                     result);
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( ArchiveTest, find_symbol ) {
+  m_pTestee->addSymbol("foo", 8);
+  m_pTestee->addSymbol("bar", 8);
+  m_pTestee->addSymbol("foo", 64);
+  m_pTestee->addSymbol("foo", 128);
+
+  size_t idx = m_pTestee->findSymbol("foo");
+  ASSERT_EQ(0, idx);
+  idx = m_pTestee->getNextSymbol(idx);
+  ASSERT_EQ(2, idx);
+  ASSERT_EQ(64, m_pTestee->getObjFileOffset(idx));
+  idx = m_pTestee->getNextSymbol(idx);
+  ASSERT_EQ(3, idx);
+  ASSERT_EQ(m_pTestee->numOfSymbols(), m_pTestee->getNextSymbol(idx));
+
+  ASSERT_EQ(1, m_pTestee->findSymbol("bar"));
+  ASSERT_EQ(m_pTestee->numOfSymbols(), m_pTestee->getNextSymbol(1));
+  ASSERT_EQ(m_pTestee->numOfSymbols(), m_pTestee->findSymbol("baz"));
+}
+
+TEST_F( ArchiveTest, undef_worklist ) {
+  insertUndef(*m_pNamePool, "foo");
+  insertUndef(*m_pNamePool, "foo");
+  ASSERT_EQ(1, m_pNamePool->undefs().size());
+
+  // a weak reference alone does not pull members in
+  Resolver::Result result;
+  m_pNamePool->insertSymbol("bar", false, ResolveInfo::NoType,
+                            ResolveInfo::Undefined, ResolveInfo::Weak, 0, 0,
+                            ResolveInfo::Default, NULL, result);
+  ASSERT_EQ(1, m_pNamePool->undefs().size());
+
+  // but a later strong reference to it does
+  insertUndef(*m_pNamePool, "bar");
+  ASSERT_EQ(2, m_pNamePool->undefs().size());
+  ASSERT_TRUE(m_pNamePool->findInfo("bar") == m_pNamePool->undefs()[1]);
+}
+
+/// test_archive_x86_64.a holds d.o, c.o, b.o and a.o in this order. a calls
+/// b, b calls c, and nothing refers to d. Every member that a pulls in is
+/// placed before its referrer, so a single pass over the armap finds only a.
+TEST_F( ArchiveTest, read_archive_worklist ) {
+  LinkerConfig config("x86_64-linux-gnueabi");
+  config.targets().setEndian(TargetOptions::Little);
+  config.targets().setBitClass(64);
+  Relocation::SetUp(config);
+
+  LinkerScript script;
+  Module module(script);
+  IRBuilder builder(module, config);
+  X86_64GNULDBackend backend(config,
+                             new X86_64GNUInfo(config.targets().triple()));
+  ELFObjectReader obj_reader(backend, builder, config);
+  GNUArchiveReader reader(module, obj_reader);
+
+  sys::fs::Path path(TOPDIR);
+  path.append("unittests/test_archive_x86_64.a");
+  Input* input = builder.ReadInput("test_archive_x86_64", path);
+  ASSERT_TRUE(NULL != input);
+  bool do_continue = false;
+  ASSERT_TRUE(reader.isMyFormat(*input, do_continue));
+  input->setType(Input::Archive);
+
+  builder.AddSymbol<IRBuilder::Force, IRBuilder::Resolve>(
+                                  "a", ResolveInfo::NoType,
+                                  ResolveInfo::Undefined, ResolveInfo::Global);
+
+  Archive archive(*input, builder.getInputBuilder());
+  ASSERT_TRUE(reader.readArchive(config, archive));
+
+  // the worklist follows a -> b -> c within one visit
+  ASSERT_EQ(3, archive.numOfObjectMember());
+  ASSERT_EQ(3, module.getObjectList().size());
+  ASSERT_TRUE("a.o" == module.getObjectList()[0]->name());
+  ASSERT_TRUE("b.o" == module.getObjectList()[1]->name());
+  ASSERT_TRUE("c.o" == module.getObjectList()[2]->name());
+  ASSERT_FALSE(module.getNamePool().findInfo("c")->isUndef());
+
+  size_t d_idx = archive.findSymbol("d");
+  ASSERT_TRUE(d_idx < archive.numOfSymbols());
+  ASSERT_TRUE(Archive::Symbol::Unknown == archive.getSymbolStatus(d_idx));
+  ASSERT_EQ(module.getNamePool().undefs().size(), archive.getUndefCursor());
+
+  // a later visit looks up only the new undefined symbols
+  builder.AddSymbol<IRBuilder::Force, IRBuilder::Resolve>(
+                                  "d", ResolveInfo::NoType,
+                                  ResolveInfo::Undefined, ResolveInfo::Global);
+  ASSERT_TRUE(reader.readArchive(config, archive));
+  ASSERT_EQ(4, archive.numOfObjectMember());
+  ASSERT_TRUE("d.o" == module.getObjectList()[3]->name());
+  ASSERT_TRUE(Archive::Symbol::Include == archive.getSymbolStatus(d_idx));
+
+  // and a visit without any new undefined symbol includes nothing
+  ASSERT_TRUE(reader.readArchive(config, archive));
+  ASSERT_EQ(4, module.getObjectList().size());
+}
+
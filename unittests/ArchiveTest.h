@@ -0,0 +1,59 @@
+//===- ArchiveTest.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ARCHIVE_TEST_H
+#define MCLD_ARCHIVE_TEST_H
+
+#include <gtest.h>
+
+namespace mcld
+{
+class Archive;
+class Input;
+class InputBuilder;
+class LinkerConfig;
+class NamePool;
+
+} // namespace for mcld
+
+namespace mcldtest
+{
+
+/** \class ArchiveTest
+ *  \brief The testcases of the archive symbol index and the undefined symbol
+ *  worklist.
+ *
+ *  \see Archive
+ */
+class ArchiveTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  ArchiveTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ArchiveTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+protected:
+  mcld::LinkerConfig* m_pConfig;
+  mcld::InputBuilder* m_pBuilder;
+  mcld::Input* m_pInput;
+  mcld::NamePool* m_pNamePool;
+  mcld::Archive* m_pTestee;
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -0,0 +1,139 @@
+//===- BuildIDTest.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LinkerConfig.h>
+#include <mcld/TargetOptions.h>
+#include <mcld/LD/BuildID.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <llvm/Support/ELF.h>
+#include "BuildIDTest.h"
+
+#include <cstring>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// the offset of the note in the output file image
+static const size_t NoteOffset = 64;
+
+// the note header before the descriptor: namesz, descsz, type and "GNU"
+static const size_t NoteHeaderSize = 16;
+
+// Constructor can do set-up work for all test here.
+BuildIDTest::BuildIDTest()
+{
+  m_pConfig = new LinkerConfig("x86_64-linux-gnueabi");
+  m_pSection = LDSection::Create(".note.gnu.build-id", LDFileFormat::Note,
+                                 llvm::ELF::SHT_NOTE, llvm::ELF::SHF_ALLOC);
+  m_pSection->setOffset(NoteOffset);
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+BuildIDTest::~BuildIDTest()
+{
+  LDSection::Destroy(m_pSection);
+  delete m_pConfig;
+}
+
+// SetUp() will be called immediately before each test.
+void BuildIDTest::SetUp()
+{
+  m_pConfig->targets().setEndian(TargetOptions::Little);
+}
+
+// TearDown() will be called immediately after each test.
+void BuildIDTest::TearDown()
+{
+}
+
+void BuildIDTest::emit(unsigned int pNumOfThreads)
+{
+  BuildID build_id(*m_pSection, *m_pConfig);
+  build_id.sizeOutput();
+
+  // the rest of the file is some arbitrary content
+  m_File.resize(NoteOffset + m_pSection->size() + 4096);
+  for (size_t i = 0; i < m_File.size(); ++i)
+    m_File[i] = static_cast<uint8_t>(i * 7);
+  build_id.emit(&m_File[0], m_File.size(), pNumOfThreads);
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( BuildIDTest, hex_little_endian ) {
+  ASSERT_TRUE(m_pConfig->options().setBuildID("0x0123456789ABCDEF"));
+  emit();
+
+  ASSERT_TRUE(24 == m_pSection->size());
+  const uint8_t expect[] = {
+    0x04, 0x00, 0x00, 0x00,  // namesz
+    0x08, 0x00, 0x00, 0x00,  // descsz
+    0x03, 0x00, 0x00, 0x00,  // NT_GNU_BUILD_ID
+    'G',  'N',  'U',  0x00,
+    0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef
+  };
+  ASSERT_TRUE(0 == memcmp(expect, &m_File[NoteOffset], sizeof(expect)));
+}
+
+TEST_F( BuildIDTest, hex_big_endian ) {
+  m_pConfig->targets().setEndian(TargetOptions::Big);
+  ASSERT_TRUE(m_pConfig->options().setBuildID("0x0a0b0c"));
+  emit();
+
+  // the descriptor is padded to 4 bytes
+  ASSERT_TRUE(20 == m_pSection->size());
+  const uint8_t expect[] = {
+    0x00, 0x00, 0x00, 0x04,  // namesz
+    0x00, 0x00, 0x00, 0x03,  // descsz
+    0x00, 0x00, 0x00, 0x03,  // NT_GNU_BUILD_ID
+    'G',  'N',  'U',  0x00,
+    0x0a, 0x0b, 0x0c, 0x00
+  };
+  ASSERT_TRUE(0 == memcmp(expect, &m_File[NoteOffset], sizeof(expect)));
+}
+
+TEST_F( BuildIDTest, invalid_hex ) {
+  ASSERT_FALSE(m_pConfig->options().setBuildID("0x"));
+  ASSERT_FALSE(m_pConfig->options().setBuildID("0x123"));
+  ASSERT_FALSE(m_pConfig->options().setBuildID("0x12zz"));
+}
+
+TEST_F( BuildIDTest, uuid ) {
+  ASSERT_TRUE(m_pConfig->options().setBuildID("uuid"));
+  emit();
+
+  ASSERT_TRUE(NoteHeaderSize + 16 == m_pSection->size());
+  const uint8_t* note = &m_File[NoteOffset];
+  ASSERT_TRUE(16 == note[4]);
+  ASSERT_TRUE(3 == note[8]);
+
+  // RFC 4122 version 4, variant 1
+  const uint8_t* desc = note + NoteHeaderSize;
+  ASSERT_TRUE(0x40 == (desc[6] & 0xf0));
+  ASSERT_TRUE(0x80 == (desc[8] & 0xc0));
+}
+
+TEST_F( BuildIDTest, tree_hash ) {
+  ASSERT_TRUE(m_pConfig->options().setBuildID("sha1"));
+  emit(1);
+  ASSERT_TRUE(NoteHeaderSize + 20 == m_pSection->size());
+  ASSERT_TRUE(20 == m_File[NoteOffset + 4]);
+  std::vector<uint8_t> first(m_File);
+
+  // the build-id does not depend on the number of threads
+  emit(4);
+  ASSERT_TRUE(first == m_File);
+
+  ASSERT_TRUE(m_pConfig->options().setBuildID("fast"));
+  emit();
+  ASSERT_TRUE(NoteHeaderSize + 8 == m_pSection->size());
+  ASSERT_TRUE(8 == m_File[NoteOffset + 4]);
+}
+
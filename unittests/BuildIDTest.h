@@ -0,0 +1,59 @@
+//===- BuildIDTest.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_BUILD_ID_TEST_H
+#define MCLD_BUILD_ID_TEST_H
+
+#include <gtest.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld
+{
+class LDSection;
+class LinkerConfig;
+
+} // namespace for mcld
+
+namespace mcldtest
+{
+
+/** \class BuildIDTest
+ *  \brief The testcases of the .note.gnu.build-id writer.
+ *
+ *  \see BuildID
+ */
+class BuildIDTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  BuildIDTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~BuildIDTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+protected:
+  /// emit - size the note and write it into m_File
+  void emit(unsigned int pNumOfThreads = 1);
+
+protected:
+  mcld::LinkerConfig* m_pConfig;
+  mcld::LDSection* m_pSection;
+  std::vector<uint8_t> m_File;
+};
+
+} // namespace of mcldtest
+
+#endif
+
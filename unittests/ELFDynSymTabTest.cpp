@@ -0,0 +1,384 @@
+//===- ELFDynSymTabTest.cpp -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LinkerConfig.h>
+#include <mcld/LD/ELFDynSymTab.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/MC/Input.h>
+#include <mcld/MC/InputBuilder.h>
+#include <mcld/Support/Path.h>
+#include <llvm/Support/ELF.h>
+#include "ELFDynSymTabTest.h"
+
+#include <cstring>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+ELFDynSymTabTest::ELFDynSymTabTest()
+  : m_pTable(NULL)
+{
+  m_pConfig = new LinkerConfig("x86_64-linux-gnueabi");
+  m_pBuilder = new InputBuilder(*m_pConfig);
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ELFDynSymTabTest::~ELFDynSymTabTest()
+{
+  delete m_pBuilder;
+  delete m_pConfig;
+}
+
+// SetUp() will be called immediately before each test.
+void ELFDynSymTabTest::SetUp()
+{
+  // the null symbol
+  addSymbol("", 0x0, llvm::ELF::STB_LOCAL, llvm::ELF::STT_NOTYPE,
+            llvm::ELF::SHN_UNDEF);
+}
+
+// TearDown() will be called immediately after each test.
+void ELFDynSymTabTest::TearDown()
+{
+  delete m_pTable;
+  m_pTable = NULL;
+  m_Symbols.clear();
+  m_Hash.clear();
+}
+
+size_t ELFDynSymTabTest::addSymbol(const std::string& pName,
+                                   uint64_t pValue,
+                                   uint8_t pBind,
+                                   uint8_t pType,
+                                   uint16_t pShndx,
+                                   uint8_t pVisibility)
+{
+  Symbol sym;
+  sym.name = pName;
+  sym.value = pValue;
+  sym.info = (pBind << 4) | pType;
+  sym.other = pVisibility;
+  sym.shndx = pShndx;
+  m_Symbols.push_back(sym);
+  return m_Symbols.size() - 1;
+}
+
+void ELFDynSymTabTest::buildGNUHash(unsigned int pBitClass,
+                                    uint32_t pNumOfBuckets,
+                                    uint32_t pBloomSize,
+                                    uint32_t pBloomShift)
+{
+  // the header, the bloom filter, the buckets and the chains
+  size_t bloom_words = pBitClass / 32;
+  size_t buckets = 4 + pBloomSize * bloom_words;
+  size_t chains = buckets + pNumOfBuckets;
+  m_Hash.assign(chains + m_Symbols.size() - 1, 0x0);
+  m_Hash[0] = pNumOfBuckets;
+  m_Hash[1] = 1;
+  m_Hash[2] = pBloomSize;
+  m_Hash[3] = pBloomShift;
+
+  for (size_t idx = 1; idx < m_Symbols.size(); ++idx) {
+    uint32_t hash_val = GNUHash(m_Symbols[idx].name);
+    uint32_t bucket = hash_val % pNumOfBuckets;
+
+    size_t bloom_idx = (hash_val / pBitClass) % pBloomSize;
+    uint32_t bits[2] = { hash_val % pBitClass,
+                         (hash_val >> pBloomShift) % pBitClass };
+    for (int i = 0; i < 2; ++i)
+      m_Hash[4 + bloom_idx * bloom_words + bits[i] / 32] |= 1u << (bits[i] % 32);
+
+    if (0 == m_Hash[buckets + bucket])
+      m_Hash[buckets + bucket] = idx;
+
+    // the last symbol of a bucket has the lowest bit set
+    bool last = (m_Symbols.size() == idx + 1 ||
+                 bucket != GNUHash(m_Symbols[idx + 1].name) % pNumOfBuckets);
+    m_Hash[chains + idx - 1] = last ? (hash_val | 0x1) : (hash_val & ~0x1);
+  }
+
+  // every bucket is contiguous
+  for (size_t idx = 1; idx + 1 < m_Symbols.size(); ++idx) {
+    uint32_t bucket = GNUHash(m_Symbols[idx].name) % pNumOfBuckets;
+    uint32_t next = GNUHash(m_Symbols[idx + 1].name) % pNumOfBuckets;
+    ASSERT_TRUE(bucket == next || 0x1 == (m_Hash[chains + idx - 1] & 0x1));
+    ASSERT_TRUE(bucket == next || m_Hash[buckets + next] == idx + 1);
+  }
+}
+
+void ELFDynSymTabTest::buildSysVHash(uint32_t pNumOfBuckets)
+{
+  // the header, the buckets and the chains
+  m_Hash.assign(2 + pNumOfBuckets + m_Symbols.size(), 0x0);
+  m_Hash[0] = pNumOfBuckets;
+  m_Hash[1] = m_Symbols.size();
+  for (size_t idx = 1; idx < m_Symbols.size(); ++idx) {
+    uint32_t bucket = SysVHash(m_Symbols[idx].name) % pNumOfBuckets;
+    m_Hash[2 + pNumOfBuckets + idx] = m_Hash[2 + bucket];
+    m_Hash[2 + bucket] = idx;
+  }
+}
+
+ELFDynSymTab& ELFDynSymTabTest::open(unsigned int pBitClass, bool pGNUHash)
+{
+  std::string strtab(1, '\0');
+  std::vector<uint8_t> symtab;
+  for (size_t idx = 0; idx < m_Symbols.size(); ++idx) {
+    const Symbol& sym = m_Symbols[idx];
+    uint32_t name = sym.name.empty() ? 0 : strtab.size();
+    if (!sym.name.empty()) {
+      strtab += sym.name;
+      strtab += '\0';
+    }
+
+    size_t offset = symtab.size();
+    if (32 == pBitClass) {
+      llvm::ELF::Elf32_Sym entry;
+      std::memset(&entry, 0, sizeof(entry));
+      entry.st_name  = name;
+      entry.st_value = sym.value;
+      entry.st_info  = sym.info;
+      entry.st_other = sym.other;
+      entry.st_shndx = sym.shndx;
+      symtab.resize(offset + sizeof(entry));
+      std::memcpy(&symtab[offset], &entry, sizeof(entry));
+    }
+    else {
+      llvm::ELF::Elf64_Sym entry;
+      std::memset(&entry, 0, sizeof(entry));
+      entry.st_name  = name;
+      entry.st_value = sym.value;
+      entry.st_info  = sym.info;
+      entry.st_other = sym.other;
+      entry.st_shndx = sym.shndx;
+      symtab.resize(offset + sizeof(entry));
+      std::memcpy(&symtab[offset], &entry, sizeof(entry));
+    }
+  }
+
+  delete m_pTable;
+
+  // .dynsym, .dynstr and then the hash table
+  size_t str_offset = symtab.size();
+  size_t hash_offset = (str_offset + strtab.size() + 7) & ~0x7;
+  size_t hash_size = m_Hash.size() * 4;
+  m_File.assign(hash_offset + hash_size, 0x0);
+  std::memcpy(&m_File[0], &symtab[0], symtab.size());
+  std::memcpy(&m_File[str_offset], strtab.data(), strtab.size());
+  std::memcpy(&m_File[hash_offset], &m_Hash[0], hash_size);
+
+  LDSection* dynsym = LDSection::Create(".dynsym", LDFileFormat::NamePool,
+                                        llvm::ELF::SHT_DYNSYM,
+                                        llvm::ELF::SHF_ALLOC);
+  dynsym->setOffset(0x0);
+  dynsym->setSize(symtab.size());
+  LDSection* dynstr = LDSection::Create(".dynstr", LDFileFormat::NamePool,
+                                        llvm::ELF::SHT_STRTAB,
+                                        llvm::ELF::SHF_ALLOC);
+  dynstr->setOffset(str_offset);
+  dynstr->setSize(strtab.size());
+  dynsym->setLink(dynstr);
+  LDSection* hash = LDSection::Create(pGNUHash ? ".gnu.hash" : ".hash",
+                                      LDFileFormat::NamePool,
+                                      pGNUHash ? llvm::ELF::SHT_GNU_HASH :
+                                                 llvm::ELF::SHT_HASH,
+                                      llvm::ELF::SHF_ALLOC);
+  hash->setOffset(hash_offset);
+  hash->setSize(hash_size);
+
+  Input* input = m_pBuilder->createInput("libsynthetic.so",
+                                         sys::fs::Path("libsynthetic.so"),
+                                         Input::DynObj);
+  m_pBuilder->setContext(*input, false);
+  m_pBuilder->setMemory(*input, &m_File[0], m_File.size());
+  input->context()->appendSection(*dynsym);
+  input->context()->appendSection(*dynstr);
+  input->context()->appendSection(*hash);
+
+  m_pTable = new ELFDynSymTab(*input, pBitClass);
+  EXPECT_TRUE(m_pTable->open());
+  EXPECT_TRUE(m_Symbols.size() == m_pTable->numOfSymbols());
+  return *m_pTable;
+}
+
+/// GNUHash - the hash function of .gnu.hash
+uint32_t ELFDynSymTabTest::GNUHash(const llvm::StringRef& pName)
+{
+  uint32_t hash_val = 5381;
+  for (size_t i = 0; i < pName.size(); ++i)
+    hash_val = hash_val * 33 + (unsigned char)pName[i];
+  return hash_val;
+}
+
+/// SysVHash - the hash function of .hash
+uint32_t ELFDynSymTabTest::SysVHash(const llvm::StringRef& pName)
+{
+  uint32_t hash_val = 0;
+  for (size_t i = 0; i < pName.size(); ++i) {
+    hash_val = (hash_val << 4) + (unsigned char)pName[i];
+    uint32_t high = hash_val & 0xF0000000;
+    hash_val ^= high >> 24;
+    hash_val &= ~high;
+  }
+  return hash_val;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( ELFDynSymTabTest, gnu_hash_64 ) {
+  // bucket 0
+  addSymbol("bar", 0x1000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("printf", 0x1010, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("stdout", 0x2000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  // bucket 1
+  addSymbol("foo", 0x1020, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("qux", 0x1030, llvm::ELF::STB_WEAK, llvm::ELF::STT_FUNC);
+  addSymbol("hidden", 0x1040, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC, 1,
+            llvm::ELF::STV_HIDDEN);
+  addSymbol("undef", 0x0, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC,
+            llvm::ELF::SHN_UNDEF);
+  addSymbol("malloc", 0x1050, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  buildGNUHash(64, 2, 2, 6);
+  ELFDynSymTab& table = open(64, true);
+
+  ASSERT_TRUE(1 == table.find("bar"));
+  ASSERT_TRUE(2 == table.find("printf"));
+  ASSERT_TRUE(3 == table.find("stdout"));
+  ASSERT_TRUE(4 == table.find("foo"));
+  ASSERT_TRUE(5 == table.find("qux"));
+  ASSERT_TRUE(0 == table.find("hidden"));
+  ASSERT_TRUE(0 == table.find("undef"));
+  ASSERT_TRUE(table.isUndef(7));
+  ASSERT_TRUE(8 == table.find("malloc"));
+  ASSERT_TRUE(0 == table.find("missing"));
+  ASSERT_TRUE(0 == table.find("mallo"));
+}
+
+TEST_F( ELFDynSymTabTest, gnu_hash_32 ) {
+  addSymbol("bar", 0x1000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("stdout", 0x2000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  addSymbol("foo", 0x1020, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("malloc", 0x1050, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  buildGNUHash(32, 2, 2, 5);
+  ELFDynSymTab& table = open(32, true);
+
+  ASSERT_TRUE(1 == table.find("bar"));
+  ASSERT_TRUE(2 == table.find("stdout"));
+  ASSERT_TRUE(3 == table.find("foo"));
+  ASSERT_TRUE(4 == table.find("malloc"));
+  ASSERT_TRUE(0 == table.find("missing"));
+}
+
+TEST_F( ELFDynSymTabTest, gnu_hash_bloom_reject ) {
+  addSymbol("bar", 0x1000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("foo", 0x1020, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  buildGNUHash(64, 2, 1, 6);
+
+  // clear the first bit of foo, which bar does not use
+  uint32_t bit = GNUHash("foo") % 64;
+  ASSERT_TRUE(bit != GNUHash("bar") % 64);
+  ASSERT_TRUE(bit != (GNUHash("bar") >> 6) % 64);
+  m_Hash[4 + bit / 32] &= ~(1u << (bit % 32));
+  ELFDynSymTab& table = open(64, true);
+
+  // foo is in the chain, but the filter rejects it first
+  ASSERT_TRUE(0 == table.find("foo"));
+  ASSERT_TRUE(1 == table.find("bar"));
+}
+
+TEST_F( ELFDynSymTabTest, gnu_hash_chain_end ) {
+  // bar and baz are in bucket 0, and foo in bucket 1
+  addSymbol("bar", 0x1000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("baz", 0x1010, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("foo", 0x1020, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  buildGNUHash(64, 2, 1, 6);
+  ASSERT_TRUE(2 == open(64, true).find("baz"));
+
+  // end bucket 0 at bar, and move baz to the head of bucket 1
+  size_t buckets = 4 + 2;
+  size_t chains = buckets + 2;
+  m_Hash[chains] |= 0x1;
+  m_Hash[chains + 1] &= ~0x1;
+  m_Hash[buckets + 1] = 2;
+  ELFDynSymTab& table = open(64, true);
+
+  // the walk of bucket 0 stops at the end of the bucket
+  ASSERT_TRUE(0 == table.find("baz"));
+  ASSERT_TRUE(1 == table.find("bar"));
+  // the walk of bucket 1 passes baz
+  ASSERT_TRUE(3 == table.find("foo"));
+}
+
+TEST_F( ELFDynSymTabTest, sysv_hash_chain ) {
+  addSymbol("foo", 0x1000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("dup", 0x0, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC,
+            llvm::ELF::SHN_UNDEF);
+  addSymbol("bar", 0x1010, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("dup", 0x1020, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("hidden", 0x1030, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC, 1,
+            llvm::ELF::STV_HIDDEN);
+  addSymbol("dup", 0x1040, llvm::ELF::STB_WEAK, llvm::ELF::STT_FUNC);
+  addSymbol("baz", 0x1050, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+
+  // a chain goes from the highest index down, through every symbol when there
+  // is only one bucket
+  uint32_t num_buckets[2] = { 1, 3 };
+  for (int i = 0; i < 2; ++i) {
+    buildSysVHash(num_buckets[i]);
+    ELFDynSymTab& table = open(64, false);
+
+    ASSERT_TRUE(1 == table.find("foo"));
+    ASSERT_TRUE(3 == table.find("bar"));
+    ASSERT_TRUE(4 == table.find("dup"));
+    ASSERT_TRUE(0 == table.find("hidden"));
+    ASSERT_TRUE(7 == table.find("baz"));
+    ASSERT_TRUE(0 == table.find("missing"));
+  }
+}
+
+TEST_F( ELFDynSymTabTest, aliases ) {
+  addSymbol("environ", 0x2000, llvm::ELF::STB_WEAK, llvm::ELF::STT_OBJECT);
+  addSymbol("foo", 0x2000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_FUNC);
+  addSymbol("_environ", 0x2000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  addSymbol("__environ", 0x2000, llvm::ELF::STB_GLOBAL,
+            llvm::ELF::STT_OBJECT);
+  addSymbol("stdout", 0x3000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  addSymbol("bar", 0x4000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  addSymbol("baz", 0x4000, llvm::ELF::STB_GLOBAL, llvm::ELF::STT_OBJECT);
+  addSymbol("qux", 0x5000, llvm::ELF::STB_WEAK, llvm::ELF::STT_OBJECT);
+  addSymbol("hidden", 0x2000, llvm::ELF::STB_WEAK, llvm::ELF::STT_OBJECT, 1,
+            llvm::ELF::STV_HIDDEN);
+  buildSysVHash(3);
+  ELFDynSymTab& table = open(64, false);
+
+  // the weak one goes first, and then the strong ones by name
+  std::vector<size_t> aliases;
+  table.getAliases(4, aliases);
+  ASSERT_TRUE(3 == aliases.size());
+  ASSERT_TRUE(1 == aliases[0]);
+  ASSERT_TRUE(4 == aliases[1]);
+  ASSERT_TRUE(3 == aliases[2]);
+
+  aliases.clear();
+  table.getAliases(1, aliases);
+  ASSERT_TRUE(3 == aliases.size());
+  ASSERT_TRUE(1 == aliases[0]);
+
+  // a function, a lone object, strong objects only and a lone weak object
+  size_t others[4] = { 2, 5, 6, 8 };
+  for (int i = 0; i < 4; ++i) {
+    aliases.clear();
+    table.getAliases(others[i], aliases);
+    ASSERT_TRUE(aliases.empty());
+  }
+}
+
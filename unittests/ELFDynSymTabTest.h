@@ -0,0 +1,98 @@
+//===- ELFDynSymTabTest.h -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ELF_DYNSYM_TABLE_TEST_H
+#define MCLD_ELF_DYNSYM_TABLE_TEST_H
+
+#include <gtest.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+#include <string>
+#include <vector>
+
+namespace mcld
+{
+class ELFDynSymTab;
+class InputBuilder;
+class LinkerConfig;
+
+} // namespace for mcld
+
+namespace mcldtest
+{
+
+/** \class ELFDynSymTabTest
+ *  \brief The testcases of the symbol lookup in the hash tables of a shared
+ *  object.
+ *
+ *  \see ELFDynSymTab
+ */
+class ELFDynSymTabTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  ELFDynSymTabTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ELFDynSymTabTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+protected:
+  struct Symbol {
+    std::string name;
+    uint64_t value;
+    uint8_t info;
+    uint8_t other;
+    uint16_t shndx;
+  };
+
+protected:
+  /// addSymbol - append a symbol to .dynsym and return its index
+  size_t addSymbol(const std::string& pName,
+                   uint64_t pValue,
+                   uint8_t pBind,
+                   uint8_t pType,
+                   uint16_t pShndx = 1,
+                   uint8_t pVisibility = 0);
+
+  /// buildGNUHash - build .gnu.hash of all symbols but the null one. The
+  /// symbols must be added in the order of their buckets.
+  void buildGNUHash(unsigned int pBitClass,
+                    uint32_t pNumOfBuckets,
+                    uint32_t pBloomSize,
+                    uint32_t pBloomShift);
+
+  /// buildSysVHash - build .hash of all symbols
+  void buildSysVHash(uint32_t pNumOfBuckets);
+
+  /// open - lay out .dynsym, .dynstr and the hash table in a shared object,
+  /// and open the table of its dynamic symbols
+  mcld::ELFDynSymTab& open(unsigned int pBitClass, bool pGNUHash);
+
+  static uint32_t GNUHash(const llvm::StringRef& pName);
+
+  static uint32_t SysVHash(const llvm::StringRef& pName);
+
+protected:
+  mcld::LinkerConfig* m_pConfig;
+  mcld::InputBuilder* m_pBuilder;
+  mcld::ELFDynSymTab* m_pTable;
+  std::vector<Symbol> m_Symbols;
+  std::vector<uint32_t> m_Hash;
+  std::vector<uint8_t> m_File;
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -0,0 +1,239 @@
+//===- EhFrameHdrTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/IRBuilder.h>
+#include <mcld/LD/EhFrame.h>
+#include <mcld/LD/EhFrameHdr.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/Support/MemoryArea.h>
+#include <mcld/Support/MemoryRegion.h>
+#include <mcld/Support/Space.h>
+#include <llvm/Support/Dwarf.h>
+#include <llvm/Support/ELF.h>
+#include "EhFrameHdrTest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// the sizes of the CIE and the FDEs in .eh_frame
+static const size_t CIESize = 16;
+static const size_t FDESize = 24;
+
+// the PC Begin field follows the length and the CIE pointer of an FDE
+static const uint32_t FDEDataStart = 8;
+
+typedef std::pair<int32_t, uint32_t> TableEntry;
+
+static bool LessKey(const TableEntry& pX, const TableEntry& pY)
+{
+  return pX.first < pY.first;
+}
+
+// Constructor can do set-up work for all test here.
+EhFrameHdrTest::EhFrameHdrTest()
+  : m_EhFrameHdrAddr(0x0), m_pEhFrameHdr(NULL), m_pEhFrame(NULL)
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+EhFrameHdrTest::~EhFrameHdrTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void EhFrameHdrTest::SetUp()
+{
+  m_pEhFrameHdr = LDSection::Create(".eh_frame_hdr", LDFileFormat::EhFrameHdr,
+                                    llvm::ELF::SHT_PROGBITS,
+                                    llvm::ELF::SHF_ALLOC);
+  m_pEhFrame = LDSection::Create(".eh_frame", LDFileFormat::EhFrame,
+                                 llvm::ELF::SHT_PROGBITS,
+                                 llvm::ELF::SHF_ALLOC);
+}
+
+// TearDown() will be called immediately after each test.
+void EhFrameHdrTest::TearDown()
+{
+  LDSection::Destroy(m_pEhFrameHdr);
+  LDSection::Destroy(m_pEhFrame);
+}
+
+void EhFrameHdrTest::emit(unsigned int pBitClass,
+                          uint8_t pEncoding,
+                          const std::vector<uint64_t>& pPCs,
+                          unsigned int pNumOfThreads)
+{
+  // .eh_frame follows .eh_frame_hdr in both the file and the memory
+  size_t hdr_size = 12 + 8 * pPCs.size();
+  size_t offset = (hdr_size + 7) & ~0x7;
+  m_pEhFrameHdr->setOffset(0x0);
+  m_pEhFrameHdr->setAddr(m_EhFrameHdrAddr);
+  m_pEhFrame->setOffset(offset);
+  m_pEhFrame->setAddr(m_EhFrameHdrAddr + offset);
+  m_pEhFrame->setSize(CIESize + FDESize * pPCs.size());
+  m_File.assign(offset + m_pEhFrame->size(), 0x0);
+
+  EhFrame* eh_frame = IRBuilder::CreateEhFrame(*m_pEhFrame);
+  EhFrame::CIE* cie =
+    new EhFrame::CIE(*MemoryRegion::Create(&m_File[offset], CIESize));
+  cie->setFDEEncode(pEncoding);
+  eh_frame->addCIE(*cie);
+
+  size_t pc_size = 4;
+  if (llvm::dwarf::DW_EH_PE_absptr == (pEncoding & 0x7))
+    pc_size = pBitClass / 8;
+  else if (llvm::dwarf::DW_EH_PE_udata8 == (pEncoding & 0x7))
+    pc_size = 8;
+
+  for (size_t idx = 0; idx < pPCs.size(); ++idx) {
+    uint8_t* start = &m_File[offset + CIESize + FDESize * idx];
+    EhFrame::FDE* fde =
+      new EhFrame::FDE(*MemoryRegion::Create(start, FDESize), *cie,
+                       FDEDataStart);
+    eh_frame->addFDE(*fde);
+
+    uint64_t pc = pPCs[idx];
+    if (llvm::dwarf::DW_EH_PE_pcrel == (pEncoding & 0x70))
+      pc -= m_pEhFrame->addr() + fde->getOffset() + FDEDataStart;
+    std::memcpy(start + FDEDataStart, &pc, pc_size);
+  }
+
+  EhFrameHdr eh_frame_hdr(*m_pEhFrameHdr, *m_pEhFrame);
+  eh_frame_hdr.sizeOutput();
+  ASSERT_TRUE(hdr_size == m_pEhFrameHdr->size());
+
+  Space* space = Space::Create(&m_File[0], m_File.size());
+  {
+    MemoryArea area(*space);
+    if (32 == pBitClass)
+      eh_frame_hdr.emitOutput<32>(area, pNumOfThreads);
+    else
+      eh_frame_hdr.emitOutput<64>(area, pNumOfThreads);
+  }
+  Space::Destroy(space);
+}
+
+uint64_t EhFrameHdrTest::fdeAddr(size_t pIdx) const
+{
+  return m_pEhFrame->addr() + CIESize + FDESize * pIdx;
+}
+
+uint32_t EhFrameHdrTest::word(size_t pIdx) const
+{
+  uint32_t result;
+  std::memcpy(&result, &m_File[4 * pIdx], sizeof(result));
+  return result;
+}
+
+void EhFrameHdrTest::checkTable(const std::vector<uint64_t>& pPCs) const
+{
+  ASSERT_TRUE(pPCs.size() == word(2));
+  ASSERT_TRUE(uint32_t(m_pEhFrame->addr() - m_EhFrameHdrAddr - 4) == word(1));
+
+  // the entries are sorted by the signed offsets of the initial locations
+  std::vector<TableEntry> expect;
+  for (size_t idx = 0; idx < pPCs.size(); ++idx) {
+    int32_t key = static_cast<int32_t>(pPCs[idx] - m_EhFrameHdrAddr);
+    uint32_t value = static_cast<uint32_t>(fdeAddr(idx) - m_EhFrameHdrAddr);
+    expect.push_back(std::make_pair(key, value));
+  }
+  std::stable_sort(expect.begin(), expect.end(), LessKey);
+
+  for (size_t idx = 0; idx < expect.size(); ++idx) {
+    ASSERT_TRUE(static_cast<uint32_t>(expect[idx].first) == word(3 + 2 * idx));
+    ASSERT_TRUE(expect[idx].second == word(4 + 2 * idx));
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( EhFrameHdrTest, absptr_32 ) {
+  // the functions around .eh_frame_hdr in no particular order
+  m_EhFrameHdrAddr = 0x08050000;
+  std::vector<uint64_t> pcs;
+  pcs.push_back(0x08051000);
+  pcs.push_back(0x08048000);
+  pcs.push_back(0x08050000);
+  pcs.push_back(0x0804a000);
+  pcs.push_back(0x08060000);
+  pcs.push_back(0x08049000);
+  emit(32, llvm::dwarf::DW_EH_PE_absptr, pcs);
+
+  checkTable(pcs);
+  ASSERT_TRUE(0xffff8000 == word(3));
+  ASSERT_TRUE(0x00010000 == word(13));
+}
+
+TEST_F( EhFrameHdrTest, pcrel_32 ) {
+  m_EhFrameHdrAddr = 0x08050000;
+  std::vector<uint64_t> pcs;
+  pcs.push_back(0x0804c000);
+  pcs.push_back(0x08070000);
+  pcs.push_back(0x08048000);
+  pcs.push_back(0x0804c000);
+  emit(32, llvm::dwarf::DW_EH_PE_pcrel | llvm::dwarf::DW_EH_PE_sdata4, pcs);
+
+  checkTable(pcs);
+  ASSERT_TRUE(0xffff8000 == word(3));
+  // the FDEs of the same function keep their order
+  ASSERT_TRUE(uint32_t(fdeAddr(0) - m_EhFrameHdrAddr) == word(6));
+  ASSERT_TRUE(uint32_t(fdeAddr(3) - m_EhFrameHdrAddr) == word(8));
+}
+
+TEST_F( EhFrameHdrTest, pcrel_64 ) {
+  m_EhFrameHdrAddr = 0x400800;
+  std::vector<uint64_t> pcs;
+  pcs.push_back(0x400400);
+  pcs.push_back(0x401000);
+  pcs.push_back(0x400100);
+  pcs.push_back(0x400800);
+  pcs.push_back(0x400600);
+  emit(64, llvm::dwarf::DW_EH_PE_pcrel | llvm::dwarf::DW_EH_PE_sdata4, pcs);
+
+  checkTable(pcs);
+  ASSERT_TRUE(0xfffff900 == word(3));
+  ASSERT_TRUE(0x00000800 == word(11));
+}
+
+TEST_F( EhFrameHdrTest, absptr_64 ) {
+  // the addresses do not fit in 32 bits, but their distances do
+  m_EhFrameHdrAddr = 0x7f0000400000ULL;
+  std::vector<uint64_t> pcs;
+  pcs.push_back(0x7f0000401000ULL);
+  pcs.push_back(0x7f0000100000ULL);
+  pcs.push_back(0x7f00003ffff0ULL);
+  pcs.push_back(0x7f0000100000ULL);
+  emit(64, llvm::dwarf::DW_EH_PE_absptr, pcs);
+
+  checkTable(pcs);
+  ASSERT_TRUE(0xffd00000 == word(3));
+  ASSERT_TRUE(0xfffffff0 == word(7));
+  ASSERT_TRUE(0x00001000 == word(9));
+}
+
+TEST_F( EhFrameHdrTest, threads ) {
+  // enough FDEs for several decoding and sorting blocks, with duplicates
+  // across the blocks
+  m_EhFrameHdrAddr = 0x400000;
+  std::vector<uint64_t> pcs;
+  uint32_t seed = 1;
+  for (size_t idx = 0; idx < 3 * 4096 + 5; ++idx) {
+    seed = seed * 1103515245 + 12345;
+    pcs.push_back(m_EhFrameHdrAddr - 0x100000 + ((seed >> 8) & 0x1ffff0));
+  }
+  emit(64, llvm::dwarf::DW_EH_PE_pcrel | llvm::dwarf::DW_EH_PE_sdata4, pcs, 4);
+
+  checkTable(pcs);
+}
+
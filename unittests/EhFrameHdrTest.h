@@ -0,0 +1,73 @@
+//===- EhFrameHdrTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_EH_FRAME_HDR_TEST_H
+#define MCLD_EH_FRAME_HDR_TEST_H
+
+#include <gtest.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld
+{
+class LDSection;
+
+} // namespace for mcld
+
+namespace mcldtest
+{
+
+/** \class EhFrameHdrTest
+ *  \brief The testcases of the .eh_frame_hdr binary search table.
+ *
+ *  \see EhFrameHdr
+ */
+class EhFrameHdrTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  EhFrameHdrTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~EhFrameHdrTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+protected:
+  /// emit - emit .eh_frame_hdr for the FDEs of the functions at pPCs. The
+  /// PC Begin fields are in pEncoding.
+  void emit(unsigned int pBitClass,
+            uint8_t pEncoding,
+            const std::vector<uint64_t>& pPCs,
+            unsigned int pNumOfThreads = 1);
+
+  /// fdeAddr - the address of the pIdx-th FDE
+  uint64_t fdeAddr(size_t pIdx) const;
+
+  /// word - the pIdx-th 32-bit word of the emitted .eh_frame_hdr
+  uint32_t word(size_t pIdx) const;
+
+  /// checkTable - the binary search table is sorted by the initial locations
+  /// of pPCs, and the FDEs of the same location keep their order
+  void checkTable(const std::vector<uint64_t>& pPCs) const;
+
+protected:
+  uint64_t m_EhFrameHdrAddr;
+  mcld::LDSection* m_pEhFrameHdr;
+  mcld::LDSection* m_pEhFrame;
+  std::vector<uint8_t> m_File;
+};
+
+} // namespace of mcldtest
+
+#endif
+
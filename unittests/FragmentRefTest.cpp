@@ -10,6 +10,9 @@
 
 #include <mcld/Fragment/FragmentRef.h>
 #include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Fragment/FillFragment.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/SectionData.h>
 #include <mcld/Support/MemoryAreaFactory.h>
 #include <mcld/Support/FileHandle.h>
 #include <mcld/Support/MemoryRegion.h>
@@ -19,6 +22,26 @@ using namespace mcld;
 using namespace mcld::sys::fs;
 using namespace mcldtest;
 
+namespace {
+
+// the reference result: walk through the fragments one by one.
+Fragment* walk(Fragment& pFrag, uint64_t& pOffset)
+{
+  int64_t offset = pOffset;
+  Fragment* frag = &pFrag;
+  while (NULL != frag) {
+    offset -= frag->size();
+    if (offset <= 0)
+      break;
+    frag = frag->getNextNode();
+  }
+  if (NULL != frag)
+    pOffset = offset + frag->size();
+  return frag;
+}
+
+} // anonymous namespace
+
 // Constructor can do set-up work for all test here.
 FragmentRefTest::FragmentRefTest()
 {
@@ -67,3 +90,66 @@ TEST_F( FragmentRefTest, ) {
   delete areaFactory;
 }
 
+TEST_F( FragmentRefTest, offset_index ) {
+  LDSection* sect = LDSection::Create(".test", LDFileFormat::Regular, 0x0, 0x0);
+  SectionData* sd = SectionData::Create(*sect);
+
+  // sizes: 4, 0, 8, 0, 16, ...
+  for (unsigned int i = 0; i < 16; ++i)
+    new FillFragment(0x0, 1, (i % 2) ? 0 : (4u << (i % 6)), sd);
+
+  uint64_t total = 0;
+  for (SectionData::iterator it = sd->begin(); it != sd->end(); ++it)
+    total += it->size();
+
+  for (uint64_t offset = 0; offset <= total + 1; ++offset) {
+    FragmentRef* ref = FragmentRef::Create(sd->front(), offset);
+    uint64_t expect_offset = offset;
+    Fragment* expect = walk(sd->front(), expect_offset);
+    if (NULL == expect) {
+      ASSERT_TRUE(FragmentRef::Null() == ref);
+      continue;
+    }
+    ASSERT_TRUE(expect == ref->frag());
+    ASSERT_TRUE(expect_offset == ref->offset());
+  }
+
+  // start from a fragment in the middle
+  Fragment& middle = *(++(++sd->begin()));
+  FragmentRef* ref = FragmentRef::Create(middle, 20);
+  uint64_t expect_offset = 20;
+  ASSERT_TRUE(walk(middle, expect_offset) == ref->frag());
+  ASSERT_TRUE(expect_offset == ref->offset());
+
+  // inserting a fragment invalidates the index
+  new FillFragment(0x0, 1, 32, sd);
+  ref = FragmentRef::Create(sd->front(), total + 1);
+  ASSERT_TRUE(&sd->back() == ref->frag());
+  ASSERT_TRUE(1 == ref->offset());
+
+  SectionData::Destroy(sd);
+  LDSection::Destroy(sect);
+}
+
+/// 20k fragments in one section, and a FragmentRef for every fragment. The
+/// lookups by the offset index agree with the linear walk.
+TEST_F( FragmentRefTest, offset_index_20k_fragments ) {
+  const unsigned int num_of_frags = 20000;
+  const uint64_t frag_size = 16;
+  LDSection* sect = LDSection::Create(".test", LDFileFormat::Regular, 0x0, 0x0);
+  SectionData* sd = SectionData::Create(*sect);
+  for (unsigned int i = 0; i < num_of_frags; ++i)
+    new FillFragment(0x0, 1, frag_size, sd);
+
+  for (unsigned int i = 0; i < num_of_frags; ++i) {
+    uint64_t offset = i * frag_size + 1;
+    FragmentRef* ref = FragmentRef::Create(*sect, offset);
+    Fragment* expect = walk(sd->front(), offset);
+    ASSERT_TRUE(expect == ref->frag());
+    ASSERT_TRUE(1 == ref->offset());
+    ASSERT_TRUE(1 == offset);
+  }
+
+  SectionData::Destroy(sd);
+  LDSection::Destroy(sect);
+}
@@ -7,7 +7,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <mcld/IRBuilder.h>
+#include <mcld/Fragment/FillFragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
 #include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/LD/SectionData.h>
+#include <llvm/Support/ELF.h>
 #include "LDSymbolTest.h"
 
 using namespace mcld;
@@ -40,3 +48,33 @@ void LDSymbolTest::TearDown()
 TEST_F( LDSymbolTest, produce ) {
 }
 
+TEST_F( LDSymbolTest, symbol_section ) {
+  LDSection* text = LDSection::Create(".text", LDFileFormat::Regular,
+                                      llvm::ELF::SHT_PROGBITS,
+                                      llvm::ELF::SHF_ALLOC |
+                                      llvm::ELF::SHF_EXECINSTR);
+  SectionData* data = IRBuilder::CreateSectionData(*text);
+  FillFragment* frag = new FillFragment(0x0, 1, 0x10, data);
+
+  ResolveInfo* info = ResolveInfo::Create("foo");
+  LDSymbol* symbol = LDSymbol::Create(*info);
+  symbol->setFragmentRef(FragmentRef::Create(*frag, 0x4));
+  ASSERT_TRUE(text == getSymbolSection(*symbol));
+
+  // undefined
+  symbol->setFragmentRef(FragmentRef::Null());
+  ASSERT_TRUE(NULL == getSymbolSection(*symbol));
+
+  // a fragment in no section
+  FillFragment orphan(0x0, 1, 0x10);
+  symbol->setFragmentRef(FragmentRef::Create(orphan, 0x0));
+  ASSERT_TRUE(NULL == getSymbolSection(*symbol));
+
+  // the null symbol refers to a fragment in no section
+  ASSERT_TRUE(LDSymbol::Null()->hasFragRef());
+  ASSERT_TRUE(NULL == getSymbolSection(*LDSymbol::Null()));
+
+  LDSymbol::Destroy(symbol);
+  ResolveInfo::Destroy(info);
+  LDSection::Destroy(text);
+}
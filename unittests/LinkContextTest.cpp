@@ -0,0 +1,107 @@
+//===- LinkContextTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/LinkContext.h>
+#include <mcld/Support/GCFactory.h>
+#include <mcld/Support/ThreadPool.h>
+#include "LinkContextTest.h"
+
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+typedef GCFactory<int, 16> IntFactory;
+
+class ContextTask : public ThreadPool::Task
+{
+public:
+  ContextTask() : m_pContext(NULL) { }
+
+  void run() { m_pContext = LinkContext::GetActive(); }
+
+  LinkContext* context() const { return m_pContext; }
+
+private:
+  LinkContext* m_pContext;
+};
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+LinkContextTest::LinkContextTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+LinkContextTest::~LinkContextTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void LinkContextTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void LinkContextTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(LinkContextTest, nested_scopes) {
+  LinkContext c1, c2;
+  ASSERT_TRUE(NULL == LinkContext::GetActive());
+  ASSERT_TRUE(&LinkContext::Default() == &LinkContext::Current());
+  {
+    LinkContext::Scope s1(c1);
+    ASSERT_TRUE(&c1 == &LinkContext::Current());
+    {
+      LinkContext::Scope s2(c2);
+      ASSERT_TRUE(&c2 == &LinkContext::Current());
+    }
+    ASSERT_TRUE(&c1 == &LinkContext::Current());
+  }
+  ASSERT_TRUE(NULL == LinkContext::GetActive());
+}
+
+TEST_F(LinkContextTest, separate_arenas) {
+  LinkContext c1, c2;
+  IntFactory& f1 = c1.arena<IntFactory>(LinkContext::StrTokenArena);
+  IntFactory& f2 = c2.arena<IntFactory>(LinkContext::StrTokenArena);
+  ASSERT_TRUE(&f1 != &f2);
+  ASSERT_TRUE(&f1 == &c1.arena<IntFactory>(LinkContext::StrTokenArena));
+
+  int* x = f1.allocate();
+  new (x) int(1);
+  ASSERT_TRUE(1 == f1.size());
+  ASSERT_TRUE(0 == f2.size());
+
+  // release all at once, and the arena is created again on the next use
+  c1.release();
+  ASSERT_TRUE(0 == c1.arena<IntFactory>(LinkContext::StrTokenArena).size());
+}
+
+TEST_F(LinkContextTest, thread_pool_inherits_context) {
+  LinkContext context;
+  LinkContext::Scope scope(context);
+
+  std::vector<ContextTask> tasks(8);
+  ThreadPool::TaskList list;
+  for (size_t i = 0; i < tasks.size(); ++i)
+    list.push_back(&tasks[i]);
+
+  ThreadPool pool(4);
+  pool.run(list);
+  for (size_t i = 0; i < tasks.size(); ++i)
+    ASSERT_TRUE(&context == tasks[i].context());
+}
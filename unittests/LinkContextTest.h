@@ -0,0 +1,41 @@
+//===- LinkContextTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LINK_CONTEXT_TEST_H
+#define MCLD_LINK_CONTEXT_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest
+{
+
+/** \class LinkContextTest
+ *  \brief The testcases of LinkContext.
+ *
+ *  \see LinkContext
+ */
+class LinkContextTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  LinkContextTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~LinkContextTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -88,6 +88,31 @@ TEST_F( MemoryAreaTest, write_by_malloc )
 	//delete AreaFactory;;
 }
 
+TEST_F( MemoryAreaTest, read_whole_file )
+{
+	Path path(TOPDIR);
+	path.append("unittests/test3.txt");
+
+	MemoryAreaFactory *AreaFactory = new MemoryAreaFactory(1);
+	MemoryArea* area = AreaFactory->produce(path, FileHandle::ReadOnly);
+	ASSERT_TRUE(area->mapWhole());
+	ASSERT_TRUE(area->isMappedWhole());
+	area->advise(0, area->size(), FileHandle::WillNeed);
+
+	// regions are slices of the same mapping
+	MemoryRegion* first = area->request(0, 2);
+	MemoryRegion* second = area->request(3, 2);
+	ASSERT_FALSE(first->hasParent());
+	ASSERT_TRUE(first->start() + 3 == second->start());
+	ASSERT_EQ('H', first->getBuffer()[0]);
+	ASSERT_EQ('L', second->getBuffer()[0]);
+	ASSERT_EQ('O', second->getBuffer()[1]);
+	area->release(first);
+	area->release(second);
+	AreaFactory->destruct(area);
+	//delete AreaFactory;;
+}
+
 TEST_F( MemoryAreaTest, read_one_page )
 {
         Path path(TOPDIR) ;
@@ -0,0 +1,107 @@
+//===- MergeStringTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/MergeString.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDFileFormat.h>
+#include "MergeStringTest.h"
+
+#include <cstring>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+MergeStringTest::MergeStringTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+MergeStringTest::~MergeStringTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void MergeStringTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void MergeStringTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+static void Merge(MergeString& pMergeString)
+{
+  for (size_t idx = 0; idx < pMergeString.numOfSections(); ++idx)
+    pMergeString.split(idx);
+  for (unsigned int shard = 0; shard < MergeString::NumOfShards; ++shard)
+    pMergeString.dedup(shard);
+  pMergeString.layout();
+}
+
+TEST_F(MergeStringTest, dedup_across_sections) {
+  LDSection* s1 = LDSection::Create(".rodata.str1.1", LDFileFormat::Regular,
+                                    0x0, 0x0);
+  LDSection* s2 = LDSection::Create(".rodata.str1.1", LDFileFormat::Regular,
+                                    0x0, 0x0);
+  const char c1[] = "abc\0def\0abc";
+  const char c2[] = "def\0xyz\0";
+
+  MergeString ms(1, 1);
+  ms.addSection(*s1, llvm::StringRef(c1, sizeof(c1)));
+  ms.addSection(*s2, llvm::StringRef(c2, sizeof(c2)));
+  Merge(ms);
+
+  // "abc", "def" and "xyz" are kept once, and so is the empty string
+  ASSERT_TRUE(13 == ms.size());
+  ASSERT_TRUE(0 == memcmp(ms.data(), "abc\0def\0xyz\0\0", 13));
+
+  ASSERT_TRUE(0 == ms.getOutputOffset(*s1, 0));
+  ASSERT_TRUE(4 == ms.getOutputOffset(*s1, 4));
+  ASSERT_TRUE(0 == ms.getOutputOffset(*s1, 8));
+  // an offset into the middle of a string
+  ASSERT_TRUE(2 == ms.getOutputOffset(*s1, 10));
+  ASSERT_TRUE(4 == ms.getOutputOffset(*s2, 0));
+  ASSERT_TRUE(8 == ms.getOutputOffset(*s2, 4));
+  ASSERT_TRUE(12 == ms.getOutputOffset(*s2, 8));
+
+  ASSERT_TRUE(21 == ms.inputSize());
+
+  LDSection::Destroy(s1);
+  LDSection::Destroy(s2);
+}
+
+TEST_F(MergeStringTest, wide_and_aligned_strings) {
+  LDSection* s1 = LDSection::Create(".rodata.str2.4", LDFileFormat::Regular,
+                                    0x0, 0x0);
+  LDSection* s2 = LDSection::Create(".rodata.str2.4", LDFileFormat::Regular,
+                                    0x0, 0x0);
+  // two-byte strings: "a\0" is not a terminator in the middle of an entry
+  const char c1[] = { 'a', 0, 'b', 0, 0, 0 };
+  const char c2[] = { 'c', 0, 0, 0, 'a', 0, 'b', 0, 0, 0 };
+
+  MergeString ms(2, 4);
+  ms.addSection(*s1, llvm::StringRef(c1, sizeof(c1)));
+  ms.addSection(*s2, llvm::StringRef(c2, sizeof(c2)));
+  Merge(ms);
+
+  // "ab" at 0 and "c" at 8, aligned to 4
+  ASSERT_TRUE(12 == ms.size());
+  ASSERT_TRUE(0 == ms.getOutputOffset(*s1, 0));
+  ASSERT_TRUE(8 == ms.getOutputOffset(*s2, 0));
+  ASSERT_TRUE(0 == ms.getOutputOffset(*s2, 4));
+  ASSERT_TRUE(0 == memcmp(ms.data() + 8, c2, 4));
+
+  LDSection::Destroy(s1);
+  LDSection::Destroy(s2);
+}
+
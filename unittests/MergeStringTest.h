@@ -0,0 +1,41 @@
+//===- MergeStringTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_MERGE_STRING_TEST_H
+#define MCLD_MERGE_STRING_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest
+{
+
+/** \class MergeStringTest
+ *  \brief The testcases of MergeString.
+ *
+ *  \see MergeString
+ */
+class MergeStringTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  MergeStringTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~MergeStringTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -266,3 +266,76 @@ TEST_F( NamePoolTest, insert_16384_weak_reference_symbols ) {
     }
   }
 }
+
+TEST_F( NamePoolTest, scan_name ) {
+  const char strtab[] = "\0foo\0_ZN4mcld8NamePool4ScanEPKcRj\0";
+  uint32_t hash = 0;
+  llvm::StringRef name = NamePool::Scan(strtab + 5, hash);
+  EXPECT_TRUE(name.equals("_ZN4mcld8NamePool4ScanEPKcRj"));
+  EXPECT_EQ(strtab + 5, name.data());
+  EXPECT_EQ(NamePool::Hash(name), hash);
+
+  name = NamePool::Scan(strtab, hash);
+  EXPECT_TRUE(name.empty());
+  EXPECT_EQ(NamePool::Hash(name), hash);
+}
+
+TEST_F( NamePoolTest, insertSymbol_with_hash ) {
+  const char strtab[] = "\0printf\0";
+  uint32_t hash = 0;
+  llvm::StringRef name = NamePool::Scan(strtab + 1, hash);
+
+  Resolver::Result result1;
+  m_pTestee->insertSymbol(name, hash, false, ResolveInfo::Function,
+                          ResolveInfo::Undefined, ResolveInfo::Global, 0, 0,
+                          ResolveInfo::Default, NULL, result1);
+  EXPECT_FALSE(result1.existent);
+  EXPECT_NE(strtab + 1, result1.info->name());
+  EXPECT_TRUE(result1.info->nameSize() == 6);
+
+  Resolver::Result result2;
+  m_pTestee->insertSymbol("printf", false, ResolveInfo::Function,
+                          ResolveInfo::Define, ResolveInfo::Global, 0, 0,
+                          ResolveInfo::Default, NULL, result2);
+  EXPECT_TRUE(result2.existent);
+  EXPECT_EQ(result1.info, result2.info);
+}
+
+TEST_F( NamePoolTest, resolve_existent_without_allocation ) {
+  char name[4] = { 'f', 0, 0, 0 };
+  Resolver::Result result;
+  for (int i = 1; i < 128; ++i) {
+    name[1] = i;
+    for (int j = 1; j < 128; ++j) {
+      name[2] = j;
+      m_pTestee->insertSymbol(name, false, ResolveInfo::Function,
+                              ResolveInfo::Undefined, ResolveInfo::Global,
+                              0, 0, ResolveInfo::Default, NULL, result);
+      ASSERT_FALSE(result.existent);
+    }
+  }
+  NamePool::size_type num = m_pTestee->size();
+  NamePool::size_type num_infos = m_pTestee->numOfProducedInfos();
+  ASSERT_TRUE(num_infos >= 127 * 127);
+
+  // the definitions override the references, and then the references meet
+  // the definitions. Neither allocates a temporary ResolveInfo.
+  for (int round = 0; round < 8; ++round) {
+    ResolveInfo::Desc desc = (0 == round) ? ResolveInfo::Define
+                                          : ResolveInfo::Undefined;
+    for (int i = 1; i < 128; ++i) {
+      name[1] = i;
+      for (int j = 1; j < 128; ++j) {
+        name[2] = j;
+        m_pTestee->insertSymbol(name, false, ResolveInfo::Function, desc,
+                                ResolveInfo::Global, 0, 0,
+                                ResolveInfo::Default, NULL, result);
+        ASSERT_TRUE(result.existent);
+        ASSERT_EQ((0 == round), result.overriden);
+        ASSERT_TRUE(result.info->isDefine());
+      }
+    }
+  }
+  EXPECT_EQ(num, m_pTestee->size());
+  EXPECT_EQ(num_infos, m_pTestee->numOfProducedInfos());
+}
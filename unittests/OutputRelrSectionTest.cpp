@@ -0,0 +1,217 @@
+//===- OutputRelrSectionTest.cpp ------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/IRBuilder.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/Fragment/FillFragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/ELFFileFormat.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/Support/MemoryRegion.h>
+#include <mcld/Target/OutputRelrSection.h>
+#include <llvm/Support/ELF.h>
+#include "OutputRelrSectionTest.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+// the address of .data
+static const uint64_t DataAddr = 0x1000;
+
+// Constructor can do set-up work for all test here.
+OutputRelrSectionTest::OutputRelrSectionTest()
+{
+  m_pConfig = new LinkerConfig("x86_64-linux-gnueabi");
+  Relocation::SetUp(*m_pConfig);
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+OutputRelrSectionTest::~OutputRelrSectionTest()
+{
+  delete m_pConfig;
+}
+
+// SetUp() will be called immediately before each test.
+void OutputRelrSectionTest::SetUp()
+{
+  m_pData = LDSection::Create(".data", LDFileFormat::Regular,
+                              llvm::ELF::SHT_PROGBITS,
+                              llvm::ELF::SHF_ALLOC | llvm::ELF::SHF_WRITE,
+                              0x1000, DataAddr);
+  SectionData* data = IRBuilder::CreateSectionData(*m_pData);
+  m_pFragment = new FillFragment(0x0, 1, 0x1000, data);
+  m_pFragment->setOffset(0x0);
+
+  m_pRelDyn = LDSection::Create(".rela.dyn", LDFileFormat::Relocation,
+                                llvm::ELF::SHT_RELA, llvm::ELF::SHF_ALLOC);
+  IRBuilder::CreateRelocData(*m_pRelDyn);
+
+  m_pRelrDyn = LDSection::Create(".relr.dyn", LDFileFormat::Relocation,
+                                 ELFFileFormat::SHT_RELR,
+                                 llvm::ELF::SHF_ALLOC);
+}
+
+// TearDown() will be called immediately after each test.
+void OutputRelrSectionTest::TearDown()
+{
+  LDSection::Destroy(m_pData);
+  LDSection::Destroy(m_pRelDyn);
+  LDSection::Destroy(m_pRelrDyn);
+}
+
+void OutputRelrSectionTest::addRelative(uint64_t pPlace)
+{
+  FragmentRef* ref = FragmentRef::Create(*m_pFragment, pPlace - DataAddr);
+  Relocation* reloc = Relocation::Create(llvm::ELF::R_X86_64_RELATIVE, *ref);
+  m_pRelDyn->getRelocData()->append(*reloc);
+}
+
+size_t OutputRelrSectionTest::pack(unsigned int pBitClass,
+                                   bool pIsLittleEndian,
+                                   std::vector<uint64_t>& pEntries)
+{
+  OutputRelrSection relr(*m_pRelrDyn, pBitClass, pIsLittleEndian);
+  relr.sizeOutput(m_pRelDyn->getRelocData()->size());
+  size_t num = relr.pack(*m_pRelDyn->getRelocData(),
+                         llvm::ELF::R_X86_64_RELATIVE);
+
+  std::vector<uint8_t> buffer(m_pRelrDyn->size());
+  MemoryRegion* region = MemoryRegion::Create(&buffer[0], buffer.size());
+  relr.emit(*region);
+  MemoryRegion::Destroy(region);
+
+  // decode the entries in the target byte order
+  size_t size = relr.entrySize();
+  pEntries.clear();
+  for (size_t idx = 0; idx < relr.numOfEntries(); ++idx) {
+    uint64_t entry = 0x0;
+    for (size_t i = 0; i < size; ++i) {
+      size_t pos = pIsLittleEndian ? (size - 1 - i) : i;
+      entry = (entry << 8) | buffer[idx * size + pos];
+    }
+    pEntries.push_back(entry);
+  }
+
+  // the unused tail is filled with empty bitmaps
+  for (size_t idx = relr.numOfEntries() * size; idx < buffer.size(); ++idx) {
+    size_t first = pIsLittleEndian ? 0 : (size - 1);
+    uint8_t expect = (first == (idx % size)) ? 0x1 : 0x0;
+    EXPECT_EQ(expect, buffer[idx]);
+  }
+  return num;
+}
+
+size_t OutputRelrSectionTest::numOfRelDyn() const
+{
+  return m_pRelDyn->getRelocData()->size();
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( OutputRelrSectionTest, adjacent_words ) {
+  // out of order
+  addRelative(DataAddr + 0x10);
+  addRelative(DataAddr);
+  addRelative(DataAddr + 0x8);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(3 == pack(64, true, entries));
+  ASSERT_TRUE(0 == numOfRelDyn());
+  ASSERT_TRUE(2 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0x7 == entries[1]);
+  // two entries are enough for three relocations
+  ASSERT_TRUE(3 * 8 == m_pRelrDyn->size());
+}
+
+TEST_F( OutputRelrSectionTest, wide_gap ) {
+  // the last word of the bitmap, and the first word after it
+  addRelative(DataAddr);
+  addRelative(DataAddr + 63 * 8);
+  addRelative(DataAddr + 0x400);
+  addRelative(DataAddr + 0x400 + 64 * 8);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(4 == pack(64, true, entries));
+  ASSERT_TRUE(4 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0x8000000000000001ULL == entries[1]);
+  ASSERT_TRUE(DataAddr + 0x400 == entries[2]);
+  ASSERT_TRUE(DataAddr + 0x400 + 64 * 8 == entries[3]);
+}
+
+TEST_F( OutputRelrSectionTest, full_bitmap_64 ) {
+  // an address, a full bitmap and one bit of the next bitmap
+  for (uint64_t i = 0; i < 65; ++i)
+    addRelative(DataAddr + i * 8);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(65 == pack(64, true, entries));
+  ASSERT_TRUE(3 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0xffffffffffffffffULL == entries[1]);
+  ASSERT_TRUE(0x3 == entries[2]);
+}
+
+TEST_F( OutputRelrSectionTest, full_bitmap_32 ) {
+  // a 32-bit bitmap covers 31 words of 4 bytes
+  for (uint64_t i = 0; i < 33; ++i)
+    addRelative(DataAddr + i * 4);
+  // beyond the third bitmap, which would be empty
+  addRelative(DataAddr + 4 + 31 * 4 * 3);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(34 == pack(32, true, entries));
+  ASSERT_TRUE(4 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0xffffffff == entries[1]);
+  ASSERT_TRUE(0x3 == entries[2]);
+  ASSERT_TRUE(DataAddr + 4 + 31 * 4 * 3 == entries[3]);
+}
+
+TEST_F( OutputRelrSectionTest, big_endian ) {
+  addRelative(DataAddr);
+  addRelative(DataAddr + 4);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(2 == pack(32, false, entries));
+  ASSERT_TRUE(2 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0x3 == entries[1]);
+}
+
+TEST_F( OutputRelrSectionTest, duplicate_place ) {
+  // a place relocated twice is packed once, and no relocation is left
+  addRelative(DataAddr);
+  addRelative(DataAddr + 8);
+  addRelative(DataAddr + 8);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(3 == pack(64, true, entries));
+  ASSERT_TRUE(0 == numOfRelDyn());
+  ASSERT_TRUE(2 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+  ASSERT_TRUE(0x3 == entries[1]);
+}
+
+TEST_F( OutputRelrSectionTest, unaligned_place ) {
+  addRelative(DataAddr);
+  addRelative(DataAddr + 12);
+
+  std::vector<uint64_t> entries;
+  ASSERT_TRUE(1 == pack(64, true, entries));
+  ASSERT_TRUE(1 == numOfRelDyn());
+  ASSERT_TRUE(1 == entries.size());
+  ASSERT_TRUE(DataAddr == entries[0]);
+}
+
@@ -0,0 +1,72 @@
+//===- OutputRelrSectionTest.h --------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OUTPUT_RELR_SECTION_TEST_H
+#define MCLD_OUTPUT_RELR_SECTION_TEST_H
+
+#include <gtest.h>
+#include <llvm/Support/DataTypes.h>
+#include <vector>
+
+namespace mcld
+{
+class Fragment;
+class LDSection;
+class LinkerConfig;
+
+} // namespace for mcld
+
+namespace mcldtest
+{
+
+/** \class OutputRelrSectionTest
+ *  \brief The testcases of the .relr.dyn encoder.
+ *
+ *  \see OutputRelrSection
+ */
+class OutputRelrSectionTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  OutputRelrSectionTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~OutputRelrSectionTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+protected:
+  /// addRelative - add a relative relocation of the place pPlace in .data
+  void addRelative(uint64_t pPlace);
+
+  /// pack - pack the relative relocations into a .relr.dyn of pBitClass
+  /// and read back the emitted entries. Return the number of the packed
+  /// relocations.
+  size_t pack(unsigned int pBitClass,
+              bool pIsLittleEndian,
+              std::vector<uint64_t>& pEntries);
+
+  /// numOfRelDyn - the number of relocations left in .rela.dyn
+  size_t numOfRelDyn() const;
+
+protected:
+  mcld::LinkerConfig* m_pConfig;
+  mcld::LDSection* m_pData;
+  mcld::Fragment* m_pFragment;
+  mcld::LDSection* m_pRelDyn;
+  mcld::LDSection* m_pRelrDyn;
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -0,0 +1,88 @@
+//===- SHA1Test.cpp -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/SHA1.h>
+#include "SHA1Test.h"
+
+#include <cstring>
+#include <algorithm>
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+SHA1Test::SHA1Test()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SHA1Test::~SHA1Test()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SHA1Test::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SHA1Test::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+static std::string ToHex(const uint8_t* pDigest)
+{
+  static const char hex[] = "0123456789abcdef";
+  std::string result;
+  for (unsigned int i = 0; i < SHA1::DigestSize; ++i) {
+    result += hex[pDigest[i] >> 4];
+    result += hex[pDigest[i] & 0xf];
+  }
+  return result;
+}
+
+TEST_F(SHA1Test, known_digests) {
+  uint8_t digest[SHA1::DigestSize];
+  SHA1 sha1;
+
+  sha1.final(digest);
+  ASSERT_TRUE("da39a3ee5e6b4b0d3255bfef95601890afd80709" == ToHex(digest));
+
+  sha1.update("abc", 3);
+  sha1.final(digest);
+  ASSERT_TRUE("a9993e364706816aba3e25717850c26c9cd0d89d" == ToHex(digest));
+
+  // 56 bytes, the padding takes one more block
+  const char* msg =
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  sha1.update(msg, strlen(msg));
+  sha1.final(digest);
+  ASSERT_TRUE("84983e441c3bd26ebaae4aa1f95129e5e54670f1" == ToHex(digest));
+}
+
+TEST_F(SHA1Test, split_updates) {
+  std::string data(1000000, 'a');
+  uint8_t digest[SHA1::DigestSize];
+  SHA1 sha1;
+
+  // feed the message in pieces which do not fit the block boundary
+  size_t pos = 0, step = 1;
+  while (pos < data.size()) {
+    size_t size = std::min(step, data.size() - pos);
+    sha1.update(data.data() + pos, size);
+    pos += size;
+    step = step * 3 + 1;
+  }
+  sha1.final(digest);
+  ASSERT_TRUE("34aa973cd4c4daa4f61eeb2bdbad27316534016f" == ToHex(digest));
+}
+
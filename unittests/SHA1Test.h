@@ -0,0 +1,41 @@
+//===- SHA1Test.h ---------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SHA1_TEST_H
+#define MCLD_SHA1_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest
+{
+
+/** \class SHA1Test
+ *  \brief The testcases of SHA1.
+ *
+ *  \see SHA1
+ */
+class SHA1Test : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  SHA1Test();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~SHA1Test();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+} // namespace of mcldtest
+
+#endif
+
@@ -0,0 +1,74 @@
+//===- SearchDirsTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/MC/SearchDirs.h>
+#include <mcld/MC/MCLDDirectory.h>
+#include <mcld/Support/Path.h>
+#include "SearchDirsTest.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+SearchDirsTest::SearchDirsTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SearchDirsTest::~SearchDirsTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SearchDirsTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SearchDirsTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(SearchDirsTest, find_script) {
+  sys::fs::Path dir(TOPDIR);
+  dir.append("unittests");
+
+  SearchDirs dirs;
+  ASSERT_TRUE(dirs.insert(dir));
+
+  const SearchDirs& const_dirs = dirs;
+  const sys::fs::Path* path = const_dirs.find("test.txt", Input::Script);
+  ASSERT_TRUE(NULL != path);
+  ASSERT_TRUE("test.txt" == path->filename().native());
+
+  // the second look-up hits the index
+  ASSERT_TRUE(path == dirs.find("test.txt", Input::Script));
+  ASSERT_TRUE((*dirs.begin())->isIndexed());
+
+  ASSERT_TRUE(NULL == dirs.find("test", Input::Archive));
+  ASSERT_TRUE(NULL == dirs.find("test", Input::DynObj));
+  ASSERT_TRUE(NULL == dirs.find("no-such-file.txt", Input::Script));
+}
+
+TEST_F(SearchDirsTest, index_from_listing) {
+  MCLDDirectory dir(TOPDIR);
+  std::vector<std::string> names;
+  names.push_back("libfoo.so");
+  names.push_back("libfoo.a");
+  dir.buildIndex(names);
+  ASSERT_TRUE(dir.isIndexed());
+
+  sys::fs::Path* path = dir.find("libfoo.a");
+  ASSERT_TRUE(NULL != path);
+  ASSERT_TRUE("libfoo.a" == path->filename().native());
+  ASSERT_TRUE(NULL != dir.find("libfoo.so"));
+  ASSERT_TRUE(NULL == dir.find("libfoo"));
+}
@@ -0,0 +1,128 @@
+//===- SectionMatcherTest.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Object/SectionMatcher.h>
+#include <mcld/Script/WildcardPattern.h>
+#include <mcld/Script/StringList.h>
+#include "SectionMatcherTest.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+/// CreateSpec - a description like "pFile(EXCLUDE_FILE(pExclude) pSects)".
+/// A NULL pattern is left out.
+InputSectDesc::Spec CreateSpec(const char* pFile,
+                               const char* pExclude,
+                               const char* pSect1,
+                               const char* pSect2 = NULL)
+{
+  InputSectDesc::Spec spec;
+  spec.m_pWildcardFile = NULL;
+  if (NULL != pFile)
+    spec.m_pWildcardFile =
+      WildcardPattern::create(pFile, WildcardPattern::SORT_NONE);
+
+  spec.m_pExcludeFiles = NULL;
+  if (NULL != pExclude) {
+    spec.m_pExcludeFiles = StringList::create();
+    spec.m_pExcludeFiles->push_back(
+      WildcardPattern::create(pExclude, WildcardPattern::SORT_NONE));
+  }
+
+  spec.m_pWildcardSections = NULL;
+  if (NULL != pSect1) {
+    spec.m_pWildcardSections = StringList::create();
+    spec.m_pWildcardSections->push_back(
+      WildcardPattern::create(pSect1, WildcardPattern::SORT_NONE));
+    if (NULL != pSect2)
+      spec.m_pWildcardSections->push_back(
+        WildcardPattern::create(pSect2, WildcardPattern::SORT_NONE));
+  }
+  return spec;
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+SectionMatcherTest::SectionMatcherTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SectionMatcherTest::~SectionMatcherTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SectionMatcherTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SectionMatcherTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(SectionMatcherTest, first_match) {
+  SectionMatcher matcher;
+  ASSERT_TRUE(0 == matcher.addRule(CreateSpec("*", NULL, ".text.unlikely")));
+  ASSERT_TRUE(1 == matcher.addRule(CreateSpec("*", NULL, ".text", ".text.*")));
+  ASSERT_TRUE(2 == matcher.addRule(CreateSpec("*", NULL, ".t?xt.[a-z]*")));
+  ASSERT_TRUE(3 == matcher.addRule(CreateSpec("*", NULL, ".data*")));
+
+  ASSERT_TRUE(0 == matcher.match("a.o", ".text.unlikely"));
+  ASSERT_TRUE(1 == matcher.match("a.o", ".text"));
+  ASSERT_TRUE(1 == matcher.match("a.o", ".text.foo"));
+  ASSERT_TRUE(1 == matcher.match("a.o", ".text."));
+  ASSERT_TRUE(2 == matcher.match("a.o", ".tyxt.bar"));
+  ASSERT_TRUE(3 == matcher.match("a.o", ".data"));
+  ASSERT_TRUE(3 == matcher.match("a.o", ".data.rel.ro"));
+  ASSERT_TRUE(SectionMatcher::NoMatch == matcher.match("a.o", ".tex"));
+  ASSERT_TRUE(SectionMatcher::NoMatch == matcher.match("a.o", ".tyxt.1"));
+  ASSERT_TRUE(SectionMatcher::NoMatch == matcher.match("a.o", ".bss"));
+
+  // memoized
+  ASSERT_TRUE(1 == matcher.match("a.o", ".text.foo"));
+}
+
+TEST_F(SectionMatcherTest, files) {
+  SectionMatcher matcher;
+  matcher.addRule(CreateSpec("*", "*crtbegin.o", ".ctors"));
+  matcher.addRule(CreateSpec("*crtbegin.o", NULL, NULL));
+  matcher.addRule(CreateSpec("*", NULL, "*"));
+
+  ASSERT_TRUE(0 == matcher.match("/lib/a.o", ".ctors"));
+  ASSERT_TRUE(1 == matcher.match("/lib/crtbegin.o", ".ctors"));
+  ASSERT_TRUE(1 == matcher.match("/lib/crtbegin.o", ".text"));
+  ASSERT_TRUE(2 == matcher.match("/lib/a.o", ".text"));
+
+  // a rule with section patterns does not check its file pattern
+  SectionMatcher other;
+  other.addRule(CreateSpec("b.o", NULL, ".text"));
+  ASSERT_TRUE(0 == other.match("a.o", ".text"));
+}
+
+TEST_F(SectionMatcherTest, clear) {
+  SectionMatcher matcher;
+  matcher.addRule(CreateSpec("*", NULL, ".text*"));
+  ASSERT_TRUE(0 == matcher.match("a.o", ".text.foo"));
+
+  matcher.clear();
+  ASSERT_TRUE(0 == matcher.size());
+  ASSERT_TRUE(SectionMatcher::NoMatch == matcher.match("a.o", ".text.foo"));
+
+  matcher.addRule(CreateSpec("*", NULL, ".data"));
+  matcher.addRule(CreateSpec("*", NULL, ".text.*"));
+  ASSERT_TRUE(1 == matcher.match("a.o", ".text.foo"));
+}
+
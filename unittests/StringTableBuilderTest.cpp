@@ -0,0 +1,100 @@
+//===- StringTableBuilderTest.cpp -----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/StringTableBuilder.h>
+#include "StringTableBuilderTest.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+StringTableBuilderTest::StringTableBuilderTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+StringTableBuilderTest::~StringTableBuilderTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void StringTableBuilderTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void StringTableBuilderTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(StringTableBuilderTest, tail_merge) {
+  StringTableBuilder table;
+  table.add("bar");
+  table.add("foobar");
+  table.add("ar");
+  table.add("foobar");
+  table.add("");
+  table.add("baz");
+  table.finalize();
+
+  // "\0baz\0foobar\0"
+  ASSERT_TRUE(12 == table.size());
+  ASSERT_TRUE(4 == table.numOfStrings());
+  ASSERT_TRUE(0 == table.getOffset(""));
+  ASSERT_TRUE(1 == table.getOffset("baz"));
+  ASSERT_TRUE(5 == table.getOffset("foobar"));
+  ASSERT_TRUE(8 == table.getOffset("bar"));
+  ASSERT_TRUE(9 == table.getOffset("ar"));
+
+  std::vector<char> buffer(table.size());
+  table.emit(&buffer[0]);
+  ASSERT_TRUE(0 == memcmp(&buffer[0], "\0baz\0foobar\0", 12));
+  ASSERT_TRUE(0 == strcmp(&buffer[table.getOffset("ar")], "ar"));
+}
+
+TEST_F(StringTableBuilderTest, order_independent) {
+  StringTableBuilder t1, t2;
+  t1.add("_ZN4mcld6ModuleD1Ev");
+  t1.add("_ZN4mcld6ModuleD2Ev");
+  t1.add("D2Ev");
+  t2.add("D2Ev");
+  t2.add("_ZN4mcld6ModuleD2Ev");
+  t2.add("_ZN4mcld6ModuleD1Ev");
+  t1.finalize();
+  t2.finalize();
+
+  ASSERT_TRUE(t1.size() == t2.size());
+  ASSERT_TRUE(t1.getOffset("D2Ev") == t2.getOffset("D2Ev"));
+  ASSERT_TRUE(t1.getOffset("_ZN4mcld6ModuleD1Ev") ==
+              t2.getOffset("_ZN4mcld6ModuleD1Ev"));
+}
+
+TEST_F(StringTableBuilderTest, add_after_finalize) {
+  StringTableBuilder table;
+  table.add("foo");
+  table.finalize();
+  ASSERT_TRUE(5 == table.size());
+
+  // the late string is appended, even if it is a suffix
+  table.add("oo");
+  table.add("foo");
+  ASSERT_TRUE(1 == table.getOffset("foo"));
+  ASSERT_TRUE(5 == table.getOffset("oo"));
+  ASSERT_TRUE(8 == table.size());
+
+  std::vector<char> buffer(table.size());
+  table.emit(&buffer[0]);
+  ASSERT_TRUE(0 == memcmp(&buffer[0], "\0foo\0oo\0", 8));
+}
+
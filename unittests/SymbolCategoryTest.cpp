@@ -9,6 +9,7 @@
 #include <mcld/MC/SymbolCategory.h>
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/LDSymbol.h>
+#include <algorithm>
 #include <iostream>
 #include "SymbolCategoryTest.h"
 
@@ -142,3 +143,48 @@ TEST_F(SymbolCategoryTest, change_local_to_dynamic) {
   ++sym;
   ASSERT_STREQ("e", (*sym)->name());
 }
+
+TEST_F(SymbolCategoryTest, arrange_after_reorder) {
+  ResolveInfo* a = ResolveInfo::Create("a");
+  ResolveInfo* b = ResolveInfo::Create("b");
+  ResolveInfo* c = ResolveInfo::Create("c");
+  ResolveInfo* d = ResolveInfo::Create("d");
+
+  a->setBinding(ResolveInfo::Global);
+  b->setBinding(ResolveInfo::Global);
+  c->setBinding(ResolveInfo::Global);
+  d->setBinding(ResolveInfo::Global);
+
+  LDSymbol* aa = LDSymbol::Create(*a);
+  LDSymbol* bb = LDSymbol::Create(*b);
+  LDSymbol* cc = LDSymbol::Create(*c);
+  LDSymbol* dd = LDSymbol::Create(*d);
+
+  m_pTestee->add(*aa);
+  m_pTestee->add(*bb);
+  m_pTestee->add(*cc);
+  m_pTestee->add(*dd);
+  ASSERT_TRUE(4 == m_pTestee->numOfDynamics());
+
+  // reorder the dynamic symbols behind the back of SymbolCategory
+  std::reverse(m_pTestee->dynamicBegin(), m_pTestee->dynamicEnd());
+
+  // b becomes hidden and moves to the regular symbols
+  ResolveInfo* old_b = ResolveInfo::Create("b");
+  old_b->override(*b);
+  b->setVisibility(ResolveInfo::Hidden);
+  m_pTestee->arrange(*bb, *old_b);
+  ASSERT_TRUE(3 == m_pTestee->numOfDynamics());
+  ASSERT_TRUE(1 == m_pTestee->numOfRegulars());
+  ASSERT_TRUE(bb == *m_pTestee->regularBegin());
+
+  // a moves up to the local dynamic symbols
+  m_pTestee->changeToDynamic(*aa);
+  ASSERT_TRUE(1 == m_pTestee->numOfLocalDyns());
+  ASSERT_TRUE(aa == *m_pTestee->localDynBegin());
+
+  SymbolCategory::iterator sym = m_pTestee->dynamicBegin();
+  ASSERT_STREQ("c", (*sym)->name());
+  ++sym;
+  ASSERT_STREQ("d", (*sym)->name());
+}
@@ -0,0 +1,93 @@
+//===- ThreadPoolTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/ThreadPool.h>
+#include "ThreadPoolTest.h"
+
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+class CountTask : public ThreadPool::Task
+{
+public:
+  CountTask() : m_Count(0) { }
+
+  void run() { ++m_Count; }
+
+  unsigned int count() const { return m_Count; }
+
+private:
+  unsigned int m_Count;
+};
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+ThreadPoolTest::ThreadPoolTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ThreadPoolTest::~ThreadPoolTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void ThreadPoolTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void ThreadPoolTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ThreadPoolTest, zero_means_one) {
+  ThreadPool pool(0);
+  ASSERT_TRUE(1 == pool.numOfThreads());
+}
+
+TEST_F(ThreadPoolTest, run_each_task_once) {
+  std::vector<CountTask> tasks(1000);
+  ThreadPool::TaskList task_list;
+  for (size_t i = 0; i < tasks.size(); ++i)
+    task_list.push_back(&tasks[i]);
+
+  ThreadPool pool(4);
+  pool.run(task_list);
+  for (size_t i = 0; i < tasks.size(); ++i)
+    ASSERT_TRUE(1 == tasks[i].count());
+
+  // a pool can be reused
+  pool.run(task_list);
+  for (size_t i = 0; i < tasks.size(); ++i)
+    ASSERT_TRUE(2 == tasks[i].count());
+}
+
+TEST_F(ThreadPoolTest, more_threads_than_tasks) {
+  std::vector<CountTask> tasks(2);
+  ThreadPool::TaskList task_list;
+  task_list.push_back(&tasks[0]);
+  task_list.push_back(&tasks[1]);
+
+  ThreadPool pool(16);
+  pool.run(task_list);
+  ASSERT_TRUE(1 == tasks[0].count());
+  ASSERT_TRUE(1 == tasks[1].count());
+
+  ThreadPool::TaskList empty;
+  pool.run(empty);
+}
+